@@ -327,22 +327,7 @@ template<> struct ldlt_inplace<Lower>
 
       transpositions.coeffRef(k) = IndexType(index_of_biggest_in_corner);
       if(k != index_of_biggest_in_corner)
-      {
-        // apply the transposition while taking care to consider only
-        // the lower triangular part
-        Index s = size-index_of_biggest_in_corner-1; // trailing size after the biggest element
-        mat.row(k).head(k).swap(mat.row(index_of_biggest_in_corner).head(k));
-        mat.col(k).tail(s).swap(mat.col(index_of_biggest_in_corner).tail(s));
-        std::swap(mat.coeffRef(k,k),mat.coeffRef(index_of_biggest_in_corner,index_of_biggest_in_corner));
-        for(Index i=k+1;i<index_of_biggest_in_corner;++i)
-        {
-          Scalar tmp = mat.coeffRef(i,k);
-          mat.coeffRef(i,k) = numext::conj(mat.coeffRef(index_of_biggest_in_corner,i));
-          mat.coeffRef(index_of_biggest_in_corner,i) = numext::conj(tmp);
-        }
-        if(NumTraits<Scalar>::IsComplex)
-          mat.coeffRef(index_of_biggest_in_corner,k) = numext::conj(mat.coeff(index_of_biggest_in_corner,k));
-      }
+        swap_lower(mat, k, index_of_biggest_in_corner);
 
       // partition the matrix:
       //       A00 |  -  |  -
@@ -389,19 +374,127 @@ template<> struct ldlt_inplace<Lower>
       if(found_zero_pivot && pivot_is_valid) ret = false; // factorization failed
       else if(!pivot_is_valid) found_zero_pivot = true;
 
-      if (sign == PositiveSemiDef) {
-        if (realAkk < static_cast<RealScalar>(0)) sign = Indefinite;
-      } else if (sign == NegativeSemiDef) {
-        if (realAkk > static_cast<RealScalar>(0)) sign = Indefinite;
-      } else if (sign == ZeroSign) {
-        if (realAkk > static_cast<RealScalar>(0)) sign = PositiveSemiDef;
-        else if (realAkk < static_cast<RealScalar>(0)) sign = NegativeSemiDef;
+      update_sign(sign, realAkk);
+    }
+
+    return ret;
+  }
+
+  // Same as unblocked(), but the columns are factorized by panels, as in LAPACK's xLASYF, without its 2x2 pivots.
+  // Within a panel, the current column is updated by the previous columns of the panel only, and the lower part
+  // of the trailing matrix is updated by the whole panel at the end, by a matrix-matrix product. The pivots are
+  // still chosen from the diagonal coefficients of the input matrix, which are saved beforehand.
+  template<typename MatrixType, typename TranspositionType, typename Workspace>
+  static bool blocked(MatrixType& mat, TranspositionType& transpositions, Workspace& temp, SignMatrix& sign)
+  {
+    using std::abs;
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename MatrixType::RealScalar RealScalar;
+    typedef typename TranspositionType::StorageIndex IndexType;
+    eigen_assert(mat.rows()==mat.cols());
+    const Index size = mat.rows();
+    // matrices with a fixed maximal size are not large enough to allocate the panels
+    if(size < 32 || MatrixType::MaxRowsAtCompileTime != Dynamic)
+      return unblocked(mat, transpositions, temp, sign);
+
+    Index blockSize = size/8;
+    blockSize = (blockSize/16)*16;
+    blockSize = (std::min)((std::max)(blockSize,Index(8)), Index(128));
+
+    Matrix<Scalar,Dynamic,1> diag = mat.diagonal();
+    Matrix<Scalar,Dynamic,Dynamic> W(size, blockSize); // W(:,j) = L(:,k+j) * D(k+j) for the columns of the current panel
+    bool found_zero_pivot = false;
+    bool ret = true;
+
+    for(Index k = 0; k < size; k += blockSize)
+    {
+      Index bs = (std::min)(blockSize, size-k);
+      for(Index j = 0; j < bs; ++j)
+      {
+        const Index i = k + j;
+        Index index_of_biggest_in_corner;
+        diag.tail(size-i).cwiseAbs().maxCoeff(&index_of_biggest_in_corner);
+        index_of_biggest_in_corner += i;
+
+        transpositions.coeffRef(i) = IndexType(index_of_biggest_in_corner);
+        if(i != index_of_biggest_in_corner)
+        {
+          swap_lower(mat, i, index_of_biggest_in_corner);
+          std::swap(diag.coeffRef(i), diag.coeffRef(index_of_biggest_in_corner));
+          W.row(i).head(j).swap(W.row(index_of_biggest_in_corner).head(j));
+        }
+
+        Index rs = size - i - 1;
+        if(j>0)
+          mat.col(i).tail(size-i).noalias() -= mat.block(i, k, size-i, j) * W.row(i).head(j).adjoint();
+
+        RealScalar realAkk = numext::real(mat.coeffRef(i,i));
+        bool pivot_is_valid = (abs(realAkk) > RealScalar(0));
+
+        if(i==0 && !pivot_is_valid)
+        {
+          // see unblocked()
+          sign = ZeroSign;
+          for(Index c = 0; c<size; ++c)
+          {
+            transpositions.coeffRef(c) = IndexType(c);
+            ret = ret && (mat.col(c).tail(size-c-1).array()==Scalar(0)).all();
+          }
+          return ret;
+        }
+
+        W.col(j).tail(size-i) = mat.col(i).tail(size-i);
+        if((rs>0) && pivot_is_valid)
+          mat.col(i).tail(rs) /= realAkk;
+        else if(rs>0)
+          ret = ret && (mat.col(i).tail(rs).array()==Scalar(0)).all();
+
+        if(found_zero_pivot && pivot_is_valid) ret = false; // factorization failed
+        else if(!pivot_is_valid) found_zero_pivot = true;
+
+        update_sign(sign, realAkk);
       }
+
+      Index rs = size - k - bs;
+      if(rs>0)
+        mat.bottomRightCorner(rs,rs).template triangularView<Lower>() -= mat.block(k+bs, k, rs, bs) * W.block(k+bs, 0, rs, bs).adjoint();
     }
 
     return ret;
   }
 
+  // Applies the transposition (k,p), k<p, to the rows and columns of the lower triangular part of mat
+  template<typename MatrixType>
+  static void swap_lower(MatrixType& mat, Index k, Index p)
+  {
+    typedef typename MatrixType::Scalar Scalar;
+    Index s = mat.rows()-p-1; // trailing size after the biggest element
+    mat.row(k).head(k).swap(mat.row(p).head(k));
+    mat.col(k).tail(s).swap(mat.col(p).tail(s));
+    std::swap(mat.coeffRef(k,k),mat.coeffRef(p,p));
+    for(Index i=k+1;i<p;++i)
+    {
+      Scalar tmp = mat.coeffRef(i,k);
+      mat.coeffRef(i,k) = numext::conj(mat.coeffRef(p,i));
+      mat.coeffRef(p,i) = numext::conj(tmp);
+    }
+    if(NumTraits<Scalar>::IsComplex)
+      mat.coeffRef(p,k) = numext::conj(mat.coeff(p,k));
+  }
+
+  template<typename RealScalar>
+  static void update_sign(SignMatrix& sign, const RealScalar& realAkk)
+  {
+    if (sign == PositiveSemiDef) {
+      if (realAkk < static_cast<RealScalar>(0)) sign = Indefinite;
+    } else if (sign == NegativeSemiDef) {
+      if (realAkk > static_cast<RealScalar>(0)) sign = Indefinite;
+    } else if (sign == ZeroSign) {
+      if (realAkk > static_cast<RealScalar>(0)) sign = PositiveSemiDef;
+      else if (realAkk < static_cast<RealScalar>(0)) sign = NegativeSemiDef;
+    }
+  }
+
   // Reference for the algorithm: Davis and Hager, "Multiple Rank
   // Modifications of a Sparse Cholesky Factorization" (Algorithm 1)
   // Trivial rearrangements of their computations (Timothy E. Holy)
@@ -466,6 +559,13 @@ template<> struct ldlt_inplace<Upper>
     return ldlt_inplace<Lower>::unblocked(matt, transpositions, temp, sign);
   }
 
+  template<typename MatrixType, typename TranspositionType, typename Workspace>
+  static EIGEN_STRONG_INLINE bool blocked(MatrixType& mat, TranspositionType& transpositions, Workspace& temp, SignMatrix& sign)
+  {
+    Transpose<MatrixType> matt(mat);
+    return ldlt_inplace<Lower>::blocked(matt, transpositions, temp, sign);
+  }
+
   template<typename MatrixType, typename TranspositionType, typename Workspace, typename WType>
   static EIGEN_STRONG_INLINE bool update(MatrixType& mat, TranspositionType& transpositions, Workspace& tmp, WType& w, const typename MatrixType::RealScalar& sigma=1)
   {
@@ -523,7 +623,7 @@ LDLT<MatrixType,_UpLo>& LDLT<MatrixType,_UpLo>::compute(const EigenBase<InputTyp
   m_temporary.resize(size);
   m_sign = internal::ZeroSign;
 
-  m_info = internal::ldlt_inplace<UpLo>::unblocked(m_matrix, m_transpositions, m_temporary, m_sign) ? Success : NumericalIssue;
+  m_info = internal::ldlt_inplace<UpLo>::blocked(m_matrix, m_transpositions, m_temporary, m_sign) ? Success : NumericalIssue;
 
   m_isInitialized = true;
   return *this;
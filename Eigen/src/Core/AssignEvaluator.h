@@ -22,6 +22,52 @@ namespace internal {
 * Part 1 : the logic deciding a strategy for traversal and unrolling       *
 ***************************************************************************/
 
+// has_mixed_storage_orders<Xpr>::value is true if Xpr combines operands which are not stored in the same order,
+// such as B.transpose() + C. Such expressions cannot be traversed in a cache friendly order as a whole.
+template<typename Xpr> struct has_mixed_storage_orders { enum { value = false }; };
+
+template<typename T1, typename T2> struct storage_orders_differ
+{
+  typedef typename remove_all<T1>::type Xpr1;
+  typedef typename remove_all<T2>::type Xpr2;
+  enum { value = !bool(Xpr1::IsVectorAtCompileTime) && !bool(Xpr2::IsVectorAtCompileTime)
+              && (int(evaluator<Xpr1>::Flags)&RowMajorBit) != (int(evaluator<Xpr2>::Flags)&RowMajorBit) };
+};
+
+template<typename UnaryOp, typename ArgType>
+struct has_mixed_storage_orders<CwiseUnaryOp<UnaryOp,ArgType> > : has_mixed_storage_orders<typename remove_all<ArgType>::type> {};
+template<typename ViewOp, typename MatrixType>
+struct has_mixed_storage_orders<CwiseUnaryView<ViewOp,MatrixType> > : has_mixed_storage_orders<typename remove_all<MatrixType>::type> {};
+template<typename MatrixType>
+struct has_mixed_storage_orders<Transpose<MatrixType> > : has_mixed_storage_orders<typename remove_all<MatrixType>::type> {};
+template<typename XprType, int BlockRows, int BlockCols, bool InnerPanel>
+struct has_mixed_storage_orders<Block<XprType,BlockRows,BlockCols,InnerPanel> > : has_mixed_storage_orders<typename remove_all<XprType>::type> {};
+template<typename MatrixType, int Direction>
+struct has_mixed_storage_orders<Reverse<MatrixType,Direction> > : has_mixed_storage_orders<typename remove_all<MatrixType>::type> {};
+template<typename MatrixType, int RowFactor, int ColFactor>
+struct has_mixed_storage_orders<Replicate<MatrixType,RowFactor,ColFactor> > : has_mixed_storage_orders<typename remove_all<MatrixType>::type> {};
+template<typename ExpressionType>
+struct has_mixed_storage_orders<ArrayWrapper<ExpressionType> > : has_mixed_storage_orders<typename remove_all<ExpressionType>::type> {};
+template<typename ExpressionType>
+struct has_mixed_storage_orders<MatrixWrapper<ExpressionType> > : has_mixed_storage_orders<typename remove_all<ExpressionType>::type> {};
+
+template<typename BinaryOp, typename Lhs, typename Rhs>
+struct has_mixed_storage_orders<CwiseBinaryOp<BinaryOp,Lhs,Rhs> >
+{
+  enum { value = storage_orders_differ<Lhs,Rhs>::value
+              || has_mixed_storage_orders<typename remove_all<Lhs>::type>::value
+              || has_mixed_storage_orders<typename remove_all<Rhs>::type>::value };
+};
+
+template<typename TernaryOp, typename Arg1, typename Arg2, typename Arg3>
+struct has_mixed_storage_orders<CwiseTernaryOp<TernaryOp,Arg1,Arg2,Arg3> >
+{
+  enum { value = storage_orders_differ<Arg1,Arg2>::value || storage_orders_differ<Arg1,Arg3>::value
+              || has_mixed_storage_orders<typename remove_all<Arg1>::type>::value
+              || has_mixed_storage_orders<typename remove_all<Arg2>::type>::value
+              || has_mixed_storage_orders<typename remove_all<Arg3>::type>::value };
+};
+
 // copy_using_evaluator_traits is based on assign_traits
 
 template <typename DstEvaluator, typename SrcEvaluator, typename AssignFunc, int MaxPacketSize = -1>
@@ -90,11 +136,17 @@ private:
       /* If the destination isn't aligned, we have to do runtime checks and we don't unroll,
          so it's only good for large enough sizes. */
     MaySliceVectorize  = bool(MightVectorize) && bool(DstHasDirectAccess)
-                       && (int(InnerMaxSize)==Dynamic || int(InnerMaxSize)>=(EIGEN_UNALIGNED_VECTORIZE?InnerPacketSize:(3*InnerPacketSize)))
+                       && (int(InnerMaxSize)==Dynamic || int(InnerMaxSize)>=(EIGEN_UNALIGNED_VECTORIZE?InnerPacketSize:(3*InnerPacketSize))),
       /* slice vectorization can be slow, so we only want it if the slices are big, which is
          indicated by InnerMaxSize rather than InnerSize, think of the case of a dynamic block
          in a fixed-size matrix
          However, with EIGEN_UNALIGNED_VECTORIZE and unrolling, slice vectorization is still worth it */
+    MayTile = (!bool(StorageOrdersAgree) || bool(has_mixed_storage_orders<typename SrcEvaluator::XprType>::value))
+            && !bool(Dst::IsVectorAtCompileTime)
+            && (int(Dst::MaxRowsAtCompileTime)==Dynamic || int(Dst::MaxRowsAtCompileTime)>int(EIGEN_ASSIGN_TILE_SIZE))
+            && (int(Dst::MaxColsAtCompileTime)==Dynamic || int(Dst::MaxColsAtCompileTime)>int(EIGEN_ASSIGN_TILE_SIZE))
+      /* the default traversal of large matrices follows the storage order of the destination only,
+         so the operands stored in the other order are traversed by tiles to remain in cache */
   };
 
 public:
@@ -104,6 +156,7 @@ public:
               : int(MayLinearVectorize)  ? int(LinearVectorizedTraversal)
               : int(MaySliceVectorize)   ? int(SliceVectorizedTraversal)
               : int(MayLinearize)        ? int(LinearTraversal)
+              : int(MayTile)             ? int(TiledTraversal)
                                          : int(DefaultTraversal),
     Vectorized = int(Traversal) == InnerVectorizedTraversal
               || int(Traversal) == LinearVectorizedTraversal
@@ -172,6 +225,7 @@ public:
     EIGEN_DEBUG_VAR(MayInnerVectorize)
     EIGEN_DEBUG_VAR(MayLinearVectorize)
     EIGEN_DEBUG_VAR(MaySliceVectorize)
+    EIGEN_DEBUG_VAR(MayTile)
     std::cerr << "Traversal" << " = " << Traversal << " (" << demangle_traversal(Traversal) << ")" << std::endl;
     EIGEN_DEBUG_VAR(SrcEvaluator::CoeffReadCost)
     EIGEN_DEBUG_VAR(DstEvaluator::CoeffReadCost)
@@ -316,6 +370,9 @@ template<typename Kernel,
          int Unrolling = Kernel::AssignmentTraits::Unrolling>
 struct dense_assignment_loop;
 
+// defined in ParallelCwise.h
+template<typename Kernel> struct parallel_dense_assignment_loop;
+
 /************************
 *** Default traversal ***
 ************************/
@@ -356,6 +413,35 @@ struct dense_assignment_loop<Kernel, DefaultTraversal, InnerUnrolling>
   }
 };
 
+/**********************
+*** Tiled traversal ***
+**********************/
+
+// Same as the default traversal, but the destination is traversed by square tiles of EIGEN_ASSIGN_TILE_SIZE^2
+// coefficients, so that the operands stored in the other order than the destination are read by contiguous
+// chunks which are reused across the columns (or rows) of a tile while they are still in cache.
+template<typename Kernel>
+struct dense_assignment_loop<Kernel, TiledTraversal, NoUnrolling>
+{
+  EIGEN_DEVICE_FUNC static void EIGEN_STRONG_INLINE run(Kernel &kernel)
+  {
+    const Index tileSize = EIGEN_ASSIGN_TILE_SIZE;
+    const Index outerSize = kernel.outerSize();
+    const Index innerSize = kernel.innerSize();
+    for(Index outer0 = 0; outer0 < outerSize; outer0 += tileSize)
+    {
+      const Index outerEnd = numext::mini(outer0+tileSize, outerSize);
+      for(Index inner0 = 0; inner0 < innerSize; inner0 += tileSize)
+      {
+        const Index innerEnd = numext::mini(inner0+tileSize, innerSize);
+        for(Index outer = outer0; outer < outerEnd; ++outer)
+          for(Index inner = inner0; inner < innerEnd; ++inner)
+            kernel.assignCoeffByOuterInner(outer, inner);
+      }
+    }
+  }
+};
+
 /***************************
 *** Linear vectorization ***
 ***************************/
@@ -764,6 +850,11 @@ EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void call_dense_assignment_loop(DstXprType
   typedef generic_dense_assignment_kernel<DstEvaluatorType,SrcEvaluatorType,Functor> Kernel;
   Kernel kernel(dstEvaluator, srcEvaluator, func, dst.const_cast_derived());
 
+#if defined(EIGEN_PARALLELIZE_CWISE) && !defined(EIGEN_GPU_COMPILE_PHASE)
+  if(parallel_dense_assignment_loop<Kernel>::run(kernel))
+    return;
+#endif
+
   dense_assignment_loop<Kernel>::run(kernel);
 }
 
@@ -32,6 +32,7 @@ template<> struct storage_kind_to_shape<Dense>                  { typedef DenseS
 template<> struct storage_kind_to_shape<SolverStorage>          { typedef SolverShape Shape;           };
 template<> struct storage_kind_to_shape<PermutationStorage>     { typedef PermutationShape Shape;     };
 template<> struct storage_kind_to_shape<TranspositionsStorage>  { typedef TranspositionsShape Shape;  };
+template<> struct storage_kind_to_shape<PackedStorage>          { typedef PackedShape Shape;          };
 
 // Evaluators have to be specialized with respect to various criteria such as:
 //  - storage/structure/shape
@@ -598,6 +598,16 @@ pmadd(const Packet&  a,
          const Packet&  c)
 { return padd(pmul(a, b),c); }
 
+/** \internal \returns c + a0*b0 + a1*b1 for each 32-bit integer of the packets, where (a0,a1) and (b0,b1) are the
+  * pairs of signed 16-bit integers packed into the 32-bit integers of \a a and \a b (the first one in the low bits).
+  * This is the building block of the integer products of QuantizedProduct.h. */
+template<typename Packet> EIGEN_DEVICE_FUNC inline Packet
+pmadd_pairs(const Packet& a, const Packet& b, const Packet& c)
+{
+  return c + Packet(static_cast<short>(a)) * Packet(static_cast<short>(b))
+           + Packet(static_cast<short>(a >> 16)) * Packet(static_cast<short>(b >> 16));
+}
+
 /** \internal \returns a packet version of \a *from.
   * The pointer \a from must be aligned on a \a Alignment bytes boundary. */
 template<typename Packet, int Alignment>
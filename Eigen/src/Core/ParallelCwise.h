@@ -0,0 +1,321 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_PARALLEL_CWISE_H
+#define EIGEN_PARALLEL_CWISE_H
+
+namespace Eigen {
+
+namespace internal {
+
+/** \internal \returns the number of threads worth using for a coefficient-wise operation whose estimated
+  * cost is \a cost cycles. As in the TensorCostModel of the Tensor module, each additional thread must be
+  * given at least EIGEN_PARALLEL_CWISE_THREAD_COST cycles of work to amortize its startup.
+  * Nested calls from an OpenMP parallel region run sequentially. */
+inline Index parallel_cwise_threads(double cost)
+{
+  Index threads = nbThreads();
+  if(threads<=1)
+    return 1;
+#ifdef EIGEN_HAS_OPENMP
+  bool nested = omp_get_num_threads()>1;
+#ifdef EIGEN_GEMM_THREADPOOL
+  nested = nested && getGemmThreadPool()==0;
+#endif
+  if(nested)
+    return 1;
+#endif
+  const double maxThreads = cost / double(EIGEN_PARALLEL_CWISE_THREAD_COST);
+  if(maxThreads < double(threads))
+    threads = Index(maxThreads);
+  return (std::max)(threads, Index(1));
+}
+
+/***************************************************************************
+* Part 1 : parallel assignment
+***************************************************************************/
+
+/** \internal Restricts an assignment kernel to the range [start,end) of either the linear indices (if \a Linear
+  * is true) or the outer indices of the destination. The traversal loops are run unchanged on the restricted
+  * kernel, which shifts the indices it is given. */
+template<typename Kernel, bool Linear>
+class sliced_dense_assignment_kernel : public Kernel
+{
+  typedef Kernel Base;
+public:
+  typedef typename Base::Scalar Scalar;
+
+  sliced_dense_assignment_kernel(const Kernel& kernel, Index start, Index end)
+    : Base(kernel), m_start(start), m_end(end)
+  {}
+
+  Index size() const        { return Linear ? m_end-m_start : (m_end-m_start)*Base::innerSize(); }
+  Index outerSize() const   { return m_end-m_start; }
+
+  using Base::assignCoeff;
+  using Base::assignPacket;
+
+  EIGEN_STRONG_INLINE void assignCoeff(Index index)
+  {
+    Base::assignCoeff(m_start+index);
+  }
+
+  EIGEN_STRONG_INLINE void assignCoeffByOuterInner(Index outer, Index inner)
+  {
+    Base::assignCoeffByOuterInner(m_start+outer, inner);
+  }
+
+  template<int StoreMode, int LoadMode, typename PacketType>
+  EIGEN_STRONG_INLINE void assignPacket(Index index)
+  {
+    Base::template assignPacket<StoreMode,LoadMode,PacketType>(m_start+index);
+  }
+
+  template<int StoreMode, int LoadMode, typename PacketType>
+  EIGEN_STRONG_INLINE void assignPacketByOuterInner(Index outer, Index inner)
+  {
+    Base::template assignPacketByOuterInner<StoreMode,LoadMode,PacketType>(m_start+outer, inner);
+  }
+
+  const Scalar* dstDataPtr() const
+  {
+    return Base::dstDataPtr() + (Linear ? m_start : m_start*Base::outerStride());
+  }
+
+protected:
+  Index m_start, m_end;
+};
+
+/** \internal Assigns the \a i-th block of \a blockSize linear or outer indices, see parallel_dense_assignment_loop. */
+template<typename Kernel, bool Linear>
+struct parallel_assignment_task
+{
+  typedef sliced_dense_assignment_kernel<Kernel,Linear> SlicedKernel;
+
+  parallel_assignment_task(const Kernel& kernel, Index size, Index blockSize)
+    : m_kernel(kernel), m_size(size), m_blockSize(blockSize)
+  {}
+
+  void operator()(Index i) const
+  {
+    const Index start = i*m_blockSize;
+    SlicedKernel slice(m_kernel, start, (std::min)(start+m_blockSize, m_size));
+    dense_assignment_loop<SlicedKernel>::run(slice);
+  }
+
+  const Kernel& m_kernel;
+  Index m_size, m_blockSize;
+};
+
+/** \internal
+  * Splits a large coefficient-wise assignment into blocks of consecutive coefficients, or of consecutive
+  * columns (rows if row-major) when the destination cannot be traversed linearly, and assigns them concurrently
+  * with parallel_run_tasks(). The number of threads follows from the estimated cost of the assignment.
+  * Fully unrolled assignments, and expressions which cannot be evaluated concurrently (e.g., random matrices),
+  * are left to the sequential loop.
+  * \returns false if the assignment has not been performed and must be run sequentially.
+  */
+template<typename Kernel>
+struct parallel_dense_assignment_loop
+{
+  typedef typename Kernel::AssignmentTraits Traits;
+  typedef typename Kernel::SrcEvaluatorType SrcEvaluatorType;
+  typedef typename Kernel::Scalar Scalar;
+  enum {
+    Traversal = int(Traits::Traversal),
+    Linear = Traversal==LinearTraversal || Traversal==LinearVectorizedTraversal,
+    Vectorized = Traversal==LinearVectorizedTraversal || Traversal==InnerVectorizedTraversal || Traversal==SliceVectorizedTraversal,
+    PacketSize = unpacket_traits<typename Kernel::PacketType>::size,
+    CoeffCost = int(SrcEvaluatorType::CoeffReadCost) + int(NumTraits<Scalar>::ReadCost),
+    Enabled = int(Traits::Unrolling)!=CompleteUnrolling && Traversal!=AllAtOnceTraversal
+           && !(int(SrcEvaluatorType::Flags)&EvalBeforeNestingBit)
+  };
+
+  static bool run(Kernel& kernel)
+  {
+    return run(kernel, typename conditional<bool(Enabled),true_type,false_type>::type());
+  }
+
+private:
+  static bool run(Kernel&, false_type) { return false; }
+
+  static bool run(Kernel& kernel, true_type)
+  {
+    const Index size = Linear ? kernel.size() : kernel.outerSize();
+    if(size<2)
+      return false;
+    const double cost = double(kernel.size()) * double(CoeffCost) / double(Vectorized ? int(PacketSize) : 1);
+    const Index threads = parallel_cwise_threads(cost);
+    if(threads<=1)
+      return false;
+
+    // A few blocks per thread balance the load. Blocks are made of a multiple of the packet size, so that each one
+    // starts at an offset of the destination which keeps its alignment, as the vectorized loops assume.
+    Index blockSize = (size + 4*threads - 1) / (4*threads);
+    blockSize = ((blockSize + PacketSize - 1) / PacketSize) * PacketSize;
+    parallel_assignment_task<Kernel,Linear> task(kernel, size, blockSize);
+    parallel_run_tasks((size + blockSize - 1) / blockSize, threads, task);
+    return true;
+  }
+};
+
+/***************************************************************************
+* Part 2 : parallel reduction
+***************************************************************************/
+
+/** \internal
+  * Reduces large expressions by blocks of EIGEN_PARALLEL_REDUX_BLOCK_SIZE coefficients (or of whole columns,
+  * or rows if row-major, when the expression cannot be traversed linearly), which are reduced concurrently
+  * with parallel_run_tasks(). The partial results are then combined sequentially, in order.
+  *
+  * Since the blocks only depend on the size of the expression, the result is reproducible: it is the same
+  * whatever the number of threads, including when running sequentially.
+  */
+template<typename Func, typename Evaluator>
+struct parallel_redux_impl
+{
+  typedef redux_traits<Func,Evaluator> Traits;
+  typedef typename Evaluator::Scalar Scalar;
+  typedef typename Traits::PacketType PacketType;
+  enum {
+    Linear = (int(Evaluator::Flags)&LinearAccessBit) != 0,
+    Vectorized = int(Traits::Traversal)!=DefaultTraversal,
+    PacketSize = Vectorized ? int(Traits::PacketSize) : 1,
+    CoeffCost = int(Evaluator::CoeffReadCost) + int(functor_traits<Func>::Cost),
+    Enabled = int(Traits::Unrolling)==NoUnrolling && !(int(Evaluator::Flags)&EvalBeforeNestingBit)
+  };
+
+  template<typename XprType>
+  static bool run(const Evaluator& eval, const Func& func, const XprType& xpr, Scalar& res)
+  {
+    return run(eval, func, xpr, res, typename conditional<bool(Enabled),true_type,false_type>::type());
+  }
+
+private:
+  struct task
+  {
+    task(const Evaluator& eval, const Func& func, Index size, Index innerSize, Index blockSize, Scalar* partials)
+      : m_eval(eval), m_func(func), m_size(size), m_innerSize(innerSize), m_blockSize(blockSize), m_partials(partials)
+    {}
+
+    void operator()(Index i) const
+    {
+      const Index start = i*m_blockSize;
+      m_partials[i] = reduce_block(m_eval, m_func, start, (std::min)(start+m_blockSize, m_size), m_innerSize);
+    }
+
+    const Evaluator& m_eval;
+    const Func& m_func;
+    Index m_size, m_innerSize, m_blockSize;
+    Scalar* m_partials;
+  };
+
+  template<typename XprType>
+  static bool run(const Evaluator&, const Func&, const XprType&, Scalar&, false_type) { return false; }
+
+  template<typename XprType>
+  static bool run(const Evaluator& eval, const Func& func, const XprType& xpr, Scalar& res, true_type)
+  {
+    const Index size = Linear ? xpr.size() : xpr.outerSize();
+    const Index innerSize = Linear ? 1 : xpr.innerSize();
+    const Index blockSize = (std::max)(Index(EIGEN_PARALLEL_REDUX_BLOCK_SIZE)/innerSize, Index(1));
+    const Index numBlocks = (size + blockSize - 1) / blockSize;
+    if(numBlocks<2)
+      return false;
+
+    const double cost = double(xpr.size()) * double(CoeffCost) / double(PacketSize);
+    const Index threads = parallel_cwise_threads(cost);
+    if(threads<=1)
+    {
+      res = reduce_block(eval, func, 0, blockSize, innerSize);
+      for(Index start=blockSize; start<size; start+=blockSize)
+        res = func(res, reduce_block(eval, func, start, (std::min)(start+blockSize, size), innerSize));
+      return true;
+    }
+
+    ei_declare_aligned_stack_constructed_variable(Scalar, partials, numBlocks, 0);
+    parallel_run_tasks(numBlocks, threads, task(eval, func, size, innerSize, blockSize, partials));
+    res = partials[0];
+    for(Index i=1; i<numBlocks; ++i)
+      res = func(res, partials[i]);
+    return true;
+  }
+
+  // Reduces the linear or outer indices [start,end)
+  static Scalar reduce_block(const Evaluator& eval, const Func& func, Index start, Index end, Index innerSize)
+  {
+    return reduce_block(eval, func, start, end, innerSize, typename conditional<bool(Vectorized),true_type,false_type>::type());
+  }
+
+  static Scalar reduce_block(const Evaluator& eval, const Func& func, Index start, Index end, Index innerSize, false_type)
+  {
+    Scalar res;
+    if(Linear)
+    {
+      res = eval.coeff(start);
+      for(Index i=start+1; i<end; ++i)
+        res = func(res, eval.coeff(i));
+    }
+    else
+    {
+      res = eval.coeffByOuterInner(start, 0);
+      for(Index j=start; j<end; ++j)
+        for(Index i=(j==start?1:0); i<innerSize; ++i)
+          res = func(res, eval.coeffByOuterInner(j, i));
+    }
+    return res;
+  }
+
+  static Scalar reduce_block(const Evaluator& eval, const Func& func, Index start, Index end, Index innerSize, true_type)
+  {
+    Scalar res;
+    if(Linear)
+    {
+      const Index packetEnd = start + ((end-start)/PacketSize)*PacketSize;
+      if(packetEnd==start)
+        return reduce_block(eval, func, start, end, innerSize, false_type());
+      PacketType packet_res0 = eval.template packet<Unaligned,PacketType>(start);
+      if(packetEnd-start >= 2*PacketSize)
+      {
+        PacketType packet_res1 = eval.template packet<Unaligned,PacketType>(start+PacketSize);
+        const Index packetEnd2 = start + ((end-start)/(2*PacketSize))*(2*PacketSize);
+        for(Index i=start+2*PacketSize; i<packetEnd2; i+=2*PacketSize)
+        {
+          packet_res0 = func.packetOp(packet_res0, eval.template packet<Unaligned,PacketType>(i));
+          packet_res1 = func.packetOp(packet_res1, eval.template packet<Unaligned,PacketType>(i+PacketSize));
+        }
+        packet_res0 = func.packetOp(packet_res0, packet_res1);
+        if(packetEnd>packetEnd2)
+          packet_res0 = func.packetOp(packet_res0, eval.template packet<Unaligned,PacketType>(packetEnd2));
+      }
+      res = func.predux(packet_res0);
+      for(Index i=packetEnd; i<end; ++i)
+        res = func(res, eval.coeff(i));
+    }
+    else
+    {
+      const Index packetInnerSize = (innerSize/PacketSize)*PacketSize;
+      if(packetInnerSize==0)
+        return reduce_block(eval, func, start, end, innerSize, false_type());
+      PacketType packet_res = eval.template packetByOuterInner<Unaligned,PacketType>(start, 0);
+      for(Index j=start; j<end; ++j)
+        for(Index i=(j==start?PacketSize:0); i<packetInnerSize; i+=PacketSize)
+          packet_res = func.packetOp(packet_res, eval.template packetByOuterInner<Unaligned,PacketType>(j, i));
+      res = func.predux(packet_res);
+      for(Index j=start; j<end; ++j)
+        for(Index i=packetInnerSize; i<innerSize; ++i)
+          res = func(res, eval.coeffByOuterInner(j, i));
+    }
+    return res;
+  }
+};
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+#endif // EIGEN_PARALLEL_CWISE_H
@@ -240,6 +240,342 @@ EIGEN_CATCH_ASSIGN_XPR_OP_PRODUCT(assign_op,    scalar_difference_op,sub_assign_
 EIGEN_CATCH_ASSIGN_XPR_OP_PRODUCT(add_assign_op,scalar_difference_op,sub_assign_op);
 EIGEN_CATCH_ASSIGN_XPR_OP_PRODUCT(sub_assign_op,scalar_difference_op,add_assign_op);
 
+//----------------------------------------
+// Catch "Dense = f(Product<>)" where f is a chain of coefficient-wise operations, such as "(A*B).rowwise() + bias"
+// or "((A*B).rowwise() + bias).cwiseMax(0)", and apply f to each block of the destination as soon as the
+// matrix-matrix product completes it, while it is still in cache (a GEMM epilogue), instead of evaluating the
+// product into a temporary. The other operands of f must be cheap to evaluate by blocks.
+
+// Operands of an epilogue: objects with direct access, nullary expressions, and broadcasts or wrappers of them.
+template<typename T> struct gemm_epilogue_operand
+{
+  enum { value = has_direct_access<T>::ret };
+  // Returns true if x reads some memory in [begin,end)
+  static bool overlaps(const T& x, const char* begin, const char* end)
+  {
+    if(x.size()==0)
+      return false;
+    const char* first = reinterpret_cast<const char*>(x.data());
+    const char* last = reinterpret_cast<const char*>(x.data() + (x.outerSize()-1)*x.outerStride() + (x.innerSize()-1)*x.innerStride());
+    return first<end && begin<=last;
+  }
+};
+
+template<typename NullaryOp, typename PlainObjectType>
+struct gemm_epilogue_operand<CwiseNullaryOp<NullaryOp,PlainObjectType> >
+{
+  enum { value = true };
+  static bool overlaps(const CwiseNullaryOp<NullaryOp,PlainObjectType>&, const char*, const char*) { return false; }
+};
+
+template<typename XprType, typename NestedXpr>
+struct gemm_epilogue_nested_operand
+{
+  typedef typename remove_all<NestedXpr>::type Nested;
+  enum { value = gemm_epilogue_operand<Nested>::value };
+  static bool overlaps(const XprType& x, const char* begin, const char* end)
+  { return gemm_epilogue_operand<Nested>::overlaps(x.nestedExpression(), begin, end); }
+};
+
+template<typename MatrixType, int RowFactor, int ColFactor>
+struct gemm_epilogue_operand<Replicate<MatrixType,RowFactor,ColFactor> >
+  : gemm_epilogue_nested_operand<Replicate<MatrixType,RowFactor,ColFactor>, MatrixType> {};
+template<typename MatrixType>
+struct gemm_epilogue_operand<Transpose<MatrixType> >
+  : gemm_epilogue_nested_operand<Transpose<MatrixType>, MatrixType> {};
+template<typename ExpressionType>
+struct gemm_epilogue_operand<ArrayWrapper<ExpressionType> >
+  : gemm_epilogue_nested_operand<ArrayWrapper<ExpressionType>, ExpressionType> {};
+template<typename ExpressionType>
+struct gemm_epilogue_operand<MatrixWrapper<ExpressionType> >
+  : gemm_epilogue_nested_operand<MatrixWrapper<ExpressionType>, ExpressionType> {};
+
+// gemm_epilogue_traits<Xpr>::value is true if Xpr is a valid epilogue applied to a matrix-matrix product
+template<typename Xpr> struct gemm_epilogue_traits
+{
+  enum { value = false };
+  typedef void ProductType;
+};
+
+template<typename Lhs, typename Rhs>
+struct gemm_epilogue_traits<Product<Lhs,Rhs,DefaultProduct> >
+{
+  enum { value = int(product_type<Lhs,Rhs>::value)==int(GemmProduct)
+              && is_same<typename evaluator_traits<Lhs>::Shape,DenseShape>::value
+              && is_same<typename evaluator_traits<Rhs>::Shape,DenseShape>::value };
+  typedef Product<Lhs,Rhs,DefaultProduct> ProductType;
+};
+
+template<typename UnaryOp, typename ArgType>
+struct gemm_epilogue_traits<CwiseUnaryOp<UnaryOp,ArgType> >
+  : gemm_epilogue_traits<typename remove_all<ArgType>::type> {};
+template<typename ExpressionType>
+struct gemm_epilogue_traits<ArrayWrapper<ExpressionType> >
+  : gemm_epilogue_traits<typename remove_all<ExpressionType>::type> {};
+template<typename ExpressionType>
+struct gemm_epilogue_traits<MatrixWrapper<ExpressionType> >
+  : gemm_epilogue_traits<typename remove_all<ExpressionType>::type> {};
+
+template<typename BinaryOp, typename LhsType, typename RhsType>
+struct gemm_epilogue_traits<CwiseBinaryOp<BinaryOp,LhsType,RhsType> >
+{
+  typedef gemm_epilogue_traits<typename remove_all<LhsType>::type> LhsTraits;
+  typedef gemm_epilogue_traits<typename remove_all<RhsType>::type> RhsTraits;
+  enum { value = (LhsTraits::value && gemm_epilogue_operand<typename remove_all<RhsType>::type>::value)
+              || (RhsTraits::value && gemm_epilogue_operand<typename remove_all<LhsType>::type>::value) };
+  typedef typename conditional<bool(LhsTraits::value), typename LhsTraits::ProductType, typename RhsTraits::ProductType>::type ProductType;
+};
+
+// "Dense ?= xpr op Product<>" is already caught above
+template<typename Xpr> struct gemm_epilogue_rhs_is_product { enum { value = false }; };
+template<typename BinaryOp, typename LhsType, typename Lhs, typename Rhs, int Options>
+struct gemm_epilogue_rhs_is_product<CwiseBinaryOp<BinaryOp,LhsType,const Product<Lhs,Rhs,Options> > > { enum { value = true }; };
+
+// A wrapped product has no epilogue to apply
+template<typename Xpr> struct gemm_epilogue_is_product { enum { value = false }; };
+template<typename Lhs, typename Rhs, int Options>
+struct gemm_epilogue_is_product<Product<Lhs,Rhs,Options> > { enum { value = true }; };
+template<typename ExpressionType>
+struct gemm_epilogue_is_product<ArrayWrapper<ExpressionType> > : gemm_epilogue_is_product<typename remove_all<ExpressionType>::type> {};
+template<typename ExpressionType>
+struct gemm_epilogue_is_product<MatrixWrapper<ExpressionType> > : gemm_epilogue_is_product<typename remove_all<ExpressionType>::type> {};
+
+template<typename Xpr, bool IsEpilogue = gemm_epilogue_traits<Xpr>::value>
+struct gemm_epilogue_enabled { enum { value = false }; };
+
+template<typename Xpr>
+struct gemm_epilogue_enabled<Xpr,true>
+{
+  enum { value = is_same<typename Xpr::Scalar, typename gemm_epilogue_traits<Xpr>::ProductType::Scalar>::value
+              && !gemm_epilogue_rhs_is_product<Xpr>::value && !gemm_epilogue_is_product<Xpr>::value };
+};
+
+// gemm_epilogue<Xpr> extracts the product of an epilogue, and rebuilds the epilogue on a block of the evaluated product
+template<typename Xpr> struct gemm_epilogue;
+
+template<typename Lhs, typename Rhs>
+struct gemm_epilogue<Product<Lhs,Rhs,DefaultProduct> >
+{
+  typedef Product<Lhs,Rhs,DefaultProduct> XprType;
+  typedef XprType ProductType;
+  template<typename ProductBlock> struct rebuild { typedef ProductBlock type; };
+
+  static const ProductType& product(const XprType& xpr) { return xpr; }
+  static bool overlaps(const XprType&, const char*, const char*) { return false; }
+  template<typename ProductBlock>
+  static ProductBlock build(const XprType&, const ProductBlock& block, Index, Index, Index, Index) { return block; }
+};
+
+template<typename UnaryOp, typename ArgType>
+struct gemm_epilogue<CwiseUnaryOp<UnaryOp,ArgType> >
+{
+  typedef CwiseUnaryOp<UnaryOp,ArgType> XprType;
+  typedef gemm_epilogue<typename remove_all<ArgType>::type> Nested;
+  typedef typename Nested::ProductType ProductType;
+  template<typename ProductBlock> struct rebuild
+  { typedef CwiseUnaryOp<UnaryOp, const typename Nested::template rebuild<ProductBlock>::type> type; };
+
+  static const ProductType& product(const XprType& xpr) { return Nested::product(xpr.nestedExpression()); }
+  static bool overlaps(const XprType& xpr, const char* begin, const char* end) { return Nested::overlaps(xpr.nestedExpression(), begin, end); }
+  template<typename ProductBlock>
+  static typename rebuild<ProductBlock>::type build(const XprType& xpr, const ProductBlock& block, Index i, Index j, Index rows, Index cols)
+  {
+    return typename rebuild<ProductBlock>::type(Nested::build(xpr.nestedExpression(), block, i, j, rows, cols), xpr.functor());
+  }
+};
+
+template<template<typename> class Wrapper, typename ExpressionType>
+struct gemm_epilogue_wrapper
+{
+  typedef Wrapper<ExpressionType> XprType;
+  typedef gemm_epilogue<typename remove_all<ExpressionType>::type> Nested;
+  typedef typename Nested::ProductType ProductType;
+  template<typename ProductBlock> struct rebuild
+  { typedef Wrapper<const typename Nested::template rebuild<ProductBlock>::type> type; };
+
+  static const ProductType& product(const XprType& xpr) { return Nested::product(xpr.nestedExpression()); }
+  static bool overlaps(const XprType& xpr, const char* begin, const char* end) { return Nested::overlaps(xpr.nestedExpression(), begin, end); }
+  template<typename ProductBlock>
+  static typename rebuild<ProductBlock>::type build(const XprType& xpr, const ProductBlock& block, Index i, Index j, Index rows, Index cols)
+  {
+    return typename rebuild<ProductBlock>::type(Nested::build(xpr.nestedExpression(), block, i, j, rows, cols));
+  }
+};
+
+template<typename ExpressionType>
+struct gemm_epilogue<ArrayWrapper<ExpressionType> > : gemm_epilogue_wrapper<ArrayWrapper,ExpressionType> {};
+template<typename ExpressionType>
+struct gemm_epilogue<MatrixWrapper<ExpressionType> > : gemm_epilogue_wrapper<MatrixWrapper,ExpressionType> {};
+
+template<typename XprType, bool ProductOnLhs> struct gemm_epilogue_binary;
+
+template<typename BinaryOp, typename LhsType, typename RhsType>
+struct gemm_epilogue_binary<CwiseBinaryOp<BinaryOp,LhsType,RhsType>, true>
+{
+  typedef CwiseBinaryOp<BinaryOp,LhsType,RhsType> XprType;
+  typedef gemm_epilogue<typename remove_all<LhsType>::type> Nested;
+  typedef typename remove_all<RhsType>::type Operand;
+  typedef typename Nested::ProductType ProductType;
+  template<typename ProductBlock> struct rebuild
+  { typedef CwiseBinaryOp<BinaryOp, const typename Nested::template rebuild<ProductBlock>::type, const Block<const Operand> > type; };
+
+  static const ProductType& product(const XprType& xpr) { return Nested::product(xpr.lhs()); }
+  static bool overlaps(const XprType& xpr, const char* begin, const char* end)
+  {
+    return Nested::overlaps(xpr.lhs(), begin, end) || gemm_epilogue_operand<Operand>::overlaps(xpr.rhs(), begin, end);
+  }
+  template<typename ProductBlock>
+  static typename rebuild<ProductBlock>::type build(const XprType& xpr, const ProductBlock& block, Index i, Index j, Index rows, Index cols)
+  {
+    return typename rebuild<ProductBlock>::type(Nested::build(xpr.lhs(), block, i, j, rows, cols),
+                                                Block<const Operand>(xpr.rhs(), i, j, rows, cols), xpr.functor());
+  }
+};
+
+template<typename BinaryOp, typename LhsType, typename RhsType>
+struct gemm_epilogue_binary<CwiseBinaryOp<BinaryOp,LhsType,RhsType>, false>
+{
+  typedef CwiseBinaryOp<BinaryOp,LhsType,RhsType> XprType;
+  typedef gemm_epilogue<typename remove_all<RhsType>::type> Nested;
+  typedef typename remove_all<LhsType>::type Operand;
+  typedef typename Nested::ProductType ProductType;
+  template<typename ProductBlock> struct rebuild
+  { typedef CwiseBinaryOp<BinaryOp, const Block<const Operand>, const typename Nested::template rebuild<ProductBlock>::type> type; };
+
+  static const ProductType& product(const XprType& xpr) { return Nested::product(xpr.rhs()); }
+  static bool overlaps(const XprType& xpr, const char* begin, const char* end)
+  {
+    return Nested::overlaps(xpr.rhs(), begin, end) || gemm_epilogue_operand<Operand>::overlaps(xpr.lhs(), begin, end);
+  }
+  template<typename ProductBlock>
+  static typename rebuild<ProductBlock>::type build(const XprType& xpr, const ProductBlock& block, Index i, Index j, Index rows, Index cols)
+  {
+    return typename rebuild<ProductBlock>::type(Block<const Operand>(xpr.lhs(), i, j, rows, cols),
+                                                Nested::build(xpr.rhs(), block, i, j, rows, cols), xpr.functor());
+  }
+};
+
+template<typename BinaryOp, typename LhsType, typename RhsType>
+struct gemm_epilogue<CwiseBinaryOp<BinaryOp,LhsType,RhsType> >
+  : gemm_epilogue_binary<CwiseBinaryOp<BinaryOp,LhsType,RhsType>, gemm_epilogue_traits<typename remove_all<LhsType>::type>::value> {};
+
+// The product is evaluated into a matrix view of the destination
+template<typename DstXprType, typename XprKind = typename traits<DstXprType>::XprKind>
+struct gemm_epilogue_product_dst
+{
+  typedef DstXprType& type;
+  static type get(DstXprType& dst) { return dst; }
+};
+
+template<typename DstXprType>
+struct gemm_epilogue_product_dst<DstXprType,ArrayXpr>
+{
+  typedef MatrixWrapper<DstXprType> type;
+  static type get(DstXprType& dst) { return type(dst); }
+};
+
+// Output kernel of the matrix-matrix product applying the epilogue SrcXprType to each completed block of the destination
+template<typename DstXprType, typename ProductDstType, typename SrcXprType>
+struct gemm_epilogue_kernel
+{
+  gemm_epilogue_kernel(DstXprType& dst, ProductDstType& productDst, const SrcXprType& src)
+    : m_dst(dst), m_productDst(productDst), m_src(src)
+  {}
+
+  void operator()(Index i, Index j, Index rows, Index cols) const
+  {
+    Block<DstXprType> dstBlock(m_dst, i, j, rows, cols);
+    Block<ProductDstType> productBlock(m_productDst, i, j, rows, cols);
+    call_assignment_no_alias(dstBlock, gemm_epilogue<SrcXprType>::build(m_src, productBlock, i, j, rows, cols),
+                             assign_op<typename DstXprType::Scalar,typename SrcXprType::Scalar>());
+  }
+
+  DstXprType& m_dst;
+  ProductDstType& m_productDst;
+  const SrcXprType& m_src;
+};
+
+template<typename DstXprType, typename SrcXprType>
+struct gemm_epilogue_assignment
+{
+  typedef typename SrcXprType::Scalar Scalar;
+  static void run(DstXprType &dst, const SrcXprType &src, const internal::assign_op<Scalar,Scalar> &func)
+  {
+    typedef gemm_epilogue<SrcXprType> Epilogue;
+    typedef typename Epilogue::ProductType ProductType;
+
+    Index dstRows = src.rows();
+    Index dstCols = src.cols();
+    if((dst.rows()!=dstRows) || (dst.cols()!=dstCols))
+      dst.resize(dstRows, dstCols);
+
+    if(dst.size()==0)
+      return;
+
+    // The product overwrites the destination before the epilogue reads its other operands,
+    // so fall back to the evaluation through a temporary if some of them are stored in dst
+    const char* dstBegin = reinterpret_cast<const char*>(dst.data());
+    const char* dstEnd = reinterpret_cast<const char*>(dst.data() + (dst.outerSize()-1)*dst.outerStride() + (dst.innerSize()-1)*dst.innerStride() + 1);
+    if(Epilogue::overlaps(src, dstBegin, dstEnd))
+    {
+      call_dense_assignment_loop(dst, src, func);
+      return;
+    }
+
+    typedef gemm_epilogue_product_dst<DstXprType> ProductDst;
+    typename ProductDst::type productDst(ProductDst::get(dst));
+    typedef typename remove_reference<typename ProductDst::type>::type ProductDstType;
+    const ProductType& prod = Epilogue::product(src);
+    generic_product_impl<typename ProductType::Lhs, typename ProductType::Rhs>::evalTo(productDst, prod.lhs(), prod.rhs(),
+      gemm_epilogue_kernel<DstXprType,ProductDstType,SrcXprType>(dst, productDst, src));
+  }
+};
+
+template< typename DstXprType, typename UnaryOp, typename ArgType, typename Scalar>
+struct Assignment<DstXprType, CwiseUnaryOp<UnaryOp,ArgType>, internal::assign_op<Scalar,Scalar>, Dense2Dense,
+  typename enable_if<gemm_epilogue_enabled<CwiseUnaryOp<UnaryOp,ArgType> >::value && bool(has_direct_access<DstXprType>::ret)>::type>
+  : gemm_epilogue_assignment<DstXprType, CwiseUnaryOp<UnaryOp,ArgType> >
+{};
+
+template< typename DstXprType, typename BinaryOp, typename LhsType, typename RhsType, typename Scalar>
+struct Assignment<DstXprType, CwiseBinaryOp<BinaryOp,LhsType,RhsType>, internal::assign_op<Scalar,Scalar>, Dense2Dense,
+  typename enable_if<gemm_epilogue_enabled<CwiseBinaryOp<BinaryOp,LhsType,RhsType> >::value && bool(has_direct_access<DstXprType>::ret)>::type>
+  : gemm_epilogue_assignment<DstXprType, CwiseBinaryOp<BinaryOp,LhsType,RhsType> >
+{};
+
+template< typename DstXprType, typename ExpressionType, typename Scalar>
+struct Assignment<DstXprType, ArrayWrapper<ExpressionType>, internal::assign_op<Scalar,Scalar>, Dense2Dense,
+  typename enable_if<gemm_epilogue_enabled<ArrayWrapper<ExpressionType> >::value && bool(has_direct_access<DstXprType>::ret)>::type>
+  : gemm_epilogue_assignment<DstXprType, ArrayWrapper<ExpressionType> >
+{};
+
+template< typename DstXprType, typename ExpressionType, typename Scalar>
+struct Assignment<DstXprType, MatrixWrapper<ExpressionType>, internal::assign_op<Scalar,Scalar>, Dense2Dense,
+  typename enable_if<gemm_epilogue_enabled<MatrixWrapper<ExpressionType> >::value && bool(has_direct_access<DstXprType>::ret)>::type>
+  : gemm_epilogue_assignment<DstXprType, MatrixWrapper<ExpressionType> >
+{};
+
+// Without noalias(), the epilogue is fused into the evaluation of a temporary
+template<typename UnaryOp, typename ArgType, typename Shape>
+struct evaluator_assume_aliasing<CwiseUnaryOp<UnaryOp,ArgType>, Shape> {
+  static const bool value = is_same<Shape,DenseShape>::value && gemm_epilogue_enabled<CwiseUnaryOp<UnaryOp,ArgType> >::value;
+};
+
+template<typename BinaryOp, typename LhsType, typename RhsType, typename Shape>
+struct evaluator_assume_aliasing<CwiseBinaryOp<BinaryOp,LhsType,RhsType>, Shape> {
+  static const bool value = is_same<Shape,DenseShape>::value && gemm_epilogue_enabled<CwiseBinaryOp<BinaryOp,LhsType,RhsType> >::value;
+};
+
+template<typename ExpressionType, typename Shape>
+struct evaluator_assume_aliasing<ArrayWrapper<ExpressionType>, Shape> {
+  static const bool value = is_same<Shape,DenseShape>::value && gemm_epilogue_enabled<ArrayWrapper<ExpressionType> >::value;
+};
+
+template<typename ExpressionType, typename Shape>
+struct evaluator_assume_aliasing<MatrixWrapper<ExpressionType>, Shape> {
+  static const bool value = is_same<Shape,DenseShape>::value && gemm_epilogue_enabled<MatrixWrapper<ExpressionType> >::value;
+};
+
 //----------------------------------------
 
 template<typename Lhs, typename Rhs>
@@ -188,6 +188,9 @@ template<typename Func, typename Evaluator,
 >
 struct redux_impl;
 
+// defined in ParallelCwise.h
+template<typename Func, typename Evaluator> struct parallel_redux_impl;
+
 template<typename Func, typename Evaluator>
 struct redux_impl<Func, Evaluator, DefaultTraversal, NoUnrolling>
 {
@@ -413,6 +416,12 @@ DenseBase<Derived>::redux(const Func& func) const
   typedef typename internal::redux_evaluator<Derived> ThisEvaluator;
   ThisEvaluator thisEval(derived());
 
+#if defined(EIGEN_PARALLELIZE_CWISE) && !defined(EIGEN_GPU_COMPILE_PHASE)
+  Scalar res;
+  if(internal::parallel_redux_impl<Func, ThisEvaluator>::run(thisEval, func, derived(), res))
+    return res;
+#endif
+
   // The initial expression is passed to the reducer as an additional argument instead of
   // passing it as a member of redux_evaluator to help  
   return internal::redux_impl<Func, ThisEvaluator>::run(thisEval, func, derived());
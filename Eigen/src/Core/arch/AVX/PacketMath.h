@@ -34,11 +34,15 @@ typedef __m256d Packet4d;
 typedef struct {
   __m128i x;
 } Packet8h;
+typedef struct {
+  __m128i x;
+} Packet8bf;
 
 template<> struct is_arithmetic<__m256>  { enum { value = true }; };
 template<> struct is_arithmetic<__m256i> { enum { value = true }; };
 template<> struct is_arithmetic<__m256d> { enum { value = true }; };
 template<> struct is_arithmetic<Packet8h> { enum { value = true }; };
+template<> struct is_arithmetic<Packet8bf> { enum { value = true }; };
 
 #define _EIGEN_DECLARE_CONST_Packet8f(NAME,X) \
   const Packet8f p8f_##NAME = pset1<Packet8f>(X)
@@ -133,6 +137,35 @@ struct packet_traits<Eigen::half> : default_packet_traits {
     HasBlend = 0
   };
 };
+
+template <>
+struct packet_traits<Eigen::bfloat16> : default_packet_traits {
+  typedef Packet8bf type;
+  // There is no half-size packet for Packet8bf.
+  typedef Packet8bf half;
+  enum {
+    Vectorizable = 1,
+    AlignedOnScalar = 1,
+    size = 8,
+    HasHalfPacket = 0,
+    HasAdd    = 1,
+    HasSub    = 1,
+    HasMul    = 1,
+    HasDiv    = 1,
+    HasNegate = 1,
+    HasAbs    = 1,
+    HasAbs2   = 1,
+    HasMin    = 1,
+    HasMax    = 1,
+    HasConj   = 1,
+    HasSetLinear = 0,
+    HasSqrt = 0,
+    HasRsqrt = 0,
+    HasExp = 0,
+    HasLog = 0,
+    HasBlend = 0
+  };
+};
 #endif
 
 template<> struct scalar_div_cost<float,true> { enum { value = 14 }; };
@@ -193,6 +226,16 @@ template<> EIGEN_STRONG_INLINE Packet8i padd<Packet8i>(const Packet8i& a, const
 #endif
 }
 
+template<> EIGEN_STRONG_INLINE Packet8i pmadd_pairs(const Packet8i& a, const Packet8i& b, const Packet8i& c) {
+#ifdef EIGEN_VECTORIZE_AVX2
+  return _mm256_add_epi32(c, _mm256_madd_epi16(a,b));
+#else
+  __m128i lo = _mm_add_epi32(_mm256_extractf128_si256(c, 0), _mm_madd_epi16(_mm256_extractf128_si256(a, 0), _mm256_extractf128_si256(b, 0)));
+  __m128i hi = _mm_add_epi32(_mm256_extractf128_si256(c, 1), _mm_madd_epi16(_mm256_extractf128_si256(a, 1), _mm256_extractf128_si256(b, 1)));
+  return _mm256_insertf128_si256(_mm256_castsi128_si256(lo), (hi), 1);
+#endif
+}
+
 template<> EIGEN_STRONG_INLINE Packet8f psub<Packet8f>(const Packet8f& a, const Packet8f& b) { return _mm256_sub_ps(a,b); }
 template<> EIGEN_STRONG_INLINE Packet4d psub<Packet4d>(const Packet4d& a, const Packet4d& b) { return _mm256_sub_pd(a,b); }
 
@@ -1212,6 +1255,257 @@ ptranspose(PacketBlock<Packet8h,4>& kernel) {
   kernel.packet[3] = pload<Packet8h>(out[3]);
 }
 
+// Packet math for Eigen::bfloat16
+// The arithmetic is carried out in fp32, a bfloat16 being the upper half of a float.
+template<> struct unpacket_traits<Packet8bf> { typedef Eigen::bfloat16 type; enum {size=8, alignment=Aligned16, vectorizable=true, masked_load_available=false, masked_store_available=false}; typedef Packet8bf half; };
+
+EIGEN_STRONG_INLINE Packet8f Bf16ToF32(const Packet8bf& a) {
+#ifdef EIGEN_VECTORIZE_AVX2
+  return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(a.x), 16));
+#else
+  // interleaving with zeros shifts each bfloat16 to the upper half of a 32-bit lane
+  __m128 lo = _mm_castsi128_ps(_mm_unpacklo_epi16(_mm_setzero_si128(), a.x));
+  __m128 hi = _mm_castsi128_ps(_mm_unpackhi_epi16(_mm_setzero_si128(), a.x));
+  return _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1);
+#endif
+}
+
+EIGEN_STRONG_INLINE Packet8bf F32ToBf16(const Packet8f& a) {
+  Packet8bf result;
+#ifdef EIGEN_VECTORIZE_AVX2
+  // Same rounding as F32ToBf16Bits in SSE/PacketMath.h, on 8 floats at once.
+  __m256i input = _mm256_castps_si256(a);
+  __m256i lsb = _mm256_and_si256(_mm256_srli_epi32(input, 16), _mm256_set1_epi32(1));
+  __m256i rounded = _mm256_add_epi32(input, _mm256_add_epi32(lsb, _mm256_set1_epi32(0x7fff)));
+  __m256i nan = _mm256_castps_si256(_mm256_cmp_ps(a, a, _CMP_UNORD_Q));
+  __m256i quiet = _mm256_or_si256(input, _mm256_set1_epi32(0x00400000));
+  rounded = _mm256_srai_epi32(_mm256_blendv_epi8(rounded, quiet, nan), 16);
+  result.x = _mm_packs_epi32(_mm256_castsi256_si128(rounded), _mm256_extractf128_si256(rounded, 1));
+#else
+  result.x = _mm_packs_epi32(F32ToBf16Bits(_mm256_castps256_ps128(a)), F32ToBf16Bits(_mm256_extractf128_ps(a, 1)));
+#endif
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf pset1<Packet8bf>(const Eigen::bfloat16& from) {
+  Packet8bf result;
+  result.x = _mm_set1_epi16(static_cast<short>(from.x));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Eigen::bfloat16 pfirst<Packet8bf>(const Packet8bf& from) {
+  return bfloat16_impl::raw_uint16_to_bfloat16(static_cast<unsigned short>(_mm_extract_epi16(from.x, 0)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf pload<Packet8bf>(const Eigen::bfloat16* from) {
+  Packet8bf result;
+  result.x = _mm_load_si128(reinterpret_cast<const __m128i*>(from));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf ploadu<Packet8bf>(const Eigen::bfloat16* from) {
+  Packet8bf result;
+  result.x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(from));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE void pstore<Eigen::bfloat16>(Eigen::bfloat16* to, const Packet8bf& from) {
+  _mm_store_si128(reinterpret_cast<__m128i*>(to), from.x);
+}
+
+template<> EIGEN_STRONG_INLINE void pstoreu<Eigen::bfloat16>(Eigen::bfloat16* to, const Packet8bf& from) {
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(to), from.x);
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf
+ploaddup<Packet8bf>(const Eigen::bfloat16* from) {
+  Packet8bf result;
+  short a = static_cast<short>(from[0].x);
+  short b = static_cast<short>(from[1].x);
+  short c = static_cast<short>(from[2].x);
+  short d = static_cast<short>(from[3].x);
+  result.x = _mm_set_epi16(d, d, c, c, b, b, a, a);
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf
+ploadquad<Packet8bf>(const Eigen::bfloat16* from) {
+  Packet8bf result;
+  short a = static_cast<short>(from[0].x);
+  short b = static_cast<short>(from[1].x);
+  result.x = _mm_set_epi16(b, b, b, b, a, a, a, a);
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf ptrue(const Packet8bf& a) {
+  Packet8bf r; r.x = _mm_cmpeq_epi32(a.x, a.x); return r;
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf por(const Packet8bf& a,const Packet8bf& b) {
+  Packet8bf r; r.x = _mm_or_si128(a.x,b.x); return r;
+}
+template<> EIGEN_STRONG_INLINE Packet8bf pxor(const Packet8bf& a,const Packet8bf& b) {
+  Packet8bf r; r.x = _mm_xor_si128(a.x,b.x); return r;
+}
+template<> EIGEN_STRONG_INLINE Packet8bf pand(const Packet8bf& a,const Packet8bf& b) {
+  Packet8bf r; r.x = _mm_and_si128(a.x,b.x); return r;
+}
+template<> EIGEN_STRONG_INLINE Packet8bf pandnot(const Packet8bf& a,const Packet8bf& b) {
+  Packet8bf r; r.x = _mm_andnot_si128(b.x,a.x); return r;
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf pselect(const Packet8bf& mask, const Packet8bf& a, const Packet8bf& b) {
+  Packet8bf r; r.x = _mm_blendv_epi8(b.x, a.x, mask.x); return r;
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf pcmp_eq(const Packet8bf& a,const Packet8bf& b) {
+  Packet8f rf = pcmp_eq(Bf16ToF32(a), Bf16ToF32(b));
+  // Pack the 32-bit flags into 16-bits flags.
+  Packet8bf result; result.x = _mm_packs_epi32(_mm256_extractf128_si256(_mm256_castps_si256(rf), 0),
+                                               _mm256_extractf128_si256(_mm256_castps_si256(rf), 1));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf pconj(const Packet8bf& a) { return a; }
+
+template<> EIGEN_STRONG_INLINE Packet8bf pnegate(const Packet8bf& a) {
+  Packet8bf result; result.x = _mm_xor_si128(a.x, _mm_set1_epi16(static_cast<short>(0x8000)));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf pabs(const Packet8bf& a) {
+  Packet8bf result; result.x = _mm_and_si128(a.x, _mm_set1_epi16(0x7fff));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf padd<Packet8bf>(const Packet8bf& a, const Packet8bf& b) {
+  return F32ToBf16(padd(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf psub<Packet8bf>(const Packet8bf& a, const Packet8bf& b) {
+  return F32ToBf16(psub(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf pmul<Packet8bf>(const Packet8bf& a, const Packet8bf& b) {
+  return F32ToBf16(pmul(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf pmadd<Packet8bf>(const Packet8bf& a, const Packet8bf& b, const Packet8bf& c) {
+  // rounded once
+  return F32ToBf16(pmadd(Bf16ToF32(a), Bf16ToF32(b), Bf16ToF32(c)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf pdiv<Packet8bf>(const Packet8bf& a, const Packet8bf& b) {
+  return F32ToBf16(pdiv(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf pmin<Packet8bf>(const Packet8bf& a, const Packet8bf& b) {
+  return F32ToBf16(pmin(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf pmax<Packet8bf>(const Packet8bf& a, const Packet8bf& b) {
+  return F32ToBf16(pmax(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf pgather<Eigen::bfloat16, Packet8bf>(const Eigen::bfloat16* from, Index stride)
+{
+  Packet8bf result;
+  result.x = _mm_set_epi16(static_cast<short>(from[7*stride].x), static_cast<short>(from[6*stride].x),
+                           static_cast<short>(from[5*stride].x), static_cast<short>(from[4*stride].x),
+                           static_cast<short>(from[3*stride].x), static_cast<short>(from[2*stride].x),
+                           static_cast<short>(from[1*stride].x), static_cast<short>(from[0*stride].x));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE void pscatter<Eigen::bfloat16, Packet8bf>(Eigen::bfloat16* to, const Packet8bf& from, Index stride)
+{
+  EIGEN_ALIGN32 Eigen::bfloat16 aux[8];
+  pstore(aux, from);
+  to[stride*0].x = aux[0].x;
+  to[stride*1].x = aux[1].x;
+  to[stride*2].x = aux[2].x;
+  to[stride*3].x = aux[3].x;
+  to[stride*4].x = aux[4].x;
+  to[stride*5].x = aux[5].x;
+  to[stride*6].x = aux[6].x;
+  to[stride*7].x = aux[7].x;
+}
+
+template<> EIGEN_STRONG_INLINE Eigen::bfloat16 predux<Packet8bf>(const Packet8bf& a) {
+  return Eigen::bfloat16(predux<Packet8f>(Bf16ToF32(a)));
+}
+
+template<> EIGEN_STRONG_INLINE Eigen::bfloat16 predux_max<Packet8bf>(const Packet8bf& a) {
+  return Eigen::bfloat16(predux_max<Packet8f>(Bf16ToF32(a)));
+}
+
+template<> EIGEN_STRONG_INLINE Eigen::bfloat16 predux_min<Packet8bf>(const Packet8bf& a) {
+  return Eigen::bfloat16(predux_min<Packet8f>(Bf16ToF32(a)));
+}
+
+template<> EIGEN_STRONG_INLINE Eigen::bfloat16 predux_mul<Packet8bf>(const Packet8bf& a) {
+  return Eigen::bfloat16(predux_mul<Packet8f>(Bf16ToF32(a)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf preduxp<Packet8bf>(const Packet8bf* p) {
+  Packet8f pf[8];
+  for (int i = 0; i < 8; ++i)
+    pf[i] = Bf16ToF32(p[i]);
+  return F32ToBf16(preduxp<Packet8f>(pf));
+}
+
+// The following operations only move 16-bit lanes around, and are thus shared with Packet8h.
+EIGEN_STRONG_INLINE Packet8h bf16_as_half(const Packet8bf& a) { Packet8h r; r.x = a.x; return r; }
+EIGEN_STRONG_INLINE Packet8bf half_as_bf16(const Packet8h& a) { Packet8bf r; r.x = a.x; return r; }
+
+template<> EIGEN_STRONG_INLINE Packet8bf preverse(const Packet8bf& a)
+{
+  return half_as_bf16(preverse(bf16_as_half(a)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf pinsertfirst(const Packet8bf& a, Eigen::bfloat16 b)
+{
+  Packet8bf res;
+  res.x = _mm_insert_epi16(a.x,int(b.x),0);
+  return res;
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf pinsertlast(const Packet8bf& a, Eigen::bfloat16 b)
+{
+  Packet8bf res;
+  res.x = _mm_insert_epi16(a.x,int(b.x),7);
+  return res;
+}
+
+template<int Offset>
+struct palign_impl<Offset,Packet8bf>
+{
+  static EIGEN_STRONG_INLINE void run(Packet8bf& first, const Packet8bf& second)
+  {
+    if (Offset!=0)
+      first.x = _mm_alignr_epi8(second.x,first.x, Offset*2);
+  }
+};
+
+template<int N>
+EIGEN_STRONG_INLINE void ptranspose_as_half(PacketBlock<Packet8bf,N>& kernel) {
+  PacketBlock<Packet8h,N> h;
+  for (int i = 0; i < N; ++i) h.packet[i] = bf16_as_half(kernel.packet[i]);
+  ptranspose(h);
+  for (int i = 0; i < N; ++i) kernel.packet[i] = half_as_bf16(h.packet[i]);
+}
+
+EIGEN_STRONG_INLINE void
+ptranspose(PacketBlock<Packet8bf,8>& kernel) {
+  ptranspose_as_half(kernel);
+}
+
+EIGEN_STRONG_INLINE void
+ptranspose(PacketBlock<Packet8bf,4>& kernel) {
+  ptranspose_as_half(kernel);
+}
+
+
 } // end namespace internal
 
 } // end namespace Eigen
@@ -47,9 +47,13 @@ struct is_arithmetic<__m512d> {
 typedef struct {
   __m256i x;
 } Packet16h;
+typedef struct {
+  __m256i x;
+} Packet16bf;
 
 
 template<> struct is_arithmetic<Packet16h> { enum { value = true }; };
+template<> struct is_arithmetic<Packet16bf> { enum { value = true }; };
 
 template <>
 struct packet_traits<half> : default_packet_traits {
@@ -80,6 +84,35 @@ struct packet_traits<half> : default_packet_traits {
   };
 };
 
+template <>
+struct packet_traits<bfloat16> : default_packet_traits {
+  typedef Packet16bf type;
+  // There is no half-size packet for Packet16bf.
+  typedef Packet16bf half;
+  enum {
+    Vectorizable = 1,
+    AlignedOnScalar = 1,
+    size = 16,
+    HasHalfPacket = 0,
+    HasAdd    = 1,
+    HasSub    = 1,
+    HasMul    = 1,
+    HasDiv    = 1,
+    HasNegate = 1,
+    HasAbs    = 1,
+    HasAbs2   = 1,
+    HasMin    = 1,
+    HasMax    = 1,
+    HasConj   = 1,
+    HasSetLinear = 0,
+    HasSqrt = 0,
+    HasRsqrt = 0,
+    HasExp = 0,
+    HasLog = 0,
+    HasBlend = 0
+  };
+};
+
 template<> struct packet_traits<float>  : default_packet_traits
 {
   typedef Packet16f type;
@@ -166,6 +199,13 @@ struct unpacket_traits<Packet16h> {
   enum {size=16, alignment=Aligned32, vectorizable=true, masked_load_available=false, masked_store_available=false};
 };
 
+template<>
+struct unpacket_traits<Packet16bf> {
+  typedef Eigen::bfloat16 type;
+  typedef Packet16bf half;
+  enum {size=16, alignment=Aligned32, vectorizable=true, masked_load_available=false, masked_store_available=false};
+};
+
 template <>
 EIGEN_STRONG_INLINE Packet16f pset1<Packet16f>(const float& from) {
   return _mm512_set1_ps(from);
@@ -300,6 +340,22 @@ EIGEN_STRONG_INLINE Packet8d pmadd(const Packet8d& a, const Packet8d& b,
 }
 #endif
 
+template <>
+EIGEN_STRONG_INLINE Packet16i pmadd_pairs(const Packet16i& a, const Packet16i& b,
+                                          const Packet16i& c) {
+#if defined(EIGEN_VECTORIZE_AVX512VNNI)
+  return _mm512_dpwssd_epi32(c, a, b);
+#elif defined(EIGEN_VECTORIZE_AVX512BW)
+  return _mm512_add_epi32(c, _mm512_madd_epi16(a, b));
+#else
+  __m256i lo = _mm256_add_epi32(_mm512_castsi512_si256(c),
+                                _mm256_madd_epi16(_mm512_castsi512_si256(a), _mm512_castsi512_si256(b)));
+  __m256i hi = _mm256_add_epi32(_mm512_extracti64x4_epi64(c, 1),
+                                _mm256_madd_epi16(_mm512_extracti64x4_epi64(a, 1), _mm512_extracti64x4_epi64(b, 1)));
+  return _mm512_inserti64x4(_mm512_castsi256_si512(lo), hi, 1);
+#endif
+}
+
 template <>
 EIGEN_DEVICE_FUNC inline Packet16f pselect(const Packet16f& mask,
                                            const Packet16f& a,
@@ -1904,6 +1960,243 @@ ptranspose(PacketBlock<Packet16h,4>& kernel) {
 }
 
 
+// Packet math for Eigen::bfloat16
+// The arithmetic is carried out in fp32, a bfloat16 being the upper half of a float.
+EIGEN_STRONG_INLINE Packet16f Bf16ToF32(const Packet16bf& a) {
+  return _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_cvtepu16_epi32(a.x), 16));
+}
+
+EIGEN_STRONG_INLINE Packet16bf F32ToBf16(const Packet16f& a) {
+  // Same rounding as F32ToBf16Bits in SSE/PacketMath.h, on 16 floats at once.
+  __m512i input = _mm512_castps_si512(a);
+  __m512i lsb = _mm512_and_si512(_mm512_srli_epi32(input, 16), _mm512_set1_epi32(1));
+  __m512i rounded = _mm512_add_epi32(input, _mm512_add_epi32(lsb, _mm512_set1_epi32(0x7fff)));
+  __mmask16 nan = _mm512_cmp_ps_mask(a, a, _CMP_UNORD_Q);
+  rounded = _mm512_mask_blend_epi32(nan, rounded, _mm512_or_si512(input, _mm512_set1_epi32(0x00400000)));
+  Packet16bf result;
+  result.x = _mm512_cvtepi32_epi16(_mm512_srli_epi32(rounded, 16));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf pset1<Packet16bf>(const Eigen::bfloat16& from) {
+  Packet16bf result;
+  result.x = _mm256_set1_epi16(static_cast<short>(from.x));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Eigen::bfloat16 pfirst<Packet16bf>(const Packet16bf& from) {
+  return bfloat16_impl::raw_uint16_to_bfloat16(static_cast<unsigned short>(_mm256_extract_epi16(from.x, 0)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf pload<Packet16bf>(const Eigen::bfloat16* from) {
+  Packet16bf result;
+  result.x = _mm256_load_si256(reinterpret_cast<const __m256i*>(from));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf ploadu<Packet16bf>(const Eigen::bfloat16* from) {
+  Packet16bf result;
+  result.x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(from));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE void pstore<bfloat16>(Eigen::bfloat16* to, const Packet16bf& from) {
+  _mm256_store_si256((__m256i*)(void*)to, from.x);
+}
+
+template<> EIGEN_STRONG_INLINE void pstoreu<bfloat16>(Eigen::bfloat16* to, const Packet16bf& from) {
+  _mm256_storeu_si256((__m256i*)(void*)to, from.x);
+}
+
+// The following operations only move 16-bit lanes around, and are thus shared with Packet16h.
+EIGEN_STRONG_INLINE Packet16h bf16_as_half(const Packet16bf& a) { Packet16h r; r.x = a.x; return r; }
+EIGEN_STRONG_INLINE Packet16bf half_as_bf16(const Packet16h& a) { Packet16bf r; r.x = a.x; return r; }
+
+template<> EIGEN_STRONG_INLINE Packet16bf
+ploaddup<Packet16bf>(const Eigen::bfloat16* from) {
+  // duplicate each of the 8 loaded 16-bit lanes
+  Packet16bf result;
+  __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(from));
+  result.x = _mm256_insertf128_si256(_mm256_castsi128_si256(_mm_unpacklo_epi16(a, a)), _mm_unpackhi_epi16(a, a), 1);
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf
+ploadquad(const Eigen::bfloat16* from) {
+  Packet16bf result;
+  short a = static_cast<short>(from[0].x);
+  short b = static_cast<short>(from[1].x);
+  short c = static_cast<short>(from[2].x);
+  short d = static_cast<short>(from[3].x);
+  result.x = _mm256_set_epi16(d, d, d, d, c, c, c, c, b, b, b, b, a, a, a, a);
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf ptrue(const Packet16bf& a) {
+  Packet16bf r; r.x = Packet8i(ptrue(a.x)); return r;
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf por(const Packet16bf& a,const Packet16bf& b) {
+  Packet16bf r; r.x = por(Packet8i(a.x),Packet8i(b.x)); return r;
+}
+template<> EIGEN_STRONG_INLINE Packet16bf pxor(const Packet16bf& a,const Packet16bf& b) {
+  Packet16bf r; r.x = pxor(Packet8i(a.x),Packet8i(b.x)); return r;
+}
+template<> EIGEN_STRONG_INLINE Packet16bf pand(const Packet16bf& a,const Packet16bf& b) {
+  Packet16bf r; r.x = pand(Packet8i(a.x),Packet8i(b.x)); return r;
+}
+template<> EIGEN_STRONG_INLINE Packet16bf pandnot(const Packet16bf& a,const Packet16bf& b) {
+  Packet16bf r; r.x = pandnot(Packet8i(a.x),Packet8i(b.x)); return r;
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf pselect(const Packet16bf& mask, const Packet16bf& a, const Packet16bf& b) {
+  Packet16bf r; r.x = _mm256_blendv_epi8(b.x, a.x, mask.x); return r;
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf pcmp_eq(const Packet16bf& a,const Packet16bf& b) {
+  __mmask16 eq = _mm512_cmp_ps_mask(Bf16ToF32(a), Bf16ToF32(b), _CMP_EQ_OQ);
+  // Narrow the 32-bit flags into 16-bits flags.
+  Packet16bf result; result.x = _mm512_cvtepi32_epi16(_mm512_maskz_set1_epi32(eq, -1));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf pconj(const Packet16bf& a) { return a; }
+
+template<> EIGEN_STRONG_INLINE Packet16bf pnegate(const Packet16bf& a) {
+  Packet16bf result; result.x = _mm256_xor_si256(a.x, _mm256_set1_epi16(static_cast<short>(0x8000)));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf pabs(const Packet16bf& a) {
+  Packet16bf result; result.x = _mm256_and_si256(a.x, _mm256_set1_epi16(0x7fff));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf padd<Packet16bf>(const Packet16bf& a, const Packet16bf& b) {
+  return F32ToBf16(padd(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf psub<Packet16bf>(const Packet16bf& a, const Packet16bf& b) {
+  return F32ToBf16(psub(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf pmul<Packet16bf>(const Packet16bf& a, const Packet16bf& b) {
+  return F32ToBf16(pmul(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf pmadd<Packet16bf>(const Packet16bf& a, const Packet16bf& b, const Packet16bf& c) {
+  // rounded once
+  return F32ToBf16(pmadd(Bf16ToF32(a), Bf16ToF32(b), Bf16ToF32(c)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf pdiv<Packet16bf>(const Packet16bf& a, const Packet16bf& b) {
+  return F32ToBf16(pdiv(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf pmin<Packet16bf>(const Packet16bf& a, const Packet16bf& b) {
+  return F32ToBf16(pmin(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf pmax<Packet16bf>(const Packet16bf& a, const Packet16bf& b) {
+  return F32ToBf16(pmax(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE bfloat16 predux<Packet16bf>(const Packet16bf& from) {
+  return bfloat16(predux(Bf16ToF32(from)));
+}
+
+template<> EIGEN_STRONG_INLINE bfloat16 predux_mul<Packet16bf>(const Packet16bf& from) {
+  return bfloat16(predux_mul(Bf16ToF32(from)));
+}
+
+template<> EIGEN_STRONG_INLINE bfloat16 predux_min<Packet16bf>(const Packet16bf& from) {
+  return bfloat16(predux_min(Bf16ToF32(from)));
+}
+
+template<> EIGEN_STRONG_INLINE bfloat16 predux_max<Packet16bf>(const Packet16bf& from) {
+  return bfloat16(predux_max(Bf16ToF32(from)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf preduxp<Packet16bf>(const Packet16bf* p) {
+  Packet16f pf[16];
+  for (int i = 0; i < 16; ++i)
+    pf[i] = Bf16ToF32(p[i]);
+  return F32ToBf16(preduxp<Packet16f>(pf));
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf preverse(const Packet16bf& a)
+{
+  return half_as_bf16(preverse(bf16_as_half(a)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf pinsertfirst(const Packet16bf& a, Eigen::bfloat16 b)
+{
+  Packet16bf res;
+  res.x = _mm256_insert_epi16(a.x,static_cast<short>(b.x),0);
+  return res;
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf pinsertlast(const Packet16bf& a, Eigen::bfloat16 b)
+{
+  Packet16bf res;
+  res.x = _mm256_insert_epi16(a.x,static_cast<short>(b.x),15);
+  return res;
+}
+
+template<int Offset>
+struct palign_impl<Offset,Packet16bf>
+{
+  EIGEN_STRONG_INLINE static void run(Packet16bf& first, const Packet16bf& second)
+  {
+    if (Offset!=0)
+    {
+      EIGEN_ALIGN64 Eigen::bfloat16 aux[32];
+      pstore(aux, first);
+      pstore(aux+16, second);
+      first = ploadu<Packet16bf>(aux+Offset);
+    }
+  }
+};
+
+template<> EIGEN_STRONG_INLINE Packet16bf pgather<Eigen::bfloat16, Packet16bf>(const Eigen::bfloat16* from, Index stride)
+{
+  EIGEN_ALIGN64 bfloat16 aux[16];
+  for (int i = 0; i < 16; ++i)
+    aux[i] = from[i*stride];
+  return pload<Packet16bf>(aux);
+}
+
+template<> EIGEN_STRONG_INLINE void pscatter<bfloat16, Packet16bf>(bfloat16* to, const Packet16bf& from, Index stride)
+{
+  EIGEN_ALIGN64 bfloat16 aux[16];
+  pstore(aux, from);
+  for (int i = 0; i < 16; ++i)
+    to[i*stride] = aux[i];
+}
+
+template<int N>
+EIGEN_STRONG_INLINE void ptranspose_as_half(PacketBlock<Packet16bf,N>& kernel) {
+  PacketBlock<Packet16h,N> h;
+  for (int i = 0; i < N; ++i) h.packet[i] = bf16_as_half(kernel.packet[i]);
+  ptranspose(h);
+  for (int i = 0; i < N; ++i) kernel.packet[i] = half_as_bf16(h.packet[i]);
+}
+
+EIGEN_STRONG_INLINE void
+ptranspose(PacketBlock<Packet16bf,16>& kernel) {
+  ptranspose_as_half(kernel);
+}
+
+EIGEN_STRONG_INLINE void
+ptranspose(PacketBlock<Packet16bf,8>& kernel) {
+  ptranspose_as_half(kernel);
+}
+
+EIGEN_STRONG_INLINE void
+ptranspose(PacketBlock<Packet16bf,4>& kernel) {
+  ptranspose_as_half(kernel);
+}
+
 } // end namespace internal
 
 } // end namespace Eigen
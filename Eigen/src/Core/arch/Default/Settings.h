@@ -39,6 +39,30 @@
 #endif
 
 
+/** Defines the size of the square tiles used to assign a large expression whose operands are not all stored
+  * in the same order as the destination (e.g., \c A \c = \c B.transpose() \c + \c C), so that each operand is
+  * traversed in a cache friendly way. The default is 32.
+  */
+#ifndef EIGEN_ASSIGN_TILE_SIZE
+#define EIGEN_ASSIGN_TILE_SIZE 32
+#endif
+
+
+/** Defines the minimal estimated cost, in cycles, of the work given to each thread when a coefficient-wise
+  * assignment or a reduction is parallelized (see EIGEN_PARALLELIZE_CWISE). The default is 100000.
+  */
+#ifndef EIGEN_PARALLEL_CWISE_THREAD_COST
+#define EIGEN_PARALLEL_CWISE_THREAD_COST 100000
+#endif
+
+/** Defines the number of coefficients of the blocks which are reduced independently by the reductions of large
+  * expressions when EIGEN_PARALLELIZE_CWISE is defined. Since the blocks do not depend on the number of threads,
+  * neither do the results. The default is 16384.
+  */
+#ifndef EIGEN_PARALLEL_REDUX_BLOCK_SIZE
+#define EIGEN_PARALLEL_REDUX_BLOCK_SIZE 16384
+#endif
+
 /** Defines the default number of registers available for that architecture.
   * Currently it must be 8 or 16. Other values will fail.
   */
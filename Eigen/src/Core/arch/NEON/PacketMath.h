@@ -605,6 +605,232 @@ ptranspose(PacketBlock<Packet4i,4>& kernel) {
   kernel.packet[3] = vcombine_s32(vget_high_s32(tmp1.val[1]), vget_high_s32(tmp2.val[1]));
 }
 
+//---------- bfloat16 ----------
+// The arithmetic is carried out in fp32, a bfloat16 being the upper half of a float.
+
+typedef struct {
+  uint16x4_t x;
+} Packet4bf;
+
+template<> struct is_arithmetic<Packet4bf> { enum { value = true }; };
+
+template <>
+struct packet_traits<Eigen::bfloat16> : default_packet_traits {
+  typedef Packet4bf type;
+  // There is no half-size packet for Packet4bf.
+  typedef Packet4bf half;
+  enum {
+    Vectorizable = 1,
+    AlignedOnScalar = 1,
+    size = 4,
+    HasHalfPacket = 0,
+    HasAdd    = 1,
+    HasSub    = 1,
+    HasMul    = 1,
+    HasDiv    = 1,
+    HasNegate = 1,
+    HasAbs    = 1,
+    HasAbs2   = 1,
+    HasMin    = 1,
+    HasMax    = 1,
+    HasConj   = 1,
+    HasSetLinear = 0,
+    HasSqrt = 0,
+    HasRsqrt = 0,
+    HasExp = 0,
+    HasLog = 0,
+    HasBlend = 0
+  };
+};
+
+template<> struct unpacket_traits<Packet4bf> { typedef Eigen::bfloat16 type; enum {size=4, alignment=Aligned8, vectorizable=true, masked_load_available=false, masked_store_available=false}; typedef Packet4bf half; };
+
+EIGEN_STRONG_INLINE Packet4f Bf16ToF32(const Packet4bf& a) {
+  return vreinterpretq_f32_u32(vshlq_n_u32(vmovl_u16(a.x), 16));
+}
+
+EIGEN_STRONG_INLINE Packet4bf F32ToBf16(const Packet4f& a) {
+  // Round to nearest even, NaNs are made quiet instead of rounded, which could turn them into infinities.
+  uint32x4_t input = vreinterpretq_u32_f32(a);
+  uint32x4_t lsb = vandq_u32(vshrq_n_u32(input, 16), vdupq_n_u32(1));
+  uint32x4_t rounded = vaddq_u32(input, vaddq_u32(lsb, vdupq_n_u32(0x7fff)));
+  uint32x4_t not_nan = vceqq_f32(a, a);
+  uint32x4_t quiet = vorrq_u32(input, vdupq_n_u32(0x00400000));
+  Packet4bf result;
+  result.x = vshrn_n_u32(vbslq_u32(not_nan, rounded, quiet), 16);
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pset1<Packet4bf>(const Eigen::bfloat16& from) {
+  Packet4bf result; result.x = vdup_n_u16(from.x); return result;
+}
+
+template<> EIGEN_STRONG_INLINE Eigen::bfloat16 pfirst<Packet4bf>(const Packet4bf& from) {
+  return bfloat16_impl::raw_uint16_to_bfloat16(vget_lane_u16(from.x, 0));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pload<Packet4bf>(const Eigen::bfloat16* from) {
+  Packet4bf result; result.x = vld1_u16(reinterpret_cast<const uint16_t*>(from)); return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf ploadu<Packet4bf>(const Eigen::bfloat16* from) {
+  Packet4bf result; result.x = vld1_u16(reinterpret_cast<const uint16_t*>(from)); return result;
+}
+
+template<> EIGEN_STRONG_INLINE void pstore<Eigen::bfloat16>(Eigen::bfloat16* to, const Packet4bf& from) {
+  vst1_u16(reinterpret_cast<uint16_t*>(to), from.x);
+}
+
+template<> EIGEN_STRONG_INLINE void pstoreu<Eigen::bfloat16>(Eigen::bfloat16* to, const Packet4bf& from) {
+  vst1_u16(reinterpret_cast<uint16_t*>(to), from.x);
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf ploaddup<Packet4bf>(const Eigen::bfloat16* from) {
+  Packet4bf result;
+  result.x = vzip_u16(vdup_n_u16(from[0].x), vdup_n_u16(from[1].x)).val[0];
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf ploadquad<Packet4bf>(const Eigen::bfloat16* from) {
+  return pset1<Packet4bf>(*from);
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf por(const Packet4bf& a, const Packet4bf& b) {
+  Packet4bf r; r.x = vorr_u16(a.x, b.x); return r;
+}
+template<> EIGEN_STRONG_INLINE Packet4bf pxor(const Packet4bf& a, const Packet4bf& b) {
+  Packet4bf r; r.x = veor_u16(a.x, b.x); return r;
+}
+template<> EIGEN_STRONG_INLINE Packet4bf pand(const Packet4bf& a, const Packet4bf& b) {
+  Packet4bf r; r.x = vand_u16(a.x, b.x); return r;
+}
+template<> EIGEN_STRONG_INLINE Packet4bf pandnot(const Packet4bf& a, const Packet4bf& b) {
+  Packet4bf r; r.x = vbic_u16(a.x, b.x); return r;
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pselect(const Packet4bf& mask, const Packet4bf& a, const Packet4bf& b) {
+  Packet4bf r; r.x = vbsl_u16(mask.x, a.x, b.x); return r;
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pcmp_eq(const Packet4bf& a, const Packet4bf& b) {
+  Packet4bf r; r.x = vmovn_u32(vceqq_f32(Bf16ToF32(a), Bf16ToF32(b))); return r;
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pconj(const Packet4bf& a) { return a; }
+
+template<> EIGEN_STRONG_INLINE Packet4bf pnegate(const Packet4bf& a) {
+  Packet4bf r; r.x = veor_u16(a.x, vdup_n_u16(0x8000)); return r;
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pabs(const Packet4bf& a) {
+  Packet4bf r; r.x = vand_u16(a.x, vdup_n_u16(0x7fff)); return r;
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf padd<Packet4bf>(const Packet4bf& a, const Packet4bf& b) {
+  return F32ToBf16(padd(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf psub<Packet4bf>(const Packet4bf& a, const Packet4bf& b) {
+  return F32ToBf16(psub(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pmul<Packet4bf>(const Packet4bf& a, const Packet4bf& b) {
+  return F32ToBf16(pmul(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pmadd<Packet4bf>(const Packet4bf& a, const Packet4bf& b, const Packet4bf& c) {
+  // rounded once
+  return F32ToBf16(pmadd(Bf16ToF32(a), Bf16ToF32(b), Bf16ToF32(c)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pdiv<Packet4bf>(const Packet4bf& a, const Packet4bf& b) {
+  return F32ToBf16(pdiv(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pmin<Packet4bf>(const Packet4bf& a, const Packet4bf& b) {
+  return F32ToBf16(pmin(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pmax<Packet4bf>(const Packet4bf& a, const Packet4bf& b) {
+  return F32ToBf16(pmax(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pgather<Eigen::bfloat16, Packet4bf>(const Eigen::bfloat16* from, Index stride)
+{
+  Packet4bf r = pset1<Packet4bf>(from[0]);
+  r.x = vset_lane_u16(from[1*stride].x, r.x, 1);
+  r.x = vset_lane_u16(from[2*stride].x, r.x, 2);
+  r.x = vset_lane_u16(from[3*stride].x, r.x, 3);
+  return r;
+}
+
+template<> EIGEN_STRONG_INLINE void pscatter<Eigen::bfloat16, Packet4bf>(Eigen::bfloat16* to, const Packet4bf& from, Index stride)
+{
+  to[stride*0].x = vget_lane_u16(from.x, 0);
+  to[stride*1].x = vget_lane_u16(from.x, 1);
+  to[stride*2].x = vget_lane_u16(from.x, 2);
+  to[stride*3].x = vget_lane_u16(from.x, 3);
+}
+
+template<> EIGEN_STRONG_INLINE Eigen::bfloat16 predux<Packet4bf>(const Packet4bf& a) {
+  return Eigen::bfloat16(predux(Bf16ToF32(a)));
+}
+
+template<> EIGEN_STRONG_INLINE Eigen::bfloat16 predux_max<Packet4bf>(const Packet4bf& a) {
+  return Eigen::bfloat16(predux_max(Bf16ToF32(a)));
+}
+
+template<> EIGEN_STRONG_INLINE Eigen::bfloat16 predux_min<Packet4bf>(const Packet4bf& a) {
+  return Eigen::bfloat16(predux_min(Bf16ToF32(a)));
+}
+
+template<> EIGEN_STRONG_INLINE Eigen::bfloat16 predux_mul<Packet4bf>(const Packet4bf& a) {
+  return Eigen::bfloat16(predux_mul(Bf16ToF32(a)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf preduxp<Packet4bf>(const Packet4bf* p) {
+  Packet4f pf[4];
+  pf[0] = Bf16ToF32(p[0]);
+  pf[1] = Bf16ToF32(p[1]);
+  pf[2] = Bf16ToF32(p[2]);
+  pf[3] = Bf16ToF32(p[3]);
+  return F32ToBf16(preduxp<Packet4f>(pf));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf preverse(const Packet4bf& a) {
+  Packet4bf r; r.x = vrev64_u16(a.x); return r;
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pinsertfirst(const Packet4bf& a, Eigen::bfloat16 b) {
+  Packet4bf r; r.x = vset_lane_u16(b.x, a.x, 0); return r;
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pinsertlast(const Packet4bf& a, Eigen::bfloat16 b) {
+  Packet4bf r; r.x = vset_lane_u16(b.x, a.x, 3); return r;
+}
+
+template<int Offset>
+struct palign_impl<Offset,Packet4bf>
+{
+  EIGEN_STRONG_INLINE static void run(Packet4bf& first, const Packet4bf& second)
+  {
+    if (Offset!=0)
+      first.x = vext_u16(first.x, second.x, Offset);
+  }
+};
+
+EIGEN_DEVICE_FUNC inline void
+ptranspose(PacketBlock<Packet4bf,4>& kernel) {
+  uint16x4x2_t ab = vzip_u16(kernel.packet[0].x, kernel.packet[1].x);
+  uint16x4x2_t cd = vzip_u16(kernel.packet[2].x, kernel.packet[3].x);
+  uint32x2x2_t lo = vzip_u32(vreinterpret_u32_u16(ab.val[0]), vreinterpret_u32_u16(cd.val[0]));
+  uint32x2x2_t hi = vzip_u32(vreinterpret_u32_u16(ab.val[1]), vreinterpret_u32_u16(cd.val[1]));
+  kernel.packet[0].x = vreinterpret_u16_u32(lo.val[0]);
+  kernel.packet[1].x = vreinterpret_u16_u32(lo.val[1]);
+  kernel.packet[2].x = vreinterpret_u16_u32(hi.val[0]);
+  kernel.packet[3].x = vreinterpret_u16_u32(hi.val[1]);
+}
+
 //---------- double ----------
 
 // Clang 3.5 in the iOS toolchain has an ICE triggered by NEON intrisics for double.
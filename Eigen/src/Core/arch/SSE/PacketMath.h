@@ -273,6 +273,7 @@ template<> EIGEN_STRONG_INLINE Packet2d pdiv<Packet2d>(const Packet2d& a, const
 
 // for some weird raisons, it has to be overloaded for packet of integers
 template<> EIGEN_STRONG_INLINE Packet4i pmadd(const Packet4i& a, const Packet4i& b, const Packet4i& c) { return padd(pmul(a,b), c); }
+template<> EIGEN_STRONG_INLINE Packet4i pmadd_pairs(const Packet4i& a, const Packet4i& b, const Packet4i& c) { return _mm_add_epi32(c, _mm_madd_epi16(a,b)); }
 #ifdef EIGEN_VECTORIZE_FMA
 template<> EIGEN_STRONG_INLINE Packet4f pmadd(const Packet4f& a, const Packet4f& b, const Packet4f& c) { return _mm_fmadd_ps(a,b,c); }
 template<> EIGEN_STRONG_INLINE Packet2d pmadd(const Packet2d& a, const Packet2d& b, const Packet2d& c) { return _mm_fmadd_pd(a,b,c); }
@@ -1266,6 +1267,265 @@ ptranspose(PacketBlock<Packet4h,4>& kernel) {
 #endif
 
 
+// Packet math for Eigen::bfloat16
+// The four bfloat16 of a Packet4bf are stored in the lower 64 bits of a __m128i.
+// The arithmetic is carried out in fp32, a bfloat16 being the upper half of a float.
+typedef struct {
+  __m128i x;
+} Packet4bf;
+
+template<> struct is_arithmetic<Packet4bf> { enum { value = true }; };
+
+// Use the packet_traits defined in AVX/PacketMath.h instead if we're going
+// to leverage AVX instructions.
+#ifndef EIGEN_VECTORIZE_AVX
+template <>
+struct packet_traits<Eigen::bfloat16> : default_packet_traits {
+  typedef Packet4bf type;
+  // There is no half-size packet for Packet4bf.
+  typedef Packet4bf half;
+  enum {
+    Vectorizable = 1,
+    AlignedOnScalar = 1,
+    size = 4,
+    HasHalfPacket = 0,
+    HasAdd    = 1,
+    HasSub    = 1,
+    HasMul    = 1,
+    HasDiv    = 1,
+    HasNegate = 1,
+    HasAbs    = 1,
+    HasAbs2   = 1,
+    HasMin    = 1,
+    HasMax    = 1,
+    HasConj   = 1,
+    HasSetLinear = 0,
+    HasSqrt = 0,
+    HasRsqrt = 0,
+    HasExp = 0,
+    HasLog = 0,
+    HasBlend = 0
+  };
+};
+#endif
+
+template<> struct unpacket_traits<Packet4bf> { typedef Eigen::bfloat16 type; enum {size=4, alignment=Aligned8, vectorizable=true, masked_load_available=false, masked_store_available=false}; typedef Packet4bf half; };
+
+EIGEN_STRONG_INLINE Packet4f Bf16ToF32(const Packet4bf& a) {
+  // interleaving with zeros shifts each bfloat16 to the upper half of a 32-bit lane
+  return _mm_castsi128_ps(_mm_unpacklo_epi16(_mm_setzero_si128(), a.x));
+}
+
+// Rounds the floats of a to the nearest bfloat16, ties to even, and returns them in the lower 16 bits of
+// each 32-bit lane, sign extended so that they can be narrowed with a signed saturation.
+EIGEN_STRONG_INLINE Packet4i F32ToBf16Bits(const Packet4f& a) {
+  Packet4i input = _mm_castps_si128(a);
+  Packet4i lsb = _mm_and_si128(_mm_srli_epi32(input, 16), _mm_set1_epi32(1));
+  Packet4i rounded = _mm_add_epi32(input, _mm_add_epi32(lsb, _mm_set1_epi32(0x7fff)));
+  // NaNs are made quiet instead of rounded, which could turn them into infinities
+  Packet4i nan = _mm_castps_si128(_mm_cmpunord_ps(a, a));
+  Packet4i quiet = _mm_or_si128(input, _mm_set1_epi32(0x00400000));
+  rounded = _mm_or_si128(_mm_and_si128(nan, quiet), _mm_andnot_si128(nan, rounded));
+  return _mm_srai_epi32(rounded, 16);
+}
+
+EIGEN_STRONG_INLINE Packet4bf F32ToBf16(const Packet4f& a) {
+  Packet4bf result;
+  result.x = _mm_packs_epi32(F32ToBf16Bits(a), _mm_setzero_si128());
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pset1<Packet4bf>(const Eigen::bfloat16& from) {
+  Packet4bf result;
+  result.x = _mm_set1_epi16(static_cast<short>(from.x));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Eigen::bfloat16 pfirst<Packet4bf>(const Packet4bf& from) {
+  return bfloat16_impl::raw_uint16_to_bfloat16(static_cast<unsigned short>(_mm_extract_epi16(from.x, 0)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pload<Packet4bf>(const Eigen::bfloat16* from) {
+  Packet4bf result;
+  result.x = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(from));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf ploadu<Packet4bf>(const Eigen::bfloat16* from) {
+  Packet4bf result;
+  result.x = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(from));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE void pstore<Eigen::bfloat16>(Eigen::bfloat16* to, const Packet4bf& from) {
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(to), from.x);
+}
+
+template<> EIGEN_STRONG_INLINE void pstoreu<Eigen::bfloat16>(Eigen::bfloat16* to, const Packet4bf& from) {
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(to), from.x);
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf
+ploaddup<Packet4bf>(const Eigen::bfloat16* from) {
+  Packet4bf result;
+  short a = static_cast<short>(from[0].x);
+  short b = static_cast<short>(from[1].x);
+  result.x = _mm_set_epi16(0, 0, 0, 0, b, b, a, a);
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf
+ploadquad<Packet4bf>(const Eigen::bfloat16* from) {
+  return pset1<Packet4bf>(*from);
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf por(const Packet4bf& a,const Packet4bf& b) {
+  Packet4bf r; r.x = _mm_or_si128(a.x,b.x); return r;
+}
+template<> EIGEN_STRONG_INLINE Packet4bf pxor(const Packet4bf& a,const Packet4bf& b) {
+  Packet4bf r; r.x = _mm_xor_si128(a.x,b.x); return r;
+}
+template<> EIGEN_STRONG_INLINE Packet4bf pand(const Packet4bf& a,const Packet4bf& b) {
+  Packet4bf r; r.x = _mm_and_si128(a.x,b.x); return r;
+}
+template<> EIGEN_STRONG_INLINE Packet4bf pandnot(const Packet4bf& a,const Packet4bf& b) {
+  Packet4bf r; r.x = _mm_andnot_si128(b.x,a.x); return r;
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pcmp_eq(const Packet4bf& a,const Packet4bf& b) {
+  Packet4f rf = pcmp_eq(Bf16ToF32(a), Bf16ToF32(b));
+  // Pack the 32-bit flags into 16-bits flags.
+  Packet4bf result; result.x = _mm_packs_epi32(_mm_castps_si128(rf), _mm_setzero_si128());
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pconj(const Packet4bf& a) { return a; }
+
+template<> EIGEN_STRONG_INLINE Packet4bf pnegate(const Packet4bf& a) {
+  Packet4bf result; result.x = _mm_xor_si128(a.x, _mm_set1_epi16(static_cast<short>(0x8000)));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pabs(const Packet4bf& a) {
+  Packet4bf result; result.x = _mm_and_si128(a.x, _mm_set1_epi16(0x7fff));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf padd<Packet4bf>(const Packet4bf& a, const Packet4bf& b) {
+  return F32ToBf16(padd(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf psub<Packet4bf>(const Packet4bf& a, const Packet4bf& b) {
+  return F32ToBf16(psub(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pmul<Packet4bf>(const Packet4bf& a, const Packet4bf& b) {
+  return F32ToBf16(pmul(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pmadd<Packet4bf>(const Packet4bf& a, const Packet4bf& b, const Packet4bf& c) {
+  // rounded once
+  return F32ToBf16(pmadd(Bf16ToF32(a), Bf16ToF32(b), Bf16ToF32(c)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pdiv<Packet4bf>(const Packet4bf& a, const Packet4bf& b) {
+  return F32ToBf16(pdiv(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pmin<Packet4bf>(const Packet4bf& a, const Packet4bf& b) {
+  return F32ToBf16(pmin(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pmax<Packet4bf>(const Packet4bf& a, const Packet4bf& b) {
+  return F32ToBf16(pmax(Bf16ToF32(a), Bf16ToF32(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pgather<Eigen::bfloat16, Packet4bf>(const Eigen::bfloat16* from, Index stride)
+{
+  Packet4bf result;
+  result.x = _mm_set_epi16(0, 0, 0, 0, static_cast<short>(from[3*stride].x), static_cast<short>(from[2*stride].x),
+                           static_cast<short>(from[1*stride].x), static_cast<short>(from[0*stride].x));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE void pscatter<Eigen::bfloat16, Packet4bf>(Eigen::bfloat16* to, const Packet4bf& from, Index stride)
+{
+  to[stride*0].x = static_cast<unsigned short>(_mm_extract_epi16(from.x, 0));
+  to[stride*1].x = static_cast<unsigned short>(_mm_extract_epi16(from.x, 1));
+  to[stride*2].x = static_cast<unsigned short>(_mm_extract_epi16(from.x, 2));
+  to[stride*3].x = static_cast<unsigned short>(_mm_extract_epi16(from.x, 3));
+}
+
+template<> EIGEN_STRONG_INLINE Eigen::bfloat16 predux<Packet4bf>(const Packet4bf& a) {
+  return Eigen::bfloat16(predux(Bf16ToF32(a)));
+}
+
+template<> EIGEN_STRONG_INLINE Eigen::bfloat16 predux_max<Packet4bf>(const Packet4bf& a) {
+  return Eigen::bfloat16(predux_max(Bf16ToF32(a)));
+}
+
+template<> EIGEN_STRONG_INLINE Eigen::bfloat16 predux_min<Packet4bf>(const Packet4bf& a) {
+  return Eigen::bfloat16(predux_min(Bf16ToF32(a)));
+}
+
+template<> EIGEN_STRONG_INLINE Eigen::bfloat16 predux_mul<Packet4bf>(const Packet4bf& a) {
+  return Eigen::bfloat16(predux_mul(Bf16ToF32(a)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf preduxp<Packet4bf>(const Packet4bf* p) {
+  Packet4f pf[4];
+  pf[0] = Bf16ToF32(p[0]);
+  pf[1] = Bf16ToF32(p[1]);
+  pf[2] = Bf16ToF32(p[2]);
+  pf[3] = Bf16ToF32(p[3]);
+  return F32ToBf16(preduxp<Packet4f>(pf));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf preverse(const Packet4bf& a)
+{
+  Packet4bf res;
+  res.x = _mm_shufflelo_epi16(a.x, _MM_SHUFFLE(0,1,2,3));
+  return res;
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pinsertfirst(const Packet4bf& a, Eigen::bfloat16 b)
+{
+  Packet4bf res;
+  res.x = _mm_insert_epi16(a.x,int(b.x),0);
+  return res;
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pinsertlast(const Packet4bf& a, Eigen::bfloat16 b)
+{
+  Packet4bf res;
+  res.x = _mm_insert_epi16(a.x,int(b.x),3);
+  return res;
+}
+
+template<int Offset>
+struct palign_impl<Offset,Packet4bf>
+{
+  static EIGEN_STRONG_INLINE void run(Packet4bf& first, const Packet4bf& second)
+  {
+    if (Offset!=0)
+      first.x = _mm_or_si128(_mm_srli_epi64(first.x, Offset*16), _mm_slli_epi64(second.x, (4-Offset)*16));
+  }
+};
+
+EIGEN_STRONG_INLINE void
+ptranspose(PacketBlock<Packet4bf,4>& kernel) {
+  __m128i a03b03 = _mm_unpacklo_epi16(kernel.packet[0].x, kernel.packet[1].x);
+  __m128i c03d03 = _mm_unpacklo_epi16(kernel.packet[2].x, kernel.packet[3].x);
+  __m128i a01b01c01d01 = _mm_unpacklo_epi32(a03b03, c03d03);
+  __m128i a23b23c23d23 = _mm_unpackhi_epi32(a03b03, c03d03);
+
+  kernel.packet[0].x = a01b01c01d01;
+  kernel.packet[1].x = _mm_srli_si128(a01b01c01d01, 8);
+  kernel.packet[2].x = a23b23c23d23;
+  kernel.packet[3].x = _mm_srli_si128(a23b23c23d23, 8);
+}
+
+
 } // end namespace internal
 
 } // end namespace Eigen
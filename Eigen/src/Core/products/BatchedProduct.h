@@ -0,0 +1,187 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_BATCHED_PRODUCT_H
+#define EIGEN_BATCHED_PRODUCT_H
+
+namespace Eigen {
+
+namespace internal {
+
+/* Batches of small fixed-size products are vectorized across matrices rather than within each of them:
+ * the k-th lane of a packet holds a coefficient of the k-th matrix of a group of PacketSize consecutive
+ * matrices (structure of arrays). Each product then becomes a fully unrolled sequence of pmadd on whole
+ * packets, whatever the sizes of the matrices. The price is one gather per input coefficient and one scatter
+ * per output coefficient, which only pays off for tiny matrices whose inner size (e.g., 3, 5, 6) cannot be
+ * vectorized by the regular coefficient-based product.
+ */
+
+// Unrolls the dot product between a row of the interleaved lhs and a column of the interleaved rhs.
+template<typename Packet, int Depth, int K=0>
+struct batched_product_dot_unroller
+{
+  static EIGEN_STRONG_INLINE Packet run(const Packet* lhs, Index lhsStride, const Packet* rhs, const Packet& acc)
+  {
+    return batched_product_dot_unroller<Packet,Depth,K+1>::run(lhs, lhsStride, rhs, pmadd(lhs[K*lhsStride], rhs[K], acc));
+  }
+};
+
+template<typename Packet, int Depth>
+struct batched_product_dot_unroller<Packet,Depth,Depth>
+{
+  static EIGEN_STRONG_INLINE Packet run(const Packet*, Index, const Packet*, const Packet& acc) { return acc; }
+};
+
+template<typename Lhs, typename Rhs, typename Dst,
+         bool Vectorize = (Lhs::SizeAtCompileTime!=Dynamic && Rhs::SizeAtCompileTime!=Dynamic && Dst::SizeAtCompileTime!=Dynamic
+                       && Lhs::RowsAtCompileTime<=8 && Lhs::ColsAtCompileTime<=8 && Rhs::ColsAtCompileTime<=8
+                       && int(Dst::InnerSizeAtCompileTime)>2 && int(Dst::InnerSizeAtCompileTime)%4!=0
+                       && bool(packet_traits<typename Dst::Scalar>::Vectorizable)
+                       && int(unpacket_traits<typename packet_traits<typename Dst::Scalar>::type>::size)>1)>
+struct batched_product_impl
+{
+  enum { PacketSize = 1 };
+
+  // Generic path for large or dynamic-size matrices, for non-vectorizable scalar types, and for sizes that the
+  // coefficient-based product already vectorizes well within each matrix.
+  static void run(const Lhs* lhs, const Rhs* rhs, Dst* dst, Index start, Index end)
+  {
+    for(Index p=start; p<end; ++p)
+      dst[p].noalias() = lhs[p] * rhs[p];
+  }
+};
+
+template<typename Lhs, typename Rhs, typename Dst>
+struct batched_product_impl<Lhs,Rhs,Dst,true>
+{
+  typedef typename Dst::Scalar Scalar;
+  typedef typename packet_traits<Scalar>::type Packet;
+  enum {
+    PacketSize = unpacket_traits<Packet>::size,
+    Rows = Lhs::RowsAtCompileTime,
+    Depth = Lhs::ColsAtCompileTime,
+    Cols = Rhs::ColsAtCompileTime
+  };
+  // distance between the first coefficients of two consecutive matrices
+  static const Index LhsStride = sizeof(Lhs)/sizeof(Scalar);
+  static const Index RhsStride = sizeof(Rhs)/sizeof(Scalar);
+  static const Index DstStride = sizeof(Dst)/sizeof(Scalar);
+
+  static EIGEN_STRONG_INLINE Index offset(Index i, Index j, Index rows, Index cols, bool rowMajor)
+  {
+    return rowMajor ? i*cols+j : i+j*rows;
+  }
+
+  // Evaluates the PacketSize consecutive products starting at lhs, rhs, and dst.
+  static EIGEN_STRONG_INLINE void run_packet(const Lhs* lhs, const Rhs* rhs, Dst* dst)
+  {
+    const Scalar* lhsData = lhs->data();
+    const Scalar* rhsData = rhs->data();
+    Scalar* dstData = dst->data();
+
+    // interleaved lhs, stored column-major
+    Packet a[Rows*Depth];
+    for(Index k=0; k<Depth; ++k)
+      for(Index i=0; i<Rows; ++i)
+        a[i+k*Rows] = pgather<Scalar,Packet>(lhsData + offset(i,k,Rows,Depth,Lhs::IsRowMajor), LhsStride);
+
+    for(Index j=0; j<Cols; ++j)
+    {
+      Packet b[Depth];
+      for(Index k=0; k<Depth; ++k)
+        b[k] = pgather<Scalar,Packet>(rhsData + offset(k,j,Depth,Cols,Rhs::IsRowMajor), RhsStride);
+      for(Index i=0; i<Rows; ++i)
+      {
+        Packet c = batched_product_dot_unroller<Packet,Depth>::run(a+i, Rows, b, pset1<Packet>(Scalar(0)));
+        pscatter<Scalar,Packet>(dstData + offset(i,j,Rows,Cols,Dst::IsRowMajor), c, DstStride);
+      }
+    }
+  }
+
+  static void run(const Lhs* lhs, const Rhs* rhs, Dst* dst, Index start, Index end)
+  {
+    Index p = start;
+    for(; p+PacketSize<=end; p+=PacketSize)
+      run_packet(lhs+p, rhs+p, dst+p);
+    for(; p<end; ++p)
+      dst[p].noalias() = lhs[p].lazyProduct(rhs[p]);
+  }
+};
+
+template<typename Lhs, typename Rhs, typename Dst>
+struct batched_product_task
+{
+  typedef batched_product_impl<Lhs,Rhs,Dst> Impl;
+
+  batched_product_task(const Lhs* lhs, const Rhs* rhs, Dst* dst, Index count, Index chunkSize)
+    : m_lhs(lhs), m_rhs(rhs), m_dst(dst), m_count(count), m_chunkSize(chunkSize)
+  {}
+
+  void operator()(Index i) const
+  {
+    Index start = i*m_chunkSize;
+    Impl::run(m_lhs, m_rhs, m_dst, start, (std::min)(start+m_chunkSize, m_count));
+  }
+
+  const Lhs* m_lhs;
+  const Rhs* m_rhs;
+  Dst* m_dst;
+  Index m_count, m_chunkSize;
+};
+
+} // end namespace internal
+
+/** \ingroup Core_Module
+  *
+  * Computes the \a count independent products \c dst[i] = \c lhs[i] * \c rhs[i], for i in [0,count).
+  *
+  * This function is meant for large batches of small matrices, whose products are dominated by the per-call overhead
+  * of the general matrix product. When the three matrix types are fixed-size, at most 8x8, and the inner size of
+  * \a Dst is larger than 2 and not a multiple of 4, the matrices are interleaved across the lanes of the SIMD
+  * registers, so that groups of matrices are multiplied at once by fully unrolled packet kernels. Other matrix types
+  * fall back to one regular product per matrix.
+  *
+  * Large batches are split among the threads used by the parallel products (OpenMP, or the thread pool registered
+  * with setGemmThreadPool()), see nbThreads().
+  *
+  * \param lhs pointer to the \a count left-hand side matrices, stored contiguously
+  * \param rhs pointer to the \a count right-hand side matrices, stored contiguously
+  * \param dst pointer to the \a count destination matrices, stored contiguously. They must not alias \a lhs or \a rhs.
+  * \param count number of products
+  *
+  * Example:
+  * \code
+  * std::vector<Matrix3f> a(n), b(n), c(n);
+  * batched_product(a.data(), b.data(), c.data(), n);
+  * \endcode
+  */
+template<typename Lhs, typename Rhs, typename Dst>
+void batched_product(const Lhs* lhs, const Rhs* rhs, Dst* dst, Index count)
+{
+  EIGEN_STATIC_ASSERT((internal::is_same<typename Lhs::Scalar,typename Dst::Scalar>::value
+                    && internal::is_same<typename Rhs::Scalar,typename Dst::Scalar>::value),
+                      YOU_MIXED_DIFFERENT_NUMERIC_TYPES__YOU_NEED_TO_USE_THE_CAST_METHOD_OF_MATRIXBASE_TO_CAST_NUMERIC_TYPES_EXPLICITLY)
+  EIGEN_STATIC_ASSERT(Lhs::ColsAtCompileTime==Dynamic || Rhs::RowsAtCompileTime==Dynamic
+                   || int(Lhs::ColsAtCompileTime)==int(Rhs::RowsAtCompileTime),
+                      INVALID_MATRIX_PRODUCT)
+  EIGEN_STATIC_ASSERT((Dst::RowsAtCompileTime==Dynamic || Lhs::RowsAtCompileTime==Dynamic || int(Dst::RowsAtCompileTime)==int(Lhs::RowsAtCompileTime))
+                   && (Dst::ColsAtCompileTime==Dynamic || Rhs::ColsAtCompileTime==Dynamic || int(Dst::ColsAtCompileTime)==int(Rhs::ColsAtCompileTime)),
+                      YOU_MIXED_MATRICES_OF_DIFFERENT_SIZES)
+  typedef internal::batched_product_impl<Lhs,Rhs,Dst> Impl;
+
+  // one task per chunk of matrices, chunks being multiples of the number of interleaved matrices
+  const Index chunkSize = 64 * Index(Impl::PacketSize);
+  const Index numChunks = (count + chunkSize - 1) / chunkSize;
+  double work = count>0 ? double(count) * double(lhs[0].size()) * double(rhs[0].cols()) : 0.;
+  const double kMinTaskSize = 50000;
+  Index threads = (std::min)(Index(nbThreads()), (std::max)(Index(1), Index(work/kMinTaskSize)));
+  internal::parallel_run_tasks(numChunks, threads, internal::batched_product_task<Lhs,Rhs,Dst>(lhs, rhs, dst, count, chunkSize));
+}
+
+} // end namespace Eigen
+
+#endif // EIGEN_BATCHED_PRODUCT_H
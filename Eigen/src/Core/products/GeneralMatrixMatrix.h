@@ -16,6 +16,38 @@ namespace internal {
 
 template<typename _LhsScalar, typename _RhsScalar> class level3_blocking;
 
+/* Output kernels are called by the matrix-matrix product on each block of the result as soon as it is complete,
+ * while it is still in cache, as kernel(row, col, rows, cols). They make it possible to fuse elementwise operations,
+ * such as adding a bias or applying an activation function, into the product (see ProductEvaluators.h). */
+struct gemm_no_output_kernel
+{
+  template<typename Index> void operator()(Index, Index, Index, Index) const {}
+};
+
+/* Output kernel of a sub-product whose result starts at (row,col) in the result of the whole product.
+ * If Transpose is true, the sub-product computes the transpose of the result. */
+template<typename OutputKernel, bool Transpose>
+struct gemm_output_kernel_mapper
+{
+  gemm_output_kernel_mapper(const OutputKernel& kernel, Index row, Index col)
+    : m_kernel(kernel), m_row(row), m_col(col)
+  {}
+
+  template<typename Index_>
+  void operator()(Index_ i, Index_ j, Index_ rows, Index_ cols) const
+  {
+    if(Transpose) m_kernel(m_row+Index(j), m_col+Index(i), Index(cols), Index(rows));
+    else          m_kernel(m_row+Index(i), m_col+Index(j), Index(rows), Index(cols));
+  }
+
+  const OutputKernel& m_kernel;
+  Index m_row, m_col;
+};
+
+template<typename OutputKernel> struct gemm_has_output_kernel { enum { value = true }; };
+template<> struct gemm_has_output_kernel<gemm_no_output_kernel> { enum { value = false }; };
+template<bool Transpose> struct gemm_has_output_kernel<gemm_output_kernel_mapper<gemm_no_output_kernel,Transpose> > { enum { value = false }; };
+
 /* Specialization for a row-major destination matrix => simple transposition of the product */
 template<
   typename Index,
@@ -43,6 +75,25 @@ struct general_matrix_matrix_product<Index,LhsScalar,LhsStorageOrder,ConjugateLh
       ColMajor,ResInnerStride>
     ::run(cols,rows,depth,rhs,rhsStride,lhs,lhsStride,res,resIncr,resStride,alpha,blocking,info);
   }
+
+  template<typename OutputKernel>
+  static EIGEN_STRONG_INLINE void run(
+    Index rows, Index cols, Index depth,
+    const LhsScalar* lhs, Index lhsStride,
+    const RhsScalar* rhs, Index rhsStride,
+    ResScalar* res, Index resIncr, Index resStride,
+    ResScalar alpha,
+    level3_blocking<RhsScalar,LhsScalar>& blocking,
+    GemmParallelInfo<Index>* info,
+    const OutputKernel& output_kernel)
+  {
+    general_matrix_matrix_product<Index,
+      RhsScalar, RhsStorageOrder==RowMajor ? ColMajor : RowMajor, ConjugateRhs,
+      LhsScalar, LhsStorageOrder==RowMajor ? ColMajor : RowMajor, ConjugateLhs,
+      ColMajor,ResInnerStride>
+    ::run(cols,rows,depth,rhs,rhsStride,lhs,lhsStride,res,resIncr,resStride,alpha,blocking,info,
+          gemm_output_kernel_mapper<OutputKernel,true>(output_kernel,0,0));
+  }
 };
 
 /*  Specialization for a col-major destination matrix
@@ -65,6 +116,19 @@ static void run(Index rows, Index cols, Index depth,
   ResScalar alpha,
   level3_blocking<LhsScalar,RhsScalar>& blocking,
   GemmParallelInfo<Index>* info = 0)
+{
+  run(rows, cols, depth, _lhs, lhsStride, _rhs, rhsStride, _res, resIncr, resStride, alpha, blocking, info, gemm_no_output_kernel());
+}
+
+template<typename OutputKernel>
+static void run(Index rows, Index cols, Index depth,
+  const LhsScalar* _lhs, Index lhsStride,
+  const RhsScalar* _rhs, Index rhsStride,
+  ResScalar* _res, Index resIncr, Index resStride,
+  ResScalar alpha,
+  level3_blocking<LhsScalar,RhsScalar>& blocking,
+  GemmParallelInfo<Index>* info,
+  const OutputKernel& output_kernel)
 {
   typedef const_blas_data_mapper<LhsScalar, Index, LhsStorageOrder> LhsMapper;
   typedef const_blas_data_mapper<RhsScalar, Index, RhsStorageOrder> RhsMapper;
@@ -153,6 +217,9 @@ static void run(Index rows, Index cols, Index depth,
 #endif
         info[i].users -= 1;
     }
+
+    // the columns computed by this thread are complete
+    output_kernel(Index(0), Index(0), rows, cols);
   }
   else
 #endif // EIGEN_HAS_OPENMP
@@ -173,6 +240,11 @@ static void run(Index rows, Index cols, Index depth,
     {
       const Index actual_mc = (std::min)(i2+mc,rows)-i2;
 
+      // Width of the slices of the result to which the output kernel is applied: the last panel along the depth
+      // is computed by slices of columns small enough to remain in the L1 cache until the output kernel processes them.
+      const Index nsc = (std::max)(Index(4*Traits::nr),
+                                   Index(l1CacheSize()/(actual_mc*Index(sizeof(ResScalar))))/Traits::nr*Traits::nr);
+
       for(Index k2=0; k2<depth; k2+=kc)
       {
         const Index actual_kc = (std::min)(k2+kc,depth)-k2;
@@ -195,9 +267,140 @@ static void run(Index rows, Index cols, Index depth,
             pack_rhs(blockB, rhs.getSubMapper(k2,j2), actual_kc, actual_nc);
 
           // Everything is packed, we can now call the panel * block kernel:
-          gebp(res.getSubMapper(i2, j2), blockA, blockB, actual_mc, actual_kc, actual_nc, alpha);
+          if(!gemm_has_output_kernel<OutputKernel>::value || k2+kc<depth)
+          {
+            gebp(res.getSubMapper(i2, j2), blockA, blockB, actual_mc, actual_kc, actual_nc, alpha);
+          }
+          else
+          {
+            for(Index j3=0; j3<actual_nc; j3+=nsc)
+            {
+              const Index actual_nsc = (std::min)(j3+nsc,actual_nc)-j3;
+              gebp(res.getSubMapper(i2, j2+j3), blockA, blockB+j3*actual_kc, actual_mc, actual_kc, actual_nsc, alpha);
+              output_kernel(i2, j2+j3, actual_mc, actual_nsc);
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+};
+
+/*  Specialization for bfloat16 operands and a col-major destination matrix
+ *    => the lhs and rhs blocks are converted to float while being packed, and the product is accumulated
+ *       in float by the float gebp kernel. The result is rounded to bfloat16 only once, when it is added
+ *       to the destination, which avoids the loss of precision of a bfloat16 accumulation along the depth. */
+template<
+  typename Index,
+  int LhsStorageOrder, bool ConjugateLhs,
+  int RhsStorageOrder, bool ConjugateRhs,
+  int ResInnerStride>
+struct general_matrix_matrix_product<Index,bfloat16,LhsStorageOrder,ConjugateLhs,bfloat16,RhsStorageOrder,ConjugateRhs,ColMajor,ResInnerStride>
+{
+
+typedef gebp_traits<float,float> Traits;
+
+typedef bfloat16 ResScalar;
+static void run(Index rows, Index cols, Index depth,
+  const bfloat16* _lhs, Index lhsStride,
+  const bfloat16* _rhs, Index rhsStride,
+  bfloat16* _res, Index resIncr, Index resStride,
+  bfloat16 alpha,
+  level3_blocking<bfloat16,bfloat16>& blocking,
+  GemmParallelInfo<Index>* info = 0)
+{
+  run(rows, cols, depth, _lhs, lhsStride, _rhs, rhsStride, _res, resIncr, resStride, alpha, blocking, info, gemm_no_output_kernel());
+}
+
+template<typename OutputKernel>
+static void run(Index rows, Index cols, Index depth,
+  const bfloat16* _lhs, Index lhsStride,
+  const bfloat16* _rhs, Index rhsStride,
+  bfloat16* _res, Index resIncr, Index resStride,
+  bfloat16 alpha,
+  level3_blocking<bfloat16,bfloat16>& blocking,
+  GemmParallelInfo<Index>* info,
+  const OutputKernel& output_kernel)
+{
+  typedef Matrix<bfloat16,Dynamic,Dynamic,LhsStorageOrder> BfLhsMatrix;
+  typedef Matrix<bfloat16,Dynamic,Dynamic,RhsStorageOrder> BfRhsMatrix;
+  typedef Matrix<float,Dynamic,Dynamic,LhsStorageOrder> LhsMatrix;
+  typedef Matrix<float,Dynamic,Dynamic,RhsStorageOrder> RhsMatrix;
+  typedef Matrix<float,Dynamic,Dynamic,ColMajor> AccMatrix;
+  typedef const_blas_data_mapper<float, Index, LhsStorageOrder> LhsMapper;
+  typedef const_blas_data_mapper<float, Index, RhsStorageOrder> RhsMapper;
+  typedef blas_data_mapper<float, Index, ColMajor> AccMapper;
+  typedef blas_data_mapper<bfloat16, Index, ColMajor, Unaligned, ResInnerStride> ResMapper;
+
+  // The bfloat16 blocking and the shared packing buffers are useless here: the blocks are packed as floats,
+  // and each thread of a parallel product computes its own slice of the destination.
+  EIGEN_UNUSED_VARIABLE(blocking);
+  EIGEN_UNUSED_VARIABLE(info);
+
+  Map<const BfLhsMatrix,0,OuterStride<> > lhs(_lhs, rows, depth, OuterStride<>(lhsStride));
+  Map<const BfRhsMatrix,0,OuterStride<> > rhs(_rhs, depth, cols, OuterStride<>(rhsStride));
+  ResMapper res(_res, resStride, resIncr);
+
+  Index kc = depth;
+  Index mc = rows;
+  Index nc = cols;
+  computeProductBlockingSizes<float,float>(kc, mc, nc);
+
+  gemm_pack_lhs<float, Index, LhsMapper, Traits::mr, Traits::LhsProgress, typename Traits::LhsPacket4Packing, LhsStorageOrder> pack_lhs;
+  gemm_pack_rhs<float, Index, RhsMapper, Traits::nr, RhsStorageOrder> pack_rhs;
+  gebp_kernel<float, float, Index, AccMapper, Traits::mr, Traits::nr, ConjugateLhs, ConjugateRhs> gebp;
+
+  std::size_t sizeA = kc*mc;
+  std::size_t sizeB = kc*nc;
+  ei_declare_aligned_stack_constructed_variable(float, blockA, sizeA, 0);
+  ei_declare_aligned_stack_constructed_variable(float, blockB, sizeB, 0);
+
+  // unpacked float copies of the current blocks of the operands, and float accumulator of the current block of the result
+  LhsMatrix lhsBlock(mc, kc);
+  RhsMatrix rhsBlock(kc, nc);
+  AccMatrix acc(mc, nc);
+
+  const bool pack_lhs_once = kc==depth;
+  const bool pack_rhs_once = mc!=rows && kc==depth && nc==cols;
+  const float actualAlpha = static_cast<float>(alpha);
+
+  for(Index i2=0; i2<rows; i2+=mc)
+  {
+    const Index actual_mc = (std::min)(i2+mc,rows)-i2;
+
+    for(Index j2=0; j2<cols; j2+=nc)
+    {
+      const Index actual_nc = (std::min)(j2+nc,cols)-j2;
+      AccMapper accMapper(acc.data(), acc.outerStride());
+      acc.topLeftCorner(actual_mc, actual_nc).setZero();
+
+      for(Index k2=0; k2<depth; k2+=kc)
+      {
+        const Index actual_kc = (std::min)(k2+kc,depth)-k2;
+
+        if((!pack_lhs_once) || j2==0)
+        {
+          lhsBlock.resize(actual_mc, actual_kc);
+          lhsBlock = lhs.block(i2, k2, actual_mc, actual_kc).template cast<float>();
+          pack_lhs(blockA, LhsMapper(lhsBlock.data(), lhsBlock.outerStride()), actual_kc, actual_mc);
+        }
+
+        if((!pack_rhs_once) || i2==0)
+        {
+          rhsBlock.resize(actual_kc, actual_nc);
+          rhsBlock = rhs.block(k2, j2, actual_kc, actual_nc).template cast<float>();
+          pack_rhs(blockB, RhsMapper(rhsBlock.data(), rhsBlock.outerStride()), actual_kc, actual_nc);
         }
+
+        gebp(accMapper, blockA, blockB, actual_mc, actual_kc, actual_nc, 1.f);
       }
+
+      for(Index j=0; j<actual_nc; ++j)
+        for(Index i=0; i<actual_mc; ++i)
+          res(i2+i, j2+j) = bfloat16(static_cast<float>(res(i2+i, j2+j)) + actualAlpha * acc(i, j));
+      output_kernel(i2, j2, actual_mc, actual_nc);
     }
   }
 }
@@ -209,11 +412,13 @@ static void run(Index rows, Index cols, Index depth,
 *  implementation of the high level wrapper to general_matrix_matrix_product
 **********************************************************************************/
 
-template<typename Scalar, typename Index, typename Gemm, typename Lhs, typename Rhs, typename Dest, typename BlockingType>
+template<typename Scalar, typename Index, typename Gemm, typename Lhs, typename Rhs, typename Dest, typename BlockingType,
+         typename OutputKernel = gemm_no_output_kernel>
 struct gemm_functor
 {
-  gemm_functor(const Lhs& lhs, const Rhs& rhs, Dest& dest, const Scalar& actualAlpha, BlockingType& blocking)
-    : m_lhs(lhs), m_rhs(rhs), m_dest(dest), m_actualAlpha(actualAlpha), m_blocking(blocking)
+  gemm_functor(const Lhs& lhs, const Rhs& rhs, Dest& dest, const Scalar& actualAlpha, BlockingType& blocking,
+               const OutputKernel& outputKernel = OutputKernel())
+    : m_lhs(lhs), m_rhs(rhs), m_dest(dest), m_actualAlpha(actualAlpha), m_blocking(blocking), m_outputKernel(outputKernel)
   {}
 
   void initParallelSession(Index num_threads) const
@@ -227,21 +432,46 @@ struct gemm_functor
     if(cols==-1)
       cols = m_rhs.cols();
 
-    Gemm::run(rows, cols, m_lhs.cols(),
-              &m_lhs.coeffRef(row,0), m_lhs.outerStride(),
-              &m_rhs.coeffRef(0,col), m_rhs.outerStride(),
-              (Scalar*)&(m_dest.coeffRef(row,col)), m_dest.innerStride(), m_dest.outerStride(),
-              m_actualAlpha, m_blocking, info);
+    run(row, rows, col, cols, m_blocking, info, bool_constant<gemm_has_output_kernel<OutputKernel>::value>());
+  }
+
+  // Evaluates the sub-product [row,row+rows) x [col,col+cols) using its own blocking and packing buffers,
+  // so that several blocks can be evaluated concurrently without any synchronization.
+  void evalBlock(Index row, Index rows, Index col, Index cols) const
+  {
+    BlockingType blocking(rows, cols, m_lhs.cols(), 1, true);
+    run(row, rows, col, cols, blocking, 0, bool_constant<gemm_has_output_kernel<OutputKernel>::value>());
   }
 
   typedef typename Gemm::Traits Traits;
 
   protected:
+    void run(Index row, Index rows, Index col, Index cols, BlockingType& blocking,
+             GemmParallelInfo<Index>* info, false_type) const
+    {
+      Gemm::run(rows, cols, m_lhs.cols(),
+                &m_lhs.coeffRef(row,0), m_lhs.outerStride(),
+                &m_rhs.coeffRef(0,col), m_rhs.outerStride(),
+                (Scalar*)&(m_dest.coeffRef(row,col)), m_dest.innerStride(), m_dest.outerStride(),
+                m_actualAlpha, blocking, info);
+    }
+
+    void run(Index row, Index rows, Index col, Index cols, BlockingType& blocking,
+             GemmParallelInfo<Index>* info, true_type) const
+    {
+      Gemm::run(rows, cols, m_lhs.cols(),
+                &m_lhs.coeffRef(row,0), m_lhs.outerStride(),
+                &m_rhs.coeffRef(0,col), m_rhs.outerStride(),
+                (Scalar*)&(m_dest.coeffRef(row,col)), m_dest.innerStride(), m_dest.outerStride(),
+                m_actualAlpha, blocking, info, gemm_output_kernel_mapper<OutputKernel,false>(m_outputKernel, row, col));
+    }
+
     const Lhs& m_lhs;
     const Rhs& m_rhs;
     Dest& m_dest;
     Scalar m_actualAlpha;
     BlockingType& m_blocking;
+    OutputKernel m_outputKernel;
 };
 
 template<int StorageOrder, typename LhsScalar, typename RhsScalar, int MaxRows, int MaxCols, int MaxDepth, int KcFactor=1,
@@ -446,6 +676,22 @@ struct generic_product_impl<Lhs,Rhs,DenseShape,DenseShape,GemmProduct>
     }
   }
 
+  // Evaluates the product into dst, and applies output_kernel to each block of dst as soon as it is complete.
+  template<typename Dst, typename OutputKernel>
+  static void evalTo(Dst& dst, const Lhs& lhs, const Rhs& rhs, const OutputKernel& output_kernel)
+  {
+    if((rhs.rows()+dst.rows()+dst.cols())<EIGEN_GEMM_TO_COEFFBASED_THRESHOLD && rhs.rows()>0)
+    {
+      lazyproduct::eval_dynamic(dst, lhs, rhs, internal::assign_op<typename Dst::Scalar,Scalar>());
+      output_kernel(Index(0), Index(0), dst.rows(), dst.cols());
+    }
+    else
+    {
+      dst.setZero();
+      scaleAndAddTo(dst, lhs, rhs, Scalar(1), output_kernel);
+    }
+  }
+
   template<typename Dst>
   static void addTo(Dst& dst, const Lhs& lhs, const Rhs& rhs)
   {
@@ -466,23 +712,36 @@ struct generic_product_impl<Lhs,Rhs,DenseShape,DenseShape,GemmProduct>
 
   template<typename Dest>
   static void scaleAndAddTo(Dest& dst, const Lhs& a_lhs, const Rhs& a_rhs, const Scalar& alpha)
+  {
+    scaleAndAddTo(dst, a_lhs, a_rhs, alpha, internal::gemm_no_output_kernel());
+  }
+
+  template<typename Dest, typename OutputKernel>
+  static void scaleAndAddTo(Dest& dst, const Lhs& a_lhs, const Rhs& a_rhs, const Scalar& alpha, const OutputKernel& output_kernel)
   {
     eigen_assert(dst.rows()==a_lhs.rows() && dst.cols()==a_rhs.cols());
     if(a_lhs.cols()==0 || a_lhs.rows()==0 || a_rhs.cols()==0)
+    {
+      output_kernel(Index(0), Index(0), dst.rows(), dst.cols());
       return;
+    }
 
     // Fallback to GEMV if either the lhs or rhs is a runtime vector
     if (dst.cols() == 1)
     {
       typename Dest::ColXpr dst_vec(dst.col(0));
-      return internal::generic_product_impl<Lhs,typename Rhs::ConstColXpr,DenseShape,DenseShape,GemvProduct>
+      internal::generic_product_impl<Lhs,typename Rhs::ConstColXpr,DenseShape,DenseShape,GemvProduct>
         ::scaleAndAddTo(dst_vec, a_lhs, a_rhs.col(0), alpha);
+      output_kernel(Index(0), Index(0), dst.rows(), dst.cols());
+      return;
     }
     else if (dst.rows() == 1)
     {
       typename Dest::RowXpr dst_vec(dst.row(0));
-      return internal::generic_product_impl<typename Lhs::ConstRowXpr,Rhs,DenseShape,DenseShape,GemvProduct>
+      internal::generic_product_impl<typename Lhs::ConstRowXpr,Rhs,DenseShape,DenseShape,GemvProduct>
         ::scaleAndAddTo(dst_vec, a_lhs.row(0), a_rhs, alpha);
+      output_kernel(Index(0), Index(0), dst.rows(), dst.cols());
+      return;
     }
 
     typename internal::add_const_on_value_type<ActualLhsType>::type lhs = LhsBlasTraits::extract(a_lhs);
@@ -502,11 +761,11 @@ struct generic_product_impl<Lhs,Rhs,DenseShape,DenseShape,GemmProduct>
         RhsScalar, (ActualRhsTypeCleaned::Flags&RowMajorBit) ? RowMajor : ColMajor, bool(RhsBlasTraits::NeedToConjugate),
         (Dest::Flags&RowMajorBit) ? RowMajor : ColMajor,
         Dest::InnerStrideAtCompileTime>,
-      ActualLhsTypeCleaned, ActualRhsTypeCleaned, Dest, BlockingType> GemmFunctor;
+      ActualLhsTypeCleaned, ActualRhsTypeCleaned, Dest, BlockingType, OutputKernel> GemmFunctor;
 
     BlockingType blocking(dst.rows(), dst.cols(), lhs.cols(), 1, true);
     internal::parallelize_gemm<(Dest::MaxRowsAtCompileTime>32 || Dest::MaxRowsAtCompileTime==Dynamic)>
-        (GemmFunctor(lhs, rhs, dst, actualAlpha, blocking), a_lhs.rows(), a_rhs.cols(), a_lhs.cols(), Dest::Flags&RowMajorBit);
+        (GemmFunctor(lhs, rhs, dst, actualAlpha, blocking, output_kernel), a_lhs.rows(), a_rhs.cols(), a_lhs.cols(), Dest::Flags&RowMajorBit);
   }
 };
 
@@ -103,7 +103,22 @@ static void run(Index rows, Index cols, Index depth, \
   } else b = _rhs; \
 \
   BLASFUNC(&transa, &transb, &m, &n, &k, (const BLASTYPE*)&numext::real_ref(alpha), (const BLASTYPE*)a, &lda, (const BLASTYPE*)b, &ldb, (const BLASTYPE*)&numext::real_ref(beta), (BLASTYPE*)res, &ldc); \
-}};
+} \
+\
+template<typename OutputKernel> \
+static void run(Index rows, Index cols, Index depth, \
+  const EIGTYPE* _lhs, Index lhsStride, \
+  const EIGTYPE* _rhs, Index rhsStride, \
+  EIGTYPE* res, Index resIncr, Index resStride, \
+  EIGTYPE alpha, \
+  level3_blocking<EIGTYPE, EIGTYPE>& blocking, \
+  GemmParallelInfo<Index>* info, \
+  const OutputKernel& output_kernel) \
+{ \
+  run(rows, cols, depth, _lhs, lhsStride, _rhs, rhsStride, res, resIncr, resStride, alpha, blocking, info); \
+  output_kernel(Index(0), Index(0), rows, cols); \
+} \
+};
 
 #ifdef EIGEN_USE_MKL
 GEMM_SPECIALIZATION(double,   d,  double, dgemm)
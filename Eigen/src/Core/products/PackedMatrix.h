@@ -0,0 +1,387 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_PACKED_MATRIX_H
+#define EIGEN_PACKED_MATRIX_H
+
+namespace Eigen {
+
+namespace internal {
+
+template<typename Scalar, int Side> struct packed_gemm;
+
+template<typename _Scalar, int _Side>
+struct traits<PackedMatrix<_Scalar,_Side> >
+{
+  typedef _Scalar Scalar;
+  typedef Eigen::Index StorageIndex;
+  typedef PackedStorage StorageKind;
+  typedef MatrixXpr XprKind;
+  enum {
+    RowsAtCompileTime = Dynamic,
+    ColsAtCompileTime = Dynamic,
+    MaxRowsAtCompileTime = Dynamic,
+    MaxColsAtCompileTime = Dynamic,
+    Flags = NestByRefBit
+  };
+};
+
+} // end namespace internal
+
+/** \class PackedMatrix
+  * \ingroup Core_Module
+  *
+  * \brief A dense matrix stored in the packed format of the matrix-matrix product kernels
+  *
+  * \tparam _Scalar the scalar type of the matrix
+  * \tparam _Side either OnTheLeft or OnTheRight, the side of the products in which the matrix is used
+  *
+  * A large matrix product spends a noticeable part of its time copying its operands into the cache friendly
+  * panels consumed by its kernels. When the same matrix is an operand of many products, e.g., the weights of a
+  * neural network layer, this class performs this copy once, with the blocking sizes returned by
+  * computeProductBlockingSizes(), and then reuses it for all the subsequent products:
+  * \code
+  * PackedMatrix<float,OnTheLeft> W(weights);   // W is used as the left-hand side of the products
+  * for(...)
+  *   Y.noalias() = W * X;                      // only X is packed
+  *
+  * PackedMatrix<float,OnTheRight> V(weights);  // V is used as the right-hand side of the products
+  * Z.noalias() = X * V;
+  * \endcode
+  *
+  * The products support the usual \c =, \c +=, and \c -= assignments, with or without noalias(), and are
+  * parallelized like the regular matrix products (see nbThreads()). The other operand must have the same
+  * scalar type. Column-major destinations are written directly, others go through a temporary.
+  *
+  * The packed data only depends on the coefficients of the original matrix at the time of compute(),
+  * so that later changes of the original matrix are not reflected.
+  */
+template<typename _Scalar, int _Side>
+class PackedMatrix : public EigenBase<PackedMatrix<_Scalar,_Side> >
+{
+  public:
+    typedef _Scalar Scalar;
+    typedef EigenBase<PackedMatrix> Base;
+    enum {
+      Side = _Side,
+      RowsAtCompileTime = Dynamic,
+      ColsAtCompileTime = Dynamic,
+      MaxRowsAtCompileTime = Dynamic,
+      MaxColsAtCompileTime = Dynamic,
+      IsRowMajor = 0
+    };
+
+    /** Default constructor, compute() must be called before the matrix is used in a product. */
+    PackedMatrix() : m_rows(0), m_cols(0), m_kc(0), m_blockSize(0) {}
+
+    /** Packs the matrix \a matrix. \sa compute() */
+    template<typename Derived>
+    explicit PackedMatrix(const MatrixBase<Derived>& matrix, Index otherSize = 0)
+      : m_rows(0), m_cols(0), m_kc(0), m_blockSize(0)
+    {
+      compute(matrix, otherSize);
+    }
+
+    /** Packs the matrix \a matrix.
+      *
+      * The blocking sizes depend on the three dimensions of the products. \a otherSize is the expected number of
+      * columns of the right-hand side (resp. rows of the left-hand side) of the products with \a matrix when
+      * \a Side is OnTheLeft (resp. OnTheRight). It defaults to the largest dimension of \a matrix. */
+    template<typename Derived>
+    PackedMatrix& compute(const MatrixBase<Derived>& matrix, Index otherSize = 0)
+    {
+      EIGEN_STATIC_ASSERT((internal::is_same<typename Derived::Scalar,Scalar>::value),
+        YOU_MIXED_DIFFERENT_NUMERIC_TYPES__YOU_NEED_TO_USE_THE_CAST_METHOD_OF_MATRIXBASE_TO_CAST_NUMERIC_TYPES_EXPLICITLY)
+      enum { Order = (Derived::Flags&RowMajorBit) ? RowMajor : ColMajor };
+      Ref<const Matrix<Scalar,Dynamic,Dynamic,Order>, 0, OuterStride<> > mat(matrix.derived());
+
+      m_rows = mat.rows();
+      m_cols = mat.cols();
+      if(otherSize<=0)
+        otherSize = (std::max)(m_rows, m_cols);
+
+      Index k = int(Side)==OnTheLeft ? m_cols : m_rows;
+      Index m = int(Side)==OnTheLeft ? m_rows : otherSize;
+      Index n = int(Side)==OnTheLeft ? otherSize : m_cols;
+      internal::computeProductBlockingSizes<Scalar,Scalar>(k, m, n);
+      m_kc = (std::max)(Index(1), k);
+      m_blockSize = (std::max)(Index(1), int(Side)==OnTheLeft ? m : n);
+
+      m_data.resize(m_rows*m_cols);
+      internal::packed_gemm<Scalar,Side>::template pack<Order>(*this, mat.data(), mat.outerStride());
+      return *this;
+    }
+
+    inline Index rows() const { return m_rows; }
+    inline Index cols() const { return m_cols; }
+
+    /** \returns the blocking size along the depth of the products */
+    inline Index kc() const { return m_kc; }
+    /** \returns the blocking size along the rows (resp. columns) of the matrix when \a Side is OnTheLeft (resp. OnTheRight) */
+    inline Index blockSize() const { return m_blockSize; }
+
+    /** \returns the packed coefficients, see internal::packed_gemm for their layout */
+    inline const Scalar* data() const { return m_data.data(); }
+    inline Scalar* data() { return m_data.data(); }
+
+    /** \returns an expression of the product of \c *this by the matrix \a other */
+    template<typename OtherDerived>
+    inline const Product<PackedMatrix,OtherDerived>
+    operator*(const MatrixBase<OtherDerived>& other) const
+    {
+      EIGEN_STATIC_ASSERT(int(Side)==OnTheLeft, THIS_METHOD_IS_ONLY_FOR_MATRICES_OF_A_SPECIFIC_SIZE)
+      return Product<PackedMatrix,OtherDerived>(*this, other.derived());
+    }
+
+  protected:
+    Index m_rows;
+    Index m_cols;
+    Index m_kc;
+    Index m_blockSize;
+    Matrix<Scalar,Dynamic,1> m_data;
+};
+
+/** \returns an expression of the product of the matrix \a other by the packed matrix \a packed
+  * \relates PackedMatrix */
+template<typename OtherDerived, typename Scalar>
+inline const Product<OtherDerived,PackedMatrix<Scalar,OnTheRight> >
+operator*(const MatrixBase<OtherDerived>& other, const PackedMatrix<Scalar,OnTheRight>& packed)
+{
+  return Product<OtherDerived,PackedMatrix<Scalar,OnTheRight> >(other.derived(), packed);
+}
+
+namespace internal {
+
+/* The packed matrix is stored as a sequence of the blocks produced by gemm_pack_lhs (resp. gemm_pack_rhs).
+ * For a left-hand side of size m x k, the mc x kc block (i2,k2) starts at i2*k + k2*actual_mc, where
+ * actual_mc is the number of rows of the blocks of the row panel i2.
+ * For a right-hand side of size k x n, the kc x nc block (k2,j2) starts at j2*k + k2*actual_nc.
+ * The products only pack the other operand, with the same kc so that the blocks along the depth match.
+ */
+template<typename Scalar, int Side>
+struct packed_gemm
+{
+  typedef gebp_traits<Scalar,Scalar> Traits;
+  typedef blas_data_mapper<Scalar,Index,ColMajor> ResMapper;
+  typedef gebp_kernel<Scalar,Scalar,Index,ResMapper,Traits::mr,Traits::nr,false,false> Gebp;
+
+  template<int StorageOrder>
+  static void pack(PackedMatrix<Scalar,Side>& dst, const Scalar* data, Index stride)
+  {
+    typedef const_blas_data_mapper<Scalar,Index,StorageOrder> Mapper;
+    Mapper mat(data, stride);
+    const Index rows = dst.rows(), cols = dst.cols(), kc = dst.kc(), bs = dst.blockSize();
+    if(Side==OnTheLeft)
+    {
+      gemm_pack_lhs<Scalar,Index,Mapper,Traits::mr,Traits::LhsProgress,typename Traits::LhsPacket4Packing,StorageOrder> pack_lhs;
+      for(Index i2=0; i2<rows; i2+=bs)
+      {
+        const Index actual_mc = (std::min)(i2+bs,rows)-i2;
+        for(Index k2=0; k2<cols; k2+=kc)
+          pack_lhs(dst.data() + i2*cols + k2*actual_mc, mat.getSubMapper(i2,k2), (std::min)(k2+kc,cols)-k2, actual_mc);
+      }
+    }
+    else
+    {
+      gemm_pack_rhs<Scalar,Index,Mapper,Traits::nr,StorageOrder> pack_rhs;
+      for(Index j2=0; j2<cols; j2+=bs)
+      {
+        const Index actual_nc = (std::min)(j2+bs,cols)-j2;
+        for(Index k2=0; k2<rows; k2+=kc)
+          pack_rhs(dst.data() + j2*rows + k2*actual_nc, mat.getSubMapper(k2,j2), (std::min)(k2+kc,rows)-k2, actual_nc);
+      }
+    }
+  }
+
+  /* One task evaluates a panel of the unpacked operand (columns of the rhs or rows of the lhs) against a
+   * group of consecutive blocks of the packed matrix. Each block of the unpacked operand is therefore packed
+   * once per group, and the tasks are fully independent. */
+  template<int OtherStorageOrder>
+  struct task
+  {
+    typedef const_blas_data_mapper<Scalar,Index,OtherStorageOrder> OtherMapper;
+
+    task(const PackedMatrix<Scalar,Side>& packed, const Scalar* other, Index otherStride, Index otherSize,
+         Scalar* res, Index resStride, Scalar alpha, Index panelSize, Index numGroups)
+      : m_packed(packed), m_other(other, otherStride), m_otherSize(otherSize), m_res(res, resStride), m_alpha(alpha),
+        m_panelSize(panelSize), m_numGroups(numGroups)
+    {}
+
+    void operator()(Index t) const
+    {
+      const Index packedSize = Side==OnTheLeft ? m_packed.rows() : m_packed.cols();
+      const Index depth = Side==OnTheLeft ? m_packed.cols() : m_packed.rows();
+      const Index kc = m_packed.kc();
+      const Index bs = m_packed.blockSize();
+      const Index numBlocks = (packedSize+bs-1)/bs;
+
+      const Index p0 = (t/m_numGroups)*m_panelSize;
+      const Index p1 = (std::min)(p0+m_panelSize, m_otherSize);
+      const Index g = t%m_numGroups;
+      const Index b0 = ((g*numBlocks)/m_numGroups)*bs;
+      const Index b1 = (std::min)((((g+1)*numBlocks)/m_numGroups)*bs, packedSize);
+
+      Gebp gebp;
+      std::size_t sizeW = kc*(p1-p0);
+      ei_declare_aligned_stack_constructed_variable(Scalar, work, sizeW, 0);
+
+      for(Index k2=0; k2<depth; k2+=kc)
+      {
+        const Index actual_kc = (std::min)(k2+kc,depth)-k2;
+        if(Side==OnTheLeft)
+        {
+          gemm_pack_rhs<Scalar,Index,OtherMapper,Traits::nr,OtherStorageOrder> pack_rhs;
+          pack_rhs(work, m_other.getSubMapper(k2,p0), actual_kc, p1-p0);
+          for(Index i2=b0; i2<b1; i2+=bs)
+          {
+            const Index actual_mc = (std::min)(i2+bs,packedSize)-i2;
+            gebp(m_res.getSubMapper(i2,p0), m_packed.data() + i2*depth + k2*actual_mc, work, actual_mc, actual_kc, p1-p0, m_alpha);
+          }
+        }
+        else
+        {
+          gemm_pack_lhs<Scalar,Index,OtherMapper,Traits::mr,Traits::LhsProgress,typename Traits::LhsPacket4Packing,OtherStorageOrder> pack_lhs;
+          pack_lhs(work, m_other.getSubMapper(p0,k2), actual_kc, p1-p0);
+          for(Index j2=b0; j2<b1; j2+=bs)
+          {
+            const Index actual_nc = (std::min)(j2+bs,packedSize)-j2;
+            gebp(m_res.getSubMapper(p0,j2), work, m_packed.data() + j2*depth + k2*actual_nc, p1-p0, actual_kc, actual_nc, m_alpha);
+          }
+        }
+      }
+    }
+
+    const PackedMatrix<Scalar,Side>& m_packed;
+    OtherMapper m_other;
+    Index m_otherSize;
+    ResMapper m_res;
+    Scalar m_alpha;
+    Index m_panelSize;
+    Index m_numGroups;
+  };
+
+  // res += alpha * packed * other (resp. alpha * other * packed), res being column-major.
+  template<int OtherStorageOrder>
+  static void run(const PackedMatrix<Scalar,Side>& packed, const Scalar* other, Index otherStride, Index otherSize,
+                  Scalar* res, Index resStride, Scalar alpha)
+  {
+    const Index packedSize = Side==OnTheLeft ? packed.rows() : packed.cols();
+    const Index depth = Side==OnTheLeft ? packed.cols() : packed.rows();
+    if(packedSize==0 || depth==0 || otherSize==0)
+      return;
+
+    // blocking size of the other operand, for the kc chosen at packing time
+    Index k = packed.kc(), m = Side==OnTheLeft ? packedSize : otherSize, n = Side==OnTheLeft ? otherSize : packedSize;
+    computeProductBlockingSizes<Scalar,Scalar>(k, m, n);
+    Index panelSize = (std::max)(Index(1), Side==OnTheLeft ? n : m);
+
+    const double work = static_cast<double>(packedSize) * static_cast<double>(depth) * static_cast<double>(otherSize);
+    const double kMinTaskSize = 50000;  // same heuristic as parallelize_gemm
+    Index threads = (std::min)(Index(nbThreads()), (std::max)(Index(1), Index(work/kMinTaskSize)));
+
+    const Index numBlocks = (packedSize+packed.blockSize()-1)/packed.blockSize();
+    Index numGroups = 1;
+    if(threads>1)
+    {
+      // about four tasks per thread, split the other operand first, then the blocks of the packed matrix
+      const Index granularity = Side==OnTheLeft ? Index(Traits::nr) : Index(Traits::mr);
+      const Index targetPanel = ((otherSize+4*threads-1)/(4*threads)+granularity-1)/granularity*granularity;
+      panelSize = (std::min)(panelSize, (std::max)(granularity, targetPanel));
+      const Index numPanels = (otherSize+panelSize-1)/panelSize;
+      numGroups = (std::min)(numBlocks, (4*threads+numPanels-1)/numPanels);
+    }
+    const Index numPanels = (otherSize+panelSize-1)/panelSize;
+
+    parallel_run_tasks(numPanels*numGroups, threads,
+                       task<OtherStorageOrder>(packed, other, otherStride, otherSize, res, resStride, alpha, panelSize, numGroups));
+  }
+};
+
+template<typename Dest, bool Direct = !(Dest::Flags&RowMajorBit) && (Dest::Flags&DirectAccessBit) && Dest::InnerStrideAtCompileTime==1>
+struct packed_product_dest
+{
+  // column-major destination with unit inner stride: the kernels write into it directly
+  template<typename Func>
+  static void run(Dest& dst, const Func& func) { func(dst.data(), dst.outerStride()); }
+};
+
+template<typename Dest>
+struct packed_product_dest<Dest,false>
+{
+  template<typename Func>
+  static void run(Dest& dst, const Func& func)
+  {
+    Matrix<typename Dest::Scalar,Dynamic,Dynamic> tmp(dst.rows(), dst.cols());
+    tmp.setZero();
+    func(tmp.data(), tmp.outerStride());
+    dst += tmp;
+  }
+};
+
+template<typename Scalar, int Side, typename Other>
+struct packed_product_func
+{
+  enum { OtherOrder = (Other::Flags&RowMajorBit) ? RowMajor : ColMajor };
+  typedef Ref<const Matrix<Scalar,Dynamic,Dynamic,OtherOrder>, 0, OuterStride<> > OtherRef;
+
+  packed_product_func(const PackedMatrix<Scalar,Side>& packed, const OtherRef& other, const Scalar& alpha)
+    : m_packed(packed), m_other(other), m_alpha(alpha)
+  {}
+
+  void operator()(Scalar* res, Index resStride) const
+  {
+    packed_gemm<Scalar,Side>::template run<OtherOrder>(m_packed, m_other.data(), m_other.outerStride(),
+                                                       Side==OnTheLeft ? m_other.cols() : m_other.rows(),
+                                                       res, resStride, m_alpha);
+  }
+
+  const PackedMatrix<Scalar,Side>& m_packed;
+  const OtherRef& m_other;
+  Scalar m_alpha;
+};
+
+template<typename Scalar, typename Rhs, int ProductTag>
+struct generic_product_impl<PackedMatrix<Scalar,OnTheLeft>, Rhs, PackedShape, DenseShape, ProductTag>
+  : generic_product_impl_base<PackedMatrix<Scalar,OnTheLeft>, Rhs, generic_product_impl<PackedMatrix<Scalar,OnTheLeft>, Rhs, PackedShape, DenseShape, ProductTag> >
+{
+  typedef PackedMatrix<Scalar,OnTheLeft> Lhs;
+  typedef packed_product_func<Scalar,OnTheLeft,Rhs> Func;
+
+  template<typename Dest>
+  static void scaleAndAddTo(Dest& dst, const Lhs& lhs, const Rhs& rhs, const Scalar& alpha)
+  {
+    EIGEN_STATIC_ASSERT((is_same<typename Rhs::Scalar,Scalar>::value),
+      YOU_MIXED_DIFFERENT_NUMERIC_TYPES__YOU_NEED_TO_USE_THE_CAST_METHOD_OF_MATRIXBASE_TO_CAST_NUMERIC_TYPES_EXPLICITLY)
+    eigen_assert(dst.rows()==lhs.rows() && dst.cols()==rhs.cols());
+    typename Func::OtherRef actualRhs(rhs);
+    packed_product_dest<Dest>::run(dst, Func(lhs, actualRhs, alpha));
+  }
+};
+
+template<typename Lhs, typename Scalar, int ProductTag>
+struct generic_product_impl<Lhs, PackedMatrix<Scalar,OnTheRight>, DenseShape, PackedShape, ProductTag>
+  : generic_product_impl_base<Lhs, PackedMatrix<Scalar,OnTheRight>, generic_product_impl<Lhs, PackedMatrix<Scalar,OnTheRight>, DenseShape, PackedShape, ProductTag> >
+{
+  typedef PackedMatrix<Scalar,OnTheRight> Rhs;
+  typedef packed_product_func<Scalar,OnTheRight,Lhs> Func;
+
+  template<typename Dest>
+  static void scaleAndAddTo(Dest& dst, const Lhs& lhs, const Rhs& rhs, const Scalar& alpha)
+  {
+    EIGEN_STATIC_ASSERT((is_same<typename Lhs::Scalar,Scalar>::value),
+      YOU_MIXED_DIFFERENT_NUMERIC_TYPES__YOU_NEED_TO_USE_THE_CAST_METHOD_OF_MATRIXBASE_TO_CAST_NUMERIC_TYPES_EXPLICITLY)
+    eigen_assert(dst.rows()==lhs.rows() && dst.cols()==rhs.cols());
+    typename Func::OtherRef actualLhs(lhs);
+    packed_product_dest<Dest>::run(dst, Func(rhs, actualLhs, alpha));
+  }
+};
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+#endif // EIGEN_PACKED_MATRIX_H
@@ -14,10 +14,26 @@
 #include <atomic>
 #endif
 
+#if defined(EIGEN_GEMM_THREADPOOL) && !EIGEN_HAS_CXX11_ATOMIC
+#error EIGEN_GEMM_THREADPOOL requires C++11 atomics
+#endif
+
 namespace Eigen {
 
 namespace internal {
 
+#ifdef EIGEN_GEMM_THREADPOOL
+/** \internal */
+inline ThreadPoolInterface* manage_gemm_thread_pool(Action action, ThreadPoolInterface* pool)
+{
+  static std::atomic<ThreadPoolInterface*> m_pool(0);
+  if(action==SetAction)
+    return m_pool.exchange(pool);
+  eigen_internal_assert(action==GetAction);
+  return m_pool.load();
+}
+#endif
+
 /** \internal */
 inline void manage_multi_threading(Action action, int* v)
 {
@@ -32,6 +48,13 @@ inline void manage_multi_threading(Action action, int* v)
   else if(action==GetAction)
   {
     eigen_internal_assert(v!=0);
+    #ifdef EIGEN_GEMM_THREADPOOL
+    if(ThreadPoolInterface* pool = manage_gemm_thread_pool(GetAction, 0))
+    {
+      *v = m_maxThreads>0 ? (std::min)(m_maxThreads, pool->NumThreads()) : pool->NumThreads();
+      return;
+    }
+    #endif
     #ifdef EIGEN_HAS_OPENMP
     if(m_maxThreads>0)
       *v = m_maxThreads;
@@ -74,8 +97,179 @@ inline void setNbThreads(int v)
   internal::manage_multi_threading(SetAction, &v);
 }
 
+#ifdef EIGEN_GEMM_THREADPOOL
+/** Registers \a pool as the executor of Eigen's parallel products, and returns the previously registered one.
+  *
+  * Any ThreadPoolInterface can be used, typically an Eigen::ThreadPool. Passing a null pointer restores
+  * the default behavior (OpenMP if enabled, sequential otherwise). While a pool is registered, nbThreads()
+  * is bounded by its number of threads, and products issued from within its own threads are parallelized too.
+  * The pool must outlive all the products running on it.
+  *
+  * This function is only available when EIGEN_GEMM_THREADPOOL is defined before including Eigen.
+  *
+  * \sa getGemmThreadPool(), setNbThreads() */
+inline ThreadPoolInterface* setGemmThreadPool(ThreadPoolInterface* pool)
+{
+  return internal::manage_gemm_thread_pool(SetAction, pool);
+}
+
+/** \returns the thread pool registered with setGemmThreadPool(), or a null pointer if there is none.
+  * \sa setGemmThreadPool() */
+inline ThreadPoolInterface* getGemmThreadPool()
+{
+  return internal::manage_gemm_thread_pool(GetAction, 0);
+}
+#endif
+
 namespace internal {
 
+#ifdef EIGEN_GEMM_THREADPOOL
+/** \internal Shared state of a parallel_run_tasks() call on a thread pool.
+  * Each worker owns a contiguous range of tasks, and steals the remaining tasks of the others once its own range
+  * is exhausted. This preserves locality between consecutive tasks while balancing the load dynamically.
+  * The state is reference counted because workers that start after all the tasks have been claimed
+  * may still access it after the caller returned. */
+struct parallel_tasks_state
+{
+  struct range
+  {
+    std::atomic<Index> next;
+    Index end;
+    char padding[64];  // keep the ranges of different workers on different cache lines
+  };
+
+  parallel_tasks_state(Index numTasks, Index workers)
+    : ranges(new range[workers]), numWorkers(workers), remaining(numTasks)
+  {
+    for(Index w=0; w<workers; ++w)
+    {
+      ranges[w].next = (w*numTasks)/workers;
+      ranges[w].end = ((w+1)*numTasks)/workers;
+    }
+  }
+
+  std::unique_ptr<range[]> ranges;
+  const Index numWorkers;
+  std::atomic<Index> remaining;
+  std::mutex mutex;
+  std::condition_variable cond;
+};
+
+/** \internal Runs the tasks of \a worker, then steals from the other workers until no task is left.
+  * \returns true if the calling thread completed the last task. */
+template<typename Task>
+bool parallel_tasks_work(parallel_tasks_state& state, Index worker, const Task& task)
+{
+  bool last = false;
+  for(Index k=0; k<state.numWorkers; ++k)
+  {
+    parallel_tasks_state::range& r = state.ranges[(worker+k)%state.numWorkers];
+    for(Index i=r.next++; i<r.end; i=r.next++)
+    {
+      task(i);
+      last = (--state.remaining == 0);
+    }
+  }
+  return last;
+}
+#endif
+
+/** \internal
+  * Runs \a task(i) for each i in [0,numTasks) using at most \a threads threads, the calling one included,
+  * and returns once all tasks completed. Each thread first processes a contiguous range of tasks, and idle
+  * threads steal the pending tasks of the others. Tasks must therefore not wait on each other.
+  *
+  * The work goes to the pool registered with setGemmThreadPool() if any, to OpenMP otherwise, and runs
+  * sequentially if neither is available. Since the calling thread keeps working until no task is left,
+  * it is safe to call this function from one of the pool's own threads.
+  */
+template<typename Task>
+void parallel_run_tasks(Index numTasks, Index threads, const Task& task)
+{
+  threads = (std::min)(threads, numTasks);
+#ifdef EIGEN_GEMM_THREADPOOL
+  ThreadPoolInterface* pool = getGemmThreadPool();
+  if(pool && threads>1)
+  {
+    std::shared_ptr<parallel_tasks_state> state = std::make_shared<parallel_tasks_state>(numTasks, threads);
+    const Task* task_ptr = &task;
+    for(Index t=1; t<threads; ++t)
+    {
+      pool->Schedule([state, task_ptr, t]() {
+        if(parallel_tasks_work(*state, t, *task_ptr))
+        {
+          std::unique_lock<std::mutex> lock(state->mutex);
+          state->cond.notify_all();
+        }
+      });
+    }
+    parallel_tasks_work(*state, 0, task);
+    std::unique_lock<std::mutex> lock(state->mutex);
+    while(state->remaining.load() != 0)
+      state->cond.wait(lock);
+    return;
+  }
+#endif
+#ifdef EIGEN_HAS_OPENMP
+  if(threads>1)
+  {
+    #pragma omp parallel for schedule(dynamic,1) num_threads(threads)
+    for(Index i=0; i<numTasks; ++i)
+      task(i);
+    return;
+  }
+#endif
+  EIGEN_UNUSED_VARIABLE(threads);
+  for(Index i=0; i<numTasks; ++i)
+    task(i);
+}
+
+/** \internal Computes the tiling of a parallel product of size \a rows x \a cols, where \a rows and \a cols
+  * are expressed with respect to the column-major kernel. Tiles are multiples of the mr x nr register blocks,
+  * as square as possible to balance the packing of both operands, and numerous enough to balance the load
+  * between \a threads threads. Tall-skinny and short-wide products are thus split along their large dimension.
+  */
+template<typename Index>
+void gemm_tile_sizes(Index rows, Index cols, Index threads, Index mr, Index nr, Index& tileRows, Index& tileCols)
+{
+  const Index tilesPerThread = 4;
+  const Index minTileRows = 4*mr;
+  const Index minTileCols = 4*nr;
+  double area = (double(rows) * double(cols)) / double(threads*tilesPerThread);
+  double side = std::sqrt(area);
+  double tr, tc;
+  if(side >= double(cols))      { tc = double(cols); tr = area / tc; }
+  else if(side >= double(rows)) { tr = double(rows); tc = area / tr; }
+  else                          { tr = side; tc = side; }
+  tileRows = (std::max)(minTileRows, ((Index(tr) + mr - 1) / mr) * mr);
+  tileCols = (std::max)(minTileCols, ((Index(tc) + nr - 1) / nr) * nr);
+  tileRows = (std::min)(tileRows, rows);
+  tileCols = (std::min)(tileCols, cols);
+}
+
+/** \internal Evaluates one tile of a parallel product, see parallelize_gemm().
+  * Tiles are numbered column by column, so that consecutive tiles share the same columns of the rhs. */
+template<typename Functor, typename Index>
+struct gemm_tile_task
+{
+  gemm_tile_task(const Functor& func, Index rows, Index cols, Index tileRows, Index tileCols)
+    : m_func(func), m_rows(rows), m_cols(cols), m_tileRows(tileRows), m_tileCols(tileCols),
+      m_numTileRows((rows + tileRows - 1) / tileRows)
+  {}
+
+  Index numTiles() const { return m_numTileRows * ((m_cols + m_tileCols - 1) / m_tileCols); }
+
+  void operator()(Index t) const
+  {
+    Index r0 = (t % m_numTileRows) * m_tileRows;
+    Index c0 = (t / m_numTileRows) * m_tileCols;
+    m_func.evalBlock(r0, (std::min)(m_tileRows, m_rows-r0), c0, (std::min)(m_tileCols, m_cols-c0));
+  }
+
+  const Functor& m_func;
+  Index m_rows, m_cols, m_tileRows, m_tileCols, m_numTileRows;
+};
+
 template<typename Index> struct GemmParallelInfo
 {
   GemmParallelInfo() : sync(-1), users(0), lhs_start(0), lhs_length(0) {}
@@ -104,7 +298,7 @@ void parallelize_gemm(const Functor& func, Index rows, Index cols, Index depth,
   // Without C++11, we have to disable GEMM's parallelization on
   // non x86 architectures because there volatile is not enough for our purpose.
   // See bug 1572.
-#if (! defined(EIGEN_HAS_OPENMP)) || defined(EIGEN_USE_BLAS) || ((!EIGEN_HAS_CXX11_ATOMIC) && !(EIGEN_ARCH_i386_OR_x86_64))
+#if ((! defined(EIGEN_HAS_OPENMP)) && (! defined(EIGEN_GEMM_THREADPOOL))) || defined(EIGEN_USE_BLAS) || ((!EIGEN_HAS_CXX11_ATOMIC) && !(EIGEN_ARCH_i386_OR_x86_64))
   // FIXME the transpose variable is only needed to properly split
   // the matrix product when multithreading is enabled. This is a temporary
   // fix to support row-major destination matrices. This whole
@@ -120,10 +314,23 @@ void parallelize_gemm(const Functor& func, Index rows, Index cols, Index depth,
   // - we are not already in a parallel code
   // - the sizes are large enough
 
+  const Index mr = Functor::Traits::mr;
+  const Index nr = Functor::Traits::nr;
+
+  // The default strategy splits the columns of the (column-major) result between the threads, which cooperatively
+  // pack the lhs. This is inefficient when the number of columns is small compared to the number of rows:
+  // in that case, or when running on a thread pool, the result is split into independent 2D tiles instead.
+  Index size = transpose ? rows : cols;
+  Index otherSize = transpose ? cols : rows;
+  bool useTiles = otherSize > 4*size;
+#ifdef EIGEN_GEMM_THREADPOOL
+  useTiles = useTiles || getGemmThreadPool()!=0;
+#endif
+
   // compute the maximal number of threads from the size of the product:
   // This first heuristic takes into account that the product kernel is fully optimized when working with nr columns at once.
-  Index size = transpose ? rows : cols;
-  Index pb_max_threads = std::max<Index>(1,size / Functor::Traits::nr);
+  Index pb_max_threads = useTiles ? std::max<Index>(1, (otherSize/(4*mr)) * (size/nr))
+                                  : std::max<Index>(1, size / nr);
 
   // compute the maximal number of threads from the total amount of work:
   double work = static_cast<double>(rows) * static_cast<double>(cols) *
@@ -134,12 +341,36 @@ void parallelize_gemm(const Functor& func, Index rows, Index cols, Index depth,
   // compute the number of threads we are going to use
   Index threads = std::min<Index>(nbThreads(), pb_max_threads);
 
-  // if multi-threading is explicitly disabled, not useful, or if we already are in a parallel session,
-  // then abort multi-threading
+  // if multi-threading is explicitly disabled or not useful, then abort multi-threading
+  if((!Condition) || (threads==1))
+    return func(0,rows, 0,cols);
+
+#ifdef EIGEN_HAS_OPENMP
+  // if we already are in a parallel session, then abort multi-threading
   // FIXME omp_get_num_threads()>1 only works for openmp, what if the user does not use openmp?
-  if((!Condition) || (threads==1) || (omp_get_num_threads()>1))
+  bool nested = omp_get_num_threads()>1;
+#ifdef EIGEN_GEMM_THREADPOOL
+  nested = nested && getGemmThreadPool()==0;
+#endif
+  if(nested)
     return func(0,rows, 0,cols);
+#endif
+
+  if(useTiles)
+  {
+    // Each tile is evaluated with its own packing buffers. Since the tiles are fully independent, they can be
+    // balanced dynamically, and do not even need to run concurrently, which makes it safe to share a thread pool
+    // with other work, including other products and nested calls.
+    Index tileRows, tileCols;
+    gemm_tile_sizes(otherSize, size, threads, mr, nr, tileRows, tileCols);
+    if(transpose)
+      std::swap(tileRows, tileCols);
+    gemm_tile_task<Functor,Index> task(func, rows, cols, tileRows, tileCols);
+    parallel_run_tasks(task.numTiles(), threads, task);
+    return;
+  }
 
+#ifdef EIGEN_HAS_OPENMP
   Eigen::initParallel();
   func.initParallelSession(threads);
 
@@ -154,15 +385,14 @@ void parallelize_gemm(const Functor& func, Index rows, Index cols, Index depth,
     // Note that the actual number of threads might be lower than the number of request ones.
     Index actual_threads = omp_get_num_threads();
 
-    Index blockCols = (cols / actual_threads) & ~Index(0x3);
-    Index blockRows = (rows / actual_threads);
-    blockRows = (blockRows/Functor::Traits::mr)*Functor::Traits::mr;
-
-    Index r0 = i*blockRows;
-    Index actualBlockRows = (i+1==actual_threads) ? rows-r0 : blockRows;
+    // Spread the remainders over all the threads rather than giving them all to the last one.
+    Index r0 = ((i*rows)/actual_threads/mr)*mr;
+    Index r1 = (i+1==actual_threads) ? rows : (((i+1)*rows)/actual_threads/mr)*mr;
+    Index actualBlockRows = r1-r0;
 
-    Index c0 = i*blockCols;
-    Index actualBlockCols = (i+1==actual_threads) ? cols-c0 : blockCols;
+    Index c0 = ((i*cols)/actual_threads) & ~Index(0x3);
+    Index c1 = (i+1==actual_threads) ? cols : (((i+1)*cols)/actual_threads) & ~Index(0x3);
+    Index actualBlockCols = c1-c0;
 
     info[i].lhs_start = r0;
     info[i].lhs_length = actualBlockRows;
@@ -170,6 +400,9 @@ void parallelize_gemm(const Functor& func, Index rows, Index cols, Index depth,
     if(transpose) func(c0, actualBlockCols, 0, rows, info);
     else          func(0, rows, c0, actualBlockCols, info);
   }
+#else
+  func(0,rows, 0,cols);
+#endif // EIGEN_HAS_OPENMP
 #endif
 }
 
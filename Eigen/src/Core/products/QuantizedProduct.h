@@ -0,0 +1,442 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_QUANTIZED_PRODUCT_H
+#define EIGEN_QUANTIZED_PRODUCT_H
+
+namespace Eigen {
+
+namespace internal {
+
+/* Products of 8-bit or 16-bit integer matrices accumulated into 32-bit integers.
+ *
+ * The operands are packed as pairs of consecutive coefficients along the depth: each 32-bit integer of the packed
+ * blocks holds two signed 16-bit integers (the first one in the low bits), so that one pmadd_pairs
+ * (pmaddwd, or vpdpwssd with AVX512-VNNI) multiplies and accumulates two steps of the depth at once, without any
+ * intermediate saturation. The products of uint8 by int8 coefficients (pmaddubsw) are faster, but saturate to
+ * 16 bits, which is not acceptable for a general purpose product.
+ *
+ * The lhs is packed into panels of mr rows, stored pair by pair, the rhs column by column. The micro kernel
+ * computes mr x nr blocks of the result with 2*nr packet accumulators.
+ */
+
+/** \internal \returns whether \a T is one of the scalar types supported by the quantized product kernels */
+template<typename T> struct is_quantized_scalar { enum { value = false }; };
+template<> struct is_quantized_scalar<signed char> { enum { value = true }; };
+template<> struct is_quantized_scalar<unsigned char> { enum { value = true }; };
+template<> struct is_quantized_scalar<short> { enum { value = true }; };
+
+struct quantized_gemm_traits
+{
+#if defined(EIGEN_VECTORIZE_AVX512)
+  typedef Packet16i Packet;
+#elif defined(EIGEN_VECTORIZE_AVX)
+  typedef Packet8i Packet;
+#elif defined(EIGEN_VECTORIZE_SSE2)
+  typedef Packet4i Packet;
+#else
+  typedef int Packet;
+#endif
+  enum {
+    PacketSize = unpacket_traits<Packet>::size,
+    mr = 2*PacketSize,
+    nr = 4
+  };
+
+  static EIGEN_STRONG_INLINE int pack_pair(int a0, int a1)
+  {
+    return int((unsigned(a0) & 0xffffu) | (unsigned(a1) << 16));
+  }
+
+  // number of 32-bit integers of packed lhs and rhs blocks
+  static Index lhsBlockSize(Index rows, Index depth) { return ((rows+mr-1)/mr)*mr * ((depth+1)/2); }
+  static Index rhsBlockSize(Index depth, Index cols) { return cols * ((depth+1)/2); }
+};
+
+template<typename Scalar, typename Index, typename DataMapper>
+struct quantized_gemm_pack_lhs
+{
+  EIGEN_DONT_INLINE void operator()(int* blockA, const DataMapper& lhs, Index depth, Index rows) const;
+};
+
+template<typename Scalar, typename Index, typename DataMapper>
+EIGEN_DONT_INLINE void quantized_gemm_pack_lhs<Scalar,Index,DataMapper>
+  ::operator()(int* blockA, const DataMapper& lhs, Index depth, Index rows) const
+{
+  typedef quantized_gemm_traits Traits;
+  const Index mr = Traits::mr;
+  const Index pairs = depth/2;
+  for(Index i0=0; i0<rows; i0+=mr)
+  {
+    const Index actual_mr = (std::min)(mr, rows-i0);
+    for(Index p=0; p<pairs; ++p)
+    {
+      for(Index i=0; i<actual_mr; ++i)
+        blockA[i] = Traits::pack_pair(int(lhs(i0+i,2*p)), int(lhs(i0+i,2*p+1)));
+      for(Index i=actual_mr; i<mr; ++i)
+        blockA[i] = 0;
+      blockA += mr;
+    }
+    if(depth%2)
+    {
+      for(Index i=0; i<actual_mr; ++i)
+        blockA[i] = Traits::pack_pair(int(lhs(i0+i,depth-1)), 0);
+      for(Index i=actual_mr; i<mr; ++i)
+        blockA[i] = 0;
+      blockA += mr;
+    }
+  }
+}
+
+template<typename Scalar, typename Index, typename DataMapper>
+struct quantized_gemm_pack_rhs
+{
+  EIGEN_DONT_INLINE void operator()(int* blockB, const DataMapper& rhs, Index depth, Index cols) const;
+};
+
+template<typename Scalar, typename Index, typename DataMapper>
+EIGEN_DONT_INLINE void quantized_gemm_pack_rhs<Scalar,Index,DataMapper>
+  ::operator()(int* blockB, const DataMapper& rhs, Index depth, Index cols) const
+{
+  typedef quantized_gemm_traits Traits;
+  for(Index j=0; j<cols; ++j)
+  {
+    Index k=0;
+    for(; k+1<depth; k+=2)
+      *blockB++ = Traits::pack_pair(int(rhs(k,j)), int(rhs(k+1,j)));
+    if(k<depth)
+      *blockB++ = Traits::pack_pair(int(rhs(k,j)), 0);
+  }
+}
+
+/* Adds the product of the packed blocks blockA (rows x depth) and blockB (depth x cols) to res, which must be a
+ * column-major mapper of 32-bit integers. */
+template<typename Index, typename DataMapper>
+struct quantized_gebp_kernel
+{
+  typedef quantized_gemm_traits Traits;
+  typedef Traits::Packet Packet;
+  enum { PacketSize = Traits::PacketSize, mr = Traits::mr, nr = Traits::nr };
+
+  static EIGEN_STRONG_INLINE void store(const DataMapper& res, Index i, Index j, Index actual_mr, const Packet& c0, const Packet& c1)
+  {
+    int* r = &res(i,j);
+    if(actual_mr==mr)
+    {
+      pstoreu(r, padd(ploadu<Packet>(r), c0));
+      pstoreu(r+PacketSize, padd(ploadu<Packet>(r+PacketSize), c1));
+    }
+    else
+    {
+      EIGEN_ALIGN_MAX int tmp[mr];
+      pstore(tmp, c0);
+      pstore(tmp+PacketSize, c1);
+      for(Index k=0; k<actual_mr; ++k)
+        r[k] += tmp[k];
+    }
+  }
+
+  EIGEN_DONT_INLINE void operator()(const DataMapper& res, const int* blockA, const int* blockB, Index rows, Index depth, Index cols) const;
+};
+
+template<typename Index, typename DataMapper>
+EIGEN_DONT_INLINE void quantized_gebp_kernel<Index,DataMapper>
+  ::operator()(const DataMapper& res, const int* blockA, const int* blockB, Index rows, Index depth, Index cols) const
+{
+  const Index pairs = (depth+1)/2;
+  const Packet zero = pset1<Packet>(0);
+  for(Index i0=0; i0<rows; i0+=mr)
+  {
+    const Index actual_mr = (std::min)(Index(mr), rows-i0);
+    const int* A = blockA + i0*pairs;
+    Index j0=0;
+    for(; j0+nr<=cols; j0+=nr)
+    {
+      const int* rhs0 = blockB + j0*pairs;
+      const int* rhs1 = rhs0 + pairs;
+      const int* rhs2 = rhs1 + pairs;
+      const int* rhs3 = rhs2 + pairs;
+      Packet c0 = zero, c1 = zero, c2 = zero, c3 = zero, c4 = zero, c5 = zero, c6 = zero, c7 = zero;
+      const int* a = A;
+      for(Index p=0; p<pairs; ++p, a+=mr)
+      {
+        Packet a0 = pload<Packet>(a);
+        Packet a1 = pload<Packet>(a+PacketSize);
+        Packet b = pset1<Packet>(rhs0[p]);
+        c0 = pmadd_pairs(a0, b, c0);
+        c1 = pmadd_pairs(a1, b, c1);
+        b = pset1<Packet>(rhs1[p]);
+        c2 = pmadd_pairs(a0, b, c2);
+        c3 = pmadd_pairs(a1, b, c3);
+        b = pset1<Packet>(rhs2[p]);
+        c4 = pmadd_pairs(a0, b, c4);
+        c5 = pmadd_pairs(a1, b, c5);
+        b = pset1<Packet>(rhs3[p]);
+        c6 = pmadd_pairs(a0, b, c6);
+        c7 = pmadd_pairs(a1, b, c7);
+      }
+      store(res, i0, j0+0, actual_mr, c0, c1);
+      store(res, i0, j0+1, actual_mr, c2, c3);
+      store(res, i0, j0+2, actual_mr, c4, c5);
+      store(res, i0, j0+3, actual_mr, c6, c7);
+    }
+    for(; j0<cols; ++j0)
+    {
+      const int* rhs0 = blockB + j0*pairs;
+      Packet c0 = zero, c1 = zero;
+      const int* a = A;
+      for(Index p=0; p<pairs; ++p, a+=mr)
+      {
+        Packet b = pset1<Packet>(rhs0[p]);
+        c0 = pmadd_pairs(pload<Packet>(a), b, c0);
+        c1 = pmadd_pairs(pload<Packet>(a+PacketSize), b, c1);
+      }
+      store(res, i0, j0, actual_mr, c0, c1);
+    }
+  }
+}
+
+/* Evaluates one mc x nc block of the result: the product is accumulated over the whole depth into a 32-bit integer
+ * buffer, which is then handed to the epilogue that writes it into the destination. The blocks are independent,
+ * and are distributed among the threads by parallel_run_tasks(). */
+template<typename LhsScalar, typename LhsMapper, typename RhsScalar, typename RhsMapper, typename Epilogue>
+struct quantized_gemm_task
+{
+  typedef quantized_gemm_traits Traits;
+  typedef Matrix<int,Dynamic,Dynamic> Accumulator;
+
+  quantized_gemm_task(const LhsMapper& lhs, const RhsMapper& rhs, Index rows, Index cols, Index depth,
+                      Index kc, Index mc, Index nc, const Epilogue& epilogue)
+    : m_lhs(lhs), m_rhs(rhs), m_rows(rows), m_cols(cols), m_depth(depth), m_kc(kc), m_mc(mc), m_nc(nc),
+      m_rowBlocks((rows+mc-1)/mc), m_epilogue(epilogue)
+  {}
+
+  Index numTasks() const { return m_rowBlocks * ((m_cols+m_nc-1)/m_nc); }
+
+  void operator()(Index t) const
+  {
+    const Index i2 = (t%m_rowBlocks)*m_mc;
+    const Index j2 = (t/m_rowBlocks)*m_nc;
+    const Index actual_mc = (std::min)(i2+m_mc,m_rows)-i2;
+    const Index actual_nc = (std::min)(j2+m_nc,m_cols)-j2;
+
+    std::size_t sizeA = Traits::lhsBlockSize(actual_mc, m_kc);
+    std::size_t sizeB = Traits::rhsBlockSize(m_kc, actual_nc);
+    ei_declare_aligned_stack_constructed_variable(int, blockA, sizeA, 0);
+    ei_declare_aligned_stack_constructed_variable(int, blockB, sizeB, 0);
+
+    Accumulator acc = Accumulator::Zero(actual_mc, actual_nc);
+    blas_data_mapper<int,Index,ColMajor> accMapper(acc.data(), acc.outerStride());
+    quantized_gemm_pack_lhs<LhsScalar,Index,LhsMapper> pack_lhs;
+    quantized_gemm_pack_rhs<RhsScalar,Index,RhsMapper> pack_rhs;
+    quantized_gebp_kernel<Index,blas_data_mapper<int,Index,ColMajor> > gebp;
+
+    for(Index k2=0; k2<m_depth; k2+=m_kc)
+    {
+      const Index actual_kc = (std::min)(k2+m_kc,m_depth)-k2;
+      pack_lhs(blockA, m_lhs.getSubMapper(i2,k2), actual_kc, actual_mc);
+      pack_rhs(blockB, m_rhs.getSubMapper(k2,j2), actual_kc, actual_nc);
+      gebp(accMapper, blockA, blockB, actual_mc, actual_kc, actual_nc);
+    }
+
+    m_epilogue(acc, i2, j2);
+  }
+
+  LhsMapper m_lhs;
+  RhsMapper m_rhs;
+  Index m_rows, m_cols, m_depth, m_kc, m_mc, m_nc, m_rowBlocks;
+  const Epilogue& m_epilogue;
+};
+
+template<typename LhsScalar, typename LhsMapper, typename RhsScalar, typename RhsMapper, typename Epilogue>
+void quantized_gemm(const LhsMapper& lhs, const RhsMapper& rhs, Index rows, Index cols, Index depth, const Epilogue& epilogue)
+{
+  typedef quantized_gemm_traits Traits;
+  if(rows==0 || cols==0)
+    return;
+
+  // the depth is blocked in pairs of coefficients, which take the room of one 32-bit integer in the packed blocks
+  Index kc = (depth+1)/2;
+  Index mc = rows;
+  Index nc = cols;
+  computeProductBlockingSizes<int,int>(kc, mc, nc);
+  kc = (std::max)(Index(1),kc) * 2;
+
+  double work = double(rows) * double(cols) * double(depth);
+  const double kMinTaskSize = 50000;
+  Index threads = (std::min)(Index(nbThreads()), (std::max)(Index(1), Index(work/kMinTaskSize)));
+  // make sure there are enough blocks to keep all the threads busy
+  if(threads>1 && ((rows+mc-1)/mc) * ((cols+nc-1)/nc) < threads)
+  {
+    Index rowBlocks = (std::min)(threads, (rows+Traits::mr-1)/Traits::mr);
+    mc = ((rows/rowBlocks + Traits::mr-1)/Traits::mr)*Traits::mr;
+    Index colBlocks = (threads+rowBlocks-1)/rowBlocks;
+    nc = (std::max)(Index(Traits::nr), ((cols/colBlocks + Traits::nr-1)/Traits::nr)*Traits::nr);
+  }
+
+  quantized_gemm_task<LhsScalar,LhsMapper,RhsScalar,RhsMapper,Epilogue> task(lhs, rhs, rows, cols, depth, kc, mc, nc, epilogue);
+  parallel_run_tasks(task.numTasks(), threads, task);
+}
+
+// Copies the 32-bit integer accumulators to the destination.
+template<typename Dst>
+struct quantized_assign_epilogue
+{
+  quantized_assign_epilogue(Dst& dst) : m_dst(dst) {}
+
+  void operator()(const Matrix<int,Dynamic,Dynamic>& acc, Index i, Index j) const
+  {
+    m_dst.block(i, j, acc.rows(), acc.cols()) = acc;
+  }
+
+  Dst& m_dst;
+};
+
+/* Applies the zero points and the scales of the quantized operands to the 32-bit integer accumulators:
+ *   dst(i,j) = lhsScale(i) * rhsScale(j) * sum_k (lhs(i,k)-lhsZero(i)) * (rhs(k,j)-rhsZero(j))
+ *            = lhsScale(i) * rhsScale(j) * (acc(i,j) - rhsZero(j)*lhsRowSum(i) - lhsZero(i)*rhsColSum(j) + depth*lhsZero(i)*rhsZero(j))
+ */
+template<typename Dst>
+struct quantized_dequantize_epilogue
+{
+  typedef typename Dst::Scalar Scalar;
+
+  quantized_dequantize_epilogue(Dst& dst, Index depth,
+                                const Ref<const VectorXi>& lhsZeroPoints, const Ref<const Matrix<Scalar,Dynamic,1> >& lhsScales, const VectorXi& lhsRowSums,
+                                const Ref<const RowVectorXi>& rhsZeroPoints, const Ref<const Matrix<Scalar,1,Dynamic> >& rhsScales, const RowVectorXi& rhsColSums)
+    : m_dst(dst), m_depth(int(depth)),
+      m_lhsZeroPoints(lhsZeroPoints), m_lhsScales(lhsScales), m_lhsRowSums(lhsRowSums),
+      m_rhsZeroPoints(rhsZeroPoints), m_rhsScales(rhsScales), m_rhsColSums(rhsColSums)
+  {}
+
+  void operator()(const Matrix<int,Dynamic,Dynamic>& acc, Index i, Index j) const
+  {
+    const Index rows = acc.rows();
+    for(Index c=0; c<acc.cols(); ++c)
+    {
+      const int zb = m_rhsZeroPoints(j+c);
+      m_dst.col(j+c).segment(i, rows) =
+          (acc.col(c) - zb * m_lhsRowSums.segment(i, rows) + (m_depth*zb - m_rhsColSums(j+c)) * m_lhsZeroPoints.segment(i, rows))
+          .template cast<Scalar>().cwiseProduct(m_lhsScales.segment(i, rows)) * m_rhsScales(j+c);
+    }
+  }
+
+  Dst& m_dst;
+  int m_depth;
+  const Ref<const VectorXi>& m_lhsZeroPoints;
+  const Ref<const Matrix<Scalar,Dynamic,1> >& m_lhsScales;
+  const VectorXi& m_lhsRowSums;
+  const Ref<const RowVectorXi>& m_rhsZeroPoints;
+  const Ref<const Matrix<Scalar,1,Dynamic> >& m_rhsScales;
+  const RowVectorXi& m_rhsColSums;
+};
+
+template<typename Lhs, typename Rhs, typename Dst, typename Epilogue>
+void quantized_product_impl(const Lhs& lhs, const Rhs& rhs, Dst& dst, const Epilogue& epilogue)
+{
+  typedef typename Lhs::Scalar LhsScalar;
+  typedef typename Rhs::Scalar RhsScalar;
+  EIGEN_STATIC_ASSERT(is_quantized_scalar<LhsScalar>::value && is_quantized_scalar<RhsScalar>::value,
+                      THIS_TYPE_IS_NOT_SUPPORTED)
+  EIGEN_UNUSED_VARIABLE(dst);
+  enum {
+    LhsOrder = Lhs::IsRowMajor ? RowMajor : ColMajor,
+    RhsOrder = Rhs::IsRowMajor ? RowMajor : ColMajor
+  };
+  // the kernels read the operands through their data pointer and outer stride
+  Ref<const Matrix<LhsScalar,Dynamic,Dynamic,LhsOrder>, 0, OuterStride<> > actualLhs(lhs);
+  Ref<const Matrix<RhsScalar,Dynamic,Dynamic,RhsOrder>, 0, OuterStride<> > actualRhs(rhs);
+  typedef const_blas_data_mapper<LhsScalar,Index,LhsOrder> LhsMapper;
+  typedef const_blas_data_mapper<RhsScalar,Index,RhsOrder> RhsMapper;
+  quantized_gemm<LhsScalar,LhsMapper,RhsScalar,RhsMapper>(LhsMapper(actualLhs.data(), actualLhs.outerStride()),
+                                                          RhsMapper(actualRhs.data(), actualRhs.outerStride()),
+                                                          lhs.rows(), rhs.cols(), lhs.cols(), epilogue);
+}
+
+} // end namespace internal
+
+/** \ingroup Core_Module
+  *
+  * Computes the product \a dst = \a lhs * \a rhs of two 8-bit or 16-bit integer matrices, with 32-bit integer
+  * accumulation.
+  *
+  * \a lhs and \a rhs can be any combination of \c int8_t (\c signed \c char), \c uint8_t (\c unsigned \c char), and
+  * \c int16_t (\c short) matrix expressions, and \a dst must be a matrix of \c int. The regular operator* cannot be
+  * used for such products, since its result has the scalar type of its operands and would overflow.
+  *
+  * The operands are widened to 16 bits while being packed, and pairs of consecutive products along the depth are
+  * computed and summed by a single instruction (\c pmaddwd with SSE2 and AVX2, \c vpdpwssd with AVX512-VNNI).
+  * The accumulation is exact as long as the result fits into 32 bits, which is always the case for 8-bit operands
+  * and depths smaller than 2^16. Large products are split among the threads of the parallel products, see nbThreads().
+  *
+  * \sa quantized_product(const MatrixBase<Lhs>&, const MatrixBase<Rhs>&, const MatrixBase<Dst>&, const Ref<const VectorXi>&, const Ref<const Matrix<typename Dst::Scalar,Dynamic,1> >&, const Ref<const RowVectorXi>&, const Ref<const Matrix<typename Dst::Scalar,1,Dynamic> >&)
+  */
+template<typename Lhs, typename Rhs, typename Dst>
+void quantized_product(const MatrixBase<Lhs>& lhs, const MatrixBase<Rhs>& rhs, const MatrixBase<Dst>& dst)
+{
+  EIGEN_STATIC_ASSERT((internal::is_same<typename Dst::Scalar,int>::value),
+                      YOU_MIXED_DIFFERENT_NUMERIC_TYPES__YOU_NEED_TO_USE_THE_CAST_METHOD_OF_MATRIXBASE_TO_CAST_NUMERIC_TYPES_EXPLICITLY)
+  eigen_assert(lhs.cols()==rhs.rows() && "invalid matrix product");
+  Dst& actualDst = dst.const_cast_derived();
+  actualDst.resize(lhs.rows(), rhs.cols());
+  if(lhs.cols()==0)
+  {
+    actualDst.setZero();
+    return;
+  }
+  internal::quantized_product_impl(lhs.derived(), rhs.derived(), actualDst, internal::quantized_assign_epilogue<Dst>(actualDst));
+}
+
+/** \ingroup Core_Module
+  *
+  * Computes the product of two quantized matrices and dequantizes it:
+  * \f[ dst(i,j) = s^{lhs}_i \, s^{rhs}_j \sum_k (lhs(i,k)-z^{lhs}_i)(rhs(k,j)-z^{rhs}_j) \f]
+  * where \f$ z^{lhs} \f$, \f$ s^{lhs} \f$ are the zero points and scales of the rows of \a lhs, and
+  * \f$ z^{rhs} \f$, \f$ s^{rhs} \f$ those of the columns of \a rhs. Per-tensor quantization parameters are
+  * represented by constant vectors.
+  *
+  * The product of the raw integers is accumulated in 32-bit integers as in quantized_product(const MatrixBase<Lhs>&, const MatrixBase<Rhs>&, const MatrixBase<Dst>&),
+  * and the zero points and the scales are applied while the accumulators are written into \a dst, which must be a
+  * \c float or \c double matrix. There is no intermediate integer matrix, and \a dst is written only once.
+  *
+  * Example: a linear layer whose uint8 activations are quantized per tensor, and whose int8 weights are quantized
+  * per output channel:
+  * \code
+  * Matrix<unsigned char,Dynamic,Dynamic> X;   // batch x in
+  * Matrix<signed char,Dynamic,Dynamic> W;     // in x out
+  * MatrixXf Y;
+  * quantized_product(X, W, Y, VectorXi::Constant(X.rows(),xZero), VectorXf::Constant(X.rows(),xScale),
+  *                   RowVectorXi::Zero(W.cols()), wScales);
+  * \endcode
+  */
+template<typename Lhs, typename Rhs, typename Dst>
+void quantized_product(const MatrixBase<Lhs>& lhs, const MatrixBase<Rhs>& rhs, const MatrixBase<Dst>& dst,
+                       const Ref<const VectorXi>& lhsZeroPoints, const Ref<const Matrix<typename Dst::Scalar,Dynamic,1> >& lhsScales,
+                       const Ref<const RowVectorXi>& rhsZeroPoints, const Ref<const Matrix<typename Dst::Scalar,1,Dynamic> >& rhsScales)
+{
+  EIGEN_STATIC_ASSERT(!NumTraits<typename Dst::Scalar>::IsInteger, THIS_FUNCTION_IS_NOT_FOR_INTEGER_NUMERIC_TYPES)
+  eigen_assert(lhs.cols()==rhs.rows() && "invalid matrix product");
+  eigen_assert(lhsZeroPoints.size()==lhs.rows() && lhsScales.size()==lhs.rows());
+  eigen_assert(rhsZeroPoints.size()==rhs.cols() && rhsScales.size()==rhs.cols());
+  Dst& actualDst = dst.const_cast_derived();
+  actualDst.resize(lhs.rows(), rhs.cols());
+  if(lhs.cols()==0)
+  {
+    actualDst.setZero();
+    return;
+  }
+  // the sums of the rows of lhs and of the columns of rhs carry the contribution of the zero points
+  VectorXi lhsRowSums = lhs.template cast<int>().rowwise().sum();
+  RowVectorXi rhsColSums = rhs.template cast<int>().colwise().sum();
+  internal::quantized_product_impl(lhs.derived(), rhs.derived(), actualDst,
+      internal::quantized_dequantize_epilogue<Dst>(actualDst, lhs.cols(), lhsZeroPoints, lhsScales, lhsRowSums,
+                                                   rhsZeroPoints, rhsScales, rhsColSums));
+}
+
+} // end namespace Eigen
+
+#endif // EIGEN_QUANTIZED_PRODUCT_H
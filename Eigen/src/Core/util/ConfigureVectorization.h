@@ -291,6 +291,12 @@
         #ifdef __AVX512DQ__
           #define EIGEN_VECTORIZE_AVX512DQ
         #endif
+        #ifdef __AVX512BW__
+          #define EIGEN_VECTORIZE_AVX512BW
+        #endif
+        #if defined(__AVX512BW__) && defined(__AVX512VNNI__)
+          #define EIGEN_VECTORIZE_AVX512VNNI
+        #endif
         #ifdef __AVX512ER__
           #define EIGEN_VECTORIZE_AVX512ER
         #endif
@@ -316,6 +322,12 @@
         #ifdef EIGEN_VECTORIZE_AVX512DQ
           #undef EIGEN_VECTORIZE_AVX512DQ
         #endif
+        #ifdef EIGEN_VECTORIZE_AVX512BW
+          #undef EIGEN_VECTORIZE_AVX512BW
+        #endif
+        #ifdef EIGEN_VECTORIZE_AVX512VNNI
+          #undef EIGEN_VECTORIZE_AVX512VNNI
+        #endif
         #ifdef EIGEN_VECTORIZE_AVX512ER
           #undef EIGEN_VECTORIZE_AVX512ER
         #endif
@@ -459,8 +471,12 @@ namespace Eigen {
 inline static const char *SimdInstructionSetsInUse(void) {
 #if defined(EIGEN_VECTORIZE_AVX512)
   return "AVX512, FMA, AVX2, AVX, SSE, SSE2, SSE3, SSSE3, SSE4.1, SSE4.2";
+#elif defined(EIGEN_VECTORIZE_AVX2) && defined(EIGEN_VECTORIZE_FMA)
+  return "AVX2, FMA, AVX, SSE, SSE2, SSE3, SSSE3, SSE4.1, SSE4.2";
+#elif defined(EIGEN_VECTORIZE_AVX2)
+  return "AVX2, AVX, SSE, SSE2, SSE3, SSSE3, SSE4.1, SSE4.2";
 #elif defined(EIGEN_VECTORIZE_AVX)
-  return "AVX SSE, SSE2, SSE3, SSSE3, SSE4.1, SSE4.2";
+  return "AVX, SSE, SSE2, SSE3, SSSE3, SSE4.1, SSE4.2";
 #elif defined(EIGEN_VECTORIZE_SSE4_2)
   return "SSE, SSE2, SSE3, SSSE3, SSE4.1, SSE4.2";
 #elif defined(EIGEN_VECTORIZE_SSE4_1)
@@ -291,7 +291,10 @@ enum TraversalType {
   /** \internal Special case to properly handle incompatible scalar types or other defecting cases*/
   InvalidTraversal,
   /** \internal Evaluate all entries at once */
-  AllAtOnceTraversal
+  AllAtOnceTraversal,
+  /** \internal No vectorization, traverse the destination by square tiles because the operands are not all
+    * stored in the same order */
+  TiledTraversal
 };
 
 /// 用于指定在遍历矩阵条目时是否展开循环。
@@ -523,6 +526,9 @@ struct PermutationStorage {};
 /** The type used to identify a permutation storage. */
 struct TranspositionsStorage {};
 
+/** The type used to identify a pre-packed matrix storage, see class PackedMatrix. */
+struct PackedStorage {};
+
 /** The type used to identify a matrix expression */
 struct MatrixXpr {};
 
@@ -540,6 +546,7 @@ struct SelfAdjointShape       { static std::string debugName() { return "SelfAdj
 struct PermutationShape       { static std::string debugName() { return "PermutationShape"; } };
 struct TranspositionsShape    { static std::string debugName() { return "TranspositionsShape"; } };
 struct SparseShape            { static std::string debugName() { return "SparseShape"; } };
+struct PackedShape            { static std::string debugName() { return "PackedShape"; } };
 
 namespace internal {
 
@@ -106,6 +106,7 @@ template<typename Derived> class PermutationBase;
 template<typename Derived> class TranspositionsBase;
 template<typename _IndicesType> class PermutationWrapper;
 template<typename _IndicesType> class TranspositionsWrapper;
+template<typename _Scalar, int _Side> class PackedMatrix;
 
 template<typename Derived,
          int Level = internal::accessors_level<Derived>::has_write_access ? WriteAccessors : ReadOnlyAccessors
@@ -1119,8 +1119,191 @@ inline int queryTopLevelCacheSize()
   return (std::max)(l2,l3);
 }
 
+//---------- SIMD instruction sets ----------
+
+/** \internal Bit flags of the SIMD instruction sets that can be detected at runtime. */
+enum SimdInstructionSet {
+  SimdSSE     = 0x1,
+  SimdSSE2    = 0x2,
+  SimdSSE3    = 0x4,
+  SimdSSSE3   = 0x8,
+  SimdSSE4_1  = 0x10,
+  SimdSSE4_2  = 0x20,
+  SimdAVX     = 0x40,
+  SimdFMA     = 0x80,
+  SimdAVX2    = 0x100,
+  SimdAVX512F = 0x200,
+  SimdAVX512DQ = 0x400,
+  SimdAVX512BW = 0x800,
+  SimdAVX512VNNI = 0x1000
+};
+
+/** \internal \returns the SIMD instruction sets enabled at compile time in the current translation unit,
+  * as a combination of SimdInstructionSet flags. */
+inline int compiledSimdInstructionSets()
+{
+  int flags = 0;
+#ifdef EIGEN_VECTORIZE_SSE
+  flags |= SimdSSE;
+#endif
+#ifdef EIGEN_VECTORIZE_SSE2
+  flags |= SimdSSE2;
+#endif
+#ifdef EIGEN_VECTORIZE_SSE3
+  flags |= SimdSSE3;
+#endif
+#ifdef EIGEN_VECTORIZE_SSSE3
+  flags |= SimdSSSE3;
+#endif
+#ifdef EIGEN_VECTORIZE_SSE4_1
+  flags |= SimdSSE4_1;
+#endif
+#ifdef EIGEN_VECTORIZE_SSE4_2
+  flags |= SimdSSE4_2;
+#endif
+#ifdef EIGEN_VECTORIZE_AVX
+  flags |= SimdAVX;
+#endif
+#ifdef EIGEN_VECTORIZE_FMA
+  flags |= SimdFMA;
+#endif
+#ifdef EIGEN_VECTORIZE_AVX2
+  flags |= SimdAVX2;
+#endif
+#ifdef EIGEN_VECTORIZE_AVX512
+  flags |= SimdAVX512F;
+#endif
+#ifdef EIGEN_VECTORIZE_AVX512DQ
+  flags |= SimdAVX512DQ;
+#endif
+#ifdef EIGEN_VECTORIZE_AVX512BW
+  flags |= SimdAVX512BW;
+#endif
+#ifdef EIGEN_VECTORIZE_AVX512VNNI
+  flags |= SimdAVX512VNNI;
+#endif
+  return flags;
+}
+
+#ifdef EIGEN_CPUID
+/** \internal \returns the content of the extended control register 0, i.e., the register states saved by the OS */
+inline unsigned int queryXCR0()
+{
+#if EIGEN_COMP_GNUC
+  unsigned int eax, edx;
+  // xgetbv is emitted as raw bytes so that it also assembles without -mxsave
+  __asm__ __volatile__ (".byte 0x0f, 0x01, 0xd0" : "=a" (eax), "=d" (edx) : "c" (0));
+  return eax;
+#elif EIGEN_COMP_MSVC >= 1600
+  return static_cast<unsigned int>(_xgetbv(0));
+#else
+  return 0;
+#endif
+}
+#endif
+
+/** \internal \returns the SIMD instruction sets supported by the CPU running the program and by its OS,
+  * as a combination of SimdInstructionSet flags, or -1 if they cannot be determined on this platform.
+  * The result is computed once and then cached. */
+inline int querySimdInstructionSets()
+{
+  #ifdef EIGEN_CPUID
+  static int flags = -1;
+  if(flags!=-1)
+    return flags;
+
+  int f = 0;
+  int abcd[4];
+  EIGEN_CPUID(abcd,0x0,0);
+  const int max_std_funcs = abcd[0];
+  if(max_std_funcs>=1)
+  {
+    EIGEN_CPUID(abcd,0x1,0);
+    const int ecx = abcd[2], edx = abcd[3];
+    if(edx & (1<<25)) f |= SimdSSE;
+    if(edx & (1<<26)) f |= SimdSSE2;
+    if(ecx & (1<<0))  f |= SimdSSE3;
+    if(ecx & (1<<9))  f |= SimdSSSE3;
+    if(ecx & (1<<19)) f |= SimdSSE4_1;
+    if(ecx & (1<<20)) f |= SimdSSE4_2;
+
+    // AVX requires the OS to save the ymm registers (OSXSAVE, then XCR0 bits 1 and 2)
+    const unsigned int xcr0 = (ecx & (1<<27)) ? queryXCR0() : 0u;
+    const bool os_avx = (xcr0 & 0x6) == 0x6;
+    const bool os_avx512 = (xcr0 & 0xe6) == 0xe6;
+    if(os_avx && (ecx & (1<<28)))
+    {
+      f |= SimdAVX;
+      if(ecx & (1<<12)) f |= SimdFMA;
+      if(max_std_funcs>=7)
+      {
+        EIGEN_CPUID(abcd,0x7,0);
+        const int ebx = abcd[1], ecx7 = abcd[2];
+        if(ebx & (1<<5)) f |= SimdAVX2;
+        if(os_avx512 && (ebx & (1<<16)))
+        {
+          f |= SimdAVX512F;
+          if(ebx & (1<<17)) f |= SimdAVX512DQ;
+          if(ebx & (1<<30)) f |= SimdAVX512BW;
+          if(ecx7 & (1<<11)) f |= SimdAVX512VNNI;
+        }
+      }
+    }
+  }
+  flags = f;
+  return flags;
+  #else
+  return -1;
+  #endif
+}
+
+/** \internal \returns a comma separated list of the instruction sets in \a flags */
+inline std::string simdInstructionSetsToString(int flags)
+{
+  static const char* const names[] = { "SSE", "SSE2", "SSE3", "SSSE3", "SSE4.1", "SSE4.2", "AVX", "FMA", "AVX2", "AVX512", "AVX512DQ", "AVX512BW", "AVX512VNNI" };
+  std::string res;
+  for(int i=0; i<int(sizeof(names)/sizeof(names[0])); ++i)
+  {
+    if(flags & (1<<i))
+    {
+      if(!res.empty())
+        res += ", ";
+      res += names[i];
+    }
+  }
+  return res.empty() ? std::string("None") : res;
+}
+
 } // end namespace internal
 
+/** \returns the list of the SIMD instruction sets supported by the CPU running the program, as detected at runtime,
+  * or "Unknown" if they cannot be detected on this platform.
+  *
+  * Contrary to SimdInstructionSetsInUse(), which reports the instruction sets %Eigen has been compiled for in the
+  * current translation unit, this function queries the CPU (and checks that the OS saves the corresponding
+  * registers). It is typically used to select, at startup, which of several versions of a kernel compiled with
+  * different instruction sets can be run, see \ref TopicVectorization_Dispatch "this page".
+  *
+  * Only x86 CPUs are inspected for now.
+  *
+  * \sa SimdInstructionSetsInUse(), SimdInstructionSetsInUseAreSupported() */
+inline std::string SimdInstructionSetsSupported()
+{
+  int flags = internal::querySimdInstructionSets();
+  return flags==-1 ? std::string("Unknown") : internal::simdInstructionSetsToString(flags);
+}
+
+/** \returns whether the CPU running the program supports all the SIMD instruction sets used by %Eigen in the
+  * current translation unit. The answer is \c true when the CPU features cannot be detected.
+  *
+  * \sa SimdInstructionSetsInUse(), SimdInstructionSetsSupported() */
+inline bool SimdInstructionSetsInUseAreSupported()
+{
+  int supported = internal::querySimdInstructionSets();
+  int used = internal::compiledSimdInstructionSets();
+  return supported==-1 || (used & ~supported)==0;
+}
+
 } // end namespace Eigen
 
 #endif // EIGEN_MEMORY_H
@@ -739,6 +739,7 @@ std::string demangle_traversal(int t)
   if(t==InnerVectorizedTraversal) return "InnerVectorizedTraversal";
   if(t==LinearVectorizedTraversal) return "LinearVectorizedTraversal";
   if(t==SliceVectorizedTraversal) return "SliceVectorizedTraversal";
+  if(t==TiledTraversal) return "TiledTraversal";
   return "?";
 }
 std::string demangle_unrolling(int t)
@@ -278,6 +278,90 @@ template<typename _MatrixType> class HessenbergDecomposition
     bool m_isInitialized;
 };
 
+namespace internal {
+
+/** \internal
+  * Helper routine for the block reduction to Hessenberg form.
+  *
+  * This function reduces the \a bs columns of \a A starting at column \a p, and applies the corresponding
+  * similarity transformation to the rest of \a A using matrix-matrix products. As in xLAHR2, the reflectors
+  * H_i = I - h_i v_i v_i^* are accumulated as H_p^* ... H_{p+bs-1}^* = I - V T V^*, where V holds the
+  * Householder vectors stored below the sub-diagonal of the panel and T is upper triangular, together with
+  * the product Y = A V T. Then the trailing columns are updated from the right by A -= Y V^*, and the
+  * trailing rows from the left by apply_block_householder_on_the_left().
+  */
+template<typename MatrixType, typename CoeffVectorType>
+void hessenberg_decomposition_blocked_helper(MatrixType& A, CoeffVectorType& hCoeffs, Index p, Index bs)
+{
+  using numext::conj;
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename MatrixType::RealScalar RealScalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> WorkMatrixType;
+  typedef Block<MatrixType,Dynamic,Dynamic> BlockType;
+
+  Index n = A.rows();
+  Index rs = n-p-1;   // rows of the Householder vectors
+  WorkMatrixType Y(n,bs), T(bs,bs);
+  Matrix<Scalar,Dynamic,1> tmp(bs);
+  Matrix<RealScalar,Dynamic,1> subdiag(bs);
+
+  for(Index j = 0; j < bs; ++j)
+  {
+    Index k = p+j;
+    Index remainingSize = n-k-1;
+
+    // 1 - apply the previous reflectors of the panel to the k-th column, from the right and then from the left:
+    //     A = (I - V T^* V^*) * (A - Y V^*)
+    if(j>0)
+    {
+      typename MatrixType::ColXpr::SegmentReturnType b = A.col(k).tail(rs);
+      b.noalias() -= Y.block(p+1,0,rs,j) * A.row(k).segment(p,j).adjoint();
+      tmp.head(j).noalias() = A.block(p+1,p,rs,j).template triangularView<UnitLower>().adjoint() * b;
+      tmp.head(j) = T.topLeftCorner(j,j).template triangularView<Upper>().adjoint() * tmp.head(j);
+      b.noalias() -= A.block(p+1,p,rs,j).template triangularView<UnitLower>() * tmp.head(j);
+    }
+
+    // 2 - construct the Householder transformation in-place
+    RealScalar beta;
+    Scalar h;
+    A.col(k).tail(remainingSize).makeHouseholderInPlace(h, beta);
+    A.coeffRef(k+1,k) = Scalar(1);
+    subdiag.coeffRef(j) = beta;
+    hCoeffs.coeffRef(k) = h;
+
+    // 3 - compute the bottom part of the j-th column of Y = A V T, and the j-th column of T
+    typename MatrixType::ColXpr::SegmentReturnType v = A.col(k).tail(remainingSize);
+    Scalar tau = conj(h);
+    Y.col(j).tail(rs).noalias() = A.block(p+1,k+1,rs,remainingSize) * v; // bottleneck
+    tmp.head(j).noalias() = A.block(k+1,p,remainingSize,j).adjoint() * v;
+    Y.col(j).tail(rs).noalias() -= Y.block(p+1,0,rs,j) * tmp.head(j);
+    Y.col(j).tail(rs) *= tau;
+    T.col(j).head(j).noalias() = T.topLeftCorner(j,j).template triangularView<Upper>() * tmp.head(j);
+    T.col(j).head(j) *= -tau;
+    T.coeffRef(j,j) = tau;
+  }
+
+  // compute the top part of Y
+  Y.topRows(p+1).noalias() = A.block(0,p+1,p+1,bs) * A.block(p+1,p,bs,bs).template triangularView<UnitLower>();
+  if(rs>bs)
+    Y.topRows(p+1).noalias() += A.block(0,p+bs+1,p+1,rs-bs) * A.block(p+bs+1,p,rs-bs,bs);
+  Y.topRows(p+1) = Y.topRows(p+1) * T.template triangularView<Upper>();
+
+  // apply the reflectors from the right: A = A - Y V^*
+  A.rightCols(n-p-bs).noalias() -= Y * A.block(p+bs,p,n-p-bs,bs).adjoint();
+  A.block(0,p+1,p+1,bs-1).noalias() -= Y.topLeftCorner(p+1,bs-1)
+                                     * A.block(p+1,p,bs-1,bs-1).template triangularView<UnitLower>().adjoint();
+
+  // and from the left to the trailing columns
+  BlockType A22 = A.bottomRightCorner(rs,n-p-bs);
+  BlockType V = A.block(p+1,p,rs,bs);
+  apply_block_householder_on_the_left(A22, V, hCoeffs.segment(p,bs), false);
+
+  A.template diagonal<-1>().segment(p,bs) = subdiag.template cast<Scalar>();
+}
+
+} // end namespace internal
+
 /** \internal
   * Performs a tridiagonal decomposition of \a matA in place.
   *
@@ -286,7 +370,8 @@ template<typename _MatrixType> class HessenbergDecomposition
   *
   * The result is written in the lower triangular part of \a matA.
   *
-  * Implemented from Golub's "%Matrix Computations", algorithm 8.3.1.
+  * Implemented from Golub's "%Matrix Computations", algorithm 8.3.1. Large dynamic-size matrices are first
+  * reduced by panels of columns, see internal::hessenberg_decomposition_blocked_helper().
   *
   * \sa packedMatrix()
   */
@@ -296,7 +381,15 @@ void HessenbergDecomposition<MatrixType>::_compute(MatrixType& matA, CoeffVector
   eigen_assert(matA.rows()==matA.cols());
   Index n = matA.rows();
   temp.resize(n);
-  for (Index i = 0; i<n-1; ++i)
+  Index i = 0;
+  // somewhat arbitrary threshold
+  if(MatrixType::MaxColsAtCompileTime==Dynamic && n>=128)
+  {
+    const Index blockSize = 32;
+    for(; n-i > 2*blockSize; i += blockSize)
+      internal::hessenberg_decomposition_blocked_helper(matA, hCoeffs, i, blockSize);
+  }
+  for (; i<n-1; ++i)
   {
     // let's consider the vector v = i-th column starting at position i+1
     Index remainingSize = n-i-1;
@@ -24,6 +24,9 @@ template<typename SolverType,int Size,bool IsComplex> struct direct_selfadjoint_
 template<typename MatrixType, typename DiagType, typename SubDiagType>
 EIGEN_DEVICE_FUNC
 ComputationInfo computeFromTridiagonal_impl(DiagType& diag, SubDiagType& subdiag, const Index maxIterations, bool computeEigenvectors, MatrixType& eivec);
+
+template<typename RealScalar> class tridiagonal_divide_and_conquer;
+template<typename RealScalar> class tridiagonal_bisection;
 }
 
 /** \eigenvalues_module \ingroup Eigenvalues_Module
@@ -195,6 +198,16 @@ template<typename _MatrixType> class SelfAdjointEigenSolver
       * The cost of the computation is about \f$ 9n^3 \f$ if the eigenvectors
       * are required and \f$ 4n^3/3 \f$ if they are not required.
       *
+      * For large dynamic-size matrices, the eigenvectors of the tridiagonal
+      * matrix are rather computed by a divide-and-conquer algorithm, as in
+      * LAPACK's xSTEDC, and the Householder reflectors of the tridiagonalization
+      * are then applied to them by blocks. Most of its operations are
+      * matrix-matrix products, and the cost drops to about \f$ 4n^3 \f$ or less,
+      * depending on the amount of deflation. The independent subproblems are
+      * solved concurrently (see \ref TopicMultiThreading).
+      * When only a few eigenpairs are needed, computeIndexRange() and
+      * computeValueRange() are cheaper.
+      *
       * This method reuses the memory in the SelfAdjointEigenSolver object that
       * was allocated when the object was constructed, if the size of the
       * matrix does not change.
@@ -243,6 +256,61 @@ template<typename _MatrixType> class SelfAdjointEigenSolver
       */
     SelfAdjointEigenSolver& computeFromTridiagonal(const RealVectorType& diag, const SubDiagonalType& subdiag , int options=ComputeEigenvectors);
 
+    /** \brief Computes selected eigenvalues, and their eigenvectors, of given matrix.
+      *
+      * \param[in]  matrix  Selfadjoint matrix whose eigendecomposition is to
+      *    be computed. Only the lower triangular part of the matrix is referenced.
+      * \param[in]  first   Index of the lowest wanted eigenvalue, in increasing order.
+      * \param[in]  count   Number of wanted eigenvalues.
+      * \param[in]  options Can be #ComputeEigenvectors (default) or #EigenvaluesOnly.
+      * \returns    Reference to \c *this
+      *
+      * This function computes the eigenvalues \p first to \p first + \p count - 1 of \p matrix, sorted in
+      * increasing order, and the corresponding eigenvectors if \p options equals #ComputeEigenvectors.
+      * Afterwards, eigenvalues() holds \p count eigenvalues and eigenvectors() is a n x \p count matrix.
+      * For instance, the \c k largest eigenvalues of a n x n matrix \c A are computed by:
+      * \code
+      * SelfAdjointEigenSolver<MatrixXd> es;
+      * es.computeIndexRange(A, n-k, k);
+      * \endcode
+      *
+      * The matrix is reduced to tridiagonal form as in compute(), then the wanted eigenvalues of the tridiagonal
+      * matrix are isolated by bisection, and their eigenvectors are computed by inverse iteration, as in LAPACK's
+      * xSTEBZ and xSTEIN. The eigenvalues are computed concurrently, as well as the eigenvectors of distinct
+      * eigenvalues (see \ref TopicMultiThreading). Beyond the tridiagonalization, the cost is proportional to
+      * \f$ n \f$ \p count for well separated eigenvalues, and to \f$ n^2 \f$ \p count for the back-transformation
+      * of the eigenvectors. The eigenvectors of tight clusters of eigenvalues are orthogonalized to each other,
+      * in which case compute() may be faster and more accurate.
+      *
+      * This method is only available for dynamic-size matrices.
+      *
+      * \sa computeValueRange(), compute()
+      */
+    template<typename InputType>
+    SelfAdjointEigenSolver& computeIndexRange(const EigenBase<InputType>& matrix, Index first, Index count, int options = ComputeEigenvectors);
+
+    /** \brief Computes the eigenvalues of given matrix in a given interval, and their eigenvectors.
+      *
+      * \param[in]  matrix  Selfadjoint matrix whose eigendecomposition is to
+      *    be computed. Only the lower triangular part of the matrix is referenced.
+      * \param[in]  lower   Lower bound of the wanted eigenvalues.
+      * \param[in]  upper   Upper bound of the wanted eigenvalues.
+      * \param[in]  options Can be #ComputeEigenvectors (default) or #EigenvaluesOnly.
+      * \returns    Reference to \c *this
+      *
+      * This function computes the eigenvalues of \p matrix in the interval [\p lower, \p upper), sorted in
+      * increasing order, and the corresponding eigenvectors if \p options equals #ComputeEigenvectors.
+      * The number of eigenvalues in that interval is first counted, then they are computed as
+      * in computeIndexRange(). Eigenvalues closer to the bounds than the accuracy of the computation may or may not
+      * be included.
+      *
+      * This method is only available for dynamic-size matrices.
+      *
+      * \sa computeIndexRange(), compute()
+      */
+    template<typename InputType>
+    SelfAdjointEigenSolver& computeValueRange(const EigenBase<InputType>& matrix, const RealScalar& lower, const RealScalar& upper, int options = ComputeEigenvectors);
+
     /** \brief Returns the eigenvectors of given matrix.
       *
       * \returns  A const reference to the matrix whose columns are the eigenvectors.
@@ -276,8 +344,9 @@ template<typename _MatrixType> class SelfAdjointEigenSolver
       * \pre The eigenvalues have been computed before.
       *
       * The eigenvalues are repeated according to their algebraic multiplicity,
-      * so there are as many eigenvalues as rows in the matrix. The eigenvalues
-      * are sorted in increasing order.
+      * so there are as many eigenvalues as rows in the matrix, unless they
+      * were computed by computeIndexRange() or computeValueRange(). The
+      * eigenvalues are sorted in increasing order.
       *
       * Example: \include SelfAdjointEigenSolver_eigenvalues.cpp
       * Output: \verbinclude SelfAdjointEigenSolver_eigenvalues.out
@@ -365,6 +434,16 @@ template<typename _MatrixType> class SelfAdjointEigenSolver
     {
       EIGEN_STATIC_ASSERT_NON_INTEGER(Scalar);
     }
+
+    // whether the eigenvectors of a tridiagonal matrix of size n are computed by divide-and-conquer
+    static bool useDivideAndConquer(Index n)
+    {
+      return MaxColsAtCompileTime==Dynamic && n>=128;  // somewhat arbitrary threshold
+    }
+
+    template<typename InputType>
+    void computeRange(const InputType& matrix, bool byIndex, Index first, Index count,
+                      const RealScalar& lower, const RealScalar& upper, int options);
     
     EigenvectorsType m_eivec;
     RealVectorType m_eivalues;
@@ -441,10 +520,23 @@ SelfAdjointEigenSolver<MatrixType>& SelfAdjointEigenSolver<MatrixType>
   if(scale==RealScalar(0)) scale = RealScalar(1);
   mat.template triangularView<Lower>() /= scale;
   m_subdiag.resize(n-1);
-  internal::tridiagonalization_inplace(mat, diag, m_subdiag, computeEigenvectors);
+  if(computeEigenvectors && useDivideAndConquer(n))
+  {
+    // divide-and-conquer on the tridiagonal matrix, followed by the application of the Householder reflectors
+    typename TridiagonalizationType::CoeffVectorType hCoeffs(n-1);
+    internal::tridiagonalization_inplace(mat, hCoeffs);
+    Matrix<RealScalar,Dynamic,1> d = mat.diagonal().real(), e = mat.template diagonal<-1>().real();
+    Matrix<RealScalar,Dynamic,Dynamic> z;
+    m_info = internal::tridiagonal_divide_and_conquer<RealScalar>::run(d, e, z);
+    diag = d;
+    m_eivec = householderSequence(mat, hCoeffs.conjugate()).setLength(n-1).setShift(1) * z;
+  }
+  else
+  {
+    internal::tridiagonalization_inplace(mat, diag, m_subdiag, computeEigenvectors);
+    m_info = internal::computeFromTridiagonal_impl(diag, m_subdiag, m_maxIterations, computeEigenvectors, m_eivec);
+  }
 
-  m_info = internal::computeFromTridiagonal_impl(diag, m_subdiag, m_maxIterations, computeEigenvectors, m_eivec);
-  
   // scale back the eigen values
   m_eivalues *= scale;
 
@@ -462,17 +554,90 @@ SelfAdjointEigenSolver<MatrixType>& SelfAdjointEigenSolver<MatrixType>
 
   m_eivalues = diag;
   m_subdiag = subdiag;
-  if (computeEigenvectors)
+  if (computeEigenvectors && useDivideAndConquer(diag.size()))
   {
-    m_eivec.setIdentity(diag.size(), diag.size());
+    Matrix<RealScalar,Dynamic,1> d = diag, e = subdiag;
+    Matrix<RealScalar,Dynamic,Dynamic> z;
+    m_info = internal::tridiagonal_divide_and_conquer<RealScalar>::run(d, e, z);
+    m_eivalues = d;
+    m_eivec = z.template cast<Scalar>();
+  }
+  else
+  {
+    if (computeEigenvectors)
+    {
+      m_eivec.setIdentity(diag.size(), diag.size());
+    }
+    m_info = internal::computeFromTridiagonal_impl(m_eivalues, m_subdiag, m_maxIterations, computeEigenvectors, m_eivec);
   }
-  m_info = internal::computeFromTridiagonal_impl(m_eivalues, m_subdiag, m_maxIterations, computeEigenvectors, m_eivec);
 
   m_isInitialized = true;
   m_eigenvectorsOk = computeEigenvectors;
   return *this;
 }
 
+template<typename MatrixType>
+template<typename InputType>
+SelfAdjointEigenSolver<MatrixType>& SelfAdjointEigenSolver<MatrixType>
+::computeIndexRange(const EigenBase<InputType>& matrix, Index first, Index count, int options)
+{
+  eigen_assert(first>=0 && count>=0 && first+count<=matrix.cols() && "invalid range of eigenvalues");
+  computeRange(matrix.derived(), true, first, count, RealScalar(0), RealScalar(0), options);
+  return *this;
+}
+
+template<typename MatrixType>
+template<typename InputType>
+SelfAdjointEigenSolver<MatrixType>& SelfAdjointEigenSolver<MatrixType>
+::computeValueRange(const EigenBase<InputType>& matrix, const RealScalar& lower, const RealScalar& upper, int options)
+{
+  eigen_assert(lower<=upper && "invalid range of eigenvalues");
+  computeRange(matrix.derived(), false, 0, 0, lower, upper, options);
+  return *this;
+}
+
+template<typename MatrixType>
+template<typename InputType>
+void SelfAdjointEigenSolver<MatrixType>
+::computeRange(const InputType& matrix, bool byIndex, Index first, Index count,
+               const RealScalar& lower, const RealScalar& upper, int options)
+{
+  check_template_parameters();
+  EIGEN_STATIC_ASSERT_DYNAMIC_SIZE(MatrixType);
+  eigen_assert(matrix.cols() == matrix.rows());
+  eigen_assert((options&~(EigVecMask|GenEigMask))==0
+          && (options&EigVecMask)!=EigVecMask
+          && "invalid option parameter");
+  bool computeEigenvectors = (options&ComputeEigenvectors)==ComputeEigenvectors;
+  Index n = matrix.cols();
+  EigenvectorsType& mat = m_eivec;
+
+  // map the matrix coefficients to [-1:1] to avoid over- and underflow.
+  mat = matrix.template triangularView<Lower>();
+  RealScalar scale = mat.cwiseAbs().maxCoeff();
+  if(scale==RealScalar(0)) scale = RealScalar(1);
+  mat.template triangularView<Lower>() /= scale;
+  typename TridiagonalizationType::CoeffVectorType hCoeffs(n-1);
+  internal::tridiagonalization_inplace(mat, hCoeffs);
+  Matrix<RealScalar,Dynamic,1> d = mat.diagonal().real(), e = mat.template diagonal<-1>().real();
+
+  internal::tridiagonal_bisection<RealScalar> bisection(d, e);
+  if(!byIndex)
+  {
+    first = bisection.count(lower/scale);
+    count = bisection.count(upper/scale) - first;
+  }
+  Matrix<RealScalar,Dynamic,1> values;
+  Matrix<RealScalar,Dynamic,Dynamic> z;
+  m_info = bisection.compute(first, count, values, computeEigenvectors ? &z : 0);
+  m_eivalues = values * scale;
+  if(computeEigenvectors)
+    m_eivec = householderSequence(mat, hCoeffs.conjugate()).setLength(n-1).setShift(1) * z;
+
+  m_isInitialized = true;
+  m_eigenvectorsOk = computeEigenvectors;
+}
+
 namespace internal {
 /**
   * \internal
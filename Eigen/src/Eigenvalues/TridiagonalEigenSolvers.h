@@ -0,0 +1,666 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_TRIDIAGONAL_EIGEN_SOLVERS_H
+#define EIGEN_TRIDIAGONAL_EIGEN_SOLVERS_H
+
+namespace Eigen {
+
+namespace internal {
+
+/** \internal Estimated cost, in cycles, of one term of a secular equation or of a Sturm sequence, see parallel_cwise_threads(). */
+const int TridiagonalEigenSolverCost = 10;
+
+/** \internal
+  * \eigenvalues_module \ingroup Eigenvalues_Module
+  *
+  * Divide-and-conquer eigensolver for real symmetric tridiagonal matrices (Cuppen's method, as xSTEDC).
+  *
+  * The tridiagonal matrix T is torn into two halves by a rank-one modification:
+  *   T = diag(T1, T2) + rho * v * v^T
+  * whose eigendecompositions T1 = Q1 D1 Q1^T and T2 = Q2 D2 Q2^T are computed recursively. The eigenvalues of T
+  * are then the roots of the secular equation of D + rho * z * z^T, where D = diag(D1,D2) and z = diag(Q1,Q2)^T v,
+  * and its eigenvectors are diag(Q1,Q2) U, where U are the eigenvectors of D + rho * z * z^T.
+  * The eigenpairs of D which are numerically eigenpairs of D + rho * z * z^T are first deflated. Then, as in BDCSVD,
+  * the components of z are recomputed from the roots following Gu and Eisenstat, so that U is numerically orthogonal.
+  * Most of the operations are thus spent in the matrix-matrix products diag(Q1,Q2) U.
+  *
+  * The two halves of large problems are solved concurrently, as well as the secular equations of large merges.
+  */
+template<typename _RealScalar>
+class tridiagonal_divide_and_conquer
+{
+  public:
+    typedef _RealScalar RealScalar;
+    typedef Matrix<RealScalar,Dynamic,1> VectorType;
+    typedef Matrix<RealScalar,Dynamic,Dynamic> MatrixType;
+    typedef Matrix<Index,Dynamic,1> IndicesType;
+
+    /** \internal Computes the eigenvalues and the eigenvectors of the tridiagonal matrix of diagonal \a diag and
+      * sub-diagonal \a subdiag. On output, \a diag holds the eigenvalues in increasing order, \a eivec the
+      * corresponding eigenvectors, and \a subdiag is destroyed. */
+    static ComputationInfo run(VectorType& diag, VectorType& subdiag, MatrixType& eivec)
+    {
+      Index n = diag.size();
+      eivec.setZero(n,n);
+      RealScalar scale = n>0 ? diag.cwiseAbs().maxCoeff() : RealScalar(0);
+      if(n>1)
+        scale = (std::max)(scale, subdiag.cwiseAbs().maxCoeff());
+      if(scale==RealScalar(0))
+      {
+        eivec.setIdentity();
+        return Success;
+      }
+
+      // map the coefficients to [-1:1], which also fixes the deflation tolerance
+      diag /= scale;
+      subdiag /= scale;
+      tridiagonal_divide_and_conquer solver(diag, subdiag, eivec);
+      ComputationInfo info = solver.solve(0, n);
+      diag *= scale;
+      return info;
+    }
+
+  protected:
+    enum { LeafSize = 32 };
+
+    tridiagonal_divide_and_conquer(VectorType& diag, const VectorType& subdiag, MatrixType& eivec)
+      : m_diag(diag), m_subdiag(subdiag), m_eivec(eivec)
+    {}
+
+    // solves the two halves of a problem
+    struct solve_task
+    {
+      solve_task(const tridiagonal_divide_and_conquer& solver, Index start, Index size, ComputationInfo* info)
+        : m_solver(solver), m_start(start), m_size(size), m_info(info)
+      {}
+
+      void operator()(Index i) const
+      {
+        Index m = m_size/2;
+        m_info[i] = i==0 ? m_solver.solve(m_start, m) : m_solver.solve(m_start+m, m_size-m);
+      }
+
+      const tridiagonal_divide_and_conquer& m_solver;
+      Index m_start, m_size;
+      ComputationInfo* m_info;
+    };
+
+    // computes the roots of the secular equation, the vector z of Gu and Eisenstat, or the eigenvectors U,
+    // for a range of indices
+    struct merge_task
+    {
+      enum Phase { Roots, GuEisenstat, Eigenvectors };
+
+      merge_task(Phase phase, Index k, Index numTasks, const VectorType& d, const VectorType& z, RealScalar rho,
+                 IndicesType& origin, VectorType& tau, VectorType& zhat, MatrixType& u)
+        : m_phase(phase), m_k(k), m_numTasks(numTasks), m_d(d), m_z(z), m_rho(rho),
+          m_origin(origin), m_tau(tau), m_zhat(zhat), m_u(u)
+      {}
+
+      void operator()(Index t) const
+      {
+        using std::sqrt;
+        using std::abs;
+        for(Index j=(t*m_k)/m_numTasks; j<((t+1)*m_k)/m_numTasks; ++j)
+        {
+          if(m_phase==Roots)
+            secular_root(m_d, m_z, m_rho, m_k, j, m_origin(j), m_tau(j));
+          else if(m_phase==GuEisenstat)
+          {
+            // zhat_j^2 = (lambda_j - d_j) / rho * prod_{i!=j} (lambda_i - d_j) / (d_i - d_j)
+            RealScalar p = (m_tau(j) - (m_d(j)-m_d(m_origin(j)))) / m_rho;
+            for(Index i=0; i<m_k; ++i)
+              if(i!=j)
+                p *= (m_tau(i) - (m_d(j)-m_d(m_origin(i)))) / (m_d(i)-m_d(j));
+            m_zhat(j) = m_z(j)<RealScalar(0) ? -sqrt(abs(p)) : sqrt(abs(p));
+          }
+          else
+          {
+            // u_ij = zhat_i / (d_i - lambda_j)
+            for(Index i=0; i<m_k; ++i)
+              m_u(i,j) = m_zhat(i) / ((m_d(i)-m_d(m_origin(j))) - m_tau(j));
+            m_u.col(j).normalize();
+          }
+        }
+      }
+
+      Phase m_phase;
+      Index m_k, m_numTasks;
+      const VectorType& m_d;
+      const VectorType& m_z;
+      RealScalar m_rho;
+      IndicesType& m_origin;
+      VectorType& m_tau;
+      VectorType& m_zhat;
+      MatrixType& m_u;
+    };
+
+    // sorts indices by increasing values
+    struct less_value
+    {
+      less_value(const VectorType& values) : m_values(values) {}
+      bool operator()(Index a, Index b) const { return m_values(a) < m_values(b); }
+      const VectorType& m_values;
+    };
+
+    // solves the subproblem of the given range of the tridiagonal matrix
+    ComputationInfo solve(Index start, Index size) const
+    {
+      using std::abs;
+      if(size<=LeafSize)
+      {
+        VectorType d = m_diag.segment(start,size);
+        VectorType e = m_subdiag.segment(start,size-1);
+        MatrixType q = MatrixType::Identity(size,size);
+        ComputationInfo info = computeFromTridiagonal_impl(d, e, 30, true, q);
+        m_diag.segment(start,size) = d;
+        m_eivec.block(start,start,size,size) = q;
+        return info;
+      }
+
+      // tear the matrix into two halves
+      Index m = size/2;
+      RealScalar beta = m_subdiag(start+m-1);
+      RealScalar rho = abs(beta);
+      m_diag(start+m-1) -= rho;
+      m_diag(start+m) -= rho;
+
+      ComputationInfo info[2];
+      Index threads = parallel_cwise_threads(double(m)*double(m)*double(m));
+      parallel_run_tasks(2, threads, solve_task(*this, start, size, info));
+      if(info[0]!=Success || info[1]!=Success)
+        return NoConvergence;
+
+      merge(start, size, m, rho, beta<RealScalar(0));
+      return Success;
+    }
+
+    // computes the eigendecomposition of a range of size n, from the ones of its two halves
+    void merge(Index start, Index n, Index m, RealScalar rho, bool negative) const
+    {
+      using std::abs;
+      using std::sqrt;
+      const RealScalar eps = NumTraits<RealScalar>::epsilon();
+      Block<MatrixType> q(m_eivec, start, start, n, n);
+      typename VectorType::SegmentReturnType d = m_diag.segment(start,n);
+
+      // z = diag(Q1,Q2)^T v, normalized
+      VectorType z(n);
+      z.head(m) = q.row(m-1).head(m).transpose();
+      z.tail(n-m) = q.row(m).tail(n-m).transpose();
+      if(negative)
+        z.tail(n-m) = -z.tail(n-m);
+      z /= sqrt(RealScalar(2));
+      rho *= RealScalar(2);
+
+      // merge the eigenvalues of both halves, which are sorted already
+      IndicesType perm(n);
+      for(Index i=0, i1=0, i2=m; i<n; ++i)
+        perm(i) = (i2==n || (i1<m && d(i1)<=d(i2))) ? i1++ : i2++;
+
+      // deflation, as in xLAED2: the eigenpairs whose component of z is negligible, and the ones whose
+      // eigenvalue is too close to the one of the next eigenpair after a rotation which zeroes its component
+      const RealScalar tol = RealScalar(8) * eps * (std::max)(d.cwiseAbs().maxCoeff(), z.cwiseAbs().maxCoeff());
+      VectorType dn(n), zn(n);
+      IndicesType columns(n), deflated(n);
+      Index k = 0, kd = 0;
+      Index p = -1;
+      for(Index t=0; t<n; ++t)
+      {
+        Index j = perm(t);
+        if(rho*abs(z(j))<=tol)
+        {
+          deflated(kd++) = j;
+          continue;
+        }
+        if(p>=0)
+        {
+          RealScalar tau = numext::hypot(z(j), z(p));
+          RealScalar c = z(j)/tau, s = -z(p)/tau;
+          if(abs((d(j)-d(p))*c*s)<=tol)
+          {
+            z(j) = tau;
+            z(p) = RealScalar(0);
+            VectorType qp = q.col(p);
+            q.col(p) = c*qp + s*q.col(j);
+            q.col(j) = c*q.col(j) - s*qp;
+            RealScalar dp = d(p)*c*c + d(j)*s*s;
+            d(j) = d(p)*s*s + d(j)*c*c;
+            d(p) = dp;
+            deflated(kd++) = p;
+            p = j;
+            continue;
+          }
+          dn(k) = d(p);
+          zn(k) = z(p);
+          columns(k++) = p;
+        }
+        p = j;
+      }
+      if(p>=0)
+      {
+        dn(k) = d(p);
+        zn(k) = z(p);
+        columns(k++) = p;
+      }
+
+      // move the non-deflated eigenvectors to the first k columns
+      PermutationMatrix<Dynamic,Dynamic> P(n);
+      for(Index i=0; i<k; ++i)  P.indices()(i) = int(columns(i));
+      for(Index i=0; i<kd; ++i) P.indices()(k+i) = int(deflated(i));
+      q.applyOnTheRight(P);
+      VectorType values(n);
+      for(Index i=0; i<kd; ++i)
+        values(k+i) = d(deflated(i));
+
+      if(k>0)
+      {
+        IndicesType origin(k);
+        VectorType tau(k), zhat(k);
+        MatrixType u(k,k);
+        Index threads = parallel_cwise_threads(double(k)*double(k)*double(TridiagonalEigenSolverCost));
+        Index numTasks = threads>1 ? 4*threads : 1;
+        parallel_run_tasks(numTasks, threads, merge_task(merge_task::Roots, k, numTasks, dn, zn, rho, origin, tau, zhat, u));
+        parallel_run_tasks(numTasks, threads, merge_task(merge_task::GuEisenstat, k, numTasks, dn, zn, rho, origin, tau, zhat, u));
+        parallel_run_tasks(numTasks, threads, merge_task(merge_task::Eigenvectors, k, numTasks, dn, zn, rho, origin, tau, zhat, u));
+        for(Index j=0; j<k; ++j)
+          values(j) = dn(origin(j)) + tau(j);
+
+        // back-transformation
+        q.leftCols(k) = q.leftCols(k) * u;
+      }
+
+      // sort the eigenpairs by increasing eigenvalues
+      IndicesType order(n);
+      for(Index i=0; i<n; ++i)
+        order(i) = i;
+      std::sort(order.data(), order.data()+n, less_value(values));
+      for(Index i=0; i<n; ++i)
+      {
+        P.indices()(i) = int(order(i));
+        d(i) = values(order(i));
+      }
+      q.applyOnTheRight(P);
+    }
+
+    // Computes the j-th root lambda = d(origin) + tau of the secular equation 1 + rho * sum_i z_i^2/(d_i-lambda) = 0,
+    // where d is sorted in increasing order. The root is represented relatively to the closest pole d(origin), so that
+    // the differences d_i-lambda = (d_i-d(origin))-tau are accurate. It follows the "middle way" of xLAED4: the
+    // terms of the poles on each side of the root are approximated by rational functions with a single pole.
+    static void secular_root(const VectorType& d, const VectorType& z, RealScalar rho, Index k, Index j,
+                             Index& origin, RealScalar& tau)
+    {
+      using std::abs;
+      using std::sqrt;
+      const RealScalar eps = NumTraits<RealScalar>::epsilon();
+      RealScalar lo, hi;
+      Index pa;   // the terms of the poles i<=pa and i>pa are approximated separately
+      if(j==k-1)
+      {
+        origin = j;
+        lo = RealScalar(0);
+        hi = rho * z.head(k).squaredNorm();
+        if(k==1)
+        {
+          tau = hi;
+          return;
+        }
+        pa = k-2;
+      }
+      else
+      {
+        pa = j;
+        RealScalar mid = (d(j+1)-d(j)) / RealScalar(2);
+        RealScalar f = RealScalar(1);
+        for(Index i=0; i<k; ++i)
+          f += rho*z(i)*z(i) / ((d(i)-d(j))-mid);
+        if(f>RealScalar(0)) { origin = j;   lo = RealScalar(0); hi = mid; }
+        else                { origin = j+1; lo = -mid;          hi = RealScalar(0); }
+      }
+      const RealScalar dOrigin = d(origin);
+
+      tau = (lo+hi) / RealScalar(2);
+      RealScalar prevF = NumTraits<RealScalar>::highest();
+      for(Index iter=0; iter<200; ++iter)
+      {
+        RealScalar psi(0), dpsi(0), phi(0), dphi(0);
+        for(Index i=0; i<=pa; ++i)
+        {
+          RealScalar t = z(i) / ((d(i)-dOrigin)-tau);
+          psi += z(i)*t;
+          dpsi += t*t;
+        }
+        for(Index i=pa+1; i<k; ++i)
+        {
+          RealScalar t = z(i) / ((d(i)-dOrigin)-tau);
+          phi += z(i)*t;
+          dphi += t*t;
+        }
+        psi *= rho; dpsi *= rho;
+        phi *= rho; dphi *= rho;
+        RealScalar f = RealScalar(1) + psi + phi;
+        if(abs(f) <= eps * (RealScalar(8)*(abs(psi)+abs(phi)) + RealScalar(3)))
+          return;
+        if(f<RealScalar(0)) lo = tau;
+        else                hi = tau;
+        if(hi-lo <= RealScalar(2)*eps*(std::max)(abs(lo),abs(hi)))
+          return;
+
+        // root of c + sa/(da-eta) + sb/(db-eta), which matches f and its derivative at tau
+        RealScalar next = (lo+hi) / RealScalar(2);
+        if(abs(f) <= prevF/RealScalar(2))
+        {
+          RealScalar da = (d(pa)-dOrigin)-tau, db = (d(pa+1)-dOrigin)-tau;
+          RealScalar c = f - da*dpsi - db*dphi;
+          RealScalar a = c*(da+db) + da*da*dpsi + db*db*dphi;
+          RealScalar b = da*db*f;
+          RealScalar s = sqrt(abs(a*a - RealScalar(4)*b*c));
+          RealScalar t = a>=RealScalar(0) ? a+s : a-s;
+          RealScalar eta1 = c!=RealScalar(0) ? t/(RealScalar(2)*c) : NumTraits<RealScalar>::highest();
+          RealScalar eta2 = t!=RealScalar(0) ? RealScalar(2)*b/t : NumTraits<RealScalar>::highest();
+          bool in1 = tau+eta1>lo && tau+eta1<hi;
+          bool in2 = tau+eta2>lo && tau+eta2<hi;
+          if(in1 && (!in2 || abs(eta1)<abs(eta2))) next = tau+eta1;
+          else if(in2)                              next = tau+eta2;
+        }
+        prevF = abs(f);
+        tau = next;
+      }
+    }
+
+    VectorType& m_diag;
+    const VectorType& m_subdiag;
+    MatrixType& m_eivec;
+};
+
+/** \internal
+  * \eigenvalues_module \ingroup Eigenvalues_Module
+  *
+  * Computes selected eigenvalues of a real symmetric tridiagonal matrix by bisection (as xSTEBZ), and the
+  * corresponding eigenvectors by inverse iteration (as xSTEIN).
+  *
+  * Each eigenvalue is isolated by bisection, counting the eigenvalues lower than a given value with a Sturm sequence.
+  * The eigenvectors of clusters of close eigenvalues are orthogonalized to each other during the inverse iterations.
+  * The cost is thus proportional to the size of the matrix times the number of selected eigenpairs, for eigenpairs
+  * which are not clustered. The eigenvalues, and the clusters of eigenvectors, are computed concurrently.
+  */
+template<typename _RealScalar>
+class tridiagonal_bisection
+{
+  public:
+    typedef _RealScalar RealScalar;
+    typedef Matrix<RealScalar,Dynamic,1> VectorType;
+    typedef Matrix<RealScalar,Dynamic,Dynamic> MatrixType;
+    typedef Matrix<Index,Dynamic,1> IndicesType;
+
+    /** \internal Sets up the computation of the eigenpairs of the tridiagonal matrix of diagonal \a diag and
+      * sub-diagonal \a subdiag. */
+    tridiagonal_bisection(const VectorType& diag, const VectorType& subdiag)
+    {
+      using std::abs;
+      Index n = diag.size();
+      m_scale = n>0 ? diag.cwiseAbs().maxCoeff() : RealScalar(0);
+      if(n>1)
+        m_scale = (std::max)(m_scale, subdiag.cwiseAbs().maxCoeff());
+      if(m_scale==RealScalar(0))
+        m_scale = RealScalar(1);
+      m_diag = diag / m_scale;
+      m_subdiag = subdiag / m_scale;
+      m_subdiag2 = m_subdiag.cwiseAbs2();
+
+      // Gershgorin interval
+      m_lower = NumTraits<RealScalar>::highest();
+      m_upper = -NumTraits<RealScalar>::highest();
+      m_norm = RealScalar(0);
+      for(Index i=0; i<n; ++i)
+      {
+        RealScalar r = (i>0 ? abs(m_subdiag(i-1)) : RealScalar(0)) + (i<n-1 ? abs(m_subdiag(i)) : RealScalar(0));
+        m_lower = (std::min)(m_lower, m_diag(i)-r);
+        m_upper = (std::max)(m_upper, m_diag(i)+r);
+        m_norm = (std::max)(m_norm, abs(m_diag(i))+r);
+      }
+      const RealScalar eps = NumTraits<RealScalar>::epsilon();
+      m_pivmin = (std::numeric_limits<RealScalar>::min)() * (std::max)(RealScalar(1), n>1 ? m_subdiag2.maxCoeff() : RealScalar(0));
+      RealScalar margin = RealScalar(2)*eps*m_norm*RealScalar(n) + RealScalar(4)*m_pivmin;
+      m_lower -= margin;
+      m_upper += margin;
+    }
+
+    /** \internal \returns the number of eigenvalues lower than \a x */
+    Index count(RealScalar x) const
+    {
+      return sturmCount(x / m_scale);
+    }
+
+    /** \internal Computes the eigenvalues \a first to \a first + \a num - 1 in increasing order, and the corresponding
+      * eigenvectors if \a eivec is not null. */
+    ComputationInfo compute(Index first, Index num, VectorType& eivals, MatrixType* eivec) const
+    {
+      Index n = m_diag.size();
+      eivals.resize(num);
+      Index threads = parallel_cwise_threads(double(num)*double(n)*double(64*TridiagonalEigenSolverCost));
+      Index numTasks = threads>1 ? (std::min)(num, 4*threads) : 1;
+      parallel_run_tasks(numTasks, threads, bisection_task(*this, first, num, numTasks, eivals));
+      if(eivec==0)
+      {
+        eivals *= m_scale;
+        return Success;
+      }
+
+      // clusters of close eigenvalues
+      const RealScalar ortol = RealScalar(1e-3) * m_norm;
+      IndicesType clusters(num+1);
+      Index numClusters = 0;
+      for(Index j=0; j<num; ++j)
+        if(j==0 || eivals(j)-eivals(j-1)>ortol)
+          clusters(numClusters++) = j;
+      clusters(numClusters) = num;
+
+      eivec->resize(n,num);
+      Matrix<bool,Dynamic,1> converged(numClusters);
+      threads = parallel_cwise_threads(double(num)*double(n)*double(16*TridiagonalEigenSolverCost));
+      parallel_run_tasks(numClusters, threads, inverse_iteration_task(*this, clusters, eivals, *eivec, converged));
+      eivals *= m_scale;
+      return converged.all() ? Success : NoConvergence;
+    }
+
+  protected:
+    // computes a range of eigenvalues by bisection
+    struct bisection_task
+    {
+      bisection_task(const tridiagonal_bisection& solver, Index first, Index num, Index numTasks, VectorType& eivals)
+        : m_solver(solver), m_first(first), m_num(num), m_numTasks(numTasks), m_eivals(eivals)
+      {}
+
+      void operator()(Index t) const
+      {
+        for(Index j=(t*m_num)/m_numTasks; j<((t+1)*m_num)/m_numTasks; ++j)
+          m_eivals(j) = m_solver.bisect(m_first+j);
+      }
+
+      const tridiagonal_bisection& m_solver;
+      Index m_first, m_num, m_numTasks;
+      VectorType& m_eivals;
+    };
+
+    // computes the eigenvectors of a cluster by inverse iteration
+    struct inverse_iteration_task
+    {
+      inverse_iteration_task(const tridiagonal_bisection& solver, const IndicesType& clusters, const VectorType& eivals,
+                             MatrixType& eivec, Matrix<bool,Dynamic,1>& converged)
+        : m_solver(solver), m_clusters(clusters), m_eivals(eivals), m_eivec(eivec), m_converged(converged)
+      {}
+
+      void operator()(Index c) const
+      {
+        m_converged(c) = m_solver.inverseIteration(m_clusters(c), m_clusters(c+1), m_eivals, m_eivec);
+      }
+
+      const tridiagonal_bisection& m_solver;
+      const IndicesType& m_clusters;
+      const VectorType& m_eivals;
+      MatrixType& m_eivec;
+      Matrix<bool,Dynamic,1>& m_converged;
+    };
+
+    // number of eigenvalues lower than x, for the scaled matrix
+    Index sturmCount(RealScalar x) const
+    {
+      using std::abs;
+      Index n = m_diag.size();
+      Index res = 0;
+      RealScalar q(0);
+      for(Index i=0; i<n; ++i)
+      {
+        q = m_diag(i) - x - (i>0 ? m_subdiag2(i-1)/q : RealScalar(0));
+        if(abs(q)<=m_pivmin)
+          q = -m_pivmin;
+        if(q<=RealScalar(0))
+          ++res;
+      }
+      return res;
+    }
+
+    // the i-th eigenvalue of the scaled matrix
+    RealScalar bisect(Index i) const
+    {
+      using std::abs;
+      const RealScalar eps = NumTraits<RealScalar>::epsilon();
+      RealScalar lo = m_lower, hi = m_upper;
+      while(hi-lo > RealScalar(2)*eps*(std::max)(abs(lo),abs(hi)) + eps*m_norm + m_pivmin)
+      {
+        RealScalar mid = (lo+hi) / RealScalar(2);
+        if(sturmCount(mid)<=i) lo = mid;
+        else                   hi = mid;
+      }
+      return (lo+hi) / RealScalar(2);
+    }
+
+    // computes the eigenvectors of the eigenvalues [begin,end) of a cluster, and returns false if one did not converge
+    bool inverseIteration(Index begin, Index end, const VectorType& eivals, MatrixType& eivec) const
+    {
+      using std::abs;
+      using std::sqrt;
+      const RealScalar eps = NumTraits<RealScalar>::epsilon();
+      const Index n = m_diag.size();
+      const Index maxIterations = 5, extraIterations = 2;
+      const RealScalar criterion = sqrt(RealScalar(0.1)/RealScalar(n));
+      VectorType dl(n), d(n), du(n), du2(n), x(n);
+      Matrix<bool,Dynamic,1> pivots(n);
+      bool ok = true;
+      RealScalar lambda(0);
+      for(Index j=begin; j<end; ++j)
+      {
+        // perturb the eigenvalues which are too close to the previous one
+        RealScalar prev = lambda;
+        lambda = eivals(j);
+        if(j>begin && lambda-prev < RealScalar(10)*eps*abs(lambda))
+          lambda = prev + RealScalar(10)*eps*abs(lambda);
+
+        // LU factorization of T - lambda I with partial pivoting, as xGTTRF
+        d = m_diag.array() - lambda;
+        dl.head(n-1) = m_subdiag;
+        du.head(n-1) = m_subdiag;
+        for(Index i=0; i<n-1; ++i)
+        {
+          pivots(i) = abs(d(i)) < abs(dl(i));
+          if(!pivots(i))
+          {
+            if(d(i)!=RealScalar(0))
+            {
+              dl(i) /= d(i);
+              d(i+1) -= dl(i)*du(i);
+            }
+            du2(i) = RealScalar(0);
+          }
+          else
+          {
+            RealScalar fact = d(i)/dl(i);
+            d(i) = dl(i);
+            dl(i) = fact;
+            RealScalar temp = du(i);
+            du(i) = d(i+1);
+            d(i+1) = temp - fact*d(i+1);
+            if(i<n-2)
+            {
+              du2(i) = du(i+1);
+              du(i+1) = -fact*du(i+1);
+            }
+            else
+              du2(i) = RealScalar(0);
+          }
+        }
+        // perturb the negligible pivots
+        const RealScalar pivtol = eps*m_norm;
+        for(Index i=0; i<n; ++i)
+          if(abs(d(i))<pivtol)
+            d(i) = d(i)<RealScalar(0) ? -pivtol : pivtol;
+
+        // deterministic pseudo-random starting vector
+        unsigned int seed = 4101u + 2654435761u*unsigned(j);
+        for(Index i=0; i<n; ++i)
+        {
+          seed = 1664525u*seed + 1013904223u;
+          x(i) = RealScalar(int(seed>>8)) / RealScalar(1<<23) - RealScalar(1);
+        }
+
+        Index converged = 0;
+        Index iter = 0;
+        for(; iter<maxIterations && converged<=extraIterations; ++iter)
+        {
+          x *= RealScalar(n) * m_norm * (std::max)(eps, abs(d(n-1))) / x.template lpNorm<1>();
+
+          // solve (T - lambda I) y = x
+          for(Index i=0; i<n-1; ++i)
+          {
+            if(!pivots(i))
+              x(i+1) -= dl(i)*x(i);
+            else
+            {
+              RealScalar temp = x(i);
+              x(i) = x(i+1);
+              x(i+1) = temp - dl(i)*x(i);
+            }
+          }
+          x(n-1) /= d(n-1);
+          if(n>1)
+            x(n-2) = (x(n-2) - du(n-2)*x(n-1)) / d(n-2);
+          for(Index i=n-3; i>=0; --i)
+            x(i) = (x(i) - du(i)*x(i+1) - du2(i)*x(i+2)) / d(i);
+
+          // orthogonalize against the previous eigenvectors of the cluster
+          for(Index i=begin; i<j; ++i)
+            x -= eivec.col(i).dot(x) * eivec.col(i);
+
+          if(x.cwiseAbs().maxCoeff()>=criterion)
+            ++converged;
+        }
+        if(converged==0)
+          ok = false;
+        Index imax;
+        x.cwiseAbs().maxCoeff(&imax);
+        eivec.col(j) = x / (x(imax)<RealScalar(0) ? -x.norm() : x.norm());
+      }
+      return ok;
+    }
+
+    VectorType m_diag;
+    VectorType m_subdiag;
+    VectorType m_subdiag2;
+    RealScalar m_scale;
+    RealScalar m_lower;
+    RealScalar m_upper;
+    RealScalar m_norm;
+    RealScalar m_pivmin;
+};
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+#endif // EIGEN_TRIDIAGONAL_EIGEN_SOLVERS_H
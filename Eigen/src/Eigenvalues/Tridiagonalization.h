@@ -322,31 +322,11 @@ Tridiagonalization<MatrixType>::subDiagonal() const
 namespace internal {
 
 /** \internal
-  * Performs a tridiagonal decomposition of the selfadjoint matrix \a matA in-place.
-  *
-  * \param[in,out] matA On input the selfadjoint matrix. Only the \b lower triangular part is referenced.
-  *                     On output, the strict upper part is left unchanged, and the lower triangular part
-  *                     represents the T and Q matrices in packed format has detailed below.
-  * \param[out]    hCoeffs returned Householder coefficients (see below)
-  *
-  * On output, the tridiagonal selfadjoint matrix T is stored in the diagonal
-  * and lower sub-diagonal of the matrix \a matA.
-  * The unitary matrix Q is represented in a compact way as a product of
-  * Householder reflectors \f$ H_i \f$ such that:
-  *       \f$ Q = H_{N-1} \ldots H_1 H_0 \f$.
-  * The Householder reflectors are defined as
-  *       \f$ H_i = (I - h_i v_i v_i^T) \f$
-  * where \f$ h_i = hCoeffs[i]\f$ is the \f$ i \f$th Householder coefficient and
-  * \f$ v_i \f$ is the Householder vector defined by
-  *       \f$ v_i = [ 0, \ldots, 0, 1, matA(i+2,i), \ldots, matA(N-1,i) ]^T \f$.
-  *
-  * Implemented from Golub's "Matrix Computations", algorithm 8.3.1.
-  *
-  * \sa Tridiagonalization::packedMatrix()
+  * Unblocked tridiagonal decomposition of the selfadjoint matrix \a matA in-place, see tridiagonalization_inplace().
   */
 template<typename MatrixType, typename CoeffVectorType>
 EIGEN_DEVICE_FUNC
-void tridiagonalization_inplace(MatrixType& matA, CoeffVectorType& hCoeffs)
+void tridiagonalization_inplace_unblocked(MatrixType& matA, CoeffVectorType& hCoeffs)
 {
   using numext::conj;
   typedef typename MatrixType::Scalar Scalar;
@@ -379,6 +359,135 @@ void tridiagonalization_inplace(MatrixType& matA, CoeffVectorType& hCoeffs)
   }
 }
 
+/** \internal
+  * Helper routine for the block tridiagonal decomposition.
+  *
+  * This function reduces the first \a bs columns of the selfadjoint matrix \a A, of which only the lower
+  * triangular part is referenced, and stores in \a W the update matrix such that the remaining
+  * bottom-right block of \a A has to be updated by:
+  *   A22 -= V * W^* + W * V^*
+  * where V contains the Householder vectors stored in the lower part of the first \a bs columns of \a A.
+  * As in xLATRD, the unit coefficients of the Householder vectors are stored in \a A on output, and the
+  * \a bs sub-diagonal coefficients they replace are returned in \a subdiag.
+  */
+template<typename MatrixType, typename CoeffVectorType, typename WorkspaceType, typename SubDiagType>
+void tridiagonalization_blocked_helper(MatrixType& A, CoeffVectorType& hCoeffs, Index bs,
+                                       WorkspaceType& W, SubDiagType& subdiag)
+{
+  using numext::conj;
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename MatrixType::RealScalar RealScalar;
+  Index n = A.rows();
+
+  for(Index j = 0; j < bs; ++j)
+  {
+    Index remainingSize = n-j-1;
+
+    // 1 - apply the pending updates to the j-th column
+    if(j>0)
+    {
+      A.col(j).tail(n-j).noalias() -= A.block(j,0,n-j,j) * W.row(j).head(j).adjoint();
+      A.col(j).tail(n-j).noalias() -= W.block(j,0,n-j,j) * A.row(j).head(j).adjoint();
+    }
+
+    // 2 - construct the Householder transformation in-place
+    RealScalar beta;
+    Scalar h;
+    A.col(j).tail(remainingSize).makeHouseholderInPlace(h, beta);
+    A.col(j).coeffRef(j+1) = Scalar(1);
+    subdiag.coeffRef(j) = beta;
+    hCoeffs.coeffRef(j) = h;
+
+    // 3 - compute w = conj(h) * A22 * v, where A22 is the updated bottom-right block,
+    //     and make it such that the update reads A22 -= v * w^* + w * v^*
+    typename WorkspaceType::ColXpr::SegmentReturnType w = W.col(j).tail(remainingSize);
+    typename WorkspaceType::ColXpr::SegmentReturnType tmp = W.col(j).head(j);
+    typename MatrixType::ColXpr::SegmentReturnType v = A.col(j).tail(remainingSize);
+    w.noalias() = A.bottomRightCorner(remainingSize,remainingSize).template selfadjointView<Lower>() * v; // bottleneck
+    tmp.noalias() = W.block(j+1,0,remainingSize,j).adjoint() * v;
+    w.noalias() -= A.block(j+1,0,remainingSize,j) * tmp;
+    tmp.noalias() = A.block(j+1,0,remainingSize,j).adjoint() * v;
+    w.noalias() -= W.block(j+1,0,remainingSize,j) * tmp;
+    w *= conj(h);
+    w += (conj(h)*RealScalar(-0.5)*(w.dot(v))) * v;
+  }
+
+  // update A22 with level 3 operations
+  Index rs = n-bs;
+  A.bottomRightCorner(rs,rs).template triangularView<Lower>() -= A.block(bs,0,rs,bs) * W.block(bs,0,rs,bs).adjoint();
+  A.bottomRightCorner(rs,rs).template triangularView<Lower>() -= W.block(bs,0,rs,bs) * A.block(bs,0,rs,bs).adjoint();
+}
+
+/** \internal
+  * Block tridiagonal decomposition of the selfadjoint matrix \a matA in-place, see tridiagonalization_inplace().
+  *
+  * As xSYTRD, it reduces panels of \a maxBlockSize columns at a time with tridiagonalization_blocked_helper(),
+  * so that half of the operations are performed by matrix-matrix products. The last columns are reduced
+  * by tridiagonalization_inplace_unblocked().
+  */
+template<typename MatrixType, typename CoeffVectorType>
+void tridiagonalization_inplace_blocked(MatrixType& matA, CoeffVectorType& hCoeffs, Index maxBlockSize=32)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename MatrixType::RealScalar RealScalar;
+  typedef Block<MatrixType,Dynamic,Dynamic> BlockType;
+  typedef Matrix<Scalar,Dynamic,Dynamic> WorkspaceType;
+  Index n = matA.rows();
+  eigen_assert(n==matA.cols());
+  eigen_assert(n==hCoeffs.size()+1 || n==1);
+
+  WorkspaceType W(n,maxBlockSize);
+  Matrix<RealScalar,Dynamic,1> subdiag(maxBlockSize);
+  Index k = 0;
+  for(; n-k > 2*maxBlockSize; k += maxBlockSize)
+  {
+    BlockType A = matA.bottomRightCorner(n-k,n-k);
+    Block<CoeffVectorType,Dynamic,1> hCoeffsSegment = hCoeffs.segment(k,maxBlockSize);
+    Block<WorkspaceType,Dynamic,Dynamic> Wk = W.topRows(n-k);
+    tridiagonalization_blocked_helper(A, hCoeffsSegment, maxBlockSize, Wk, subdiag);
+    A.template diagonal<-1>().head(maxBlockSize) = subdiag.template cast<Scalar>();
+  }
+
+  BlockType A = matA.bottomRightCorner(n-k,n-k);
+  Block<CoeffVectorType,Dynamic,1> hCoeffsSegment = hCoeffs.tail(n-k-1);
+  tridiagonalization_inplace_unblocked(A, hCoeffsSegment);
+}
+
+/** \internal
+  * Performs a tridiagonal decomposition of the selfadjoint matrix \a matA in-place.
+  *
+  * \param[in,out] matA On input the selfadjoint matrix. Only the \b lower triangular part is referenced.
+  *                     On output, the strict upper part is left unchanged, and the lower triangular part
+  *                     represents the T and Q matrices in packed format has detailed below.
+  * \param[out]    hCoeffs returned Householder coefficients (see below)
+  *
+  * On output, the tridiagonal selfadjoint matrix T is stored in the diagonal
+  * and lower sub-diagonal of the matrix \a matA.
+  * The unitary matrix Q is represented in a compact way as a product of
+  * Householder reflectors \f$ H_i \f$ such that:
+  *       \f$ Q = H_{N-1} \ldots H_1 H_0 \f$.
+  * The Householder reflectors are defined as
+  *       \f$ H_i = (I - h_i v_i v_i^T) \f$
+  * where \f$ h_i = hCoeffs[i]\f$ is the \f$ i \f$th Householder coefficient and
+  * \f$ v_i \f$ is the Householder vector defined by
+  *       \f$ v_i = [ 0, \ldots, 0, 1, matA(i+2,i), \ldots, matA(N-1,i) ]^T \f$.
+  *
+  * Implemented from Golub's "Matrix Computations", algorithm 8.3.1. Large dynamic-size matrices are reduced
+  * by panels of columns, see tridiagonalization_inplace_blocked().
+  *
+  * \sa Tridiagonalization::packedMatrix()
+  */
+template<typename MatrixType, typename CoeffVectorType>
+EIGEN_DEVICE_FUNC
+void tridiagonalization_inplace(MatrixType& matA, CoeffVectorType& hCoeffs)
+{
+  // somewhat arbitrary threshold
+  if(MatrixType::MaxColsAtCompileTime==Dynamic && matA.cols()>=256)
+    tridiagonalization_inplace_blocked(matA, hCoeffs);
+  else
+    tridiagonalization_inplace_unblocked(matA, hCoeffs);
+}
+
 // forward declaration, implementation at the end of this file
 template<typename MatrixType,
          int Size=MatrixType::ColsAtCompileTime,
@@ -152,8 +152,16 @@ class IncompleteCholesky : public SparseSolverBase<IncompleteCholesky<Scalar,_Up
       if (m_perm.rows() == b.rows())  x = m_perm * b;
       else                            x = b;
       x = m_scale.asDiagonal() * x;
-      x = m_L.template triangularView<Lower>().solve(x);
-      x = m_L.adjoint().template triangularView<Upper>().solve(x);
+      if(m_lowerPlan.size()>0)
+      {
+        m_lowerPlan.solveInPlace(m_L, x);
+        m_upperPlan.solveInPlace(m_L, x);
+      }
+      else
+      {
+        x = m_L.template triangularView<Lower>().solve(x);
+        x = m_L.adjoint().template triangularView<Upper>().solve(x);
+      }
       x = m_scale.asDiagonal() * x;
       if (m_perm.rows() == b.rows())
         x = m_perm.inverse() * x;
@@ -176,6 +184,8 @@ class IncompleteCholesky : public SparseSolverBase<IncompleteCholesky<Scalar,_Up
     bool m_factorizationIsOk; 
     ComputationInfo m_info;
     PermutationType m_perm; 
+    SparseTriangularSolvePlan<FactorType,Lower> m_lowerPlan;  // Level-scheduled solves with L and L^*, for large factors only
+    SparseTriangularSolvePlan<FactorType,Upper> m_upperPlan;
 
   private:
     inline void updateList(Ref<const VectorIx> colPtr, Ref<VectorIx> rowIdx, Ref<VectorSx> vals, const Index& col, const Index& jk, VectorIx& firstElt, VectorList& listCol); 
@@ -191,6 +201,8 @@ void IncompleteCholesky<Scalar,_UpLo, OrderingType>::factorize(const _MatrixType
 {
   using std::sqrt;
   eigen_assert(m_analysisIsOk && "analyzePattern() should be called first"); 
+  m_lowerPlan = SparseTriangularSolvePlan<FactorType,Lower>();
+  m_upperPlan = SparseTriangularSolvePlan<FactorType,Upper>();
     
   // Dropping strategy : Keep only the p largest elements per column, where p is the number of elements in the column of the original matrix. Other strategies will be added
   
@@ -367,6 +379,12 @@ void IncompleteCholesky<Scalar,_UpLo, OrderingType>::factorize(const _MatrixType
       m_info = Success;
     }
   } while(m_info!=Success);
+
+  if(internal::use_sparse_triangular_solve_plan(m_L.nonZeros()))
+  {
+    m_lowerPlan.compute(m_L);
+    m_upperPlan.compute(m_L, true);
+  }
 }
 
 template<typename Scalar, int _UpLo, typename OrderingType>
@@ -171,8 +171,16 @@ class IncompleteLUT : public SparseSolverBase<IncompleteLUT<_Scalar, _StorageInd
     void _solve_impl(const Rhs& b, Dest& x) const
     {
       x = m_Pinv * b;
-      x = m_lu.template triangularView<UnitLower>().solve(x);
-      x = m_lu.template triangularView<Upper>().solve(x);
+      if(m_lowerPlan.size()>0)
+      {
+        m_lowerPlan.solveInPlace(m_lu, x);
+        m_upperPlan.solveInPlace(m_lu, x);
+      }
+      else
+      {
+        x = m_lu.template triangularView<UnitLower>().solve(x);
+        x = m_lu.template triangularView<Upper>().solve(x);
+      }
       x = m_P * x; 
     }
 
@@ -196,6 +204,8 @@ protected:
     ComputationInfo m_info;
     PermutationMatrix<Dynamic,Dynamic,StorageIndex> m_P;     // Fill-reducing permutation
     PermutationMatrix<Dynamic,Dynamic,StorageIndex> m_Pinv;  // Inverse permutation
+    SparseTriangularSolvePlan<FactorType,UnitLower> m_lowerPlan;  // Level-scheduled solves with L and U, for large factors only
+    SparseTriangularSolvePlan<FactorType,Upper> m_upperPlan;
 };
 
 /**
@@ -251,6 +261,8 @@ void IncompleteLUT<Scalar,StorageIndex>::factorize(const _MatrixType& amat)
   eigen_assert((amat.rows() == amat.cols()) && "The factorization should be done on a square matrix");
   Index n = amat.cols();  // Size of the matrix
   m_lu.resize(n,n);
+  m_lowerPlan = SparseTriangularSolvePlan<FactorType,UnitLower>();
+  m_upperPlan = SparseTriangularSolvePlan<FactorType,Upper>();
   // Declare Working vectors and variables
   Vector u(n) ;     // real values of the row -- maximum size is n --
   VectorI ju(n);   // column position of the values in u -- maximum size  is n
@@ -444,6 +456,12 @@ void IncompleteLUT<Scalar,StorageIndex>::factorize(const _MatrixType& amat)
   m_lu.finalize();
   m_lu.makeCompressed();
 
+  if(internal::use_sparse_triangular_solve_plan(m_lu.nonZeros()))
+  {
+    m_lowerPlan.compute(m_lu);
+    m_upperPlan.compute(m_lu);
+  }
+
   m_factorizationIsOk = true;
   m_info = Success;
 }
@@ -44,6 +44,10 @@ template<typename _MatrixType> struct traits<ColPivHouseholderQR<_MatrixType> >
   * This decomposition performs column pivoting in order to be rank-revealing and improve
   * numerical stability. It is slower than HouseholderQR, and faster than FullPivHouseholderQR.
   *
+  * Large matrices are factorized by panels of columns, as done by LAPACK's \c xGEQP3: the Householder
+  * reflectors of a panel are accumulated and applied to the trailing columns at once by a matrix-matrix
+  * product, while the norms of the remaining columns are downdated from the rows of \b R as they are computed.
+  *
   * This class supports the \link InplaceDecomposition inplace decomposition \endlink mechanism.
   * 
   * \sa MatrixBase::colPivHouseholderQr()
@@ -432,6 +436,9 @@ template<typename _MatrixType> class ColPivHouseholderQR
     }
 
     void computeInPlace();
+    Index pivotColumn(Index k, RealScalar threshold_helper, Index& number_of_transpositions);
+    Index computePanelInPlace(Index k0, Index blockSize, RealScalar threshold_helper, RealScalar norm_downdate_threshold,
+                              Index& number_of_transpositions);
 
     MatrixType m_qr;
     HCoeffsType m_hCoeffs;
@@ -514,26 +521,16 @@ void ColPivHouseholderQR<MatrixType>::computeInPlace()
   m_nonzero_pivots = size; // the generic case is that in which all pivots are nonzero (invertible case)
   m_maxpivot = RealScalar(0);
 
-  for(Index k = 0; k < size; ++k)
+  // large matrices are factorized by panels, and their last columns one at a time
+  const Index blockSize = 32;
+  Index k = 0;
+  if(rows >= 2*blockSize && MatrixType::MaxColsAtCompileTime == Dynamic)
+    while(size - k > 2*blockSize)
+      k += computePanelInPlace(k, blockSize, threshold_helper, norm_downdate_threshold, number_of_transpositions);
+
+  for(; k < size; ++k)
   {
-    // first, we look up in our table m_colNormsUpdated which column has the biggest norm
-    Index biggest_col_index;
-    RealScalar biggest_col_sq_norm = numext::abs2(m_colNormsUpdated.tail(cols-k).maxCoeff(&biggest_col_index));
-    biggest_col_index += k;
-
-    // Track the number of meaningful pivots but do not stop the decomposition to make
-    // sure that the initial matrix is properly reproduced. See bug 941.
-    if(m_nonzero_pivots==size && biggest_col_sq_norm < threshold_helper * RealScalar(rows-k))
-      m_nonzero_pivots = k;
-
-    // apply the transposition to the columns
-    m_colsTranspositions.coeffRef(k) = biggest_col_index;
-    if(k != biggest_col_index) {
-      m_qr.col(k).swap(m_qr.col(biggest_col_index));
-      std::swap(m_colNormsUpdated.coeffRef(k), m_colNormsUpdated.coeffRef(biggest_col_index));
-      std::swap(m_colNormsDirect.coeffRef(k), m_colNormsDirect.coeffRef(biggest_col_index));
-      ++number_of_transpositions;
-    }
+    pivotColumn(k, threshold_helper, number_of_transpositions);
 
     // generate the householder vector, store it below the diagonal
     RealScalar beta;
@@ -581,6 +578,124 @@ void ColPivHouseholderQR<MatrixType>::computeInPlace()
   m_isInitialized = true;
 }
 
+/** \internal Swaps the column of largest norm among the columns \a k to cols()-1 with the column \a k, and returns its
+  * former index. */
+template<typename MatrixType>
+Index ColPivHouseholderQR<MatrixType>::pivotColumn(Index k, RealScalar threshold_helper, Index& number_of_transpositions)
+{
+  const Index rows = m_qr.rows();
+  const Index cols = m_qr.cols();
+
+  // first, we look up in our table m_colNormsUpdated which column has the biggest norm
+  Index biggest_col_index;
+  RealScalar biggest_col_sq_norm = numext::abs2(m_colNormsUpdated.tail(cols-k).maxCoeff(&biggest_col_index));
+  biggest_col_index += k;
+
+  // Track the number of meaningful pivots but do not stop the decomposition to make
+  // sure that the initial matrix is properly reproduced. See bug 941.
+  if(m_nonzero_pivots==m_qr.diagonalSize() && biggest_col_sq_norm < threshold_helper * RealScalar(rows-k))
+    m_nonzero_pivots = k;
+
+  // apply the transposition to the columns
+  m_colsTranspositions.coeffRef(k) = biggest_col_index;
+  if(k != biggest_col_index) {
+    m_qr.col(k).swap(m_qr.col(biggest_col_index));
+    std::swap(m_colNormsUpdated.coeffRef(k), m_colNormsUpdated.coeffRef(biggest_col_index));
+    std::swap(m_colNormsDirect.coeffRef(k), m_colNormsDirect.coeffRef(biggest_col_index));
+    ++number_of_transpositions;
+  }
+  return biggest_col_index;
+}
+
+/** \internal Factorizes at most \a blockSize columns starting at \a k0, and returns their number.
+  *
+  * This follows LAPACK's \c xLAQPS: the reflectors H_k = I - h_k v_k v_k^* of the panel are applied to the trailing
+  * columns by a single update A -= V F^*, where the column \c k of F is conj(h_k) times the trailing columns, as
+  * updated by the previous reflectors of the panel, times v_k. Within the panel, only the current column and the
+  * current row of \b R are updated, which is enough to downdate the column norms and choose the next pivot. The
+  * panel stops early when a downdated norm becomes inaccurate, since it must then be recomputed from the updated
+  * trailing columns.
+  */
+template<typename MatrixType>
+Index ColPivHouseholderQR<MatrixType>::computePanelInPlace(Index k0, Index blockSize, RealScalar threshold_helper,
+                                                           RealScalar norm_downdate_threshold, Index& number_of_transpositions)
+{
+  using std::abs;
+  typedef Matrix<Scalar,Dynamic,Dynamic> PanelType;
+  typedef Matrix<Scalar,Dynamic,1> PanelVectorType;
+
+  const Index rows = m_qr.rows();
+  const Index cols = m_qr.cols();
+  PanelType F(cols-k0, blockSize);
+  PanelVectorType aux(blockSize);
+  Matrix<Index,Dynamic,1> recompute(cols-k0);
+  Index recomputeCount = 0;
+
+  Index k = 0;
+  while(k < blockSize && recomputeCount == 0)
+  {
+    const Index rk = k0 + k;
+    const Index biggest_col_index = pivotColumn(rk, threshold_helper, number_of_transpositions);
+    if(rk != biggest_col_index)
+      F.row(k).swap(F.row(biggest_col_index-k0));
+
+    // apply the previous reflectors of the panel to the pivot column, whose upper part is already up to date
+    if(k > 0)
+      m_qr.col(rk).tail(rows-rk).noalias() -= m_qr.block(rk, k0, rows-rk, k) * F.row(k).head(k).adjoint();
+
+    // generate the householder vector, store it below the diagonal
+    RealScalar beta;
+    m_qr.col(rk).tail(rows-rk).makeHouseholderInPlace(m_hCoeffs.coeffRef(rk), beta);
+    if(abs(beta) > m_maxpivot) m_maxpivot = abs(beta);
+    const Scalar tau = m_hCoeffs.coeff(rk);
+    m_qr.coeffRef(rk,rk) = Scalar(1);
+
+    // F(:,k) = conj(tau) (A - V F^*)^* v
+    F.col(k).head(k+1).setZero();
+    if(rk+1 < cols)
+      F.col(k).tail(cols-rk-1).noalias() = numext::conj(tau) * (m_qr.block(rk, rk+1, rows-rk, cols-rk-1).adjoint() * m_qr.col(rk).tail(rows-rk));
+    if(k > 0)
+    {
+      aux.head(k).noalias() = -numext::conj(tau) * (m_qr.block(rk, k0, rows-rk, k).adjoint() * m_qr.col(rk).tail(rows-rk));
+      F.col(k).noalias() += F.leftCols(k) * aux.head(k);
+    }
+
+    // update the current row of R
+    if(rk+1 < cols)
+      m_qr.row(rk).tail(cols-rk-1).noalias() -= m_qr.row(rk).segment(k0, k+1) * F.block(k+1, 0, cols-rk-1, k+1).adjoint();
+    m_qr.coeffRef(rk,rk) = beta;
+
+    // downdate the norms of the remaining columns, see computeInPlace()
+    for(Index j = rk + 1; j < cols; ++j) {
+      if (m_colNormsUpdated.coeffRef(j) != RealScalar(0)) {
+        RealScalar temp = abs(m_qr.coeffRef(rk, j)) / m_colNormsUpdated.coeffRef(j);
+        temp = (RealScalar(1) + temp) * (RealScalar(1) - temp);
+        temp = temp <  RealScalar(0) ? RealScalar(0) : temp;
+        RealScalar temp2 = temp * numext::abs2<RealScalar>(m_colNormsUpdated.coeffRef(j) /
+                                                           m_colNormsDirect.coeffRef(j));
+        if (temp2 <= norm_downdate_threshold)
+          recompute(recomputeCount++) = j;
+        else
+          m_colNormsUpdated.coeffRef(j) *= numext::sqrt(temp);
+      }
+    }
+    ++k;
+  }
+
+  // apply the reflectors of the panel to the rows below it
+  const Index last = k0 + k;
+  if(last < rows && last < cols)
+    m_qr.bottomRightCorner(rows-last, cols-last).noalias() -= m_qr.block(last, k0, rows-last, k) * F.block(k, 0, cols-last, k).adjoint();
+
+  for(Index i = 0; i < recomputeCount; ++i)
+  {
+    const Index j = recompute(i);
+    m_colNormsDirect.coeffRef(j) = m_qr.col(j).tail(rows-last).norm();
+    m_colNormsUpdated.coeffRef(j) = m_colNormsDirect.coeffRef(j);
+  }
+  return k;
+}
+
 #ifndef EIGEN_PARSED_BY_DOXYGEN
 template<typename _MatrixType>
 template<typename RhsType, typename DstType>
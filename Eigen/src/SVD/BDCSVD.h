@@ -42,7 +42,10 @@ struct traits<BDCSVD<_MatrixType> >
         : traits<_MatrixType>
 {
   typedef _MatrixType MatrixType;
-};  
+};
+
+/** \internal Estimated cost, in cycles, of one term of the secular equation of BDCSVD, see parallel_cwise_threads(). */
+const int BDCSVDSecularCost = 10;
 
 } // end namespace internal
   
@@ -62,6 +65,9 @@ struct traits<BDCSVD<_MatrixType> >
  * For small matrice (<16), it is thus preferable to directly use JacobiSVD. For larger ones, BDCSVD is highly
  * recommended and can several order of magnitude faster.
  *
+ * The two halves of the large divide steps are diagonalized concurrently, as well as the roots of the secular
+ * equations of their merges, see \ref TopicMultiThreading.
+ *
  * \warning this algorithm is unlikely to provide accurate result when compiled with unsafe math optimizations.
  * For instance, this concerns Intel's compiler (ICC), which performs such optimization by default unless
  * you compile with the \c -fp-model \c precise option. Likewise, the \c -ffast-math option of GCC or clang will
@@ -178,22 +184,92 @@ public:
  
 private:
   void allocate(Index rows, Index cols, unsigned int computationOptions);
-  void divide(Index firstCol, Index lastCol, Index firstRowW, Index firstColW, Index shift);
-  void computeSVDofM(Index firstCol, Index n, MatrixXr& U, VectorType& singVals, MatrixXr& V);
-  void computeSingVals(const ArrayRef& col0, const ArrayRef& diag, const IndicesRef& perm, VectorType& singVals, ArrayRef shifts, ArrayRef mus);
-  void perturbCol0(const ArrayRef& col0, const ArrayRef& diag, const IndicesRef& perm, const VectorType& singVals, const ArrayRef& shifts, const ArrayRef& mus, ArrayRef zhat);
-  void computeSingVecs(const ArrayRef& zhat, const ArrayRef& diag, const IndicesRef& perm, const VectorType& singVals, const ArrayRef& shifts, const ArrayRef& mus, MatrixXr& U, MatrixXr& V);
+  int divide(Index firstCol, Index lastCol, Index firstRowW, Index firstColW, Index shift, RealScalar* workspace, Index* workspaceI);
+  int computeSVDofM(Index firstCol, Index n, MatrixXr& U, VectorType& singVals, MatrixXr& V, RealScalar* workspace, Index* workspaceI);
+  int computeSingVals(const ArrayRef& col0, const ArrayRef& diag, const IndicesRef& perm, VectorType& singVals, ArrayRef shifts, ArrayRef mus, Index begin, Index end, ArrayRef diagShifted);
+  void perturbCol0(const ArrayRef& col0, const ArrayRef& diag, const IndicesRef& perm, const VectorType& singVals, const ArrayRef& shifts, const ArrayRef& mus, ArrayRef zhat, Index begin, Index end);
+  void computeSingVecs(const ArrayRef& zhat, const ArrayRef& diag, const IndicesRef& perm, const VectorType& singVals, const ArrayRef& shifts, const ArrayRef& mus, MatrixXr& U, MatrixXr& V, Index begin, Index end);
   void deflation43(Index firstCol, Index shift, Index i, Index size);
   void deflation44(Index firstColu , Index firstColm, Index firstRowW, Index firstColW, Index i, Index j, Index size);
-  void deflation(Index firstCol, Index lastCol, Index k, Index firstRowW, Index firstColW, Index shift);
+  void deflation(Index firstCol, Index lastCol, Index k, Index firstRowW, Index firstColW, Index shift, Index* workspaceI);
   template<typename HouseholderU, typename HouseholderV, typename NaiveU, typename NaiveV>
   void copyUV(const HouseholderU &householderU, const HouseholderV &householderV, const NaiveU &naiveU, const NaiveV &naivev);
-  void structured_update(Block<MatrixXr,Dynamic,Dynamic> A, const MatrixXr &B, Index n1);
+  void structured_update(Block<MatrixXr,Dynamic,Dynamic> A, const MatrixXr &B, Index n1, RealScalar* workspace);
   static RealScalar secularEq(RealScalar x, const ArrayRef& col0, const ArrayRef& diag, const IndicesRef &perm, const ArrayRef& diagShifted, RealScalar shift);
 
+  // diagonalizes one of the two halves of a divide step, each of them working on its own part of the workspace
+  struct divide_task
+  {
+    divide_task(BDCSVD& svd, Index firstCol, Index lastCol, Index firstRowW, Index firstColW, Index shift,
+                RealScalar* workspace, Index* workspaceI, int* numIters)
+      : m_svd(svd), m_firstCol(firstCol), m_lastCol(lastCol), m_firstRowW(firstRowW), m_firstColW(firstColW), m_shift(shift),
+        m_workspace(workspace), m_workspaceI(workspaceI), m_numIters(numIters)
+    {}
+
+    void operator()(Index i) const
+    {
+      Index k = (m_lastCol - m_firstCol + 1)/2;
+      if(i==0)
+        m_numIters[0] = m_svd.divide(m_firstCol + k + 1, m_lastCol, m_firstRowW + k + 1, m_firstColW + k + 1, m_shift,
+                                     m_workspace + 3*(k+1)*(k+1), m_workspaceI + 3*k);
+      else
+        m_numIters[1] = m_svd.divide(m_firstCol, m_firstCol + k - 1, m_firstRowW, m_firstColW + 1, m_shift + 1,
+                                     m_workspace, m_workspaceI);
+    }
+
+    BDCSVD& m_svd;
+    Index m_firstCol, m_lastCol, m_firstRowW, m_firstColW, m_shift;
+    RealScalar* m_workspace;
+    Index* m_workspaceI;
+    int* m_numIters;
+  };
+
+  // computes the singular values, the perturbed first column zhat, or the singular vectors of the
+  // deflated matrix M for a range of its singular values
+  struct secular_task
+  {
+    enum Phase { SingVals, PerturbCol0, SingVecs };
+
+    secular_task(Phase phase, BDCSVD& svd, Index numTasks, const ArrayRef& col0, const ArrayRef& diag, const IndicesRef& perm,
+                 VectorType& singVals, Map<ArrayXr>& shifts, Map<ArrayXr>& mus, Map<ArrayXr>& zhat,
+                 MatrixXr& U, MatrixXr& V, RealScalar* workspace, int* numIters)
+      : m_phase(phase), m_svd(svd), m_numTasks(numTasks), m_col0(col0), m_diag(diag), m_perm(perm), m_singVals(singVals),
+        m_shifts(shifts), m_mus(mus), m_zhat(zhat), m_U(U), m_V(V), m_workspace(workspace), m_numIters(numIters)
+    {}
+
+    void operator()(Index t) const
+    {
+      Index n = m_col0.size();
+      Index begin = (t*n)/m_numTasks, end = ((t+1)*n)/m_numTasks;
+      if(m_phase==SingVals)
+        m_numIters[t] = m_svd.computeSingVals(m_col0, m_diag, m_perm, m_singVals, m_shifts, m_mus, begin, end,
+                                              Map<ArrayXr>(m_workspace + t*n, n));
+      else if(m_phase==PerturbCol0)
+        m_svd.perturbCol0(m_col0, m_diag, m_perm, m_singVals, m_shifts, m_mus, m_zhat, begin, end);
+      else
+        m_svd.computeSingVecs(m_zhat, m_diag, m_perm, m_singVals, m_shifts, m_mus, m_U, m_V, begin, end);
+    }
+
+    Phase m_phase;
+    BDCSVD& m_svd;
+    Index m_numTasks;
+    const ArrayRef& m_col0;
+    const ArrayRef& m_diag;
+    const IndicesRef& m_perm;
+    VectorType& m_singVals;
+    Map<ArrayXr>& m_shifts;
+    Map<ArrayXr>& m_mus;
+    Map<ArrayXr>& m_zhat;
+    MatrixXr& m_U;
+    MatrixXr& m_V;
+    RealScalar* m_workspace;
+    int* m_numIters;
+  };
+
 protected:
   MatrixXr m_naiveU, m_naiveV;
   MatrixXr m_computed;
+  VectorType m_diagonal, m_superdiagonal;
   Index m_nRec;
   ArrayXr m_workspace;
   ArrayXi m_workspaceI;
@@ -226,6 +302,8 @@ void BDCSVD<MatrixType>::allocate(Eigen::Index rows, Eigen::Index cols, unsigned
     return;
   
   m_computed = MatrixXr::Zero(m_diagSize + 1, m_diagSize );
+  m_diagonal.resize(m_diagSize);
+  m_superdiagonal.resize(m_diagSize);
   m_compU = computeV();
   m_compV = computeU();
   if (m_isTranspose)
@@ -278,10 +356,13 @@ BDCSVD<MatrixType>& BDCSVD<MatrixType>::compute(const MatrixType& matrix, unsign
   //**** step 2 - Divide & Conquer
   m_naiveU.setZero();
   m_naiveV.setZero();
-  // FIXME this line involves a temporary matrix
-  m_computed.topRows(m_diagSize) = bid.bidiagonal().toDenseMatrix().transpose();
-  m_computed.template bottomRows<1>().setZero();
-  divide(0, m_diagSize - 1, 0, 0, 0);
+  // The bidiagonal matrix is kept aside, since the subproblems are diagonalized in place in m_computed
+  // and overwrite the input of their neighbors.
+  m_diagonal = bid.bidiagonal().diagonal().transpose();
+  m_superdiagonal.head(m_diagSize - 1) = bid.bidiagonal().diagonal(1).transpose();
+  m_superdiagonal(m_diagSize - 1) = Literal(0);
+  m_computed.setZero();
+  m_numIters += divide(0, m_diagSize - 1, 0, 0, 0, m_workspace.data(), m_workspaceI.data());
 
   //**** step 3 - Copy singular values and vectors
   for (int i=0; i<m_diagSize; i++)
@@ -340,10 +421,10 @@ void BDCSVD<MatrixType>::copyUV(const HouseholderU &householderU, const Househol
   *      [A2]
   * such that A1.rows()==n1, then we assume that at least half of the columns of A1 and A2 are zeros.
   * We can thus pack them prior to the the matrix product. However, this is only worth the effort if the matrix is large
-  * enough.
+  * enough. The \a workspace must hold 3*n*n coefficients, where n is the size of A.
   */
 template<typename MatrixType>
-void BDCSVD<MatrixType>::structured_update(Block<MatrixXr,Dynamic,Dynamic> A, const MatrixXr &B, Index n1)
+void BDCSVD<MatrixType>::structured_update(Block<MatrixXr,Dynamic,Dynamic> A, const MatrixXr &B, Index n1, RealScalar* workspace)
 {
   Index n = A.rows();
   if(n>100)
@@ -351,10 +432,10 @@ void BDCSVD<MatrixType>::structured_update(Block<MatrixXr,Dynamic,Dynamic> A, co
     // If the matrices are large enough, let's exploit the sparse structure of A by
     // splitting it in half (wrt n1), and packing the non-zero columns.
     Index n2 = n - n1;
-    Map<MatrixXr> A1(m_workspace.data()      , n1, n);
-    Map<MatrixXr> A2(m_workspace.data()+ n1*n, n2, n);
-    Map<MatrixXr> B1(m_workspace.data()+  n*n, n,  n);
-    Map<MatrixXr> B2(m_workspace.data()+2*n*n, n,  n);
+    Map<MatrixXr> A1(workspace      , n1, n);
+    Map<MatrixXr> A2(workspace+ n1*n, n2, n);
+    Map<MatrixXr> B1(workspace+  n*n, n,  n);
+    Map<MatrixXr> B2(workspace+2*n*n, n,  n);
     Index k1=0, k2=0;
     for(Index j=0; j<n; ++j)
     {
@@ -377,7 +458,7 @@ void BDCSVD<MatrixType>::structured_update(Block<MatrixXr,Dynamic,Dynamic> A, co
   }
   else
   {
-    Map<MatrixXr,Aligned> tmp(m_workspace.data(),n,n);
+    Map<MatrixXr> tmp(workspace,n,n);
     tmp.noalias() = A*B;
     A = tmp;
   }
@@ -393,8 +474,11 @@ void BDCSVD<MatrixType>::structured_update(Block<MatrixXr,Dynamic,Dynamic> A, co
 //@param firstRowW : Same as firstRowW with the column.
 //@param shift : Each time one takes the left submatrix, one must add 1 to the shift. Why? Because! We actually want the last column of the U submatrix 
 // to become the first column (*coeff) and to shift all the other columns to the right. There are more details on the reference paper.
+//@param workspace, workspaceI : The workspaces of the submatrix, of 3*(n+1)*(n+1) and 3*n coefficients respectively, where n is its size.
+//@return the number of iterations spent in the secular equations.
 template<typename MatrixType>
-void BDCSVD<MatrixType>::divide (Eigen::Index firstCol, Eigen::Index lastCol, Eigen::Index firstRowW, Eigen::Index firstColW, Eigen::Index shift)
+int BDCSVD<MatrixType>::divide (Eigen::Index firstCol, Eigen::Index lastCol, Eigen::Index firstRowW, Eigen::Index firstColW, Eigen::Index shift,
+                                RealScalar* workspace, Eigen::Index* workspaceI)
 {
   // requires rows = cols + 1;
   using std::pow;
@@ -413,7 +497,10 @@ void BDCSVD<MatrixType>::divide (Eigen::Index firstCol, Eigen::Index lastCol, Ei
   if (n < m_algoswap)
   {
     // FIXME this line involves temporaries
-    JacobiSVD<MatrixXr> b(m_computed.block(firstCol, firstCol, n + 1, n), ComputeFullU | (m_compV ? ComputeFullV : 0));
+    MatrixXr B = MatrixXr::Zero(n + 1, n);
+    B.diagonal() = m_diagonal.segment(firstCol, n);
+    B.diagonal(-1) = m_superdiagonal.segment(firstCol, n);
+    JacobiSVD<MatrixXr> b(B, ComputeFullU | (m_compV ? ComputeFullV : 0));
     if (m_compU)
       m_naiveU.block(firstCol, firstCol, n + 1, n + 1).real() = b.matrixU();
     else 
@@ -424,16 +511,17 @@ void BDCSVD<MatrixType>::divide (Eigen::Index firstCol, Eigen::Index lastCol, Ei
     if (m_compV) m_naiveV.block(firstRowW, firstColW, n, n).real() = b.matrixV();
     m_computed.block(firstCol + shift, firstCol + shift, n + 1, n).setZero();
     m_computed.diagonal().segment(firstCol + shift, n) = b.singularValues().head(n);
-    return;
+    return 0;
   }
   // We use the divide and conquer algorithm
-  alphaK =  m_computed(firstCol + k, firstCol + k);
-  betaK = m_computed(firstCol + k + 1, firstCol + k);
-  // The divide must be done in that order in order to have good results. Divide change the data inside the submatrices
-  // and the divide of the right submatrice reads one column of the left submatrice. That's why we need to treat the 
-  // right submatrix before the left one. 
-  divide(k + 1 + firstCol, lastCol, k + 1 + firstRowW, k + 1 + firstColW, shift);
-  divide(firstCol, k - 1 + firstCol, firstRowW, firstColW + 1, shift + 1);
+  alphaK = m_diagonal(firstCol + k);
+  betaK = m_superdiagonal(firstCol + k);
+  // The right and left submatrices write to disjoint parts of m_computed, m_naiveU and m_naiveV, and read the
+  // bidiagonal matrix from m_diagonal and m_superdiagonal: they can be treated concurrently. The left one works on the
+  // first 3*(k+1)^2 coefficients of the workspace, and the right one on the next 3*(n-k)^2 ones.
+  int numIters[2];
+  Index threads = internal::parallel_cwise_threads(double(k)*double(k)*double(k));
+  internal::parallel_run_tasks(2, threads, divide_task(*this, firstCol, lastCol, firstRowW, firstColW, shift, workspace, workspaceI, numIters));
 
   if (m_compU)
   {
@@ -521,7 +609,7 @@ void BDCSVD<MatrixType>::divide (Eigen::Index firstCol, Eigen::Index lastCol, Ei
   ArrayXr tmp1 = (m_computed.block(firstCol+shift, firstCol+shift, n, n)).jacobiSvd().singularValues();
 #endif
   // Second part: try to deflate singular values in combined matrix
-  deflation(firstCol, lastCol, k, firstRowW, firstColW, shift);
+  deflation(firstCol, lastCol, k, firstRowW, firstColW, shift, workspaceI);
 #ifdef EIGEN_BDCSVD_DEBUG_VERBOSE
   ArrayXr tmp2 = (m_computed.block(firstCol+shift, firstCol+shift, n, n)).jacobiSvd().singularValues();
   std::cout << "\n\nj1 = " << tmp1.transpose().format(bdcsvdfmt) << "\n";
@@ -537,7 +625,7 @@ void BDCSVD<MatrixType>::divide (Eigen::Index firstCol, Eigen::Index lastCol, Ei
   // Third part: compute SVD of combined matrix
   MatrixXr UofSVD, VofSVD;
   VectorType singVals;
-  computeSVDofM(firstCol + shift, n, UofSVD, singVals, VofSVD);
+  int numItersM = computeSVDofM(firstCol + shift, n, UofSVD, singVals, VofSVD, workspace, workspaceI);
   
 #ifdef EIGEN_BDCSVD_SANITY_CHECKS
   assert(UofSVD.allFinite());
@@ -545,15 +633,15 @@ void BDCSVD<MatrixType>::divide (Eigen::Index firstCol, Eigen::Index lastCol, Ei
 #endif
   
   if (m_compU)
-    structured_update(m_naiveU.block(firstCol, firstCol, n + 1, n + 1), UofSVD, (n+2)/2);
+    structured_update(m_naiveU.block(firstCol, firstCol, n + 1, n + 1), UofSVD, (n+2)/2, workspace);
   else
   {
-    Map<Matrix<RealScalar,2,Dynamic>,Aligned> tmp(m_workspace.data(),2,n+1);
+    Map<Matrix<RealScalar,2,Dynamic> > tmp(workspace,2,n+1);
     tmp.noalias() = m_naiveU.middleCols(firstCol, n+1) * UofSVD;
     m_naiveU.middleCols(firstCol, n + 1) = tmp;
   }
   
-  if (m_compV)  structured_update(m_naiveV.block(firstRowW, firstColW, n, n), VofSVD, (n+1)/2);
+  if (m_compV)  structured_update(m_naiveV.block(firstRowW, firstColW, n, n), VofSVD, (n+1)/2, workspace);
   
 #ifdef EIGEN_BDCSVD_SANITY_CHECKS
   assert(m_naiveU.allFinite());
@@ -563,24 +651,28 @@ void BDCSVD<MatrixType>::divide (Eigen::Index firstCol, Eigen::Index lastCol, Ei
   
   m_computed.block(firstCol + shift, firstCol + shift, n, n).setZero();
   m_computed.block(firstCol + shift, firstCol + shift, n, n).diagonal() = singVals;
+  return numIters[0] + numIters[1] + numItersM;
 }// end divide
 
 // Compute SVD of m_computed.block(firstCol, firstCol, n + 1, n); this block only has non-zeros in
 // the first column and on the diagonal and has undergone deflation, so diagonal is in increasing
 // order except for possibly the (0,0) entry. The computed SVD is stored U, singVals and V, except
 // that if m_compV is false, then V is not computed. Singular values are sorted in decreasing order.
+// The singular values, and then the singular vectors, of large matrices are computed concurrently by ranges.
+// Returns the number of iterations spent in the secular equation.
 //
 // TODO Opportunities for optimization: better root finding algo, better stopping criterion, better
 // handling of round-off errors, be consistent in ordering
 // For instance, to solve the secular equation using FMM, see http://www.stat.uchicago.edu/~lekheng/courses/302/classics/greengard-rokhlin.pdf
 template <typename MatrixType>
-void BDCSVD<MatrixType>::computeSVDofM(Eigen::Index firstCol, Eigen::Index n, MatrixXr& U, VectorType& singVals, MatrixXr& V)
+int BDCSVD<MatrixType>::computeSVDofM(Eigen::Index firstCol, Eigen::Index n, MatrixXr& U, VectorType& singVals, MatrixXr& V,
+                                      RealScalar* workspace, Eigen::Index* workspaceI)
 {
   const RealScalar considerZero = (std::numeric_limits<RealScalar>::min)();
   using std::abs;
   ArrayRef col0 = m_computed.col(firstCol).segment(firstCol, n);
-  m_workspace.head(n) =  m_computed.block(firstCol, firstCol, n, n).diagonal();
-  ArrayRef diag = m_workspace.head(n);
+  ArrayRef diag = Map<ArrayXr>(workspace, n);
+  diag = m_computed.block(firstCol, firstCol, n, n).diagonal();
   diag(0) = Literal(0);
 
   // Allocate space for singular values and vectors
@@ -601,12 +693,18 @@ void BDCSVD<MatrixType>::computeSVDofM(Eigen::Index firstCol, Eigen::Index n, Ma
   Index m = 0; // size of the deflated problem
   for(Index k=0;k<actual_n;++k)
     if(abs(col0(k))>considerZero)
-      m_workspaceI(m++) = k;
-  Map<ArrayXi> perm(m_workspaceI.data(),m);
+      workspaceI[m++] = k;
+  IndicesRef perm = Map<ArrayXi>(workspaceI,m);
   
-  Map<ArrayXr> shifts(m_workspace.data()+1*n, n);
-  Map<ArrayXr> mus(m_workspace.data()+2*n, n);
-  Map<ArrayXr> zhat(m_workspace.data()+3*n, n);
+  Map<ArrayXr> shifts(workspace+1*n, n);
+  Map<ArrayXr> mus(workspace+2*n, n);
+  Map<ArrayXr> zhat(workspace+3*n, n);
+
+  // Each task shifts the diagonal by its own roots in the next n coefficients of the workspace.
+  Index threads = internal::parallel_cwise_threads(double(n)*double(m)*double(internal::BDCSVDSecularCost));
+  Index numTasks = threads>1 ? (std::min)(4*threads, n) : 1;
+  Matrix<int,Dynamic,1> numIters = Matrix<int,Dynamic,1>::Zero(numTasks);
+  typedef secular_task Task;
 
 #ifdef EIGEN_BDCSVD_DEBUG_VERBOSE
   std::cout << "computeSVDofM using:\n";
@@ -615,7 +713,7 @@ void BDCSVD<MatrixType>::computeSVDofM(Eigen::Index firstCol, Eigen::Index n, Ma
 #endif
   
   // Compute singVals, shifts, and mus
-  computeSingVals(col0, diag, perm, singVals, shifts, mus);
+  internal::parallel_run_tasks(numTasks, threads, Task(Task::SingVals, *this, numTasks, col0, diag, perm, singVals, shifts, mus, zhat, U, V, workspace+4*n, numIters.data()));
   
 #ifdef EIGEN_BDCSVD_DEBUG_VERBOSE
   std::cout << "  j:        " << (m_computed.block(firstCol, firstCol, n, n)).jacobiSvd().singularValues().transpose().reverse() << "\n\n";
@@ -639,7 +737,7 @@ void BDCSVD<MatrixType>::computeSVDofM(Eigen::Index firstCol, Eigen::Index n, Ma
 #endif
   
   // Compute zhat
-  perturbCol0(col0, diag, perm, singVals, shifts, mus, zhat);
+  internal::parallel_run_tasks(numTasks, threads, Task(Task::PerturbCol0, *this, numTasks, col0, diag, perm, singVals, shifts, mus, zhat, U, V, workspace+4*n, numIters.data()));
 #ifdef  EIGEN_BDCSVD_DEBUG_VERBOSE
   std::cout << "  zhat: " << zhat.transpose() << "\n";
 #endif
@@ -648,7 +746,8 @@ void BDCSVD<MatrixType>::computeSVDofM(Eigen::Index firstCol, Eigen::Index n, Ma
   assert(zhat.allFinite());
 #endif
   
-  computeSingVecs(zhat, diag, perm, singVals, shifts, mus, U, V);
+  internal::parallel_run_tasks(numTasks, threads, Task(Task::SingVecs, *this, numTasks, col0, diag, perm, singVals, shifts, mus, zhat, U, V, workspace+4*n, numIters.data()));
+  U.col(n) = VectorType::Unit(n+1, n);
   
 #ifdef  EIGEN_BDCSVD_DEBUG_VERBOSE
   std::cout << "U^T U: " << (U.transpose() * U - MatrixXr(MatrixXr::Identity(U.cols(),U.cols()))).norm() << "\n";
@@ -699,6 +798,7 @@ void BDCSVD<MatrixType>::computeSVDofM(Eigen::Index firstCol, Eigen::Index n, Ma
   std::cout << "  * sing-val: " << singVals.transpose() << "\n";
 //   std::cout << "  * err:      " << ((jsvd.singularValues()-singVals)>1e-13*singVals.norm()).transpose() << "\n";
 #endif
+  return numIters.sum();
 }
 
 template <typename MatrixType>
@@ -717,9 +817,12 @@ typename BDCSVD<MatrixType>::RealScalar BDCSVD<MatrixType>::secularEq(RealScalar
 
 }
 
+// Computes the singular values of index begin to end-1, using diagShifted as workspace.
+// Returns the number of iterations of the rational interpolation.
 template <typename MatrixType>
-void BDCSVD<MatrixType>::computeSingVals(const ArrayRef& col0, const ArrayRef& diag, const IndicesRef &perm,
-                                         VectorType& singVals, ArrayRef shifts, ArrayRef mus)
+int BDCSVD<MatrixType>::computeSingVals(const ArrayRef& col0, const ArrayRef& diag, const IndicesRef &perm,
+                                        VectorType& singVals, ArrayRef shifts, ArrayRef mus,
+                                        Eigen::Index begin, Eigen::Index end, ArrayRef diagShifted)
 {
   using std::abs;
   using std::swap;
@@ -731,7 +834,8 @@ void BDCSVD<MatrixType>::computeSingVals(const ArrayRef& col0, const ArrayRef& d
   // because 1) we have diag(i)==0 => col0(i)==0 and 2) if col0(i)==0, then diag(i) is already a singular value.
   while(actual_n>1 && col0(actual_n-1)==Literal(0)) --actual_n;
 
-  for (Index k = 0; k < n; ++k)
+  int numIters = 0;
+  for (Index k = begin; k < end; ++k)
   {
     if (col0(k) == Literal(0) || actual_n==1)
     {
@@ -782,7 +886,6 @@ void BDCSVD<MatrixType>::computeSingVals(const ArrayRef& col0, const ArrayRef& d
     RealScalar shift = (k == actual_n-1 || fMid > Literal(0)) ? left : right;
     
     // measure everything relative to shift
-    Map<ArrayXr> diagShifted(m_workspace.data()+4*n, n);
     diagShifted = diag - shift;
 
     if(k!=actual_n-1)
@@ -827,7 +930,7 @@ void BDCSVD<MatrixType>::computeSingVals(const ArrayRef& col0, const ArrayRef& d
     bool useBisection = fPrev*fCur>Literal(0);
     while (fCur!=Literal(0) && abs(muCur - muPrev) > Literal(8) * NumTraits<RealScalar>::epsilon() * numext::maxi<RealScalar>(abs(muCur), abs(muPrev)) && abs(fCur - fPrev)>NumTraits<RealScalar>::epsilon() && !useBisection)
     {
-      ++m_numIters;
+      ++numIters;
 
       // Find a and b such that the function f(mu) = a / mu + b matches the current and previous samples.
       RealScalar a = (fCur - fPrev) / (Literal(1)/muCur - Literal(1)/muPrev);
@@ -949,7 +1052,7 @@ void BDCSVD<MatrixType>::computeSingVals(const ArrayRef& col0, const ArrayRef& d
       std::cout << "found " << singVals[k] << " == " << shift << " + " << muCur << " from " << diag(k) << " .. "  << diag(k+1) << "\n";
 #endif
 #ifdef EIGEN_BDCSVD_SANITY_CHECKS
-    assert(k==0 || singVals[k]>=singVals[k-1]);
+    assert(k==begin || singVals[k]>=singVals[k-1]);
     assert(singVals[k]>=diag(k));
 #endif
 
@@ -959,26 +1062,27 @@ void BDCSVD<MatrixType>::computeSingVals(const ArrayRef& col0, const ArrayRef& d
 //     if (singVals[k] == left) singVals[k] *= 1 + NumTraits<RealScalar>::epsilon();
 //     if (singVals[k] == right) singVals[k] *= 1 - NumTraits<RealScalar>::epsilon();
   }
+  return numIters;
 }
 
 
-// zhat is perturbation of col0 for which singular vectors can be computed stably (see Section 3.1)
+// zhat is perturbation of col0 for which singular vectors can be computed stably (see Section 3.1),
+// it is computed for the entries of index begin to end-1
 template <typename MatrixType>
 void BDCSVD<MatrixType>::perturbCol0
    (const ArrayRef& col0, const ArrayRef& diag, const IndicesRef &perm, const VectorType& singVals,
-    const ArrayRef& shifts, const ArrayRef& mus, ArrayRef zhat)
+    const ArrayRef& shifts, const ArrayRef& mus, ArrayRef zhat, Eigen::Index begin, Eigen::Index end)
 {
   using std::sqrt;
-  Index n = col0.size();
   Index m = perm.size();
   if(m==0)
   {
-    zhat.setZero();
+    zhat.segment(begin, end-begin).setZero();
     return;
   }
   Index lastIdx = perm(m-1);
   // The offset permits to skip deflated entries while computing zhat
-  for (Index k = 0; k < n; ++k)
+  for (Index k = begin; k < end; ++k)
   {
     if (col0(k) == Literal(0)) // deflated
       zhat(k) = Literal(0);
@@ -1005,7 +1109,7 @@ void BDCSVD<MatrixType>::perturbCol0
           if(i>=k && (l==0 || l-1>=m))
           {
             std::cout << "Error in perturbCol0\n";
-            std::cout << "  " << k << "/" << n << " "  << l << "/" << m << " " << i << "/" << n << " ; " << col0(k) << " " << diag(k) << " "  <<  "\n";
+            std::cout << "  " << k << "/" << col0.size() << " "  << l << "/" << m << " " << i << "/" << col0.size() << " ; " << col0(k) << " " << diag(k) << " "  <<  "\n";
             std::cout << "  " <<diag(i) << "\n";
             Index j = (i<k /*|| l==0*/) ? i : perm(l-1);
             std::cout << "  " << "j=" << j << "\n";
@@ -1042,16 +1146,16 @@ void BDCSVD<MatrixType>::perturbCol0
   }
 }
 
-// compute singular vectors
+// compute the singular vectors of index begin to end-1, the last column of U is set by the caller
 template <typename MatrixType>
 void BDCSVD<MatrixType>::computeSingVecs
    (const ArrayRef& zhat, const ArrayRef& diag, const IndicesRef &perm, const VectorType& singVals,
-    const ArrayRef& shifts, const ArrayRef& mus, MatrixXr& U, MatrixXr& V)
+    const ArrayRef& shifts, const ArrayRef& mus, MatrixXr& U, MatrixXr& V, Eigen::Index begin, Eigen::Index end)
 {
   Index n = zhat.size();
   Index m = perm.size();
   
-  for (Index k = 0; k < n; ++k)
+  for (Index k = begin; k < end; ++k)
   {
     if (zhat(k) == Literal(0))
     {
@@ -1082,7 +1186,6 @@ void BDCSVD<MatrixType>::computeSingVecs
       }
     }
   }
-  U.col(n) = VectorType::Unit(n+1, n);
 }
 
 
@@ -1159,7 +1262,8 @@ void BDCSVD<MatrixType>::deflation44(Eigen::Index firstColu , Eigen::Index first
 
 // acts on block from (firstCol+shift, firstCol+shift) to (lastCol+shift, lastCol+shift) [inclusive]
 template <typename MatrixType>
-void BDCSVD<MatrixType>::deflation(Eigen::Index firstCol, Eigen::Index lastCol, Eigen::Index k, Eigen::Index firstRowW, Eigen::Index firstColW, Eigen::Index shift)
+void BDCSVD<MatrixType>::deflation(Eigen::Index firstCol, Eigen::Index lastCol, Eigen::Index k, Eigen::Index firstRowW, Eigen::Index firstColW, Eigen::Index shift,
+                                   Eigen::Index* workspaceI)
 {
   using std::sqrt;
   using std::abs;
@@ -1229,7 +1333,7 @@ void BDCSVD<MatrixType>::deflation(Eigen::Index firstCol, Eigen::Index lastCol,
     
     // Sort the diagonal entries, since diag(1:k-1) and diag(k:length) are already sorted, let's do a sorted merge.
     // First, compute the respective permutation.
-    Index *permutation = m_workspaceI.data();
+    Index *permutation = workspaceI;
     {
       permutation[0] = 0;
       Index p = 1;
@@ -1266,8 +1370,8 @@ void BDCSVD<MatrixType>::deflation(Eigen::Index firstCol, Eigen::Index lastCol,
     }
     
     // Current index of each col, and current column of each index
-    Index *realInd = m_workspaceI.data()+length;
-    Index *realCol = m_workspaceI.data()+2*length;
+    Index *realInd = workspaceI+length;
+    Index *realCol = workspaceI+2*length;
     
     for(int pos = 0; pos< length; pos++)
     {
@@ -174,13 +174,13 @@ class SimplicialCholeskyBase : public SparseSolverBase<Derived>
       else
         dest = b;
 
-      if(m_matrix.nonZeros()>0) // otherwise L==I
+      if(m_matrix.nonZeros()>0 && !solveInPlaceByLevels(dest, false)) // otherwise L==I
         derived().matrixL().solveInPlace(dest);
 
       if(m_diag.size()>0)
         dest = m_diag.asDiagonal().inverse() * dest;
 
-      if (m_matrix.nonZeros()>0) // otherwise U==I
+      if (m_matrix.nonZeros()>0 && !solveInPlaceByLevels(dest, true)) // otherwise U==I
         derived().matrixU().solveInPlace(dest);
 
       if(m_P.size()>0)
@@ -235,6 +235,26 @@ class SimplicialCholeskyBase : public SparseSolverBase<Derived>
     template<bool DoLDLT>
     void factorize_preordered(const CholMatrixType& a);
 
+    /** \internal Solves L x = b in place, or L^* x = b if \a adjoint is true, using the level-scheduled plans of the factor.
+      * \returns false if there are none, i.e., if the factor is too small to be solved on several threads. */
+    template<typename Dest>
+    bool solveInPlaceByLevels(MatrixBase<Dest>& dest, bool adjoint) const
+    {
+      if(m_lowerPlan.size()>0)
+      {
+        if(adjoint) m_upperPlan.solveInPlace(m_matrix, dest);
+        else        m_lowerPlan.solveInPlace(m_matrix, dest);
+      }
+      else if(m_unitLowerPlan.size()>0)
+      {
+        if(adjoint) m_unitUpperPlan.solveInPlace(m_matrix, dest);
+        else        m_unitLowerPlan.solveInPlace(m_matrix, dest);
+      }
+      else
+        return false;
+      return true;
+    }
+
     void analyzePattern(const MatrixType& a, bool doLDLT)
     {
       eigen_assert(a.rows()==a.cols());
@@ -267,6 +287,11 @@ class SimplicialCholeskyBase : public SparseSolverBase<Derived>
     PermutationMatrix<Dynamic,Dynamic,StorageIndex> m_P;     // the permutation
     PermutationMatrix<Dynamic,Dynamic,StorageIndex> m_Pinv;  // the inverse permutation
 
+    SparseTriangularSolvePlan<CholMatrixType,Lower> m_lowerPlan;          // level-scheduled solves with L and L^*,
+    SparseTriangularSolvePlan<CholMatrixType,Upper> m_upperPlan;          // for large factors only (LLT mode)
+    SparseTriangularSolvePlan<CholMatrixType,UnitLower> m_unitLowerPlan;  // same in LDLT mode
+    SparseTriangularSolvePlan<CholMatrixType,UnitUpper> m_unitUpperPlan;
+
     RealScalar m_shiftOffset;
     RealScalar m_shiftScale;
 };
@@ -607,7 +632,7 @@ public:
       else
         dest = b;
 
-      if(Base::m_matrix.nonZeros()>0) // otherwise L==I
+      if(Base::m_matrix.nonZeros()>0 && !Base::solveInPlaceByLevels(dest, false)) // otherwise L==I
       {
         if(m_LDLT)
           LDLTTraits::getL(Base::m_matrix).solveInPlace(dest);
@@ -618,7 +643,7 @@ public:
       if(Base::m_diag.size()>0)
         dest = Base::m_diag.real().asDiagonal().inverse() * dest;
 
-      if (Base::m_matrix.nonZeros()>0) // otherwise I==I
+      if (Base::m_matrix.nonZeros()>0 && !Base::solveInPlaceByLevels(dest, true)) // otherwise I==I
       {
         if(m_LDLT)
           LDLTTraits::getU(Base::m_matrix).solveInPlace(dest);
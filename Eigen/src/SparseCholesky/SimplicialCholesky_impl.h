@@ -165,6 +165,24 @@ void SimplicialCholeskyBase<Derived>::factorize_preordered(const CholMatrixType&
     }
   }
 
+  m_lowerPlan = SparseTriangularSolvePlan<CholMatrixType,Lower>();
+  m_upperPlan = SparseTriangularSolvePlan<CholMatrixType,Upper>();
+  m_unitLowerPlan = SparseTriangularSolvePlan<CholMatrixType,UnitLower>();
+  m_unitUpperPlan = SparseTriangularSolvePlan<CholMatrixType,UnitUpper>();
+  if(ok && internal::use_sparse_triangular_solve_plan(m_matrix.nonZeros()))
+  {
+    if(DoLDLT)
+    {
+      m_unitLowerPlan.compute(m_matrix);
+      m_unitUpperPlan.compute(m_matrix, true);
+    }
+    else
+    {
+      m_lowerPlan.compute(m_matrix);
+      m_upperPlan.compute(m_matrix, true);
+    }
+  }
+
   m_info = ok ? Success : NumericalIssue;
   m_factorizationIsOk = true;
 }
@@ -0,0 +1,654 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_SUPERNODAL_CHOLESKY_H
+#define EIGEN_SUPERNODAL_CHOLESKY_H
+
+namespace Eigen {
+
+template<typename _MatrixType, int _UpLo = Lower, typename _Ordering = AMDOrdering<typename _MatrixType::StorageIndex> > class SupernodalLLT;
+
+namespace internal {
+
+/** \internal Factorizes the supernodes of one level of the supernodal elimination tree, see SupernodalLLT::factorize(). */
+template<typename SolverType>
+struct supernodal_llt_task
+{
+  typedef typename SolverType::CholMatrixType CholMatrixType;
+  typedef typename SolverType::StorageIndex StorageIndex;
+  supernodal_llt_task(SolverType& solver, const CholMatrixType& ap, const StorageIndex* nodes, StorageIndex* failed)
+    : m_solver(solver), m_ap(ap), m_nodes(nodes), m_failed(failed) {}
+  void operator()(Index k) const
+  {
+    m_failed[k] = m_solver.factorizeSupernode(m_nodes[k], m_ap) ? 0 : 1;
+  }
+  SolverType& m_solver;
+  const CholMatrixType& m_ap;
+  const StorageIndex* m_nodes;
+  StorageIndex* m_failed;
+};
+
+} // end namespace internal
+
+/** \ingroup SparseCholesky_Module
+  * \class SupernodalLLT
+  * \brief A supernodal sparse LLT Cholesky factorization
+  *
+  * This class provides a LL^T Cholesky factorization of sparse matrices that are selfadjoint and positive definite,
+  * like SimplicialLLT, but the columns of the factor L are grouped into supernodes: sets of consecutive columns
+  * sharing the same sparsity pattern below their diagonal block, which are stored as dense panels. The factorization
+  * and the solves then run through the dense matrix-matrix products and triangular solves of %Eigen, which makes
+  * this class much faster than SimplicialLLT on the factors with a large fill-in, as those of 3D meshes.
+  *
+  * In order to reduce the fill-in, a symmetric permutation P is applied prior to the factorization such that the
+  * factorized matrix is P A P^-1. The permutation of the \a _Ordering method is followed by a postorder of the
+  * elimination tree, which makes the columns of each supernode consecutive. Besides the fundamental supernodes,
+  * the small subtrees of the elimination tree are merged into relaxed supernodes, see setRelaxation().
+  *
+  * The supernodes of independent subtrees of the elimination tree are factorized concurrently
+  * (see \ref TopicMultiThreading).
+  *
+  * \tparam _MatrixType the type of the sparse matrix A, it must be a SparseMatrix<>
+  * \tparam _UpLo the triangular part that will be used for the computations. It can be Lower
+  *               or Upper. Default is Lower.
+  * \tparam _Ordering The ordering method to use, either AMDOrdering<> or NaturalOrdering<>. Default is AMDOrdering<>
+  *
+  * \implsparsesolverconcept
+  *
+  * \sa class SimplicialLLT, class AMDOrdering, class NaturalOrdering
+  */
+template<typename _MatrixType, int _UpLo, typename _Ordering>
+class SupernodalLLT : public SparseSolverBase<SupernodalLLT<_MatrixType,_UpLo,_Ordering> >
+{
+    typedef SparseSolverBase<SupernodalLLT> Base;
+    using Base::m_isInitialized;
+
+  public:
+    using Base::_solve_impl;
+    typedef _MatrixType MatrixType;
+    typedef _Ordering OrderingType;
+    enum { UpLo = _UpLo };
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename MatrixType::RealScalar RealScalar;
+    typedef typename MatrixType::StorageIndex StorageIndex;
+    typedef SparseMatrix<Scalar,ColMajor,StorageIndex> CholMatrixType;
+    typedef Matrix<StorageIndex,Dynamic,1> VectorI;
+    typedef PermutationMatrix<Dynamic,Dynamic,StorageIndex> PermutationType;
+
+    enum {
+      ColsAtCompileTime = MatrixType::ColsAtCompileTime,
+      MaxColsAtCompileTime = MatrixType::MaxColsAtCompileTime
+    };
+
+  protected:
+    typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+    typedef Map<DenseMatrix> PanelType;
+    typedef Map<const DenseMatrix> ConstPanelType;
+
+  public:
+    /** Default constructor */
+    SupernodalLLT()
+      : m_info(Success), m_factorizationIsOk(false), m_analysisIsOk(false), m_relax(16), m_shiftOffset(0), m_shiftScale(1)
+    {}
+
+    /** Constructs and performs the LLT factorization of \a matrix */
+    explicit SupernodalLLT(const MatrixType& matrix)
+      : m_info(Success), m_factorizationIsOk(false), m_analysisIsOk(false), m_relax(16), m_shiftOffset(0), m_shiftScale(1)
+    {
+      compute(matrix);
+    }
+
+    inline Index cols() const { return m_P.size(); }
+    inline Index rows() const { return m_P.size(); }
+
+    /** \brief Reports whether previous computation was successful.
+      *
+      * \returns \c Success if computation was successful,
+      *          \c NumericalIssue if the matrix.appears to be negative.
+      */
+    ComputationInfo info() const
+    {
+      eigen_assert(m_isInitialized && "Decomposition is not initialized.");
+      return m_info;
+    }
+
+    /** \returns the permutation P
+      * \sa permutationPinv() */
+    const PermutationType& permutationP() const { return m_P; }
+
+    /** \returns the inverse P^-1 of the permutation P
+      * \sa permutationP() */
+    const PermutationType& permutationPinv() const { return m_Pinv; }
+
+    /** Sets the shift parameters that will be used to adjust the diagonal coefficients during the numerical factorization.
+      *
+      * During the numerical factorization, the diagonal coefficients are transformed by the following linear model:\n
+      * \c d_ii = \a offset + \a scale * \c d_ii
+      *
+      * The default is the identity transformation with \a offset=0, and \a scale=1.
+      *
+      * \returns a reference to \c *this.
+      */
+    SupernodalLLT& setShift(const RealScalar& offset, const RealScalar& scale = 1)
+    {
+      m_shiftOffset = offset;
+      m_shiftScale = scale;
+      return *this;
+    }
+
+    /** Sets the maximal number of columns of the subtrees of the elimination tree which are merged into a single
+      * relaxed supernode. Their dense panels store a few explicit zeros, but the many small supernodes near the leaves
+      * of the tree are replaced by larger ones, which are more efficient. The default is 16.
+      * It must be set before analyzePattern().
+      *
+      * \returns a reference to \c *this.
+      */
+    SupernodalLLT& setRelaxation(Index columns)
+    {
+      m_relax = columns;
+      return *this;
+    }
+
+    /** \returns the number of supernodes of the factor L */
+    Index supernodes() const
+    {
+      eigen_assert(m_analysisIsOk && "You must first call analyzePattern()");
+      return m_supernodeStart.size()-1;
+    }
+
+    /** Computes the sparse Cholesky decomposition of \a matrix */
+    SupernodalLLT& compute(const MatrixType& matrix)
+    {
+      analyzePattern(matrix);
+      factorize(matrix);
+      return *this;
+    }
+
+    void analyzePattern(const MatrixType& a);
+
+    void factorize(const MatrixType& a);
+
+    /** \returns a copy of the factor L, with the explicit zeros of the relaxed supernodes */
+    CholMatrixType matrixL() const;
+
+    /** \returns the determinant of the underlying matrix from the current factorization */
+    Scalar determinant() const
+    {
+      eigen_assert(m_factorizationIsOk && "SupernodalLLT not factorized");
+      Scalar detL(1);
+      for(Index s=0; s<supernodes(); ++s)
+        detL *= panel(s).diagonal().prod();
+      return numext::abs2(detL);
+    }
+
+#ifndef EIGEN_PARSED_BY_DOXYGEN
+    /** \internal */
+    template<typename Rhs,typename Dest>
+    void _solve_impl(const MatrixBase<Rhs> &b, MatrixBase<Dest> &dest) const;
+
+    /** \internal */
+    template<typename Rhs,typename Dest>
+    void _solve_impl(const SparseMatrixBase<Rhs> &b, SparseMatrixBase<Dest> &dest) const
+    {
+      internal::solve_sparse_through_dense_panels(*this, b, dest);
+    }
+
+    /** \internal Factorizes the supernode \a s once all its descendants have been factorized,
+      * \returns false if its diagonal block is not positive definite. */
+    bool factorizeSupernode(Index s, const CholMatrixType& ap);
+#endif // EIGEN_PARSED_BY_DOXYGEN
+
+  protected:
+    // rows and columns of the dense panel of the supernode s
+    Index panelRows(Index s) const { return m_rowStart(s+1) - m_rowStart(s); }
+    Index panelCols(Index s) const { return m_supernodeStart(s+1) - m_supernodeStart(s); }
+    const StorageIndex* panelRowIndices(Index s) const { return m_rowIndices.data() + m_rowStart(s); }
+    PanelType panel(Index s) { return PanelType(m_values.data() + m_valueStart(s), panelRows(s), panelCols(s)); }
+    ConstPanelType panel(Index s) const { return ConstPanelType(m_values.data() + m_valueStart(s), panelRows(s), panelCols(s)); }
+
+    mutable ComputationInfo m_info;
+    bool m_factorizationIsOk;
+    bool m_analysisIsOk;
+    Index m_relax;
+
+    PermutationType m_P;                    // the permutation
+    PermutationType m_Pinv;                 // the inverse permutation
+    VectorI m_supernodeStart;               // first column of each supernode
+    VectorI m_rowStart;                     // start of the row indices of each supernode in m_rowIndices
+    VectorI m_rowIndices;                   // the columns of each supernode, followed by its sorted off-diagonal rows
+    Matrix<Index,Dynamic,1> m_valueStart;   // start of the panel of each supernode in m_values
+    VectorI m_updateStart;                  // start of the descendants of each supernode in m_updates
+    VectorI m_updates;                      // the descendants which update each supernode
+    VectorI m_levelStart;                   // start of each level of the supernodal elimination tree in m_levelNodes
+    VectorI m_levelNodes;                   // the supernodes sorted by level, from the leaves to the roots
+    Matrix<double,Dynamic,1> m_levelCost;   // estimated number of flops of each level
+    Matrix<Scalar,Dynamic,1> m_values;      // the dense panels, stored column-major
+
+    RealScalar m_shiftOffset;
+    RealScalar m_shiftScale;
+};
+
+/** Performs a symbolic decomposition on the sparsity of \a a: computes the fill-reducing permutation, the supernodes,
+  * their sparsity patterns, and the schedule of the numerical factorization.
+  *
+  * This function is particularly useful when solving for several problems having the same structure.
+  *
+  * \sa factorize()
+  */
+template<typename _MatrixType, int _UpLo, typename _Ordering>
+void SupernodalLLT<_MatrixType,_UpLo,_Ordering>::analyzePattern(const MatrixType& a)
+{
+  eigen_assert(a.rows()==a.cols());
+  const StorageIndex n = internal::convert_index<StorageIndex>(a.rows());
+
+  // fill-reducing ordering, the ordering methods compute the inverse permutation
+  {
+    CholMatrixType C;
+    C = a.template selfadjointView<UpLo>();
+    OrderingType ordering;
+    ordering(C, m_Pinv);
+  }
+  if(m_Pinv.size()==0)
+    m_Pinv.setIdentity(n);
+  m_P = m_Pinv.inverse();
+
+  // elimination tree and column counts of L, computed from the rows of the upper triangular part as in SimplicialLLT
+  VectorI parent(n), colCount(n), tags(n);
+  {
+    CholMatrixType ap(n,n);
+    ap.template selfadjointView<Upper>() = a.template selfadjointView<UpLo>().twistedBy(m_P);
+    for(StorageIndex k = 0; k < n; ++k)
+    {
+      parent(k) = n;
+      tags(k) = k;
+      colCount(k) = 1;
+      for(typename CholMatrixType::InnerIterator it(ap,k); it; ++it)
+      {
+        StorageIndex i = it.index();
+        if(i < k)
+        {
+          for(; tags(i) != k; i = parent(i))
+          {
+            if(parent(i) == n)
+              parent(i) = k;
+            colCount(i)++;
+            tags(i) = k;
+          }
+        }
+      }
+    }
+  }
+
+  // postorder the elimination tree, so that the columns of each subtree are consecutive
+  VectorI post, etree(n), counts(n);
+  internal::treePostorder(n, parent, post);
+  for(StorageIndex v = 0; v < n; ++v)
+  {
+    etree(post(v)) = parent(v)==n ? n : post(parent(v));
+    counts(post(v)) = colCount(v);
+  }
+  for(StorageIndex i = 0; i < n; ++i)
+    m_P.indices()(i) = post(m_P.indices()(i));
+  m_Pinv = m_P.inverse();
+
+  // relaxed supernodes: subtrees with less than m_relax descendants, as in SparseLU
+  VectorI descendants = VectorI::Zero(n), children = VectorI::Zero(n), relaxEnd = VectorI::Constant(n, -1);
+  for(StorageIndex j = 0; j < n; ++j)
+  {
+    if(etree(j) != n)
+    {
+      descendants(etree(j)) += descendants(j) + 1;
+      children(etree(j))++;
+    }
+  }
+  for(StorageIndex j = 0; j < n; )
+  {
+    StorageIndex p = etree(j), start = j;
+    while(p != n && descendants(p) < m_relax)
+    {
+      j = p;
+      p = etree(j);
+    }
+    relaxEnd(start) = j;
+    j++;
+    while(j < n && descendants(j) != 0) j++;
+  }
+
+  // fundamental supernodes: chains of columns whose pattern is the one of their child minus its diagonal
+  VectorI supernodeOf(n);
+  m_supernodeStart.resize(n+1);
+  Index S = 0;
+  for(StorageIndex j = 0; j < n; )
+  {
+    m_supernodeStart(S) = j;
+    StorageIndex k = j;
+    if(relaxEnd(j) != -1)
+      k = relaxEnd(j);
+    else
+      while(k+1 < n && etree(k) == k+1 && children(k+1) == 1 && relaxEnd(k+1) == -1 && counts(k+1)+1 == counts(k))
+        ++k;
+    for(; j <= k; ++j)
+      supernodeOf(j) = StorageIndex(S);
+    ++S;
+  }
+  m_supernodeStart(S) = n;
+  m_supernodeStart.conservativeResize(S+1);
+
+  // supernodal elimination tree
+  VectorI superParent(S), childStart = VectorI::Zero(S+1), superChildren(S);
+  for(Index s = 0; s < S; ++s)
+  {
+    StorageIndex p = etree(m_supernodeStart(s+1)-1);
+    superParent(s) = p==n ? -1 : supernodeOf(p);
+    if(p != n)
+      childStart(superParent(s)+1)++;
+  }
+  for(Index s = 0; s < S; ++s)
+    childStart(s+1) += childStart(s);
+  {
+    VectorI pos = childStart;
+    for(Index s = 0; s < S; ++s)
+      if(superParent(s) != -1)
+        superChildren(pos(superParent(s))++) = StorageIndex(s);
+  }
+
+  // pattern of each supernode: its columns, the entries of A below them, and the patterns of its children
+  CholMatrixType ap(n,n);
+  ap.template selfadjointView<Lower>() = a.template selfadjointView<UpLo>().twistedBy(m_P);
+  std::vector<StorageIndex> rowIndices;
+  rowIndices.reserve(ap.nonZeros() + n);
+  m_rowStart.resize(S+1);
+  m_valueStart.resize(S+1);
+  m_valueStart(0) = 0;
+  tags.setConstant(-1);
+  for(Index s = 0; s < S; ++s)
+  {
+    const StorageIndex first = m_supernodeStart(s), last = m_supernodeStart(s+1)-1;
+    m_rowStart(s) = StorageIndex(rowIndices.size());
+    for(StorageIndex j = first; j <= last; ++j)
+      rowIndices.push_back(j);
+    for(StorageIndex j = first; j <= last; ++j)
+    {
+      for(typename CholMatrixType::InnerIterator it(ap,j); it; ++it)
+      {
+        StorageIndex i = it.index();
+        if(i > last && tags(i) != s)
+        {
+          tags(i) = StorageIndex(s);
+          rowIndices.push_back(i);
+        }
+      }
+    }
+    for(Index c = childStart(s); c < childStart(s+1); ++c)
+    {
+      const StorageIndex child = superChildren(c);
+      for(Index k = m_rowStart(child) + panelCols(child); k < m_rowStart(child+1); ++k)
+      {
+        StorageIndex i = rowIndices[k];
+        if(i > last && tags(i) != s)
+        {
+          tags(i) = StorageIndex(s);
+          rowIndices.push_back(i);
+        }
+      }
+    }
+    std::sort(rowIndices.begin() + m_rowStart(s) + (last-first+1), rowIndices.end());
+    m_rowStart(s+1) = StorageIndex(rowIndices.size());
+    m_valueStart(s+1) = m_valueStart(s) + panelRows(s) * panelCols(s);
+  }
+  m_rowIndices = VectorI::Map(rowIndices.data(), rowIndices.size());
+
+  // descendants updating each supernode, and estimated cost of each supernode
+  Matrix<double,Dynamic,1> cost(S);
+  m_updateStart.setZero(S+1);
+  for(int pass = 0; pass < 2; ++pass)
+  {
+    VectorI pos = m_updateStart;
+    if(pass == 1)
+      m_updates.resize(m_updateStart(S));
+    for(Index d = 0; d < S; ++d)
+    {
+      const StorageIndex* rows = panelRowIndices(d);
+      const Index nd = panelCols(d), md = panelRows(d);
+      if(pass == 1)
+        cost(d) += double(md) * double(nd) * double(nd);
+      for(Index k = nd; k < md; )
+      {
+        const StorageIndex s = supernodeOf(rows[k]);
+        const Index k0 = k;
+        while(k < md && rows[k] < m_supernodeStart(s+1)) ++k;
+        if(pass == 0)
+          m_updateStart(s+1)++;
+        else
+        {
+          m_updates(pos(s)++) = StorageIndex(d);
+          cost(s) += 2. * double(md-k0) * double(k-k0) * double(nd);
+        }
+      }
+    }
+    if(pass == 0)
+    {
+      for(Index s = 0; s < S; ++s)
+        m_updateStart(s+1) += m_updateStart(s);
+      cost.setZero();
+    }
+  }
+
+  // levels of the supernodal elimination tree, the supernodes of a level are independent
+  VectorI level = VectorI::Zero(S);
+  for(Index s = 0; s < S; ++s)
+    if(superParent(s) != -1)
+      level(superParent(s)) = (std::max)(level(superParent(s)), StorageIndex(level(s)+1));
+  const Index numLevels = S==0 ? 0 : level.maxCoeff()+1;
+  m_levelStart.setZero(numLevels+1);
+  m_levelCost.setZero(numLevels);
+  for(Index s = 0; s < S; ++s)
+  {
+    m_levelStart(level(s)+1)++;
+    m_levelCost(level(s)) += cost(s);
+  }
+  for(Index l = 0; l < numLevels; ++l)
+    m_levelStart(l+1) += m_levelStart(l);
+  m_levelNodes.resize(S);
+  {
+    VectorI pos = m_levelStart;
+    for(Index s = 0; s < S; ++s)
+      m_levelNodes(pos(level(s))++) = StorageIndex(s);
+  }
+
+  m_isInitialized     = true;
+  m_info              = Success;
+  m_analysisIsOk      = true;
+  m_factorizationIsOk = false;
+}
+
+/** Performs a numeric decomposition of \a a
+  *
+  * The given matrix must have the same sparsity as the matrix on which the symbolic decomposition has been performed.
+  * The supernodes are factorized level by level of the supernodal elimination tree, from the leaves to the root:
+  * the supernodes of a level are independent and are factorized concurrently.
+  *
+  * \sa analyzePattern()
+  */
+template<typename _MatrixType, int _UpLo, typename _Ordering>
+void SupernodalLLT<_MatrixType,_UpLo,_Ordering>::factorize(const MatrixType& a)
+{
+  eigen_assert(m_analysisIsOk && "You must first call analyzePattern()");
+  eigen_assert(a.rows()==a.cols() && a.rows()==m_P.size());
+  const Index n = a.rows();
+  CholMatrixType ap(n,n);
+  ap.template selfadjointView<Lower>() = a.template selfadjointView<UpLo>().twistedBy(m_P);
+
+  m_values.resize(m_valueStart(m_valueStart.size()-1));
+  m_info = Success;
+  VectorI failed(m_levelNodes.size());
+  for(Index l = 0; l+1 < m_levelStart.size() && m_info == Success; ++l)
+  {
+    const Index count = m_levelStart(l+1) - m_levelStart(l);
+    const Index threads = (std::min)(count, internal::parallel_cwise_threads(m_levelCost(l)));
+    internal::parallel_run_tasks(count, threads,
+        internal::supernodal_llt_task<SupernodalLLT>(*this, ap, m_levelNodes.data() + m_levelStart(l), failed.data() + m_levelStart(l)));
+    if(failed.segment(m_levelStart(l), count).any())
+      m_info = NumericalIssue;
+  }
+
+  m_isInitialized = true;
+  m_factorizationIsOk = true;
+}
+
+template<typename _MatrixType, int _UpLo, typename _Ordering>
+bool SupernodalLLT<_MatrixType,_UpLo,_Ordering>::factorizeSupernode(Index s, const CholMatrixType& ap)
+{
+  const Index first = m_supernodeStart(s), ns = panelCols(s), ms = panelRows(s);
+  const StorageIndex* rows = panelRowIndices(s);
+  PanelType L = panel(s);
+
+  // scatter the columns of A
+  L.setZero();
+  for(Index c = 0; c < ns; ++c)
+  {
+    for(typename CholMatrixType::InnerIterator it(ap, first+c); it; ++it)
+    {
+      const Index k = std::lower_bound(rows+c, rows+ms, it.index()) - rows;
+      if(it.index() == first+c)
+        L(k,c) = numext::real(it.value()) * m_shiftScale + m_shiftOffset;
+      else
+        L(k,c) = it.value();
+    }
+  }
+
+  // left-looking updates by the descendants
+  DenseMatrix W;
+  Matrix<Index,Dynamic,1> relative(ms);
+  for(Index u = m_updateStart(s); u < m_updateStart(s+1); ++u)
+  {
+    const Index d = m_updates(u), nd = panelCols(d), md = panelRows(d);
+    const StorageIndex* drows = panelRowIndices(d);
+    const Index q0 = std::lower_bound(drows+nd, drows+md, StorageIndex(first)) - drows;
+    const Index q1 = std::lower_bound(drows+q0, drows+md, StorageIndex(first+ns)) - drows;
+    const Index len = md - q0, k = q1 - q0;
+    ConstPanelType Ld(m_values.data() + m_valueStart(d), md, nd);
+
+    // position of the rows of d in the pattern of s, which contains them
+    Index pos = 0;
+    for(Index t = 0; t < len; ++t)
+    {
+      pos = std::lower_bound(rows+pos, rows+ms, drows[q0+t]) - rows;
+      eigen_internal_assert(pos < ms && rows[pos] == drows[q0+t]);
+      relative(t) = pos;
+    }
+
+    if(relative(len-1) - relative(0) == len-1)
+    {
+      // contiguous rows: the update goes directly to the panel, the strictly upper part of its diagonal block is not referenced
+      L.block(relative(0), relative(0), len, k).noalias() -= Ld.middleRows(q0, len) * Ld.middleRows(q0, k).adjoint();
+    }
+    else
+    {
+      W.noalias() = Ld.middleRows(q0, len) * Ld.middleRows(q0, k).adjoint();
+      for(Index c = 0; c < k; ++c)
+        for(Index t = c; t < len; ++t)
+          L(relative(t), relative(c)) -= W(t,c);
+    }
+  }
+
+  // dense factorization of the diagonal block, and triangular solve of the rows below it
+  Block<PanelType,Dynamic,Dynamic> L11(L, 0, 0, ns, ns);
+  if(internal::llt_inplace<Scalar,Lower>::blocked(L11) >= 0)
+    return false;
+  if(ms > ns)
+  {
+    Block<PanelType,Dynamic,Dynamic> L21(L, ns, 0, ms-ns, ns);
+    L11.adjoint().template triangularView<Upper>().template solveInPlace<OnTheRight>(L21);
+  }
+  return true;
+}
+
+template<typename _MatrixType, int _UpLo, typename _Ordering>
+template<typename Rhs,typename Dest>
+void SupernodalLLT<_MatrixType,_UpLo,_Ordering>::_solve_impl(const MatrixBase<Rhs> &b, MatrixBase<Dest> &dest) const
+{
+  eigen_assert(m_factorizationIsOk && "The decomposition is not in a valid state for solving, you must first call either compute() or symbolic()/numeric()");
+  eigen_assert(m_P.size()==b.rows());
+
+  if(m_info!=Success)
+    return;
+
+  dest = m_P * b;
+  const Index S = supernodes();
+  Matrix<Scalar,Dynamic,Dynamic> tmp;
+
+  // forward substitution with L
+  for(Index s = 0; s < S; ++s)
+  {
+    const Index ns = panelCols(s), ms = panelRows(s);
+    const StorageIndex* rows = panelRowIndices(s);
+    ConstPanelType L = panel(s);
+    typename Dest::RowsBlockXpr x = dest.derived().middleRows(m_supernodeStart(s), ns);
+    L.topRows(ns).template triangularView<Lower>().solveInPlace(x);
+    if(ms > ns)
+    {
+      tmp.noalias() = L.bottomRows(ms-ns) * x;
+      for(Index t = 0; t < ms-ns; ++t)
+        dest.row(rows[ns+t]) -= tmp.row(t);
+    }
+  }
+
+  // backward substitution with L^*
+  for(Index s = S-1; s >= 0; --s)
+  {
+    const Index ns = panelCols(s), ms = panelRows(s);
+    const StorageIndex* rows = panelRowIndices(s);
+    ConstPanelType L = panel(s);
+    typename Dest::RowsBlockXpr x = dest.derived().middleRows(m_supernodeStart(s), ns);
+    if(ms > ns)
+    {
+      tmp.resize(ms-ns, dest.cols());
+      for(Index t = 0; t < ms-ns; ++t)
+        tmp.row(t) = dest.row(rows[ns+t]);
+      x.noalias() -= L.bottomRows(ms-ns).adjoint() * tmp;
+    }
+    L.topRows(ns).template triangularView<Lower>().adjoint().solveInPlace(x);
+  }
+
+  dest = m_Pinv * dest;
+}
+
+template<typename _MatrixType, int _UpLo, typename _Ordering>
+typename SupernodalLLT<_MatrixType,_UpLo,_Ordering>::CholMatrixType SupernodalLLT<_MatrixType,_UpLo,_Ordering>::matrixL() const
+{
+  eigen_assert(m_factorizationIsOk && "SupernodalLLT not factorized");
+  const Index n = m_P.size(), S = supernodes();
+  CholMatrixType L(n,n);
+  StorageIndex* Lp = L.outerIndexPtr();
+  Lp[0] = 0;
+  for(Index s = 0; s < S; ++s)
+    for(Index c = 0; c < panelCols(s); ++c)
+      Lp[m_supernodeStart(s)+c+1] = Lp[m_supernodeStart(s)+c] + StorageIndex(panelRows(s)-c);
+  L.resizeNonZeros(Lp[n]);
+  StorageIndex* Li = L.innerIndexPtr();
+  Scalar* Lx = L.valuePtr();
+  for(Index s = 0; s < S; ++s)
+  {
+    const StorageIndex* rows = panelRowIndices(s);
+    ConstPanelType Ls = panel(s);
+    for(Index c = 0; c < panelCols(s); ++c)
+    {
+      StorageIndex p = Lp[m_supernodeStart(s)+c];
+      for(Index t = c; t < panelRows(s); ++t, ++p)
+      {
+        Li[p] = rows[t];
+        Lx[p] = Ls(t,c);
+      }
+    }
+  }
+  return L;
+}
+
+} // end namespace Eigen
+
+#endif // EIGEN_SUPERNODAL_CHOLESKY_H
@@ -14,6 +14,308 @@ namespace Eigen {
 
 namespace internal {
 
+/** \internal Estimated cost, in cycles, of one multiply-add of a sparse * sparse product, see parallel_cwise_threads(). */
+const int SparseSparseProductCost = 10;
+
+/** \internal
+  * Accumulator of the columns of a sparse * sparse product, used by both the symbolic pass, which counts the nonzeros
+  * of a column, and the numeric pass, which computes them.
+  *
+  * The number of multiply-adds of a column bounds its number of nonzeros. The columns whose multiply-adds are few
+  * compared to the number of rows are accumulated in a hash table with linear probing of at least twice that size,
+  * which stays in cache. The other ones are accumulated in dense arrays of the size of a column, whose entries are
+  * tagged by the index of the last column that used them so that they never have to be cleared.
+  */
+template<typename Scalar, typename StorageIndex>
+class sparse_product_accumulator
+{
+  public:
+    // columns with less multiply-adds than the number of rows divided by this ratio are hashed
+    enum { HashRatio = 16, EmptyKey = -1 };
+
+    explicit sparse_product_accumulator(Index rows) : m_rows(rows), m_col(-1), m_size(0), m_mask(0), m_hashed(false) {}
+
+    /** Starts the accumulation of the column \a j, which costs \a flops multiply-adds. */
+    void begin(Index j, Index flops, bool numeric)
+    {
+      m_col = StorageIndex(j);
+      m_size = 0;
+      m_hashed = flops * HashRatio < m_rows;
+      if(m_hashed)
+      {
+        Index capacity = 16;
+        while(capacity < 2*flops)
+          capacity *= 2;
+        if(m_keys.size() < capacity)
+          m_keys.resize(capacity);
+        if(numeric && m_hashValues.size() < capacity)
+          m_hashValues.resize(capacity);
+        m_mask = capacity-1;
+        std::fill_n(m_keys.data(), capacity, StorageIndex(EmptyKey));
+      }
+      else
+      {
+        if(m_marker.size()==0)
+          m_marker.setConstant(m_rows, StorageIndex(EmptyKey));
+        if(numeric && m_values.size()==0)
+        {
+          m_indices.resize(m_rows);
+          m_values.resize(m_rows);
+        }
+      }
+    }
+
+    /** Inserts the row \a i in the pattern of the current column. */
+    void insert(Index i)
+    {
+      if(m_hashed)
+      {
+        Index h = slot(i);
+        if(m_keys.coeff(h)==EmptyKey)
+        {
+          m_keys.coeffRef(h) = StorageIndex(i);
+          ++m_size;
+        }
+      }
+      else if(m_marker.coeff(i)!=m_col)
+      {
+        m_marker.coeffRef(i) = m_col;
+        ++m_size;
+      }
+    }
+
+    /** Adds \a v to the coefficient of the row \a i of the current column. */
+    void add(Index i, const Scalar& v)
+    {
+      if(m_hashed)
+      {
+        Index h = slot(i);
+        if(m_keys.coeff(h)==EmptyKey)
+        {
+          m_keys.coeffRef(h) = StorageIndex(i);
+          m_hashValues.coeffRef(h) = v;
+          ++m_size;
+        }
+        else
+          m_hashValues.coeffRef(h) += v;
+      }
+      else if(m_marker.coeff(i)!=m_col)
+      {
+        m_marker.coeffRef(i) = m_col;
+        m_values.coeffRef(i) = v;
+        m_indices.coeffRef(m_size++) = StorageIndex(i);
+      }
+      else
+        m_values.coeffRef(i) += v;
+    }
+
+    /** \returns the number of nonzeros of the current column. */
+    Index size() const { return m_size; }
+
+    /** Copies the nonzeros of the current column to \a indices and \a values, sorted by row indices if \a sorted is true. */
+    void store(StorageIndex* indices, Scalar* values, bool sorted) const
+    {
+      if(m_hashed)
+      {
+        Index k = 0;
+        for(Index h=0; h<=m_mask; ++h)
+          if(m_keys.coeff(h)!=EmptyKey)
+          {
+            indices[k] = m_keys.coeff(h);
+            if(!sorted)
+              values[k] = m_hashValues.coeff(h);
+            ++k;
+          }
+        if(sorted)
+        {
+          std::sort(indices, indices+m_size);
+          for(k=0; k<m_size; ++k)
+            values[k] = m_hashValues.coeff(slot(indices[k]));
+        }
+      }
+      else
+      {
+        // as in the sequential product, the dense range is scanned rather than sorted if the column is dense enough
+        if(sorted && m_size * numext::log2(int(m_size)+1) > m_rows)
+        {
+          Index k = 0;
+          for(Index i=0; i<m_rows; ++i)
+            if(m_marker.coeff(i)==m_col)
+              indices[k++] = StorageIndex(i);
+        }
+        else
+        {
+          std::copy(m_indices.data(), m_indices.data()+m_size, indices);
+          if(sorted)
+            std::sort(indices, indices+m_size);
+        }
+        for(Index k=0; k<m_size; ++k)
+          values[k] = m_values.coeff(indices[k]);
+      }
+    }
+
+  protected:
+    /** \returns the slot of the row \a i in the hash table, empty if \a i is not there yet. */
+    Index slot(Index i) const
+    {
+      Index h = (i*107) & m_mask;
+      while(m_keys.coeff(h)!=EmptyKey && m_keys.coeff(h)!=i)
+        h = (h+1) & m_mask;
+      return h;
+    }
+
+    const Index m_rows;
+    StorageIndex m_col;
+    Index m_size;
+    Index m_mask;
+    bool m_hashed;
+    Matrix<StorageIndex,Dynamic,1> m_keys;
+    Matrix<Scalar,Dynamic,1> m_hashValues;
+    Matrix<StorageIndex,Dynamic,1> m_marker;
+    Matrix<StorageIndex,Dynamic,1> m_indices;
+    Matrix<Scalar,Dynamic,1> m_values;
+};
+
+/** \internal Splits the outer vectors of a sparse product into \a numTasks ranges \a chunks(t) - \a chunks(t+1) of about
+  * the same number of multiply-adds, given the number \a flops(j) of multiply-adds of each outer vector and their sum \a totalFlops. */
+inline void sparse_product_chunks(const Matrix<Index,Dynamic,1>& flops, Index totalFlops, Index numTasks, Matrix<Index,Dynamic,1>& chunks)
+{
+  const Index size = flops.size();
+  chunks.resize(numTasks+1);
+  chunks(0) = 0;
+  Index j = 0, acc = 0;
+  for(Index t=1; t<numTasks; ++t)
+  {
+    const double target = double(totalFlops) * double(t) / double(numTasks);
+    while(j<size && double(acc + flops(j)) <= target)
+      acc += flops(j++);
+    chunks(t) = j;
+  }
+  chunks(numTasks) = size;
+}
+
+/** \internal Runs the symbolic or the numeric pass of conservative_sparse_sparse_product_twopass() over a chunk of columns. */
+template<typename Lhs, typename Rhs, typename ResultType>
+struct conservative_sparse_sparse_product_task
+{
+  typedef evaluator<Lhs> LhsEval;
+  typedef evaluator<Rhs> RhsEval;
+  typedef typename ResultType::Scalar Scalar;
+  typedef typename ResultType::StorageIndex StorageIndex;
+
+  conservative_sparse_sparse_product_task(const LhsEval& lhsEval, const RhsEval& rhsEval, ResultType& res,
+                                          const Index* flops, const Index* chunks, bool sorted)
+    : m_lhsEval(lhsEval), m_rhsEval(rhsEval), m_res(res), m_flops(flops), m_chunks(chunks), m_sorted(sorted), m_numeric(false)
+  {}
+
+  void operator()(Index t) const
+  {
+    sparse_product_accumulator<Scalar,StorageIndex> acc(m_res.innerSize());
+    for(Index j=m_chunks[t]; j<m_chunks[t+1]; ++j)
+    {
+      acc.begin(j, m_flops[j], m_numeric);
+      for(typename RhsEval::InnerIterator rhsIt(m_rhsEval, j); rhsIt; ++rhsIt)
+      {
+        Index k = rhsIt.index();
+        if(m_numeric)
+        {
+          typename traits<Rhs>::Scalar y = rhsIt.value();
+          for(typename LhsEval::InnerIterator lhsIt(m_lhsEval, k); lhsIt; ++lhsIt)
+            acc.add(lhsIt.index(), lhsIt.value() * y);
+        }
+        else
+        {
+          for(typename LhsEval::InnerIterator lhsIt(m_lhsEval, k); lhsIt; ++lhsIt)
+            acc.insert(lhsIt.index());
+        }
+      }
+      if(m_numeric)
+      {
+        Index start = m_res.outerIndexPtr()[j];
+        eigen_internal_assert(acc.size() == m_res.outerIndexPtr()[j+1]-start);
+        acc.store(m_res.innerIndexPtr()+start, m_res.valuePtr()+start, m_sorted);
+      }
+      else
+        m_res.outerIndexPtr()[j+1] = StorageIndex(acc.size());
+    }
+  }
+
+  const LhsEval& m_lhsEval;
+  const RhsEval& m_rhsEval;
+  ResultType& m_res;
+  const Index* m_flops;
+  const Index* m_chunks;
+  const bool m_sorted;
+  bool m_numeric;
+};
+
+/** \internal
+  * Computes the sparse product \a res = \a lhs * \a rhs in two passes over the columns of \a rhs: a symbolic pass which
+  * counts the nonzeros of each column of the result, followed by a numeric pass which computes them in place once the
+  * result has been allocated. Both passes split the columns into chunks of about the same number of multiply-adds,
+  * which are processed concurrently with their own sparse_product_accumulator.
+  *
+  * \returns false if the product is too small to benefit from several threads, or if \a res is not a SparseMatrix,
+  * in which case it is left to the sequential implementation.
+  */
+template<typename Lhs, typename Rhs, typename Scalar, int Options, typename StorageIndex>
+bool conservative_sparse_sparse_product_twopass(const Lhs& lhs, const Rhs& rhs, SparseMatrix<Scalar,Options,StorageIndex>& res, bool sortedInsertion)
+{
+  typedef SparseMatrix<Scalar,Options,StorageIndex> ResultType;
+  typedef evaluator<Lhs> LhsEval;
+  typedef evaluator<Rhs> RhsEval;
+  Index cols = rhs.outerSize();
+  LhsEval lhsEval(lhs);
+  RhsEval rhsEval(rhs);
+
+  // the number of multiply-adds of each column of the result
+  Matrix<Index,Dynamic,1> lhsNnz(lhs.outerSize());
+  for(Index k=0; k<lhs.outerSize(); ++k)
+  {
+    Index nnz = 0;
+    for(typename LhsEval::InnerIterator lhsIt(lhsEval, k); lhsIt; ++lhsIt)
+      ++nnz;
+    lhsNnz(k) = nnz;
+  }
+  Matrix<Index,Dynamic,1> flops(cols);
+  Index totalFlops = 0;
+  for(Index j=0; j<cols; ++j)
+  {
+    Index f = 0;
+    for(typename RhsEval::InnerIterator rhsIt(rhsEval, j); rhsIt; ++rhsIt)
+      f += lhsNnz(rhsIt.index());
+    flops(j) = f;
+    totalFlops += f;
+  }
+
+  const Index threads = parallel_cwise_threads(double(totalFlops) * double(SparseSparseProductCost));
+  if(threads<=1)
+    return false;
+
+  const Index numTasks = 4*threads;
+  Matrix<Index,Dynamic,1> chunks;
+  sparse_product_chunks(flops, totalFlops, numTasks, chunks);
+
+  res.setZero();
+  conservative_sparse_sparse_product_task<Lhs,Rhs,ResultType> task(lhsEval, rhsEval, res, flops.data(), chunks.data(), sortedInsertion);
+  parallel_run_tasks(numTasks, threads, task);
+
+  StorageIndex* outerIndex = res.outerIndexPtr();
+  for(Index j=0; j<cols; ++j)
+    outerIndex[j+1] += outerIndex[j];
+  res.resizeNonZeros(outerIndex[cols]);
+
+  task.m_numeric = true;
+  parallel_run_tasks(numTasks, threads, task);
+  return true;
+}
+
+template<typename Lhs, typename Rhs, typename ResultType>
+bool conservative_sparse_sparse_product_twopass(const Lhs&, const Rhs&, ResultType&, bool)
+{
+  return false;
+}
+
 template<typename Lhs, typename Rhs, typename ResultType>
 static void conservative_sparse_sparse_product_impl(const Lhs& lhs, const Rhs& rhs, ResultType& res, bool sortedInsertion = false)
 {
@@ -25,6 +327,9 @@ static void conservative_sparse_sparse_product_impl(const Lhs& lhs, const Rhs& r
   Index rows = lhs.innerSize();
   Index cols = rhs.outerSize();
   eigen_assert(lhs.outerSize() == rhs.innerSize());
+
+  if(conservative_sparse_sparse_product_twopass(lhs, rhs, res, sortedInsertion))
+    return;
   
   ei_declare_aligned_stack_constructed_variable(bool,   mask,     rows, 0);
   ei_declare_aligned_stack_constructed_variable(ResScalar, values,   rows, 0);
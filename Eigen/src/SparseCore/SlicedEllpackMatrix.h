@@ -0,0 +1,323 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_SLICED_ELLPACK_MATRIX_H
+#define EIGEN_SLICED_ELLPACK_MATRIX_H
+
+namespace Eigen {
+
+template<typename _Scalar, typename _StorageIndex = int> class SlicedEllpackMatrix;
+
+namespace internal {
+
+// SlicedEllpackMatrix looks like a row-major SparseMatrix to the solvers
+template<typename _Scalar, typename _StorageIndex>
+struct traits<SlicedEllpackMatrix<_Scalar,_StorageIndex> > : traits<SparseMatrix<_Scalar,RowMajor,_StorageIndex> >
+{};
+
+/** \internal \returns the packet of the coefficients \a x[indices[0]], ..., \a x[indices[size-1]] */
+template<typename Packet, typename Scalar, typename StorageIndex>
+EIGEN_STRONG_INLINE Packet sliced_ellpack_gather(const Scalar* x, const StorageIndex* indices)
+{
+  enum { Size = unpacket_traits<Packet>::size };
+  EIGEN_ALIGN_MAX Scalar tmp[Size];
+  for(int k=0; k<Size; ++k)
+    tmp[k] = x[indices[k]];
+  return ploadu<Packet>(tmp);
+}
+
+/** \internal Sorts positions by decreasing lengths */
+template<typename IndexVector>
+struct sliced_ellpack_longer_row
+{
+  explicit sliced_ellpack_longer_row(const IndexVector& lengths) : m_lengths(lengths) {}
+  bool operator()(typename IndexVector::Scalar a, typename IndexVector::Scalar b) const { return m_lengths(a) > m_lengths(b); }
+  const IndexVector& m_lengths;
+};
+
+/** \internal Computes a range of slices of a SlicedEllpackMatrix times a dense matrix, see SlicedEllpackMatrix::scaleAndAddSlices(). */
+template<typename MatrixType, typename Rhs, typename Dest>
+struct sliced_ellpack_product_task
+{
+  typedef typename MatrixType::Scalar Scalar;
+  sliced_ellpack_product_task(const MatrixType& mat, const Rhs& rhs, Dest& dst, const Scalar& alpha, Index numTasks)
+    : m_mat(mat), m_rhs(rhs), m_dst(dst), m_alpha(alpha), m_numTasks(numTasks) {}
+  void operator()(Index t) const
+  {
+    const Index slices = m_mat.slices();
+    m_mat.scaleAndAddSlices(m_rhs, m_dst, m_alpha, (slices*t)/m_numTasks, (slices*(t+1))/m_numTasks);
+  }
+  const MatrixType& m_mat;
+  const Rhs& m_rhs;
+  Dest& m_dst;
+  const Scalar& m_alpha;
+  const Index m_numTasks;
+};
+
+} // end namespace internal
+
+/** \ingroup SparseCore_Module
+  * \class SlicedEllpackMatrix
+  *
+  * \brief A read-only sparse matrix in the sliced ELLPACK format, tailored for vectorized matrix-vector products
+  *
+  * \tparam _Scalar the scalar type, i.e. the type of the coefficients
+  * \tparam _StorageIndex the type of the column indices. It has to be a \b signed type (e.g., short, int, std::ptrdiff_t). Default is \c int.
+  *
+  * The compressed storage of SparseMatrix processes a single row at once, and its matrix-vector products
+  * make a poor use of SIMD instructions when the rows are short. This format, also known as SELL-C-\f$ \sigma \f$,
+  * stores the rows by slices of \c C = sliceHeight() consecutive rows, where \c C is the number of scalars
+  * of a packet. The coefficients of a slice are padded with zeros to the length of its longest row, and stored
+  * column by column: the product of a slice with a vector then processes its \c C rows at once, with one packet of
+  * coefficients and one gather of the vector per column of the slice. To reduce the padding, the rows are sorted
+  * by decreasing numbers of nonzeros within windows of \f$ \sigma \f$ = sortingScope() rows, which should be a
+  * few hundreds to keep the accesses to the result local.
+  *
+  * The matrix is built from any sparse expression and cannot be modified afterwards:
+  * \code
+  * SparseMatrix<double> A = ...;
+  * SlicedEllpackMatrix<double> S(A);
+  * y.noalias() = S * x;
+  * ConjugateGradient<SlicedEllpackMatrix<double>, Lower|Upper> cg(S);
+  * x = cg.solve(b);
+  * \endcode
+  * It supports the products with dense vectors and matrices of the same scalar type, which run on several threads
+  * for large matrices (see \ref TopicMultiThreading), as well as the iterative solvers with the IdentityPreconditioner
+  * and the DiagonalPreconditioner.
+  *
+  * \sa SparseMatrix
+  */
+template<typename _Scalar, typename _StorageIndex>
+class SlicedEllpackMatrix : public EigenBase<SlicedEllpackMatrix<_Scalar,_StorageIndex> >
+{
+  public:
+    typedef _Scalar Scalar;
+    typedef typename NumTraits<Scalar>::Real RealScalar;
+    typedef _StorageIndex StorageIndex;
+    typedef Matrix<StorageIndex,Dynamic,1> IndexVector;
+    typedef Matrix<Scalar,Dynamic,1> ScalarVector;
+    typedef typename internal::packet_traits<Scalar>::type Packet;
+    enum {
+      ColsAtCompileTime = Dynamic,
+      MaxColsAtCompileTime = Dynamic,
+      IsRowMajor = true,
+      SliceHeight = internal::unpacket_traits<Packet>::size
+    };
+
+    class InnerIterator;
+
+    /** Default constructor, the matrix must be initialized with compute(). */
+    SlicedEllpackMatrix() : m_rows(0), m_cols(0), m_sortingScope(1), m_nonZeros(0) {}
+
+    /** Builds the sliced ELLPACK representation of the sparse matrix \a other, see compute(). */
+    template<typename OtherDerived>
+    explicit SlicedEllpackMatrix(const SparseMatrixBase<OtherDerived>& other, Index sortingScope = 256)
+      : m_rows(0), m_cols(0), m_sortingScope(1), m_nonZeros(0)
+    {
+      compute(other, sortingScope);
+    }
+
+    template<typename OtherDerived>
+    SlicedEllpackMatrix& compute(const SparseMatrixBase<OtherDerived>& other, Index sortingScope = 256);
+
+    inline Index rows() const { return m_rows; }
+    inline Index cols() const { return m_cols; }
+    inline Index outerSize() const { return m_rows; }
+    inline Index innerSize() const { return m_cols; }
+
+    /** \returns the number of nonzeros of the matrix, without the padding */
+    inline Index nonZeros() const { return m_nonZeros; }
+
+    /** \returns the number of stored coefficients, including the padding of the slices */
+    inline Index storedSize() const { return m_values.size(); }
+
+    /** \returns the number of rows of a slice, i.e. the size of a packet of scalars */
+    static Index sliceHeight() { return SliceHeight; }
+
+    /** \returns the number of slices */
+    inline Index slices() const { return m_sliceStarts.size()==0 ? 0 : m_sliceStarts.size()-1; }
+
+    /** \returns the size of the windows of rows within which the rows are sorted by decreasing lengths */
+    inline Index sortingScope() const { return m_sortingScope; }
+
+    /** \returns the original index of the row stored at the position \a i */
+    inline StorageIndex permutation(Index i) const { return m_perm(i); }
+
+    /** \returns the dense product of \c *this by the dense vector or matrix \a x */
+    template<typename Rhs>
+    Product<SlicedEllpackMatrix,Rhs,AliasFreeProduct> operator*(const MatrixBase<Rhs>& x) const
+    {
+      eigen_assert(cols()==x.rows() && "invalid matrix product");
+      return Product<SlicedEllpackMatrix,Rhs,AliasFreeProduct>(*this, x.derived());
+    }
+
+    template<typename Rhs, typename Dest>
+    void scaleAndAddTo(Dest& dst, const Rhs& rhs, const Scalar& alpha) const;
+
+    #ifndef EIGEN_PARSED_BY_DOXYGEN
+    /** \internal Adds \a alpha times the slices \a begin to \a end-1 times \a rhs to the corresponding rows of \a dst */
+    template<typename Rhs, typename Dest>
+    void scaleAndAddSlices(const Rhs& rhs, Dest& dst, const Scalar& alpha, Index begin, Index end) const
+    {
+      EIGEN_ALIGN_MAX Scalar res[SliceHeight];
+      for(Index c=0; c<rhs.cols(); ++c)
+      {
+        const Scalar* x = rhs.col(c).data();
+        for(Index s=begin; s<end; ++s)
+        {
+          const Scalar* values = m_values.data() + m_sliceStarts(s);
+          const StorageIndex* indices = m_indices.data() + m_sliceStarts(s);
+          const Index width = (m_sliceStarts(s+1) - m_sliceStarts(s)) / SliceHeight;
+          Packet acc = internal::pset1<Packet>(Scalar(0));
+          for(Index k=0; k<width; ++k, values+=SliceHeight, indices+=SliceHeight)
+            acc = internal::pmadd(internal::ploadu<Packet>(values), internal::sliced_ellpack_gather<Packet>(x, indices), acc);
+          internal::pstoreu(res, acc);
+          const Index rowEnd = (std::min)(m_rows, (s+1)*SliceHeight);
+          for(Index i=s*SliceHeight; i<rowEnd; ++i)
+            dst.coeffRef(m_perm(i),c) += alpha * res[i-s*SliceHeight];
+        }
+      }
+    }
+    #endif
+
+  protected:
+    Index m_rows, m_cols, m_sortingScope, m_nonZeros;
+    ScalarVector m_values;     // coefficients, slice by slice and column by column within each slice
+    IndexVector m_indices;     // column indices of the coefficients
+    IndexVector m_sliceStarts; // start of each slice in m_values
+    IndexVector m_perm;        // original index of the rows in the order of the slices
+    IndexVector m_rowPos;      // position of each row in the slices
+    IndexVector m_rowLengths;  // number of nonzeros of each row
+};
+
+/** Builds the sliced ELLPACK representation of the sparse matrix \a other, whose rows are sorted by decreasing
+  * numbers of nonzeros within windows of \a sortingScope rows. The scope is rounded up to a multiple of sliceHeight(),
+  * and a scope of 1 keeps the rows in their original order. */
+template<typename _Scalar, typename _StorageIndex>
+template<typename OtherDerived>
+SlicedEllpackMatrix<_Scalar,_StorageIndex>&
+SlicedEllpackMatrix<_Scalar,_StorageIndex>::compute(const SparseMatrixBase<OtherDerived>& other, Index sortingScope)
+{
+  eigen_assert(sortingScope>0);
+  const SparseMatrix<Scalar,RowMajor,StorageIndex> mat(other.derived());
+  m_rows = mat.rows();
+  m_cols = mat.cols();
+  m_nonZeros = mat.nonZeros();
+  m_sortingScope = ((sortingScope+SliceHeight-1)/SliceHeight) * SliceHeight;
+
+  m_rowLengths.resize(m_rows);
+  m_perm.resize(m_rows);
+  m_rowPos.resize(m_rows);
+  for(Index i=0; i<m_rows; ++i)
+  {
+    m_rowLengths(i) = StorageIndex(mat.outerIndexPtr()[i+1] - mat.outerIndexPtr()[i]);
+    m_perm(i) = StorageIndex(i);
+  }
+  if(m_sortingScope>SliceHeight)
+    for(Index w=0; w<m_rows; w+=m_sortingScope)
+      std::stable_sort(m_perm.data()+w, m_perm.data()+(std::min)(m_rows, w+m_sortingScope),
+                       internal::sliced_ellpack_longer_row<IndexVector>(m_rowLengths));
+  for(Index i=0; i<m_rows; ++i)
+    m_rowPos(m_perm(i)) = StorageIndex(i);
+
+  // the width of each slice is the length of its longest row
+  const Index numSlices = (m_rows+SliceHeight-1)/SliceHeight;
+  m_sliceStarts.resize(numSlices+1);
+  m_sliceStarts(0) = 0;
+  for(Index s=0; s<numSlices; ++s)
+  {
+    StorageIndex width = 0;
+    for(Index i=s*SliceHeight; i<(std::min)(m_rows, (s+1)*SliceHeight); ++i)
+      width = (std::max)(width, m_rowLengths(m_perm(i)));
+    m_sliceStarts(s+1) = StorageIndex(m_sliceStarts(s) + width*SliceHeight);
+  }
+
+  // the padding coefficients are zeros in the first column
+  m_values.setZero(m_sliceStarts(numSlices));
+  m_indices.setZero(m_sliceStarts(numSlices));
+  for(Index i=0; i<m_rows; ++i)
+  {
+    const Index s = i/SliceHeight, start = m_sliceStarts(s) + i%SliceHeight;
+    Index k = 0;
+    for(typename SparseMatrix<Scalar,RowMajor,StorageIndex>::InnerIterator it(mat,m_perm(i)); it; ++it, ++k)
+    {
+      m_values(start + k*SliceHeight) = it.value();
+      m_indices(start + k*SliceHeight) = it.index();
+    }
+  }
+  return *this;
+}
+
+/** Adds \a alpha times \c *this times the dense matrix \a rhs to \a dst. The large products run on several threads. */
+template<typename _Scalar, typename _StorageIndex>
+template<typename Rhs, typename Dest>
+void SlicedEllpackMatrix<_Scalar,_StorageIndex>::scaleAndAddTo(Dest& dst, const Rhs& rhs, const Scalar& alpha) const
+{
+  // the columns of the rhs must be contiguous to be gathered
+  typedef Ref<const Matrix<Scalar,Dynamic,Dynamic,ColMajor> > ActualRhs;
+  ActualRhs actualRhs(rhs);
+  Index threads = internal::sparse_dense_product_threads(double(storedSize()) * double(rhs.cols()));
+  if(threads>1)
+    internal::parallel_run_tasks(4*threads, threads,
+                                 internal::sliced_ellpack_product_task<SlicedEllpackMatrix,ActualRhs,Dest>(*this, actualRhs, dst, alpha, 4*threads));
+  else
+    scaleAndAddSlices(actualRhs, dst, alpha, 0, slices());
+}
+
+/** \class SlicedEllpackMatrix::InnerIterator
+  * \brief Iterates over the nonzeros of a row of a SlicedEllpackMatrix, by increasing column indices
+  */
+template<typename _Scalar, typename _StorageIndex>
+class SlicedEllpackMatrix<_Scalar,_StorageIndex>::InnerIterator
+{
+  public:
+    InnerIterator(const SlicedEllpackMatrix& mat, Index outer)
+      : m_values(mat.m_values.data()), m_indices(mat.m_indices.data()), m_outer(outer), m_k(0), m_size(mat.m_rowLengths(outer))
+    {
+      const Index pos = mat.m_rowPos(outer);
+      m_start = mat.m_sliceStarts(pos/SliceHeight) + pos%SliceHeight;
+    }
+
+    inline InnerIterator& operator++() { ++m_k; return *this; }
+
+    inline const Scalar& value() const { return m_values[m_start + m_k*SliceHeight]; }
+    inline StorageIndex index() const { return m_indices[m_start + m_k*SliceHeight]; }
+    inline Index outer() const { return m_outer; }
+    inline Index row() const { return m_outer; }
+    inline Index col() const { return index(); }
+
+    inline operator bool() const { return m_k < m_size; }
+
+  protected:
+    const Scalar* m_values;
+    const StorageIndex* m_indices;
+    const Index m_outer;
+    Index m_start, m_k;
+    const Index m_size;
+};
+
+namespace internal {
+
+template<typename _Scalar, typename _StorageIndex, typename Rhs, int ProductType>
+struct generic_product_impl<SlicedEllpackMatrix<_Scalar,_StorageIndex>, Rhs, SparseShape, DenseShape, ProductType>
+ : generic_product_impl_base<SlicedEllpackMatrix<_Scalar,_StorageIndex>,Rhs,generic_product_impl<SlicedEllpackMatrix<_Scalar,_StorageIndex>,Rhs,SparseShape,DenseShape,ProductType> >
+{
+  typedef SlicedEllpackMatrix<_Scalar,_StorageIndex> Lhs;
+  typedef typename Product<Lhs,Rhs>::Scalar Scalar;
+
+  template<typename Dest>
+  static void scaleAndAddTo(Dest& dst, const Lhs& lhs, const Rhs& rhs, const Scalar& alpha)
+  {
+    lhs.scaleAndAddTo(dst, rhs, alpha);
+  }
+};
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+#endif // EIGEN_SLICED_ELLPACK_MATRIX_H
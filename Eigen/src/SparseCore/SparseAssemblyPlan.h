@@ -0,0 +1,253 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_SPARSE_ASSEMBLY_PLAN_H
+#define EIGEN_SPARSE_ASSEMBLY_PLAN_H
+
+namespace Eigen {
+
+namespace internal {
+
+/** \internal Estimated cost, in cycles, of the accumulation of one triplet by SparseAssemblyPlan::assemble(). */
+const int SparseAssemblyCost = 4;
+
+/** \internal Gives access to the values of a list of triplets through a random access iterator. */
+template<typename InputIterator, typename Scalar>
+struct triplet_value_iterator
+{
+  explicit triplet_value_iterator(const InputIterator& begin) : m_begin(begin) {}
+  Scalar operator[](Index k) const { return m_begin[k].value(); }
+  const InputIterator m_begin;
+};
+
+/** \internal Assembles a range of coefficients of the value array, see SparseAssemblyPlan::assemble(). */
+template<typename Plan, typename ValueIterator>
+struct sparse_assembly_task
+{
+  typedef typename Plan::Scalar Scalar;
+  sparse_assembly_task(const Plan& plan, const ValueIterator& values, Scalar* dst, Index numChunks)
+    : m_plan(plan), m_values(values), m_dst(dst), m_numChunks(numChunks) {}
+  void operator()(Index c) const
+  {
+    const Index nnz = m_plan.nonZeros();
+    m_plan.assembleRange(m_values, m_dst, (nnz*c)/m_numChunks, (nnz*(c+1))/m_numChunks);
+  }
+  const Plan& m_plan;
+  const ValueIterator& m_values;
+  Scalar* m_dst;
+  const Index m_numChunks;
+};
+
+} // end namespace internal
+
+/** \ingroup SparseCore_Module
+  * \class SparseAssemblyPlan
+  *
+  * \brief Repeated assembly of sparse matrices with a fixed structure from lists of triplets
+  *
+  * \tparam _SparseMatrixType the type of the assembled SparseMatrix
+  *
+  * Time stepping or nonlinear solvers often assemble a new matrix at each step from the same list of positions,
+  * with different values only. Instead of sorting the triplets again with SparseMatrix::setFromTriplets(),
+  * the assembly plan records, once, the sparsity pattern of the matrix and the position in its value array of
+  * each triplet. The next assemblies then only accumulate the new values in place, without any sorting or
+  * memory allocation:
+  * \code
+  * std::vector<Triplet<double> > triplets = ...;
+  * SparseMatrix<double> A(rows,cols);
+  * SparseAssemblyPlan<SparseMatrix<double> > plan(A, triplets.begin(), triplets.end());
+  * for(...)
+  * {
+  *   // compute the new values of the triplets, in the same order, into values[0], ..., values[triplets.size()-1]
+  *   plan.assemble(A, values.data());
+  *   // ...
+  * }
+  * \endcode
+  *
+  * As with setFromTriplets(), the duplicated entries are summed up, in the order of the list, so that the
+  * assembled values are the same as the ones of setFromTriplets(). The coefficients of large matrices are assembled
+  * by several threads (see \ref TopicMultiThreading).
+  *
+  * \sa SparseMatrix::setFromTriplets(), SparseMatrix::updateFromTriplets()
+  */
+template<typename _SparseMatrixType>
+class SparseAssemblyPlan
+{
+  public:
+    typedef _SparseMatrixType SparseMatrixType;
+    typedef typename SparseMatrixType::Scalar Scalar;
+    typedef typename SparseMatrixType::StorageIndex StorageIndex;
+    typedef Matrix<StorageIndex,Dynamic,1> IndexVector;
+    enum { IsRowMajor = SparseMatrixType::IsRowMajor };
+
+    /** Default constructor, the plan must be initialized with compute(). */
+    SparseAssemblyPlan() : m_rows(0), m_cols(0) {}
+
+    /** Assembles \a mat from the list of triplets \a begin - \a end and computes its plan, see compute(). */
+    template<typename InputIterators>
+    SparseAssemblyPlan(SparseMatrixType& mat, const InputIterators& begin, const InputIterators& end)
+      : m_rows(0), m_cols(0)
+    {
+      compute(mat, begin, end);
+    }
+
+    template<typename InputIterators>
+    SparseAssemblyPlan& compute(SparseMatrixType& mat, const InputIterators& begin, const InputIterators& end);
+
+    template<typename ValueIterator>
+    void assemble(SparseMatrixType& mat, const ValueIterator& values) const;
+
+    /** Assembles \a mat from the values of the triplets \a begin - \a end, which must have the same positions,
+      * in the same order, as the ones given to compute(). The iterators must be random access.
+      * \sa assemble() */
+    template<typename InputIterators>
+    void assembleFromTriplets(SparseMatrixType& mat, const InputIterators& begin, const InputIterators& end) const
+    {
+      eigen_assert(Index(end-begin)==size() && "the list of triplets does not match the assembly plan");
+      EIGEN_ONLY_USED_FOR_DEBUG(end);
+      assemble(mat, internal::triplet_value_iterator<InputIterators,Scalar>(begin));
+    }
+
+    /** \returns the number of triplets of the plan */
+    Index size() const { return m_offsets.size(); }
+
+    /** \returns the number of nonzeros of the assembled matrices */
+    Index nonZeros() const { return m_entryStarts.size()==0 ? 0 : m_entryStarts.size()-1; }
+
+    /** \returns the position, in the value array of the assembled matrices, of the coefficient of the \a k-th triplet */
+    StorageIndex offset(Index k) const { return m_offsets(k); }
+
+    /** \returns the positions, in the value array of the assembled matrices, of the coefficients of all the triplets */
+    const IndexVector& offsets() const { return m_offsets; }
+
+    /** \internal Sets the coefficients \a start to \a end-1 of \a dst */
+    template<typename ValueIterator>
+    void assembleRange(const ValueIterator& values, Scalar* dst, Index start, Index end) const
+    {
+      for(Index p=start; p<end; ++p)
+      {
+        Index k = m_entryStarts(p);
+        Scalar v = values[m_order(k)];
+        for(++k; k<m_entryStarts(p+1); ++k)
+          v += values[m_order(k)];
+        dst[p] = v;
+      }
+    }
+
+  protected:
+    static void sortByKey(const IndexVector& keys, Index numKeys, const IndexVector& order, IndexVector& sorted, IndexVector& starts);
+
+    Index m_rows, m_cols;
+    IndexVector m_offsets;     // position of each triplet in the value array
+    IndexVector m_order;       // triplets sorted by position
+    IndexVector m_entryStarts; // start of the triplets of each nonzero in m_order
+};
+
+/** Assembles \a mat from the list of triplets \a begin - \a end like SparseMatrix::setFromTriplets(), and records
+  * the position of each triplet in its value array. The matrix must be resized beforehand, its sparsity pattern
+  * is the one of the triplets, and it is compressed.
+  *
+  * \warning The pattern of \a mat must not be modified afterwards, otherwise the plan must be computed again.
+  */
+template<typename _SparseMatrixType>
+template<typename InputIterators>
+SparseAssemblyPlan<_SparseMatrixType>&
+SparseAssemblyPlan<_SparseMatrixType>::compute(SparseMatrixType& mat, const InputIterators& begin, const InputIterators& end)
+{
+  m_rows = mat.rows();
+  m_cols = mat.cols();
+  const Index outerSize = mat.outerSize(), innerSize = mat.innerSize();
+  Index n = 0;
+  for(InputIterators it(begin); it!=end; ++it)
+    ++n;
+
+  IndexVector outer(n), inner(n);
+  Matrix<Scalar,Dynamic,1> values(n);
+  Index k = 0;
+  for(InputIterators it(begin); it!=end; ++it, ++k)
+  {
+    eigen_assert(it->row()>=0 && it->row()<mat.rows() && it->col()>=0 && it->col()<mat.cols());
+    outer(k) = StorageIndex(IsRowMajor ? it->row() : it->col());
+    inner(k) = StorageIndex(IsRowMajor ? it->col() : it->row());
+    values(k) = it->value();
+  }
+
+  // stable counting sorts of the triplets by inner indices, and then by outer indices
+  IndexVector identity(n), byInner, starts;
+  for(k=0; k<n; ++k)
+    identity(k) = StorageIndex(k);
+  sortByKey(inner, innerSize, identity, byInner, starts);
+  sortByKey(outer, outerSize, byInner, m_order, starts);
+
+  // the consecutive triplets with the same position are merged into a single nonzero
+  mat.resize(m_rows, m_cols);
+  StorageIndex* outerIndex = mat.outerIndexPtr();
+  m_offsets.resize(n);
+  m_entryStarts.resize(n+1);
+  StorageIndex nnz = 0;
+  for(Index j=0; j<outerSize; ++j)
+  {
+    outerIndex[j] = nnz;
+    for(Index q=starts(j); q<starts(j+1); ++q)
+    {
+      if(q==starts(j) || inner(m_order(q))!=inner(m_order(q-1)))
+        m_entryStarts(nnz++) = StorageIndex(q);
+      m_offsets(m_order(q)) = nnz-1;
+    }
+  }
+  outerIndex[outerSize] = nnz;
+  m_entryStarts(nnz) = StorageIndex(n);
+  m_entryStarts.conservativeResize(nnz+1);
+
+  mat.resizeNonZeros(nnz);
+  StorageIndex* innerIndices = mat.innerIndexPtr();
+  for(Index p=0; p<nnz; ++p)
+    innerIndices[p] = inner(m_order(m_entryStarts(p)));
+  assemble(mat, values.data());
+  return *this;
+}
+
+/** Assembles the compressed matrix \a mat, whose sparsity pattern has been computed by compute(), where
+  * \a values[k] is the value of the \a k-th triplet. The nonzeros of \a mat are overwritten.
+  *
+  * \a ValueIterator must provide operator[], for instance a pointer or a random access iterator.
+  *
+  * \sa assembleFromTriplets()
+  */
+template<typename _SparseMatrixType>
+template<typename ValueIterator>
+void SparseAssemblyPlan<_SparseMatrixType>::assemble(SparseMatrixType& mat, const ValueIterator& values) const
+{
+  eigen_assert(mat.rows()==m_rows && mat.cols()==m_cols && mat.isCompressed() && mat.nonZeros()==nonZeros()
+               && "the matrix does not match the assembly plan");
+  const Index nnz = nonZeros();
+  const Index threads = internal::parallel_cwise_threads(double(size()) * double(internal::SparseAssemblyCost));
+  if(threads<=1)
+    assembleRange(values, mat.valuePtr(), 0, nnz);
+  else
+    internal::parallel_run_tasks(threads, threads, internal::sparse_assembly_task<SparseAssemblyPlan,ValueIterator>(*this, values, mat.valuePtr(), threads));
+}
+
+/** \internal Stable counting sort of the entries \a order by their \a keys, with the start of each key in \a starts */
+template<typename _SparseMatrixType>
+void SparseAssemblyPlan<_SparseMatrixType>::sortByKey(const IndexVector& keys, Index numKeys, const IndexVector& order,
+                                                      IndexVector& sorted, IndexVector& starts)
+{
+  starts.setZero(numKeys+1);
+  for(Index k=0; k<order.size(); ++k)
+    ++starts(keys(order(k))+1);
+  for(Index j=0; j<numKeys; ++j)
+    starts(j+1) += starts(j);
+  IndexVector pos = starts;
+  sorted.resize(order.size());
+  for(Index k=0; k<order.size(); ++k)
+    sorted(pos(keys(order(k)))++) = order(k);
+}
+
+} // end namespace Eigen
+
+#endif // EIGEN_SPARSE_ASSEMBLY_PLAN_H
@@ -17,12 +17,124 @@ namespace internal {
 template <> struct product_promote_storage_type<Sparse,Dense, OuterProduct> { typedef Sparse ret; };
 template <> struct product_promote_storage_type<Dense,Sparse, OuterProduct> { typedef Sparse ret; };
 
+/** \internal \returns the number of threads worth using for a sparse * dense product of \a work multiply-adds */
+inline Index sparse_dense_product_threads(double work)
+{
+  // This 20000 threshold has been found experimentally on 2D and 3D Poisson problems.
+  // It basically represents the minimal amount of work to be done by each thread to be worth it.
+  return parallel_cwise_threads(work / 20000. * double(EIGEN_PARALLEL_CWISE_THREAD_COST));
+}
+
+/** \internal \returns the number of threads worth using to scatter \a nnz nonzeros into \a res, see parallel_sparse_scatter().
+  * Each additional thread costs the initialization and the accumulation of a buffer of the size of \a res, so that the
+  * products with less nonzeros per row than threads are not split as much. */
+template<typename Res>
+Index sparse_scatter_threads(double nnz, const Res& res)
+{
+  Index threads = sparse_dense_product_threads(nnz * double(res.cols()));
+  return (std::min)(threads, (std::max)(Index(1), Index(nnz / double(res.rows() + 1))));
+}
+
+/** \internal Runs \a kernel on a range of \a size outer vectors, see sparse_time_dense_product_impl. */
+template<typename Kernel>
+struct sparse_dense_product_task
+{
+  sparse_dense_product_task(const Kernel& kernel, Index size, Index numTasks)
+    : m_kernel(kernel), m_size(size), m_numTasks(numTasks) {}
+  void operator()(Index t) const
+  {
+    m_kernel.run((m_size*t)/m_numTasks, (m_size*(t+1))/m_numTasks);
+  }
+  const Kernel& m_kernel;
+  const Index m_size;
+  const Index m_numTasks;
+};
+
+/** \internal Scatters a range of outer vectors into the result, or into the buffer of its task, see parallel_sparse_scatter(). */
+template<typename Kernel, typename Res, typename Buffer>
+struct sparse_scatter_task
+{
+  sparse_scatter_task(const Kernel& kernel, Index outerSize, Res& res, std::vector<Buffer>& buffers)
+    : m_kernel(kernel), m_outerSize(outerSize), m_res(res), m_buffers(buffers) {}
+  void operator()(Index t) const
+  {
+    const Index numTasks = Index(m_buffers.size()) + 1;
+    const Index begin = (m_outerSize*t)/numTasks, end = (m_outerSize*(t+1))/numTasks;
+    if(t==0)
+      m_kernel.run(begin, end, m_res);
+    else
+    {
+      m_buffers[t-1].setZero(m_res.rows(), m_res.cols());
+      m_kernel.run(begin, end, m_buffers[t-1]);
+    }
+  }
+  const Kernel& m_kernel;
+  const Index m_outerSize;
+  Res& m_res;
+  std::vector<Buffer>& m_buffers;
+};
+
+/** \internal Accumulates the buffers of parallel_sparse_scatter() into a block of rows of the result. */
+template<typename Res, typename Buffer>
+struct sparse_gather_task
+{
+  sparse_gather_task(Res& res, const std::vector<Buffer>& buffers) : m_res(res), m_buffers(buffers) {}
+  void operator()(Index t) const
+  {
+    const Index numTasks = Index(m_buffers.size()) + 1;
+    const Index begin = (m_res.rows()*t)/numTasks, end = (m_res.rows()*(t+1))/numTasks;
+    for(std::size_t k=0; k<m_buffers.size(); ++k)
+      m_res.middleRows(begin, end-begin) += m_buffers[k].middleRows(begin, end-begin);
+  }
+  Res& m_res;
+  const std::vector<Buffer>& m_buffers;
+};
+
+/** \internal
+  * Adds to \a res the scatters of the \a outerSize outer vectors of a sparse matrix, such as the columns of a column-major
+  * matrix times a vector, on \a threads threads. Each thread scatters a range of outer vectors into its own buffer, but
+  * the first one which updates \a res directly, and the buffers are then accumulated into \a res by blocks of rows.
+  * The scatters of the outer vectors \a begin to \a end-1 into \a dst are performed by \a kernel.run(begin, end, dst),
+  * for \a dst either \a res or a buffer.
+  */
+template<typename Kernel, typename Res>
+void parallel_sparse_scatter(const Kernel& kernel, Index outerSize, Res& res, Index threads)
+{
+  typedef Matrix<typename Res::Scalar,Dynamic,Dynamic> Buffer;
+  std::vector<Buffer> buffers(threads-1);
+  parallel_run_tasks(threads, threads, sparse_scatter_task<Kernel,Res,Buffer>(kernel, outerSize, res, buffers));
+  parallel_run_tasks(threads, threads, sparse_gather_task<Res,Buffer>(res, buffers));
+}
+
 template<typename SparseLhsType, typename DenseRhsType, typename DenseResType,
          typename AlphaType,
          int LhsStorageOrder = ((SparseLhsType::Flags&RowMajorBit)==RowMajorBit) ? RowMajor : ColMajor,
          bool ColPerCol = ((DenseRhsType::Flags&RowMajorBit)==0) || DenseRhsType::ColsAtCompileTime==1>
 struct sparse_time_dense_product_impl;
 
+/** \internal The kernels of sparse_time_dense_product_impl, which process a range of outer vectors of the lhs. */
+template<typename Impl, typename LhsEval, typename Rhs, typename Res, typename AlphaType>
+struct sparse_time_dense_product_kernel
+{
+  sparse_time_dense_product_kernel(const LhsEval& lhsEval, const Rhs& rhs, Res& res, const AlphaType& alpha)
+    : m_lhsEval(lhsEval), m_rhs(rhs), m_res(res), m_alpha(alpha) {}
+  // rows begin to end-1 of the result of a row-major lhs
+  void run(Index begin, Index end) const
+  {
+    Impl::processRows(m_lhsEval, m_rhs, m_res, m_alpha, begin, end);
+  }
+  // scatter of the columns begin to end-1 of a column-major lhs into dst
+  template<typename Dest>
+  void run(Index begin, Index end, Dest& dst) const
+  {
+    Impl::processColumns(m_lhsEval, m_rhs, dst, m_alpha, begin, end);
+  }
+  const LhsEval& m_lhsEval;
+  const Rhs& m_rhs;
+  Res& m_res;
+  const AlphaType& m_alpha;
+};
+
 template<typename SparseLhsType, typename DenseRhsType, typename DenseResType>
 struct sparse_time_dense_product_impl<SparseLhsType,DenseRhsType,DenseResType, typename DenseResType::Scalar, RowMajor, true>
 {
@@ -31,34 +143,28 @@ struct sparse_time_dense_product_impl<SparseLhsType,DenseRhsType,DenseResType, t
   typedef typename internal::remove_all<DenseResType>::type Res;
   typedef typename evaluator<Lhs>::InnerIterator LhsInnerIterator;
   typedef evaluator<Lhs> LhsEval;
+  typedef typename Res::Scalar AlphaType;
   static void run(const SparseLhsType& lhs, const DenseRhsType& rhs, DenseResType& res, const typename Res::Scalar& alpha)
   {
     LhsEval lhsEval(lhs);
     
     Index n = lhs.outerSize();
-#ifdef EIGEN_HAS_OPENMP
-    Eigen::initParallel();
-    Index threads = Eigen::nbThreads();
-#endif
-    
-    for(Index c=0; c<rhs.cols(); ++c)
+    Index threads = sparse_dense_product_threads(double(lhsEval.nonZerosEstimate()) * double(rhs.cols()));
+    if(threads>1)
     {
-#ifdef EIGEN_HAS_OPENMP
-      // This 20000 threshold has been found experimentally on 2D and 3D Poisson problems.
-      // It basically represents the minimal amount of work to be done to be worth it.
-      if(threads>1 && lhsEval.nonZerosEstimate() > 20000)
-      {
-        #pragma omp parallel for schedule(dynamic,(n+threads*4-1)/(threads*4)) num_threads(threads)
-        for(Index i=0; i<n; ++i)
-          processRow(lhsEval,rhs,res,alpha,i,c);
-      }
-      else
-#endif
-      {
-        for(Index i=0; i<n; ++i)
-          processRow(lhsEval,rhs,res,alpha,i,c);
-      }
+      typedef sparse_time_dense_product_kernel<sparse_time_dense_product_impl,LhsEval,DenseRhsType,DenseResType,AlphaType> Kernel;
+      Kernel kernel(lhsEval, rhs, res, alpha);
+      parallel_run_tasks(4*threads, threads, sparse_dense_product_task<Kernel>(kernel, n, 4*threads));
     }
+    else
+      processRows(lhsEval, rhs, res, alpha, 0, n);
+  }
+  
+  static void processRows(const LhsEval& lhsEval, const DenseRhsType& rhs, DenseResType& res, const typename Res::Scalar& alpha, Index begin, Index end)
+  {
+    for(Index c=0; c<rhs.cols(); ++c)
+      for(Index i=begin; i<end; ++i)
+        processRow(lhsEval,rhs,res,alpha,i,c);
   }
   
   static void processRow(const LhsEval& lhsEval, const DenseRhsType& rhs, DenseResType& res, const typename Res::Scalar& alpha, Index i, Index col)
@@ -93,9 +199,22 @@ struct sparse_time_dense_product_impl<SparseLhsType,DenseRhsType,DenseResType, A
   static void run(const SparseLhsType& lhs, const DenseRhsType& rhs, DenseResType& res, const AlphaType& alpha)
   {
     LhsEval lhsEval(lhs);
+    Index threads = sparse_scatter_threads(double(lhsEval.nonZerosEstimate()), res);
+    if(threads>1)
+    {
+      typedef sparse_time_dense_product_kernel<sparse_time_dense_product_impl,LhsEval,DenseRhsType,DenseResType,AlphaType> Kernel;
+      parallel_sparse_scatter(Kernel(lhsEval, rhs, res, alpha), lhs.outerSize(), res, threads);
+    }
+    else
+      processColumns(lhsEval, rhs, res, alpha, 0, lhs.outerSize());
+  }
+
+  template<typename Dest>
+  static void processColumns(const LhsEval& lhsEval, const DenseRhsType& rhs, Dest& res, const AlphaType& alpha, Index begin, Index end)
+  {
     for(Index c=0; c<rhs.cols(); ++c)
     {
-      for(Index j=0; j<lhs.outerSize(); ++j)
+      for(Index j=begin; j<end; ++j)
       {
 //        typename Res::Scalar rhs_j = alpha * rhs.coeff(j,c);
         typename ScalarBinaryOpTraits<AlphaType, typename Rhs::Scalar>::ReturnType rhs_j(alpha * rhs.coeff(j,c));
@@ -114,28 +233,27 @@ struct sparse_time_dense_product_impl<SparseLhsType,DenseRhsType,DenseResType, t
   typedef typename internal::remove_all<DenseResType>::type Res;
   typedef evaluator<Lhs> LhsEval;
   typedef typename LhsEval::InnerIterator LhsInnerIterator;
+  typedef typename Res::Scalar AlphaType;
   static void run(const SparseLhsType& lhs, const DenseRhsType& rhs, DenseResType& res, const typename Res::Scalar& alpha)
   {
     Index n = lhs.rows();
     LhsEval lhsEval(lhs);
 
-#ifdef EIGEN_HAS_OPENMP
-    Eigen::initParallel();
-    Index threads = Eigen::nbThreads();
-    // This 20000 threshold has been found experimentally on 2D and 3D Poisson problems.
-    // It basically represents the minimal amount of work to be done to be worth it.
-    if(threads>1 && lhsEval.nonZerosEstimate()*rhs.cols() > 20000)
+    Index threads = sparse_dense_product_threads(double(lhsEval.nonZerosEstimate()) * double(rhs.cols()));
+    if(threads>1)
     {
-      #pragma omp parallel for schedule(dynamic,(n+threads*4-1)/(threads*4)) num_threads(threads)
-      for(Index i=0; i<n; ++i)
-        processRow(lhsEval,rhs,res,alpha,i);
+      typedef sparse_time_dense_product_kernel<sparse_time_dense_product_impl,LhsEval,DenseRhsType,DenseResType,AlphaType> Kernel;
+      Kernel kernel(lhsEval, rhs, res, alpha);
+      parallel_run_tasks(4*threads, threads, sparse_dense_product_task<Kernel>(kernel, n, 4*threads));
     }
     else
-#endif
-    {
-      for(Index i=0; i<n; ++i)
-        processRow(lhsEval, rhs, res, alpha, i);
-    }
+      processRows(lhsEval, rhs, res, alpha, 0, n);
+  }
+
+  static void processRows(const LhsEval& lhsEval, const DenseRhsType& rhs, Res& res, const typename Res::Scalar& alpha, Index begin, Index end)
+  {
+    for(Index i=begin; i<end; ++i)
+      processRow(lhsEval, rhs, res, alpha, i);
   }
 
   static void processRow(const LhsEval& lhsEval, const DenseRhsType& rhs, Res& res, const typename Res::Scalar& alpha, Index i)
@@ -152,11 +270,26 @@ struct sparse_time_dense_product_impl<SparseLhsType,DenseRhsType,DenseResType, t
   typedef typename internal::remove_all<SparseLhsType>::type Lhs;
   typedef typename internal::remove_all<DenseRhsType>::type Rhs;
   typedef typename internal::remove_all<DenseResType>::type Res;
-  typedef typename evaluator<Lhs>::InnerIterator LhsInnerIterator;
+  typedef evaluator<Lhs> LhsEval;
+  typedef typename LhsEval::InnerIterator LhsInnerIterator;
+  typedef typename Res::Scalar AlphaType;
   static void run(const SparseLhsType& lhs, const DenseRhsType& rhs, DenseResType& res, const typename Res::Scalar& alpha)
   {
-    evaluator<Lhs> lhsEval(lhs);
-    for(Index j=0; j<lhs.outerSize(); ++j)
+    LhsEval lhsEval(lhs);
+    Index threads = sparse_scatter_threads(double(lhsEval.nonZerosEstimate()), res);
+    if(threads>1)
+    {
+      typedef sparse_time_dense_product_kernel<sparse_time_dense_product_impl,LhsEval,DenseRhsType,DenseResType,AlphaType> Kernel;
+      parallel_sparse_scatter(Kernel(lhsEval, rhs, res, alpha), lhs.outerSize(), res, threads);
+    }
+    else
+      processColumns(lhsEval, rhs, res, alpha, 0, lhs.outerSize());
+  }
+
+  template<typename Dest>
+  static void processColumns(const LhsEval& lhsEval, const DenseRhsType& rhs, Dest& res, const typename Res::Scalar& alpha, Index begin, Index end)
+  {
+    for(Index j=begin; j<end; ++j)
     {
       typename Rhs::ConstRowXpr rhs_j(rhs.row(j));
       for(LhsInnerIterator it(lhsEval,j); it ;++it)
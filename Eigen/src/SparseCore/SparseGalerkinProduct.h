@@ -0,0 +1,236 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_SPARSE_GALERKIN_PRODUCT_H
+#define EIGEN_SPARSE_GALERKIN_PRODUCT_H
+
+namespace Eigen {
+
+namespace internal {
+
+/** \internal
+  * Runs the symbolic or the numeric pass of SparseGalerkinProduct over a range of outer vectors of the coarse matrix.
+  * The outer vector \a j of the result is the sum, over the nonzeros x of the column \a j of \a X, of x times the
+  * product of the outer vector of \a A matching x by the rows of \a Y, so that X^T * A * Y is never formed.
+  */
+template<typename XType, typename AType, typename YType, typename SparseMatrixType>
+struct sparse_galerkin_product_task
+{
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef typename SparseMatrixType::StorageIndex StorageIndex;
+
+  sparse_galerkin_product_task(const XType& x, const AType& a, const YType& y, SparseMatrixType& res,
+                               const Index* flops, const Index* chunks, bool numeric)
+    : m_x(x), m_a(a), m_y(y), m_res(res), m_flops(flops), m_chunks(chunks), m_numeric(numeric)
+  {}
+
+  void operator()(Index t) const
+  {
+    const StorageIndex *xOuter = m_x.outerIndexPtr(), *xInner = m_x.innerIndexPtr();
+    const StorageIndex *aOuter = m_a.outerIndexPtr(), *aInner = m_a.innerIndexPtr();
+    const StorageIndex *yOuter = m_y.outerIndexPtr(), *yInner = m_y.innerIndexPtr();
+    const Scalar *xValues = m_x.valuePtr(), *aValues = m_a.valuePtr(), *yValues = m_y.valuePtr();
+
+    sparse_product_accumulator<Scalar,StorageIndex> acc(m_res.innerSize());
+    for(Index j=m_chunks[t]; j<m_chunks[t+1]; ++j)
+    {
+      acc.begin(j, m_flops[j], m_numeric);
+      for(Index p=xOuter[j]; p<xOuter[j+1]; ++p)
+      {
+        const Index k = xInner[p];
+        for(Index q=aOuter[k]; q<aOuter[k+1]; ++q)
+        {
+          const Index l = aInner[q];
+          if(m_numeric)
+          {
+            const Scalar xa = xValues[p] * aValues[q];
+            for(Index r=yOuter[l]; r<yOuter[l+1]; ++r)
+              acc.add(yInner[r], xa * yValues[r]);
+          }
+          else
+          {
+            for(Index r=yOuter[l]; r<yOuter[l+1]; ++r)
+              acc.insert(yInner[r]);
+          }
+        }
+      }
+      if(m_numeric)
+      {
+        Index start = m_res.outerIndexPtr()[j];
+        eigen_assert(acc.size() == m_res.outerIndexPtr()[j+1]-start && "the sparsity patterns do not match the ones given to compute()");
+        acc.store(m_res.innerIndexPtr()+start, m_res.valuePtr()+start, true);
+      }
+      else
+        m_res.outerIndexPtr()[j+1] = StorageIndex(acc.size());
+    }
+  }
+
+  const XType& m_x;
+  const AType& m_a;
+  const YType& m_y;
+  SparseMatrixType& m_res;
+  const Index* m_flops;
+  const Index* m_chunks;
+  const bool m_numeric;
+};
+
+} // end namespace internal
+
+/** \ingroup SparseCore_Module
+  * \class SparseGalerkinProduct
+  *
+  * \brief Fused computation of sparse triple products R^T * A * P
+  *
+  * \tparam _SparseMatrixType the type of the SparseMatrix holding the result
+  *
+  * The setup of algebraic multigrid methods computes the coarse operators \f$ A_c = R^T A P \f$ from the fine
+  * operator \c A, and the restriction \c R and prolongation \c P operators. Evaluating
+  * <tt>R.transpose() * A * P</tt> first materializes the product <tt>A * P</tt>, which may be as large as
+  * \c A itself. Instead, SparseGalerkinProduct computes each row of \f$ A_c \f$ (each column for a column-major result)
+  * directly, by streaming the rows of \f$ R^T \f$ through \c A and \c P into an accumulator.
+  *
+  * As for the sparse * sparse products, the result is computed in two passes: a symbolic one, which counts the
+  * nonzeros of each outer vector of the result, and a numeric one, which computes them in place. Both are split
+  * over several threads for large products (see \ref TopicMultiThreading). When the setup is repeated with the same
+  * sparsity patterns but different values, the symbolic pass can be skipped:
+  * \code
+  * SparseMatrix<double> R, A, P, Ac;
+  * SparseGalerkinProduct<SparseMatrix<double> > galerkin(R, A, P, Ac);    // Ac = R^T * A * P
+  * for(...)
+  * {
+  *   // update the values of R, A and P, but not their sparsity patterns
+  *   galerkin.update(R, A, P, Ac);
+  * }
+  * \endcode
+  *
+  * The rows of \c A must be stored in the same order as the result, that is \c A must be row-major if the result
+  * is row-major, and column-major otherwise: \c A is copied at each call otherwise. Likewise, \c R is best
+  * column-major and \c P row-major for a row-major result, and the opposite for a column-major result.
+  *
+  * Since the rows of \c A P are recomputed for each nonzero of R in the matching row, this computation costs more
+  * multiply-adds than the product of \c R^T by the precomputed product \c A P when the columns of \c R overlap much.
+  * It is best suited to aggregation-based multigrid, whose restriction operators have a few nonzeros per row.
+  *
+  * \sa SparseMatrix::operator*()
+  */
+template<typename _SparseMatrixType>
+class SparseGalerkinProduct
+{
+  public:
+    typedef _SparseMatrixType SparseMatrixType;
+    typedef typename SparseMatrixType::Scalar Scalar;
+    typedef typename SparseMatrixType::StorageIndex StorageIndex;
+    enum { IsRowMajor = SparseMatrixType::IsRowMajor };
+
+    /** Default constructor, the product must be initialized with compute(). */
+    SparseGalerkinProduct() : m_rows(0), m_cols(0), m_threads(1) {}
+
+    /** Computes \a Ac = \a R^T * \a A * \a P, see compute(). */
+    template<typename RDerived, typename ADerived, typename PDerived>
+    SparseGalerkinProduct(const SparseMatrixBase<RDerived>& R, const SparseMatrixBase<ADerived>& A,
+                          const SparseMatrixBase<PDerived>& P, SparseMatrixType& Ac)
+      : m_rows(0), m_cols(0), m_threads(1)
+    {
+      compute(R, A, P, Ac);
+    }
+
+    /** Computes the sparsity pattern and the values of \a Ac = \a R^T * \a A * \a P, and records the information
+      * needed by update() to compute it again for new values with the same sparsity patterns. */
+    template<typename RDerived, typename ADerived, typename PDerived>
+    SparseGalerkinProduct& compute(const SparseMatrixBase<RDerived>& R, const SparseMatrixBase<ADerived>& A,
+                                   const SparseMatrixBase<PDerived>& P, SparseMatrixType& Ac)
+    {
+      eigen_assert(R.rows()==A.rows() && A.cols()==P.rows() && "invalid matrix product");
+      m_rows = R.cols();
+      m_cols = P.cols();
+      if(IsRowMajor)
+        analyze(ColMajorRef(R.derived()), InnerRef(A.derived()), RowMajorRef(P.derived()), Ac);
+      else
+        analyze(ColMajorRef(P.derived()), InnerRef(A.derived()), RowMajorRef(R.derived()), Ac);
+      return *this;
+    }
+
+    /** Computes the values of \a Ac = \a R^T * \a A * \a P, where \a R, \a A and \a P have the same sparsity
+      * patterns as the matrices given to compute(), and \a Ac is the result of compute() or of a previous update().
+      * There is no memory allocation unless the matrices need to be copied to other storage orders. */
+    template<typename RDerived, typename ADerived, typename PDerived>
+    void update(const SparseMatrixBase<RDerived>& R, const SparseMatrixBase<ADerived>& A,
+                const SparseMatrixBase<PDerived>& P, SparseMatrixType& Ac) const
+    {
+      eigen_assert(R.cols()==m_rows && P.cols()==m_cols && R.rows()==A.rows() && A.cols()==P.rows()
+                   && "the matrices do not match the ones given to compute()");
+      eigen_assert(Ac.rows()==m_rows && Ac.cols()==m_cols && Ac.isCompressed() && "the result does not match the one of compute()");
+      if(IsRowMajor)
+        run(ColMajorRef(R.derived()), InnerRef(A.derived()), RowMajorRef(P.derived()), Ac, true);
+      else
+        run(ColMajorRef(P.derived()), InnerRef(A.derived()), RowMajorRef(R.derived()), Ac, true);
+    }
+
+    /** \returns the number of multiply-adds of the numeric pass */
+    double flops() const { return double(m_flops.sum()); }
+
+  protected:
+    typedef Ref<const SparseMatrix<Scalar,ColMajor,StorageIndex>,StandardCompressedFormat> ColMajorRef;
+    typedef Ref<const SparseMatrix<Scalar,RowMajor,StorageIndex>,StandardCompressedFormat> RowMajorRef;
+    typedef Ref<const SparseMatrix<Scalar,IsRowMajor?RowMajor:ColMajor,StorageIndex>,StandardCompressedFormat> InnerRef;
+
+    template<typename XType, typename AType, typename YType>
+    void analyze(const XType& x, const AType& a, const YType& y, SparseMatrixType& Ac)
+    {
+      const StorageIndex *xOuter = x.outerIndexPtr(), *xInner = x.innerIndexPtr();
+      const StorageIndex *aOuter = a.outerIndexPtr(), *aInner = a.innerIndexPtr();
+      const StorageIndex *yOuter = y.outerIndexPtr();
+
+      // the number of multiply-adds of each outer vector of the result
+      Matrix<Index,Dynamic,1> ayFlops(a.outerSize());
+      for(Index k=0; k<a.outerSize(); ++k)
+      {
+        Index f = 0;
+        for(Index q=aOuter[k]; q<aOuter[k+1]; ++q)
+          f += yOuter[aInner[q]+1] - yOuter[aInner[q]];
+        ayFlops(k) = f;
+      }
+      m_flops.resize(x.outerSize());
+      Index totalFlops = 0;
+      for(Index j=0; j<x.outerSize(); ++j)
+      {
+        Index f = 0;
+        for(Index p=xOuter[j]; p<xOuter[j+1]; ++p)
+          f += ayFlops(xInner[p]);
+        m_flops(j) = f;
+        totalFlops += f;
+      }
+
+      m_threads = internal::parallel_cwise_threads(double(totalFlops) * double(internal::SparseSparseProductCost));
+      internal::sparse_product_chunks(m_flops, totalFlops, m_threads>1 ? 4*m_threads : 1, m_chunks);
+
+      Ac.resize(m_rows, m_cols);
+      run(x, a, y, Ac, false);
+      StorageIndex* outerIndex = Ac.outerIndexPtr();
+      for(Index j=0; j<Ac.outerSize(); ++j)
+        outerIndex[j+1] += outerIndex[j];
+      Ac.resizeNonZeros(outerIndex[Ac.outerSize()]);
+      run(x, a, y, Ac, true);
+    }
+
+    template<typename XType, typename AType, typename YType>
+    void run(const XType& x, const AType& a, const YType& y, SparseMatrixType& Ac, bool numeric) const
+    {
+      internal::sparse_galerkin_product_task<XType,AType,YType,SparseMatrixType> task(x, a, y, Ac, m_flops.data(), m_chunks.data(), numeric);
+      internal::parallel_run_tasks(m_chunks.size()-1, m_threads, task);
+    }
+
+    Index m_rows;
+    Index m_cols;
+    Index m_threads;
+    Matrix<Index,Dynamic,1> m_flops;
+    Matrix<Index,Dynamic,1> m_chunks;
+};
+
+} // end namespace Eigen
+
+#endif // EIGEN_SPARSE_GALERKIN_PRODUCT_H
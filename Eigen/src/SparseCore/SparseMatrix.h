@@ -447,6 +447,12 @@ class SparseMatrix
     template<typename InputIterators,typename DupFunctor>
     void setFromTriplets(const InputIterators& begin, const InputIterators& end, DupFunctor dup_func);
 
+    template<typename InputIterators>
+    void updateFromTriplets(const InputIterators& begin, const InputIterators& end);
+
+    template<typename InputIterators,typename DupFunctor>
+    void updateFromTriplets(const InputIterators& begin, const InputIterators& end, DupFunctor dup_func);
+
     void sumupDuplicates() { collapseDuplicates(internal::scalar_sum_op<Scalar,Scalar>()); }
 
     template<typename DupFunctor>
@@ -1025,12 +1031,244 @@ private:
 
 namespace internal {
 
+/** \internal Tells whether the triplets can be split among several threads, that is, whether \a Iterator
+  * is a pointer or a random access iterator. */
+template<typename Iterator, typename EnableIf = void>
+struct is_random_access_triplet_iterator { enum { value = false }; };
+
+template<typename T>
+struct is_random_access_triplet_iterator<T*> { enum { value = true }; };
+
+template<typename Iterator>
+struct is_random_access_triplet_iterator<Iterator,
+    typename enable_if<is_same<typename Iterator::iterator_category, std::random_access_iterator_tag>::value>::type>
+{ enum { value = true }; };
+
+/** \internal Estimated cost, in cycles, of the assembly of one triplet, see parallel_cwise_threads(). */
+const int TripletAssemblyCost = 50;
+
+/** \internal
+  * Multi-threaded assembly of a sparse matrix from a list of triplets, see set_from_triplets().
+  *
+  * Like the sequential version, the triplets are sorted by a stable counting sort along the inner dimension,
+  * followed by a stable counting sort along the outer dimension, and the duplicates, which end up next to each
+  * other in the order of the input list, are then merged. Each counting sort is parallelized by splitting its
+  * input into one chunk per thread: the entries per inner (or outer) index are counted within each chunk, and
+  * prefix sums over the indices and the chunks give each chunk the position where to scatter its entries.
+  * The result, including the order in which the duplicates are combined, is thus the same as the sequential one.
+  */
+template<typename InputIterator, typename SparseMatrixType, typename DupFunctor>
+struct parallel_triplet_assembly
+{
+  enum { IsRowMajor = SparseMatrixType::IsRowMajor };
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef typename SparseMatrixType::StorageIndex StorageIndex;
+  typedef parallel_triplet_assembly Self;
+
+  // Calls the member function Pass on each chunk
+  template<void (Self::*Pass)(Index)>
+  struct task
+  {
+    explicit task(Self& self) : m_self(self) {}
+    void operator()(Index c) const { (m_self.*Pass)(c); }
+    Self& m_self;
+  };
+
+  parallel_triplet_assembly(const InputIterator& begin, Index size, SparseMatrixType& mat, DupFunctor dup_func, Index numChunks)
+    : m_begin(begin), m_size(size), m_mat(mat), m_dup(dup_func), m_numChunks(numChunks),
+      m_innerSize(mat.innerSize()), m_outerSize(mat.outerSize()),
+      m_counts(numChunks*(std::max)(m_innerSize,m_outerSize)), m_starts((std::max)(m_innerSize,m_outerSize)+1),
+      m_outerStarts(m_outerSize+1), m_outerChunks(numChunks+1),
+      m_tmpOuter(size), m_tmpInner(size), m_inner(size), m_tmpValues(size), m_values(size)
+  {}
+
+  void run(Index threads)
+  {
+    // pass 1: sort by inner indices
+    m_keySize = m_innerSize;
+    parallel_run_tasks(m_numChunks, threads, task<&Self::countTriplets>(*this));
+    computeStarts(threads);
+    parallel_run_tasks(m_numChunks, threads, task<&Self::scatterTriplets>(*this));
+
+    // pass 2: sort by outer indices
+    m_keySize = m_outerSize;
+    parallel_run_tasks(m_numChunks, threads, task<&Self::countOuter>(*this));
+    computeStarts(threads);
+    for(Index j=0; j<=m_outerSize; ++j)
+      m_outerStarts[j] = m_starts[j];
+    parallel_run_tasks(m_numChunks, threads, task<&Self::scatterOuter>(*this));
+
+    // pass 3: merge the duplicates, the outer vectors are split into chunks of about the same number of entries
+    for(Index c=0; c<=m_numChunks; ++c)
+      m_outerChunks[c] = StorageIndex(std::lower_bound(m_outerStarts.ptr(), m_outerStarts.ptr()+m_outerSize, StorageIndex(chunkStart(c)))
+                                      - m_outerStarts.ptr());
+    m_outerChunks[m_numChunks] = StorageIndex(m_outerSize);
+    m_mat.resize(m_mat.rows(), m_mat.cols());
+    parallel_run_tasks(m_numChunks, threads, task<&Self::countUnique>(*this));
+    StorageIndex* outerIndex = m_mat.outerIndexPtr();
+    outerIndex[0] = 0;
+    for(Index j=0; j<m_outerSize; ++j)
+      outerIndex[j+1] += outerIndex[j];
+    m_mat.resizeNonZeros(outerIndex[m_outerSize]);
+    parallel_run_tasks(m_numChunks, threads, task<&Self::merge>(*this));
+  }
+
+private:
+  Index chunkStart(Index c) const { return (m_size*c)/m_numChunks; }
+  StorageIndex& count(Index c, Index key) { return m_counts[c*m_keySize+key]; }
+
+  // Turns the counts of each chunk into offsets relative to the start of each key, and computes these starts
+  void computeStarts(Index threads)
+  {
+    parallel_run_tasks(m_numChunks, threads, task<&Self::accumulateCounts>(*this));
+    StorageIndex start = 0;
+    for(Index k=0; k<m_keySize; ++k)
+    {
+      StorageIndex n = m_starts[k];
+      m_starts[k] = start;
+      start += n;
+    }
+    m_starts[m_keySize] = start;
+  }
+
+  void accumulateCounts(Index part)
+  {
+    const Index k0 = (m_keySize*part)/m_numChunks, k1 = (m_keySize*(part+1))/m_numChunks;
+    for(Index k=k0; k<k1; ++k)
+    {
+      StorageIndex n = 0;
+      for(Index c=0; c<m_numChunks; ++c)
+      {
+        StorageIndex nc = count(c,k);
+        count(c,k) = n;
+        n += nc;
+      }
+      m_starts[k] = n;
+    }
+  }
+
+  void countTriplets(Index c)
+  {
+    std::fill(&count(c,0), &count(c,0)+m_keySize, StorageIndex(0));
+    const InputIterator end = m_begin + chunkStart(c+1);
+    for(InputIterator it = m_begin + chunkStart(c); it!=end; ++it)
+    {
+      eigen_assert(it->row()>=0 && it->row()<m_mat.rows() && it->col()>=0 && it->col()<m_mat.cols());
+      ++count(c, IsRowMajor ? it->col() : it->row());
+    }
+  }
+
+  void scatterTriplets(Index c)
+  {
+    const InputIterator end = m_begin + chunkStart(c+1);
+    for(InputIterator it = m_begin + chunkStart(c); it!=end; ++it)
+    {
+      const StorageIndex inner = StorageIndex(IsRowMajor ? it->col() : it->row());
+      const StorageIndex k = m_starts[inner] + count(c,inner)++;
+      m_tmpOuter[k] = StorageIndex(IsRowMajor ? it->row() : it->col());
+      m_tmpInner[k] = inner;
+      m_tmpValues[k] = it->value();
+    }
+  }
+
+  void countOuter(Index c)
+  {
+    std::fill(&count(c,0), &count(c,0)+m_keySize, StorageIndex(0));
+    for(Index k=chunkStart(c); k<chunkStart(c+1); ++k)
+      ++count(c, m_tmpOuter[k]);
+  }
+
+  void scatterOuter(Index c)
+  {
+    for(Index k=chunkStart(c); k<chunkStart(c+1); ++k)
+    {
+      const StorageIndex outer = m_tmpOuter[k];
+      const StorageIndex p = m_starts[outer] + count(c,outer)++;
+      m_inner[p] = m_tmpInner[k];
+      m_values[p] = m_tmpValues[k];
+    }
+  }
+
+  void countUnique(Index c)
+  {
+    StorageIndex* outerIndex = m_mat.outerIndexPtr();
+    for(Index j=m_outerChunks[c]; j<m_outerChunks[c+1]; ++j)
+    {
+      StorageIndex n = 0;
+      for(Index k=m_outerStarts[j]; k<m_outerStarts[j+1]; ++k)
+        if(k==m_outerStarts[j] || m_inner[k]!=m_inner[k-1])
+          ++n;
+      outerIndex[j+1] = n;
+    }
+  }
+
+  void merge(Index c)
+  {
+    const StorageIndex* outerIndex = m_mat.outerIndexPtr();
+    StorageIndex* innerIndices = m_mat.innerIndexPtr();
+    Scalar* values = m_mat.valuePtr();
+    for(Index j=m_outerChunks[c]; j<m_outerChunks[c+1]; ++j)
+    {
+      StorageIndex p = outerIndex[j]-1;
+      for(Index k=m_outerStarts[j]; k<m_outerStarts[j+1]; ++k)
+      {
+        if(k==m_outerStarts[j] || m_inner[k]!=m_inner[k-1])
+        {
+          ++p;
+          innerIndices[p] = m_inner[k];
+          values[p] = m_values[k];
+        }
+        else
+          values[p] = m_dup(values[p], m_values[k]);
+      }
+    }
+  }
+
+  const InputIterator m_begin;
+  const Index m_size;
+  SparseMatrixType& m_mat;
+  DupFunctor m_dup;
+  const Index m_numChunks, m_innerSize, m_outerSize;
+  Index m_keySize;
+  scoped_array<StorageIndex> m_counts;      // per chunk and per key counts, then offsets
+  scoped_array<StorageIndex> m_starts;      // start of each key in the sorted entries
+  scoped_array<StorageIndex> m_outerStarts; // start of each outer vector in the sorted entries
+  scoped_array<StorageIndex> m_outerChunks; // outer vectors of each chunk when merging the duplicates
+  scoped_array<StorageIndex> m_tmpOuter, m_tmpInner, m_inner;
+  scoped_array<Scalar> m_tmpValues, m_values;
+};
+
+template<typename InputIterator, typename SparseMatrixType, typename DupFunctor>
+bool set_from_triplets_parallel(const InputIterator&, const InputIterator&, SparseMatrixType&, DupFunctor, false_type)
+{
+  return false;
+}
+
+/** \internal Runs parallel_triplet_assembly if the list of triplets is large enough to benefit from several threads.
+  * \returns false if the matrix has not been assembled and must be assembled sequentially. */
+template<typename InputIterator, typename SparseMatrixType, typename DupFunctor>
+bool set_from_triplets_parallel(const InputIterator& begin, const InputIterator& end, SparseMatrixType& mat, DupFunctor dup_func, true_type)
+{
+  const Index size = end - begin;
+  const Index threads = parallel_cwise_threads(double(size) * double(TripletAssemblyCost));
+  if(threads<=1)
+    return false;
+  parallel_triplet_assembly<InputIterator,SparseMatrixType,DupFunctor> assembly(begin, size, mat, dup_func, threads);
+  assembly.run(threads);
+  return true;
+}
+
 template<typename InputIterator, typename SparseMatrixType, typename DupFunctor>
 void set_from_triplets(const InputIterator& begin, const InputIterator& end, SparseMatrixType& mat, DupFunctor dup_func)
 {
   enum { IsRowMajor = SparseMatrixType::IsRowMajor };
   typedef typename SparseMatrixType::Scalar Scalar;
   typedef typename SparseMatrixType::StorageIndex StorageIndex;
+
+  typedef typename conditional<is_random_access_triplet_iterator<InputIterator>::value,true_type,false_type>::type IsRandomAccess;
+  if(set_from_triplets_parallel(begin, end, mat, dup_func, IsRandomAccess()))
+    return;
+
   SparseMatrix<Scalar,IsRowMajor?ColMajor:RowMajor,StorageIndex> trMat(mat.rows(),mat.cols());
 
   if(begin!=end)
@@ -1057,6 +1295,95 @@ void set_from_triplets(const InputIterator& begin, const InputIterator& end, Spa
   mat = trMat;
 }
 
+
+/** \internal \returns the position in the value array of \a mat of the coefficient of the triplet \a t,
+  * which must be in the sparsity pattern of the compressed matrix \a mat. */
+template<typename SparseMatrixType, typename TripletType>
+typename SparseMatrixType::StorageIndex triplet_offset(const SparseMatrixType& mat, const TripletType& t)
+{
+  enum { IsRowMajor = SparseMatrixType::IsRowMajor };
+  eigen_assert(t.row()>=0 && t.row()<mat.rows() && t.col()>=0 && t.col()<mat.cols());
+  const Index outer = IsRowMajor ? t.row() : t.col();
+  const Index inner = IsRowMajor ? t.col() : t.row();
+  const Index end = mat.outerIndexPtr()[outer+1];
+  const Index p = mat.data().searchLowerIndex(mat.outerIndexPtr()[outer], end, inner);
+  eigen_assert(p<end && mat.innerIndexPtr()[p]==inner && "the triplet is not in the sparsity pattern of the matrix");
+  EIGEN_ONLY_USED_FOR_DEBUG(end);
+  return typename SparseMatrixType::StorageIndex(p);
+}
+
+/** \internal Computes the positions of the triplets of a chunk in the value array, see update_from_triplets(). */
+template<typename InputIterator, typename SparseMatrixType>
+struct triplet_offset_task
+{
+  typedef typename SparseMatrixType::StorageIndex StorageIndex;
+  triplet_offset_task(const InputIterator& begin, Index size, Index numChunks, const SparseMatrixType& mat, StorageIndex* offsets)
+    : m_begin(begin), m_size(size), m_numChunks(numChunks), m_mat(mat), m_offsets(offsets) {}
+  void operator()(Index c) const
+  {
+    const Index start = (m_size*c)/m_numChunks, end = (m_size*(c+1))/m_numChunks;
+    InputIterator it = m_begin + start;
+    for(Index k=start; k<end; ++k, ++it)
+      m_offsets[k] = triplet_offset(m_mat, *it);
+  }
+  const InputIterator m_begin;
+  const Index m_size, m_numChunks;
+  const SparseMatrixType& m_mat;
+  StorageIndex* m_offsets;
+};
+
+template<typename InputIterator, typename SparseMatrixType, typename DupFunctor>
+void update_from_triplets(const InputIterator& begin, const InputIterator& end, SparseMatrixType& mat, DupFunctor dup_func, false_type)
+{
+  typedef typename SparseMatrixType::Scalar Scalar;
+  const Index nnz = mat.nonZeros();
+  scoped_array<bool> assigned(nnz);
+  std::fill(assigned.ptr(), assigned.ptr()+nnz, false);
+  Scalar* values = mat.valuePtr();
+  for(InputIterator it(begin); it!=end; ++it)
+  {
+    const Index p = triplet_offset(mat, *it);
+    values[p] = assigned[p] ? Scalar(dup_func(values[p], it->value())) : Scalar(it->value());
+    assigned[p] = true;
+  }
+  for(Index p=0; p<nnz; ++p)
+    if(!assigned[p])
+      values[p] = Scalar(0);
+}
+
+template<typename InputIterator, typename SparseMatrixType, typename DupFunctor>
+void update_from_triplets(const InputIterator& begin, const InputIterator& end, SparseMatrixType& mat, DupFunctor dup_func, true_type)
+{
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef typename SparseMatrixType::StorageIndex StorageIndex;
+  const Index size = end - begin;
+  const Index threads = parallel_cwise_threads(double(size) * double(TripletAssemblyCost));
+  if(threads<=1)
+  {
+    update_from_triplets(begin, end, mat, dup_func, false_type());
+    return;
+  }
+
+  // the searches of the positions are done in parallel, the values are then accumulated in the order of the triplets
+  scoped_array<StorageIndex> offsets(size);
+  parallel_run_tasks(threads, threads, triplet_offset_task<InputIterator,SparseMatrixType>(begin, size, threads, mat, offsets.ptr()));
+
+  const Index nnz = mat.nonZeros();
+  scoped_array<bool> assigned(nnz);
+  std::fill(assigned.ptr(), assigned.ptr()+nnz, false);
+  Scalar* values = mat.valuePtr();
+  InputIterator it = begin;
+  for(Index k=0; k<size; ++k, ++it)
+  {
+    const Index p = offsets[k];
+    values[p] = assigned[p] ? Scalar(dup_func(values[p], it->value())) : Scalar(it->value());
+    assigned[p] = true;
+  }
+  for(Index p=0; p<nnz; ++p)
+    if(!assigned[p])
+      values[p] = Scalar(0);
+}
+
 }
 
 
@@ -1096,6 +1423,12 @@ void set_from_triplets(const InputIterator& begin, const InputIterator& end, Spa
   * \warning The list of triplets is read multiple times (at least twice). Therefore, it is not recommended to define
   * an abstract iterator over a complex data-structure that would be expensive to evaluate. The triplets should rather
   * be explicitly stored into a std::vector for instance.
+
+  *
+  * When the iterators are random access and the list is large enough, the matrix is assembled by several threads
+  * (see \ref TopicMultiThreading), with the same result as the sequential assembly.
+  *
+  * \sa updateFromTriplets()
   */
 template<typename Scalar, int _Options, typename _StorageIndex>
 template<typename InputIterators>
@@ -1120,6 +1453,41 @@ void SparseMatrix<Scalar,_Options,_StorageIndex>::setFromTriplets(const InputIte
   internal::set_from_triplets<InputIterators, SparseMatrix<Scalar,_Options,_StorageIndex>, DupFunctor>(begin, end, *this, dup_func);
 }
 
+/** Overwrites the values of the compressed matrix \c *this with the list of \em triplets defined by the iterator range
+  * \a begin - \a end, keeping its sparsity pattern.
+  *
+  * This is meant for the repeated assembly of matrices with the same structure: once the pattern has been built by
+  * setFromTriplets(), the next lists of triplets only need to look up the position of their coefficients, without
+  * sorting them or reallocating the matrix. As in setFromTriplets(), the duplicates are summed up.
+  * The coefficients of the pattern which do not appear in the list of triplets are set to zero, they are \b not removed.
+  *
+  * \warning The matrix must be compressed, and the position of each triplet must be in its sparsity pattern.
+  *
+  * \sa setFromTriplets()
+  */
+template<typename Scalar, int _Options, typename _StorageIndex>
+template<typename InputIterators>
+void SparseMatrix<Scalar,_Options,_StorageIndex>::updateFromTriplets(const InputIterators& begin, const InputIterators& end)
+{
+  updateFromTriplets(begin, end, internal::scalar_sum_op<Scalar,Scalar>());
+}
+
+/** The same as updateFromTriplets but when duplicates are met the functor \a dup_func is applied:
+  * \code
+  * value = dup_func(OldValue, NewValue)
+  * \endcode
+  * \sa setFromTriplets(const InputIterators&, const InputIterators&, DupFunctor)
+  */
+template<typename Scalar, int _Options, typename _StorageIndex>
+template<typename InputIterators,typename DupFunctor>
+void SparseMatrix<Scalar,_Options,_StorageIndex>::updateFromTriplets(const InputIterators& begin, const InputIterators& end, DupFunctor dup_func)
+{
+  eigen_assert(isCompressed() && "updateFromTriplets requires a compressed matrix");
+  typedef typename internal::conditional<internal::is_random_access_triplet_iterator<InputIterators>::value,
+                                         internal::true_type,internal::false_type>::type IsRandomAccess;
+  internal::update_from_triplets(begin, end, *this, dup_func, IsRandomAccess());
+}
+
 /** \internal */
 template<typename Scalar, int _Options, typename _StorageIndex>
 template<typename DupFunctor>
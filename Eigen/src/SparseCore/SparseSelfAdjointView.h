@@ -276,17 +276,12 @@ struct Assignment<DstXprType, SrcXprType, Functor, SparseSelfAdjoint2Sparse>
 
 namespace internal {
 
-template<int Mode, typename SparseLhsType, typename DenseRhsType, typename DenseResType, typename AlphaType>
-inline void sparse_selfadjoint_time_dense_product(const SparseLhsType& lhs, const DenseRhsType& rhs, DenseResType& res, const AlphaType& alpha)
+/** \internal Scatters the outer vectors \a begin to \a end-1 of a selfadjoint sparse matrix times a dense matrix,
+  * see sparse_selfadjoint_time_dense_product(). */
+template<int Mode, typename LhsEval, typename LhsScalar, typename DenseRhsType, typename AlphaType>
+struct sparse_selfadjoint_time_dense_product_kernel
 {
-  EIGEN_ONLY_USED_FOR_DEBUG(alpha);
-  
-  typedef typename internal::nested_eval<SparseLhsType,DenseRhsType::MaxColsAtCompileTime>::type SparseLhsTypeNested;
-  typedef typename internal::remove_all<SparseLhsTypeNested>::type SparseLhsTypeNestedCleaned;
-  typedef evaluator<SparseLhsTypeNestedCleaned> LhsEval;
   typedef typename LhsEval::InnerIterator LhsIterator;
-  typedef typename SparseLhsType::Scalar LhsScalar;
-  
   enum {
     LhsIsRowMajor = (LhsEval::Flags&RowMajorBit)==RowMajorBit,
     ProcessFirstHalf =
@@ -295,45 +290,79 @@ inline void sparse_selfadjoint_time_dense_product(const SparseLhsType& lhs, cons
           || ( (Mode&Lower) && LhsIsRowMajor),
     ProcessSecondHalf = !ProcessFirstHalf
   };
-  
-  SparseLhsTypeNested lhs_nested(lhs);
-  LhsEval lhsEval(lhs_nested);
 
-  // work on one column at once
-  for (Index k=0; k<rhs.cols(); ++k)
+  sparse_selfadjoint_time_dense_product_kernel(const LhsEval& lhsEval, const DenseRhsType& rhs, const AlphaType& alpha)
+    : m_lhsEval(lhsEval), m_rhs(rhs), m_alpha(alpha) {}
+
+  template<typename Dest>
+  void run(Index begin, Index end, Dest& res) const
   {
-    for (Index j=0; j<lhs.outerSize(); ++j)
+    const DenseRhsType& rhs = m_rhs;
+    const AlphaType& alpha = m_alpha;
+    // work on one column at once
+    for (Index k=0; k<rhs.cols(); ++k)
     {
-      LhsIterator i(lhsEval,j);
-      // handle diagonal coeff
-      if (ProcessSecondHalf)
+      for (Index j=begin; j<end; ++j)
       {
-        while (i && i.index()<j) ++i;
-        if(i && i.index()==j)
+        LhsIterator i(m_lhsEval,j);
+        // handle diagonal coeff
+        if (ProcessSecondHalf)
         {
-          res.coeffRef(j,k) += alpha * i.value() * rhs.coeff(j,k);
-          ++i;
+          while (i && i.index()<j) ++i;
+          if(i && i.index()==j)
+          {
+            res.coeffRef(j,k) += alpha * i.value() * rhs.coeff(j,k);
+            ++i;
+          }
         }
-      }
 
-      // premultiplied rhs for scatters
-      typename ScalarBinaryOpTraits<AlphaType, typename DenseRhsType::Scalar>::ReturnType rhs_j(alpha*rhs(j,k));
-      // accumulator for partial scalar product
-      typename DenseResType::Scalar res_j(0);
-      for(; (ProcessFirstHalf ? i && i.index() < j : i) ; ++i)
-      {
-        LhsScalar lhs_ij = i.value();
-        if(!LhsIsRowMajor) lhs_ij = numext::conj(lhs_ij);
-        res_j += lhs_ij * rhs.coeff(i.index(),k);
-        res(i.index(),k) += numext::conj(lhs_ij) * rhs_j;
-      }
-      res.coeffRef(j,k) += alpha * res_j;
+        // premultiplied rhs for scatters
+        typename ScalarBinaryOpTraits<AlphaType, typename DenseRhsType::Scalar>::ReturnType rhs_j(alpha*rhs(j,k));
+        // accumulator for partial scalar product
+        typename Dest::Scalar res_j(0);
+        for(; (ProcessFirstHalf ? i && i.index() < j : i) ; ++i)
+        {
+          LhsScalar lhs_ij = i.value();
+          if(!LhsIsRowMajor) lhs_ij = numext::conj(lhs_ij);
+          res_j += lhs_ij * rhs.coeff(i.index(),k);
+          res(i.index(),k) += numext::conj(lhs_ij) * rhs_j;
+        }
+        res.coeffRef(j,k) += alpha * res_j;
 
-      // handle diagonal coeff
-      if (ProcessFirstHalf && i && (i.index()==j))
-        res.coeffRef(j,k) += alpha * i.value() * rhs.coeff(j,k);
+        // handle diagonal coeff
+        if (ProcessFirstHalf && i && (i.index()==j))
+          res.coeffRef(j,k) += alpha * i.value() * rhs.coeff(j,k);
+      }
     }
   }
+
+  const LhsEval& m_lhsEval;
+  const DenseRhsType& m_rhs;
+  const AlphaType& m_alpha;
+};
+
+template<int Mode, typename SparseLhsType, typename DenseRhsType, typename DenseResType, typename AlphaType>
+inline void sparse_selfadjoint_time_dense_product(const SparseLhsType& lhs, const DenseRhsType& rhs, DenseResType& res, const AlphaType& alpha)
+{
+  EIGEN_ONLY_USED_FOR_DEBUG(alpha);
+  
+  typedef typename internal::nested_eval<SparseLhsType,DenseRhsType::MaxColsAtCompileTime>::type SparseLhsTypeNested;
+  typedef typename internal::remove_all<SparseLhsTypeNested>::type SparseLhsTypeNestedCleaned;
+  typedef evaluator<SparseLhsTypeNestedCleaned> LhsEval;
+  typedef typename SparseLhsType::Scalar LhsScalar;
+  typedef sparse_selfadjoint_time_dense_product_kernel<Mode,LhsEval,LhsScalar,DenseRhsType,AlphaType> Kernel;
+  
+  SparseLhsTypeNested lhs_nested(lhs);
+  LhsEval lhsEval(lhs_nested);
+  Kernel kernel(lhsEval, rhs, alpha);
+
+  // each stored coefficient is scattered twice, the outer vectors are thus split over several threads as the
+  // columns of a column-major product
+  Index threads = sparse_scatter_threads(2. * double(lhsEval.nonZerosEstimate()), res);
+  if(threads>1)
+    parallel_sparse_scatter(kernel, lhs.outerSize(), res, threads);
+  else
+    kernel.run(0, lhs.outerSize(), res);
 }
 
 
@@ -0,0 +1,281 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_SPARSE_TRIANGULAR_SOLVE_PLAN_H
+#define EIGEN_SPARSE_TRIANGULAR_SOLVE_PLAN_H
+
+namespace Eigen {
+
+namespace internal {
+
+/** \internal Estimated cost, in cycles, of one nonzero of a sparse triangular solve, for one right hand side. */
+const int SparseTriangularSolveCost = 8;
+
+/** \internal \returns whether the solves with a triangular factor of \a nnz nonzeros may run on several threads,
+  * in which case the solvers sort its unknowns into levels with a SparseTriangularSolvePlan. */
+inline bool use_sparse_triangular_solve_plan(Index nnz)
+{
+  return parallel_cwise_threads(double(nnz) * double(SparseTriangularSolveCost)) > 1;
+}
+
+/** \internal Solves a range of rows of a level, see SparseTriangularSolvePlan::solveInPlace(). */
+template<typename Plan, typename Dest>
+struct sparse_triangular_solve_task
+{
+  typedef typename Plan::Scalar Scalar;
+  sparse_triangular_solve_task(const Plan& plan, const Scalar* values, Dest& dest, Index begin, Index end, Index numTasks)
+    : m_plan(plan), m_values(values), m_dest(dest), m_begin(begin), m_size(end-begin), m_numTasks(numTasks) {}
+  void operator()(Index t) const
+  {
+    m_plan.solveRows(m_values, m_dest, m_begin + (m_size*t)/m_numTasks, m_begin + (m_size*(t+1))/m_numTasks);
+  }
+  const Plan& m_plan;
+  const Scalar* m_values;
+  Dest& m_dest;
+  const Index m_begin;
+  const Index m_size;
+  const Index m_numTasks;
+};
+
+} // end namespace internal
+
+/** \ingroup SparseCore_Module
+  * \class SparseTriangularSolvePlan
+  *
+  * \brief Level-scheduled parallel solver for sparse triangular systems
+  *
+  * \tparam _SparseMatrixType the type of the SparseMatrix holding the triangular factor
+  * \tparam _Mode either \c #Lower or \c #Upper, possibly combined with \c #UnitDiag
+  *
+  * The forward and backward substitutions of <tt>mat.triangularView<Mode>().solveInPlace(b)</tt> process one
+  * row after the other. Yet, the unknowns of a triangular system are often independent of many of the previous
+  * ones: compute() sorts them into levels, such that the unknowns of a level only depend on the ones of the
+  * previous levels. solveInPlace() then solves the levels one after the other, and the rows of each large level
+  * concurrently (see \ref TopicMultiThreading).
+  *
+  * The analysis only depends on the sparsity pattern, it is performed once for a triangular factor and reused for
+  * all its solves, as done by the incomplete factorizations and the simplicial Cholesky factorizations when they are
+  * large enough to benefit from several threads:
+  * \code
+  * SparseMatrix<double> L = ...;
+  * SparseTriangularSolvePlan<SparseMatrix<double>, Lower> lower(L);        // L
+  * SparseTriangularSolvePlan<SparseMatrix<double>, Upper> upper(L, true);  // L^*
+  * lower.solveInPlace(L, b);   // b = L^-1 b
+  * upper.solveInPlace(L, b);   // b = L^-* b
+  * \endcode
+  *
+  * The factor can be row-major or column-major, and the adjoint of the stored matrix can be solved as well. In all
+  * cases, the plan records the position in the value array of each nonzero of each row of the triangular factor, so
+  * that the matrix must be compressed, and its values can change between compute() and solveInPlace().
+  *
+  * \sa TriangularViewImpl::solveInPlace()
+  */
+template<typename _SparseMatrixType, int _Mode>
+class SparseTriangularSolvePlan
+{
+  public:
+    typedef _SparseMatrixType SparseMatrixType;
+    typedef typename SparseMatrixType::Scalar Scalar;
+    typedef typename SparseMatrixType::StorageIndex StorageIndex;
+    typedef Matrix<StorageIndex,Dynamic,1> IndexVector;
+    enum {
+      Mode = _Mode,
+      IsLower = (Mode & Lower) == Lower,
+      DiagSize = (Mode & UnitDiag) ? 0 : 1  // the diagonal entry of a row is stored after its off-diagonal ones
+    };
+
+    /** Default constructor, the plan must be initialized with compute(). */
+    SparseTriangularSolvePlan() : m_size(0), m_nonZeros(0), m_adjoint(false) {}
+
+    /** Analyzes the triangular factor \a mat, see compute(). */
+    explicit SparseTriangularSolvePlan(const SparseMatrixType& mat, bool adjoint = false)
+      : m_size(0), m_nonZeros(0), m_adjoint(false)
+    {
+      compute(mat, adjoint);
+    }
+
+    SparseTriangularSolvePlan& compute(const SparseMatrixType& mat, bool adjoint = false);
+
+    template<typename Dest>
+    void solveInPlace(const SparseMatrixType& mat, MatrixBase<Dest>& other) const;
+
+    /** \returns the number of unknowns */
+    Index size() const { return m_size; }
+
+    /** \returns the number of levels, i.e., the number of sequential steps of the solve */
+    Index levels() const { return m_levelStarts.size()==0 ? 0 : m_levelStarts.size()-1; }
+
+    /** \returns the unknowns of the level \a l */
+    typename IndexVector::ConstSegmentReturnType level(Index l) const
+    {
+      return m_order.segment(m_levelStarts(l), m_levelStarts(l+1)-m_levelStarts(l));
+    }
+
+    /** \internal Solves the rows \a begin to \a end-1, in the order of the levels */
+    template<typename Dest>
+    void solveRows(const Scalar* values, Dest& other, Index begin, Index end) const
+    {
+      for(Index c=0; c<other.cols(); ++c)
+      {
+        for(Index p=begin; p<end; ++p)
+        {
+          const Index i = m_order.coeff(p);
+          Scalar tmp = other.coeff(i,c);
+          const Index rowEnd = m_rowStarts.coeff(p+1) - DiagSize;
+          for(Index q=m_rowStarts.coeff(p); q<rowEnd; ++q)
+            tmp -= value(values, q) * other.coeff(m_indices.coeff(q), c);
+          if(Mode & UnitDiag)
+            other.coeffRef(i,c) = tmp;
+          else
+            other.coeffRef(i,c) = tmp / value(values, rowEnd);
+        }
+      }
+    }
+
+  protected:
+    Scalar value(const Scalar* values, Index q) const
+    {
+      return m_adjoint ? numext::conj(values[m_positions.coeff(q)]) : values[m_positions.coeff(q)];
+    }
+
+    Index m_size;
+    Index m_nonZeros;
+    bool m_adjoint;
+    IndexVector m_order;            // unknowns sorted by levels
+    IndexVector m_levelStarts;      // start of each level in m_order
+    IndexVector m_rowStarts;        // start of the nonzeros of each row of m_order in m_indices and m_positions
+    IndexVector m_indices;          // column of each nonzero in the triangular factor
+    IndexVector m_positions;        // position of each nonzero in the value array of the matrix
+    Matrix<double,Dynamic,1> m_levelCost;
+};
+
+/** Sorts the unknowns of the triangular part \a Mode of \a mat into levels, or of its adjoint if \a adjoint is true.
+  * The matrix must be compressed. The coefficients of \a mat outside the triangular part are ignored, but the
+  * diagonal coefficients must be stored unless \a Mode includes \c #UnitDiag.
+  *
+  * \warning The pattern of \a mat must not be modified afterwards, otherwise the plan must be computed again.
+  */
+template<typename _SparseMatrixType, int _Mode>
+SparseTriangularSolvePlan<_SparseMatrixType,_Mode>&
+SparseTriangularSolvePlan<_SparseMatrixType,_Mode>::compute(const SparseMatrixType& mat, bool adjoint)
+{
+  eigen_assert(mat.rows()==mat.cols() && mat.isCompressed());
+  const Index n = mat.rows();
+  const StorageIndex* outerIndex = mat.outerIndexPtr();
+  const StorageIndex* innerIndex = mat.innerIndexPtr();
+  m_size = n;
+  m_nonZeros = mat.nonZeros();
+  m_adjoint = adjoint;
+
+  // the rows of the triangular factor are the outer vectors of mat if it is row-major, or of its adjoint if it is
+  // column-major, otherwise they are gathered from its inner vectors
+  const bool rowsAreOuter = bool(SparseMatrixType::IsRowMajor) != adjoint;
+  IndexVector rowSizes = IndexVector::Zero(n);
+  IndexVector diagPos = IndexVector::Constant(n, -1);
+  for(Index j=0; j<n; ++j)
+    for(Index p=outerIndex[j]; p<outerIndex[j+1]; ++p)
+    {
+      const Index i = innerIndex[p];
+      const Index row = rowsAreOuter ? j : i, col = rowsAreOuter ? i : j;
+      if(row==col)
+        diagPos(row) = StorageIndex(p);
+      else if((row>col) == bool(IsLower))
+        ++rowSizes(row);
+    }
+
+  // the levels, in the order of the substitution
+  IndexVector rowStarts(n+1);
+  rowStarts(0) = 0;
+  for(Index i=0; i<n; ++i)
+    rowStarts(i+1) = rowStarts(i) + rowSizes(i) + DiagSize;
+  IndexVector indices(rowStarts(n)), positions(rowStarts(n)), fill = rowStarts.head(n);
+  for(Index j=0; j<n; ++j)
+    for(Index p=outerIndex[j]; p<outerIndex[j+1]; ++p)
+    {
+      const Index i = innerIndex[p];
+      const Index row = rowsAreOuter ? j : i, col = rowsAreOuter ? i : j;
+      if(row!=col && (row>col) == bool(IsLower))
+      {
+        indices(fill(row)) = StorageIndex(col);
+        positions(fill(row)++) = StorageIndex(p);
+      }
+    }
+  IndexVector level(n);
+  StorageIndex numLevels = 0;
+  for(Index k=0; k<n; ++k)
+  {
+    const Index i = IsLower ? k : n-1-k;
+    StorageIndex l = 0;
+    for(Index q=rowStarts(i); q<rowStarts(i)+rowSizes(i); ++q)
+      l = (std::max)(l, StorageIndex(level(indices(q))+1));
+    level(i) = l;
+    numLevels = (std::max)(numLevels, StorageIndex(l+1));
+    if(DiagSize)
+    {
+      eigen_assert(diagPos(i)>=0 && "the diagonal coefficients of a triangular matrix must be stored");
+      indices(rowStarts(i+1)-1) = StorageIndex(i);
+      positions(rowStarts(i+1)-1) = diagPos(i);
+    }
+  }
+
+  // stable counting sort of the unknowns by levels, and copy of their rows in that order
+  m_levelStarts.setZero(numLevels+1);
+  for(Index i=0; i<n; ++i)
+    ++m_levelStarts(level(i)+1);
+  for(Index l=0; l<numLevels; ++l)
+    m_levelStarts(l+1) += m_levelStarts(l);
+  IndexVector next = m_levelStarts;
+  m_order.resize(n);
+  for(Index k=0; k<n; ++k)
+  {
+    const Index i = IsLower ? k : n-1-k;
+    m_order(next(level(i))++) = StorageIndex(i);
+  }
+  m_rowStarts.resize(n+1);
+  m_indices.resize(indices.size());
+  m_positions.resize(positions.size());
+  m_levelCost.setZero(numLevels);
+  StorageIndex q = 0;
+  for(Index l=0; l<numLevels; ++l)
+    for(Index p=m_levelStarts(l); p<m_levelStarts(l+1); ++p)
+    {
+      const Index i = m_order(p);
+      m_rowStarts(p) = q;
+      for(Index k=rowStarts(i); k<rowStarts(i+1); ++k, ++q)
+      {
+        m_indices(q) = indices(k);
+        m_positions(q) = positions(k);
+      }
+      m_levelCost(l) += double(rowStarts(i+1)-rowStarts(i)+1) * double(internal::SparseTriangularSolveCost);
+    }
+  m_rowStarts(n) = q;
+  return *this;
+}
+
+template<typename _SparseMatrixType, int _Mode>
+template<typename Dest>
+void SparseTriangularSolvePlan<_SparseMatrixType,_Mode>::solveInPlace(const SparseMatrixType& mat, MatrixBase<Dest>& other) const
+{
+  eigen_assert(mat.rows()==m_size && mat.cols()==m_size && mat.isCompressed() && mat.nonZeros()==m_nonZeros
+               && "the matrix does not match the triangular solve plan");
+  eigen_assert(other.rows()==m_size);
+  const Scalar* values = mat.valuePtr();
+  for(Index l=0; l<levels(); ++l)
+  {
+    const Index begin = m_levelStarts(l), end = m_levelStarts(l+1);
+    const Index threads = (std::min)(end-begin, internal::parallel_cwise_threads(m_levelCost(l) * double(other.cols())));
+    if(threads<=1)
+      solveRows(values, other.derived(), begin, end);
+    else
+      internal::parallel_run_tasks(threads, threads,
+          internal::sparse_triangular_solve_task<SparseTriangularSolvePlan,Dest>(*this, values, other.derived(), begin, end, threads));
+  }
+}
+
+} // end namespace Eigen
+
+#endif // EIGEN_SPARSE_TRIANGULAR_SOLVE_PLAN_H
@@ -18,6 +18,34 @@ template <typename _MatrixType, typename _OrderingType = COLAMDOrdering<typename
 template <typename MappedSparseMatrixType> struct SparseLUMatrixLReturnType;
 template <typename MatrixLType, typename MatrixUType> struct SparseLUMatrixUReturnType;
 
+namespace internal {
+
+/** \internal Estimated cost, in cycles, of the factorization per nonzero of the matrix, see SparseLU::factorize(). */
+const int SparseLUCost = 100;
+
+/** \internal Factorizes the subtrees of the column elimination tree assigned to one task, see SparseLU::factorize(). */
+template<typename SolverType>
+struct sparselu_subtree_task
+{
+  typedef typename SolverType::IndexVector IndexVector;
+  typedef typename SolverType::SubtreeRange SubtreeRange;
+  typedef typename SolverType::SubtreeTask SubtreeTask;
+  sparselu_subtree_task(SolverType& solver, const IndexVector& relax_end, IndexVector& iperm_c,
+                        std::vector<SubtreeRange>& ranges, std::vector<SubtreeTask>& tasks)
+    : m_solver(solver), m_relax_end(relax_end), m_iperm_c(iperm_c), m_ranges(ranges), m_tasks(tasks) {}
+  void operator()(Index t) const
+  {
+    m_solver.factorizeSubtrees(m_tasks[t], m_relax_end, m_iperm_c, m_ranges);
+  }
+  SolverType& m_solver;
+  const IndexVector& m_relax_end;
+  IndexVector& m_iperm_c;
+  std::vector<SubtreeRange>& m_ranges;
+  std::vector<SubtreeTask>& m_tasks;
+};
+
+} // end namespace internal
+
 /** \ingroup SparseLU_Module
   * \class SparseLU
   * 
@@ -57,6 +85,9 @@ template <typename MatrixLType, typename MatrixUType> struct SparseLUMatrixURetu
   * \warning The input matrix A should be in a \b compressed and \b column-major form.
   * Otherwise an expensive copy will be made. You can call the inexpensive makeCompressed() to get a compressed matrix.
   * 
+  * The independent subtrees of the column elimination tree are factorized concurrently, and the updates from
+  * large supernodes go through the multi-threaded matrix-matrix products of %Eigen (see \ref TopicMultiThreading).
+  * 
   * \note Unlike the initial SuperLU implementation, there is no step to equilibrate the matrix. 
   * For badly scaled matrices, this step can be useful to reduce the pivoting during factorization. 
   * If this is the case for your matrices, you can try the basic scaling method at
@@ -355,6 +386,37 @@ class SparseLU : public SparseSolverBase<SparseLU<_MatrixType,_OrderingType> >,
       return (m_detPermR * m_detPermC) > 0 ? det : -det;
     }
 
+#ifndef EIGEN_PARSED_BY_DOXYGEN
+    // Working arrays of the numerical factorization
+    struct Workspace
+    {
+      IndexVector segrep, parent, xplore, repfnz, panel_lsub, xprune, marker;
+      ScalarVector dense, tempv;
+    };
+
+    // Columns first to last-1, which contain all their descendants in the column elimination tree
+    struct SubtreeRange
+    {
+      Index first, last;
+      Index task;       // the task which factorizes it
+      IndexVector xsup; // first column of each of its supernodes
+    };
+
+    // Subtree ranges factorized by one thread into private factors, which are then merged into m_glu
+    struct SubtreeTask
+    {
+      Index rangeStart, rangeEnd; // the ranges of the task in the list of ranges
+      Index nnz;                  // estimated number of nonzeros of its columns
+      typename Base::GlobalLU_t glu;
+      Workspace work;
+      Index info;
+      std::string lastError;
+    };
+
+    /** \internal Factorizes the subtree ranges of \a task, independently of all other columns. */
+    void factorizeSubtrees(SubtreeTask& task, const IndexVector& relax_end, IndexVector& iperm_c, std::vector<SubtreeRange>& ranges);
+#endif // EIGEN_PARSED_BY_DOXYGEN
+
   protected:
     // Functions 
     void initperfvalues()
@@ -366,6 +428,11 @@ class SparseLU : public SparseSolverBase<SparseLU<_MatrixType,_OrderingType> >,
       m_perfv.colblk = 8; 
       m_perfv.fillfactor = 20;  
     }
+    void initWorkspace(Workspace& work, Index m, Index n);
+    Index factorizeColumns(Index first, Index last, const IndexVector& relax_end, IndexVector& iperm_c,
+                           typename Base::GlobalLU_t& glu, Workspace& work, std::string& lastError);
+    void findSubtrees(Index threads, std::vector<SubtreeRange>& ranges, std::vector<SubtreeTask>& tasks);
+    Index mergeSubtree(const SubtreeRange& range, const SubtreeTask& task, IndexVector& xprune);
       
     // Variables 
     mutable ComputationInfo m_info;
@@ -532,7 +599,6 @@ void SparseLU<MatrixType, OrderingType>::factorize(const MatrixType& matrix)
   Index m = m_mat.rows();
   Index n = m_mat.cols();
   Index nnz = m_mat.nonZeros();
-  Index maxpanel = m_perfv.panel_size * m;
   // Allocate working storage common to the factor routines
   Index lwork = 0;
   Index info = Base::memInit(m, n, nnz, lwork, m_perfv.fillfactor, m_perfv.panel_size, m_glu); 
@@ -543,23 +609,9 @@ void SparseLU<MatrixType, OrderingType>::factorize(const MatrixType& matrix)
     return ; 
   }
   
-  // Set up pointers for integer working arrays 
-  IndexVector segrep(m); segrep.setZero();
-  IndexVector parent(m); parent.setZero();
-  IndexVector xplore(m); xplore.setZero();
-  IndexVector repfnz(maxpanel);
-  IndexVector panel_lsub(maxpanel);
-  IndexVector xprune(n); xprune.setZero();
-  IndexVector marker(m*internal::LUNoMarker); marker.setZero();
-  
-  repfnz.setConstant(-1); 
-  panel_lsub.setConstant(-1);
-  
-  // Set up pointers for scalar working arrays 
-  ScalarVector dense; 
-  dense.setZero(maxpanel);
-  ScalarVector tempv; 
-  tempv.setZero(internal::LUnumTempV(m, m_perfv.panel_size, m_perfv.maxsuper, /*m_perfv.rowblk*/m) );
+  // Set up the working arrays common to the factor routines
+  Workspace work;
+  initWorkspace(work, m, n);
   
   // Compute the inverse of perm_c
   PermutationType iperm_c(m_perm_c.inverse()); 
@@ -567,34 +619,121 @@ void SparseLU<MatrixType, OrderingType>::factorize(const MatrixType& matrix)
   // Identify initial relaxed snodes
   IndexVector relax_end(n);
   if ( m_symmetricmode == true ) 
-    Base::heap_relax_snode(n, m_etree, m_perfv.relax, marker, relax_end);
+    Base::heap_relax_snode(n, m_etree, m_perfv.relax, work.marker, relax_end);
   else
-    Base::relax_snode(n, m_etree, m_perfv.relax, marker, relax_end);
+    Base::relax_snode(n, m_etree, m_perfv.relax, work.marker, relax_end);
   
   
   m_perm_r.resize(m); 
   m_perm_r.indices().setConstant(-1);
-  marker.setConstant(-1);
+  work.marker.setConstant(-1);
   m_detPermR = 1; // Record the determinant of the row permutation
   
   m_glu.supno(0) = emptyIdxLU; m_glu.xsup.setConstant(0);
   m_glu.xsup(0) = m_glu.xlsub(0) = m_glu.xusub(0) = m_glu.xlusup(0) = Index(0);
   
+  // The columns of disjoint subtrees of the column elimination tree have disjoint row structures in L and U,
+  // whatever the row pivoting. Large subtrees are thus first factorized concurrently into private factors.
+  // The elimination tree is only postordered in the non symmetric mode, which keeps the subtrees contiguous.
+  std::vector<SubtreeRange> ranges;
+  std::vector<SubtreeTask> tasks;
+  if (!m_symmetricmode)
+    findSubtrees(internal::parallel_cwise_threads(double(nnz) * double(internal::SparseLUCost)), ranges, tasks);
+  if (!tasks.empty())
+  {
+    internal::parallel_run_tasks(Index(tasks.size()), Index(tasks.size()),
+        internal::sparselu_subtree_task<SparseLU>(*this, relax_end, iperm_c.indices(), ranges, tasks));
+    for (std::size_t t = 0; t < tasks.size(); ++t)
+    {
+      if (tasks[t].info)
+      {
+        m_lastError = tasks[t].lastError;
+        m_info = NumericalIssue; 
+        m_factorizationIsOk = false; 
+        return; 
+      }
+    }
+  }
+  
+  // Factorize the remaining columns, in order, and insert the factors of the subtrees on the way
+  Index jcol = 0;
+  for (std::size_t r = 0; r <= ranges.size(); ++r)
+  {
+    info = factorizeColumns(jcol, r < ranges.size() ? ranges[r].first : n, relax_end, iperm_c.indices(), m_glu, work, m_lastError);
+    if (info == 0 && r < ranges.size())
+    {
+      info = mergeSubtree(ranges[r], tasks[ranges[r].task], work.xprune);
+      if ( info ) 
+        m_lastError = "UNABLE TO EXPAND MEMORY IN FACTORIZE() ";
+      jcol = ranges[r].last;
+    }
+    if ( info ) 
+    {
+      m_info = NumericalIssue; 
+      m_factorizationIsOk = false; 
+      return; 
+    }
+  }
+  
+  m_detPermR = m_perm_r.determinant();
+  m_detPermC = m_perm_c.determinant();
+  
+  // Count the number of nonzeros in factors 
+  Base::countnz(n, m_nnzL, m_nnzU, m_glu); 
+  // Apply permutation  to the L subscripts 
+  Base::fixupL(n, m_perm_r.indices(), m_glu);
+  
+  // Create supernode matrix L 
+  m_Lstore.setInfos(m, n, m_glu.lusup, m_glu.xlusup, m_glu.lsub, m_glu.xlsub, m_glu.supno, m_glu.xsup); 
+  // Create the column major upper sparse matrix  U; 
+  new (&m_Ustore) MappedSparseMatrix<Scalar, ColMajor, StorageIndex> ( m, n, m_nnzU, m_glu.xusub.data(), m_glu.usub.data(), m_glu.ucol.data() );
+  
+  m_info = Success;
+  m_factorizationIsOk = true;
+}
+
+template <typename MatrixType, typename OrderingType>
+void SparseLU<MatrixType, OrderingType>::initWorkspace(Workspace& work, Index m, Index n)
+{
+  Index maxpanel = m_perfv.panel_size * m;
+  work.segrep.setZero(m);
+  work.parent.setZero(m);
+  work.xplore.setZero(m);
+  work.repfnz.setConstant(maxpanel, -1);
+  work.panel_lsub.setConstant(maxpanel, -1);
+  work.xprune.setZero(n);
+  work.marker.setConstant(m*internal::LUNoMarker, -1);
+  work.dense.setZero(maxpanel);
+  work.tempv.setZero(internal::LUnumTempV(m, m_perfv.panel_size, m_perfv.maxsuper, /*m_perfv.rowblk*/m) );
+}
+
+/** \internal
+  * Factorizes the columns \a first to \a last-1 into \a glu, whose storage and supernodes already contain
+  * the columns 0 to \a first-1.
+  * \returns 0 on success, and the error code of the failing routine otherwise, with its message in \a lastError
+  */
+template <typename MatrixType, typename OrderingType>
+Index SparseLU<MatrixType, OrderingType>::factorizeColumns(Index first, Index last, const IndexVector& relax_end, IndexVector& iperm_c,
+                                                            typename Base::GlobalLU_t& glu, Workspace& work, std::string& lastError)
+{
+  using internal::emptyIdxLU;
+  Index m = m_mat.rows();
+  Index info;
+  
   // Work on one 'panel' at a time. A panel is one of the following :
   //  (a) a relaxed supernode at the bottom of the etree, or
   //  (b) panel_size contiguous columns, <panel_size> defined by the user
   Index jcol; 
-  IndexVector panel_histo(n);
   Index pivrow; // Pivotal row number in the original row matrix
   Index nseg1; // Number of segments in U-column above panel row jcol
   Index nseg; // Number of segments in each U-column 
   Index irep; 
   Index i, k, jj; 
-  for (jcol = 0; jcol < n; )
+  for (jcol = first; jcol < last; )
   {
     // Adjust panel size so that a panel won't overlap with the next relaxed snode. 
     Index panel_size = m_perfv.panel_size; // upper bound on panel width
-    for (k = jcol + 1; k < (std::min)(jcol+panel_size, n); k++)
+    for (k = jcol + 1; k < (std::min)(jcol+panel_size, last); k++)
     {
       if (relax_end(k) != emptyIdxLU) 
       {
@@ -602,14 +741,14 @@ void SparseLU<MatrixType, OrderingType>::factorize(const MatrixType& matrix)
         break; 
       }
     }
-    if (k == n) 
-      panel_size = n - jcol; 
+    if (k == last) 
+      panel_size = last - jcol; 
       
     // Symbolic outer factorization on a panel of columns 
-    Base::panel_dfs(m, panel_size, jcol, m_mat, m_perm_r.indices(), nseg1, dense, panel_lsub, segrep, repfnz, xprune, marker, parent, xplore, m_glu); 
+    Base::panel_dfs(m, panel_size, jcol, m_mat, m_perm_r.indices(), nseg1, work.dense, work.panel_lsub, work.segrep, work.repfnz, work.xprune, work.marker, work.parent, work.xplore, glu); 
     
     // Numeric sup-panel updates in topological order 
-    Base::panel_bmod(m, panel_size, jcol, nseg1, dense, tempv, segrep, repfnz, m_glu); 
+    Base::panel_bmod(m, panel_size, jcol, nseg1, work.dense, work.tempv, work.segrep, work.repfnz, glu); 
     
     // Sparse LU within the panel, and below the panel diagonal 
     for ( jj = jcol; jj< jcol + panel_size; jj++) 
@@ -618,83 +757,240 @@ void SparseLU<MatrixType, OrderingType>::factorize(const MatrixType& matrix)
       
       nseg = nseg1; // begin after all the panel segments
       //Depth-first-search for the current column
-      VectorBlock<IndexVector> panel_lsubk(panel_lsub, k, m);
-      VectorBlock<IndexVector> repfnz_k(repfnz, k, m); 
-      info = Base::column_dfs(m, jj, m_perm_r.indices(), m_perfv.maxsuper, nseg, panel_lsubk, segrep, repfnz_k, xprune, marker, parent, xplore, m_glu); 
+      VectorBlock<IndexVector> panel_lsubk(work.panel_lsub, k, m);
+      VectorBlock<IndexVector> repfnz_k(work.repfnz, k, m); 
+      info = Base::column_dfs(m, jj, m_perm_r.indices(), m_perfv.maxsuper, nseg, panel_lsubk, work.segrep, repfnz_k, work.xprune, work.marker, work.parent, work.xplore, glu); 
       if ( info ) 
       {
-        m_lastError =  "UNABLE TO EXPAND MEMORY IN COLUMN_DFS() ";
-        m_info = NumericalIssue; 
-        m_factorizationIsOk = false; 
-        return; 
+        lastError =  "UNABLE TO EXPAND MEMORY IN COLUMN_DFS() ";
+        return info; 
       }
       // Numeric updates to this column 
-      VectorBlock<ScalarVector> dense_k(dense, k, m); 
-      VectorBlock<IndexVector> segrep_k(segrep, nseg1, m-nseg1); 
-      info = Base::column_bmod(jj, (nseg - nseg1), dense_k, tempv, segrep_k, repfnz_k, jcol, m_glu); 
+      VectorBlock<ScalarVector> dense_k(work.dense, k, m); 
+      VectorBlock<IndexVector> segrep_k(work.segrep, nseg1, m-nseg1); 
+      info = Base::column_bmod(jj, (nseg - nseg1), dense_k, work.tempv, segrep_k, repfnz_k, jcol, glu); 
       if ( info ) 
       {
-        m_lastError = "UNABLE TO EXPAND MEMORY IN COLUMN_BMOD() ";
-        m_info = NumericalIssue; 
-        m_factorizationIsOk = false; 
-        return; 
+        lastError = "UNABLE TO EXPAND MEMORY IN COLUMN_BMOD() ";
+        return info; 
       }
       
       // Copy the U-segments to ucol(*)
-      info = Base::copy_to_ucol(jj, nseg, segrep, repfnz_k ,m_perm_r.indices(), dense_k, m_glu); 
+      info = Base::copy_to_ucol(jj, nseg, work.segrep, repfnz_k ,m_perm_r.indices(), dense_k, glu); 
       if ( info ) 
       {
-        m_lastError = "UNABLE TO EXPAND MEMORY IN COPY_TO_UCOL() ";
-        m_info = NumericalIssue; 
-        m_factorizationIsOk = false; 
-        return; 
+        lastError = "UNABLE TO EXPAND MEMORY IN COPY_TO_UCOL() ";
+        return info; 
       }
       
       // Form the L-segment 
-      info = Base::pivotL(jj, m_diagpivotthresh, m_perm_r.indices(), iperm_c.indices(), pivrow, m_glu);
+      info = Base::pivotL(jj, m_diagpivotthresh, m_perm_r.indices(), iperm_c, pivrow, glu);
       if ( info ) 
       {
-        m_lastError = "THE MATRIX IS STRUCTURALLY SINGULAR ... ZERO COLUMN AT ";
+        lastError = "THE MATRIX IS STRUCTURALLY SINGULAR ... ZERO COLUMN AT ";
         std::ostringstream returnInfo;
         returnInfo << info; 
-        m_lastError += returnInfo.str();
-        m_info = NumericalIssue; 
-        m_factorizationIsOk = false; 
-        return; 
+        lastError += returnInfo.str();
+        return info; 
       }
       
-      // Update the determinant of the row permutation matrix
-      // FIXME: the following test is not correct, we should probably take iperm_c into account and pivrow is not directly the row pivot.
-      if (pivrow != jj) m_detPermR = -m_detPermR;
-
       // Prune columns (0:jj-1) using column jj
-      Base::pruneL(jj, m_perm_r.indices(), pivrow, nseg, segrep, repfnz_k, xprune, m_glu); 
+      Base::pruneL(jj, m_perm_r.indices(), pivrow, nseg, work.segrep, repfnz_k, work.xprune, glu); 
       
       // Reset repfnz for this column 
       for (i = 0; i < nseg; i++)
       {
-        irep = segrep(i); 
+        irep = work.segrep(i); 
         repfnz_k(irep) = emptyIdxLU; 
       }
     } // end SparseLU within the panel  
     jcol += panel_size;  // Move to the next panel
   } // end for -- end elimination 
+  return 0;
+}
+
+/** \internal
+  * Splits the column elimination tree into subtrees of similar sizes, which are distributed over at most
+  * \a threads tasks. The subtrees are returned in \a ranges by increasing columns, and are left empty if
+  * the tree does not have enough independent subtrees.
+  */
+template <typename MatrixType, typename OrderingType>
+void SparseLU<MatrixType, OrderingType>::findSubtrees(Index threads, std::vector<SubtreeRange>& ranges, std::vector<SubtreeTask>& tasks)
+{
+  const Index n = m_mat.cols();
+  if (threads < 2 || n < 2)
+    return;
   
-  m_detPermR = m_perm_r.determinant();
-  m_detPermC = m_perm_c.determinant();
+  // the size of each subtree, estimated by its number of columns and nonzeros, and its first column
+  // (the descendants of a column are the columns just before it, in postorder)
+  IndexVector firstCol(n);
+  Matrix<double,Dynamic,1> weight(n);
+  for (Index j = 0; j < n; ++j)
+  {
+    firstCol(j) = StorageIndex(j);
+    weight(j) = double(m_mat.innerNonZeroPtr() ? m_mat.innerNonZeroPtr()[j] : m_mat.outerIndexPtr()[j+1] - m_mat.outerIndexPtr()[j]) + 1.;
+  }
+  double total = 0;
+  for (Index j = 0; j < n; ++j)
+  {
+    Index p = m_etree(j);
+    if (p < n)
+    {
+      weight(p) += weight(j);
+      firstCol(p) = (std::min)(firstCol(p), firstCol(j));
+    }
+    else
+      total += weight(j);
+  }
   
-  // Count the number of nonzeros in factors 
-  Base::countnz(n, m_nnzL, m_nnzU, m_glu); 
-  // Apply permutation  to the L subscripts 
-  Base::fixupL(n, m_perm_r.indices(), m_glu);
+  // the largest subtrees which are not larger than the share of one thread
+  const double grain = total / double(threads);
+  double selected = 0;
+  for (Index j = 0; j < n; ++j)
+  {
+    Index p = m_etree(j);
+    if (weight(j) <= grain && (p >= n || weight(p) > grain))
+    {
+      SubtreeRange range;
+      range.first = firstCol(j);
+      range.last = j+1;
+      range.task = 0;
+      ranges.push_back(range);
+      selected += weight(j);
+    }
+  }
   
-  // Create supernode matrix L 
-  m_Lstore.setInfos(m, n, m_glu.lusup, m_glu.xlusup, m_glu.lsub, m_glu.xlsub, m_glu.supno, m_glu.xsup); 
-  // Create the column major upper sparse matrix  U; 
-  new (&m_Ustore) MappedSparseMatrix<Scalar, ColMajor, StorageIndex> ( m, n, m_nnzU, m_glu.xusub.data(), m_glu.usub.data(), m_glu.ucol.data() );
+  // distribute consecutive subtrees over the tasks, and merge the adjacent ones of a task
+  std::vector<SubtreeRange> merged;
+  double done = 0;
+  Index bucket = -1;
+  for (std::size_t r = 0; r < ranges.size(); ++r)
+  {
+    const Index b = (std::min)(Index(done * double(threads) / selected), threads-1);
+    const double w = weight(ranges[r].last-1);
+    done += w;
+    if (b != bucket)
+    {
+      bucket = b;
+      tasks.push_back(SubtreeTask());
+      tasks.back().rangeStart = Index(merged.size());
+      tasks.back().nnz = 0;
+    }
+    if (Index(merged.size()) > tasks.back().rangeStart && merged.back().last == ranges[r].first)
+      merged.back().last = ranges[r].last;
+    else
+    {
+      ranges[r].task = Index(tasks.size()) - 1;
+      merged.push_back(ranges[r]);
+    }
+    tasks.back().rangeEnd = Index(merged.size());
+    tasks.back().nnz += Index(w);
+  }
+  ranges.swap(merged);
+  if (tasks.size() < 2)
+  {
+    ranges.clear();
+    tasks.clear();
+  }
+}
+
+template <typename MatrixType, typename OrderingType>
+void SparseLU<MatrixType, OrderingType>::factorizeSubtrees(SubtreeTask& task, const IndexVector& relax_end, IndexVector& iperm_c,
+                                                            std::vector<SubtreeRange>& ranges)
+{
+  using internal::emptyIdxLU;
+  Index m = m_mat.rows();
+  Index n = m_mat.cols();
+  typename Base::GlobalLU_t& glu = task.glu;
   
-  m_info = Success;
-  m_factorizationIsOk = true;
+  // the initial storage is estimated from the columns of the task, but the factors are indexed by the global columns
+  Index cols = 0;
+  for (Index r = task.rangeStart; r < task.rangeEnd; ++r)
+    cols += ranges[r].last - ranges[r].first;
+  task.info = Base::memInit(m, cols, task.nnz, 0, m_perfv.fillfactor, m_perfv.panel_size, glu);
+  if (task.info)
+  {
+    task.lastError = "UNABLE TO ALLOCATE WORKING MEMORY\n\n" ;
+    return;
+  }
+  glu.xsup.resize(n+1);
+  glu.supno.resize(n+1);
+  glu.xlsub.resize(n+1);
+  glu.xlusup.resize(n+1);
+  glu.xusub.resize(n+1);
+  initWorkspace(task.work, m, n);
+  
+  // The ranges are stored one after the other in the factors of the task, and each one starts a new supernode
+  // numbering, from the first column of the range as for column 0.
+  StorageIndex nextl = 0, nextlu = 0, nextu = 0;
+  for (Index r = task.rangeStart; r < task.rangeEnd; ++r)
+  {
+    SubtreeRange& range = ranges[r];
+    glu.supno(range.first) = emptyIdxLU;
+    glu.xsup(0) = StorageIndex(range.first);
+    glu.xlsub(range.first) = nextl;
+    glu.xlusup(range.first) = nextlu;
+    glu.xusub(range.first) = nextu;
+    task.info = factorizeColumns(range.first, range.last, relax_end, iperm_c, glu, task.work, task.lastError);
+    if (task.info)
+      return;
+    range.xsup = glu.xsup.head(glu.supno(range.last)+2);
+    nextl = glu.xlsub(range.last);
+    nextlu = glu.xlusup(range.last);
+    nextu = glu.xusub(range.last);
+  }
+}
+
+/** \internal
+  * Appends the factors of the subtree \a range, computed by \a task, to the factors of the columns before it.
+  * \returns 0 on success, and the size of the memory allocated so far if the storage cannot be expanded
+  */
+template <typename MatrixType, typename OrderingType>
+Index SparseLU<MatrixType, OrderingType>::mergeSubtree(const SubtreeRange& range, const SubtreeTask& task, IndexVector& xprune)
+{
+  const typename Base::GlobalLU_t& glu = task.glu;
+  const Index first = range.first, last = range.last;
+  
+  // The supernode of the column before the range is not compressed, as the last supernode of a factorization.
+  const StorageIndex nsuper = m_glu.supno(first) + 1; // supno(0) is emptyIdxLU
+  const StorageIndex nextl = m_glu.xlsub(first), nextlu = m_glu.xlusup(first), nextu = m_glu.xusub(first);
+  const StorageIndex lsubStart = glu.xlsub(first), lusupStart = glu.xlusup(first), ucolStart = glu.xusub(first);
+  const Index lsubSize = glu.xlsub(last) - lsubStart, lusupSize = glu.xlusup(last) - lusupStart, ucolSize = glu.xusub(last) - ucolStart;
+  
+  Index mem;
+  while (nextl + lsubSize > m_glu.nzlmax)
+  {
+    mem = Base::memXpand(m_glu.lsub, m_glu.nzlmax, nextl, internal::LSUB, m_glu.num_expansions);
+    if (mem) return mem;
+  }
+  while (nextlu + lusupSize > m_glu.nzlumax)
+  {
+    mem = Base::memXpand(m_glu.lusup, m_glu.nzlumax, nextlu, internal::LUSUP, m_glu.num_expansions);
+    if (mem) return mem;
+  }
+  while (nextu + ucolSize > m_glu.nzumax)
+  {
+    mem = Base::memXpand(m_glu.ucol, m_glu.nzumax, nextu, internal::UCOL, m_glu.num_expansions);
+    if (mem) return mem;
+    mem = Base::memXpand(m_glu.usub, m_glu.nzumax, nextu, internal::USUB, m_glu.num_expansions);
+    if (mem) return mem;
+  }
+  
+  m_glu.lsub.segment(nextl, lsubSize) = glu.lsub.segment(lsubStart, lsubSize);
+  m_glu.lusup.segment(nextlu, lusupSize) = glu.lusup.segment(lusupStart, lusupSize);
+  m_glu.ucol.segment(nextu, ucolSize) = glu.ucol.segment(ucolStart, ucolSize);
+  m_glu.usub.segment(nextu, ucolSize) = glu.usub.segment(ucolStart, ucolSize);
+  for (Index j = first; j <= last; ++j)
+  {
+    m_glu.supno(j) = glu.supno(j) + nsuper;
+    m_glu.xlsub(j) = glu.xlsub(j) - lsubStart + nextl;
+    m_glu.xlusup(j) = glu.xlusup(j) - lusupStart + nextlu;
+    m_glu.xusub(j) = glu.xusub(j) - ucolStart + nextu;
+    if (j < last)
+      xprune(j) = task.work.xprune(j) - lsubStart + nextl;
+  }
+  m_glu.xsup.segment(nsuper, range.xsup.size()) = range.xsup;
+  return 0;
 }
 
 template<typename MappedSupernodalType>
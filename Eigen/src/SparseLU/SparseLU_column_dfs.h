@@ -122,9 +122,9 @@ Index SparseLUImpl<Scalar,StorageIndex>::column_dfs(const Index m, const Index j
   Index jcolm1 = jcol - 1;
   
   // check to see if j belongs in the same supernode as j-1
-  if ( jcol == 0 )
-  { // Do nothing for column 0 
-    nsuper = glu.supno(0) = 0 ;
+  if ( nsuper == emptyIdxLU )
+  { // Do nothing for column 0, or for the first column of an independent subtree
+    nsuper = glu.supno(jcol) = 0 ;
   }
   else 
   {
@@ -149,7 +149,11 @@ void SparseLUImpl<Scalar,StorageIndex>::panel_bmod(const Index m, const Index w,
       MappedMatrixBlock L(tempv.data()+w*ldu+offset, nrow, u_cols, OuterStride<>(ldl));
       
       L.setZero();
-      internal::sparselu_gemm<Scalar>(L.rows(), L.cols(), B.cols(), B.data(), B.outerStride(), U.data(), U.outerStride(), L.data(), L.outerStride());
+      // the updates from large supernodes go through the general, multi-threaded, matrix product
+      if(internal::parallel_cwise_threads(double(nrow)*double(u_rows)*double(u_cols)) > 1)
+        L.noalias() += B * U;
+      else
+        internal::sparselu_gemm<Scalar>(L.rows(), L.cols(), B.cols(), B.data(), B.outerStride(), U.data(), U.outerStride(), L.data(), L.outerStride());
       
       // scatter U and L
       u_col = 0;
@@ -0,0 +1,78 @@
+// Benchmarks batched_product against a loop of individual products on batches of small fixed-size matrices.
+//
+// g++ -O3 -DNDEBUG -I.. -march=native bench_batched_product.cpp -o bench_batched_product
+// g++ -O3 -DNDEBUG -I.. -march=native -fopenmp bench_batched_product.cpp -o bench_batched_product
+//
+// Usage: ./bench_batched_product [number of matrices]
+
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+#include <Eigen/Core>
+#include <bench/BenchTimer.h>
+
+using namespace Eigen;
+
+#ifndef SCALAR
+#define SCALAR float
+#endif
+
+#ifndef REPEAT
+#define REPEAT 10
+#endif
+
+#ifndef TRIES
+#define TRIES 4
+#endif
+
+template<typename MatrixType>
+EIGEN_DONT_INLINE void loop_product(const std::vector<MatrixType,aligned_allocator<MatrixType> >& a,
+                                    const std::vector<MatrixType,aligned_allocator<MatrixType> >& b,
+                                    std::vector<MatrixType,aligned_allocator<MatrixType> >& c)
+{
+  for(size_t i=0; i<a.size(); ++i)
+    c[i].noalias() = a[i] * b[i];
+}
+
+template<int Size>
+void bench(Index count)
+{
+  typedef Matrix<SCALAR,Size,Size> MatrixType;
+  typedef std::vector<MatrixType,aligned_allocator<MatrixType> > Batch;
+
+  // keep the amount of work roughly independent of the matrix size
+  count = (std::max)(Index(1), count * 27 / (Size*Size*Size));
+  Batch a(count), b(count), c(count), r(count);
+  for(Index i=0; i<count; ++i)
+  {
+    a[i].setRandom();
+    b[i].setRandom();
+  }
+
+  BenchTimer tloop, tbatch;
+  BENCH(tloop, TRIES, REPEAT, loop_product(a, b, r));
+  BENCH(tbatch, TRIES, REPEAT, batched_product(a.data(), b.data(), c.data(), count));
+
+  double maxError = 0;
+  for(Index i=0; i<count; ++i)
+    maxError = (std::max)(maxError, double((c[i]-r[i]).cwiseAbs().maxCoeff()));
+
+  double flops = 2. * double(Size) * Size * Size * double(count) * REPEAT * 1e-9;
+  std::cout << Size << "x" << Size << " x " << count << " matrices:"
+            << "  loop " << tloop.best() << "s (" << flops/tloop.best() << " GFlops)"
+            << "  batched " << tbatch.best() << "s (" << flops/tbatch.best() << " GFlops)"
+            << "  speedup " << tloop.best()/tbatch.best()
+            << "  max error " << maxError << "\n";
+}
+
+int main(int argc, char** argv)
+{
+  Index count = argc>1 ? std::atoi(argv[1]) : 100000;
+  std::cout << "threads: " << nbThreads() << "\n";
+  bench<3>(count);
+  bench<4>(count);
+  bench<8>(count);
+  bench<16>(count);
+  bench<32>(count);
+  return 0;
+}
@@ -8,6 +8,9 @@
 // -DSCALARA=double or -DSCALARB=double
 // -DHAVE_BLAS
 // -DDECOUPLED
+// -DEIGEN_GEMM_THREADPOOL -DNB_THREADS=n : run the parallel product on an Eigen::ThreadPool of n threads
+//
+// Tall-skinny products, which are split into 2D tiles, can be benchmarked with e.g. -s 100000 64 64
 //
 
 #include <iostream>
@@ -253,7 +256,22 @@ int main(int argc, char ** argv)
   C r = c;
 
   // check the parallel product is correct
-  #if defined EIGEN_HAS_OPENMP
+  #if defined EIGEN_GEMM_THREADPOOL
+  #ifndef NB_THREADS
+  #define NB_THREADS 4
+  #endif
+  ThreadPool pool(NB_THREADS);
+  setGemmThreadPool(&pool);
+  int procs = nbThreads();
+  std::cout << "Thread pool       = " << procs << " threads\n";
+  {
+    setGemmThreadPool(0);
+    r.noalias() += a * b;
+    setGemmThreadPool(&pool);
+    c.noalias() += a * b;
+    if(!r.isApprox(c)) std::cerr << "Warning, your parallel product is crap!\n\n";
+  }
+  #elif defined EIGEN_HAS_OPENMP
   Eigen::initParallel();
   int procs = omp_get_max_threads();
   if(procs>1)
@@ -304,11 +322,13 @@ int main(int argc, char ** argv)
   std::cout << "eigen cpu         " << tmt.best(CPU_TIMER)/rep  << "s  \t" << (double(m)*n*p*rep*2/tmt.best(CPU_TIMER))*1e-9  <<  " GFLOPS \t(" << tmt.total(CPU_TIMER)  << "s)\n";
   std::cout << "eigen real        " << tmt.best(REAL_TIMER)/rep << "s  \t" << (double(m)*n*p*rep*2/tmt.best(REAL_TIMER))*1e-9 <<  " GFLOPS \t(" << tmt.total(REAL_TIMER) << "s)\n";
 
-  #ifdef EIGEN_HAS_OPENMP
+  #if defined EIGEN_HAS_OPENMP || defined EIGEN_GEMM_THREADPOOL
   if(procs>1)
   {
     BenchTimer tmono;
+    #ifdef EIGEN_HAS_OPENMP
     omp_set_num_threads(1);
+    #endif
     Eigen::setNbThreads(1);
     c = rc;
     BENCH(tmono, tries, rep, gemm(a,b,c));
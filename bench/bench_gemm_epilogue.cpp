@@ -0,0 +1,56 @@
+// Benchmarks the fusion of coefficient-wise operations into the matrix-matrix product, as in a dense layer
+// of a neural network, relu(A*B + bias), against the evaluation of the product into a temporary.
+//
+// g++ -O3 -DNDEBUG -I.. -march=native bench_gemm_epilogue.cpp -o bench_gemm_epilogue
+//
+// Usage: ./bench_gemm_epilogue [rows depth cols]
+
+#include <iostream>
+#include <cstdlib>
+#include <Eigen/Core>
+#include <bench/BenchTimer.h>
+
+using namespace Eigen;
+
+#ifndef REPEAT
+#define REPEAT 10
+#endif
+
+#ifndef TRIES
+#define TRIES 4
+#endif
+
+void bench(Index rows, Index depth, Index cols)
+{
+  MatrixXf a = MatrixXf::Random(rows, depth);
+  MatrixXf b = MatrixXf::Random(depth, cols);
+  RowVectorXf bias = RowVectorXf::Random(cols);
+  MatrixXf c(rows, cols), tmp(rows, cols), ref(rows, cols);
+
+  BenchTimer tgemm, tunfused, tfused;
+  BENCH(tgemm, TRIES, REPEAT, c.noalias() = a * b);
+  BENCH(tunfused, TRIES, REPEAT, tmp.noalias() = a * b; ref = (tmp.rowwise() + bias).cwiseMax(0.f));
+  BENCH(tfused, TRIES, REPEAT, c.noalias() = ((a * b).rowwise() + bias).cwiseMax(0.f));
+
+  std::cout << rows << "x" << depth << " * " << depth << "x" << cols << ":"
+            << "  product " << tgemm.best() << "s"
+            << "  unfused " << tunfused.best() << "s"
+            << "  fused " << tfused.best() << "s"
+            << "  speedup " << tunfused.best()/tfused.best()
+            << "  error " << (c-ref).cwiseAbs().maxCoeff() << "\n";
+}
+
+int main(int argc, char** argv)
+{
+  if(argc>3)
+  {
+    bench(std::atoi(argv[1]), std::atoi(argv[2]), std::atoi(argv[3]));
+    return 0;
+  }
+  // batches of activations times weight matrices
+  bench(256, 256, 256);
+  bench(1024, 256, 1024);
+  bench(4096, 64, 1024);
+  bench(1024, 1024, 1024);
+  return 0;
+}
@@ -0,0 +1,77 @@
+// Benchmarks quantized_product on 8-bit and 16-bit integer matrices against the float matrix product.
+//
+// g++ -O3 -DNDEBUG -I.. -march=native bench_quantized_gemm.cpp -o bench_quantized_gemm
+// g++ -O3 -DNDEBUG -I.. -march=native -fopenmp bench_quantized_gemm.cpp -o bench_quantized_gemm
+//
+// Usage: ./bench_quantized_gemm [size]
+
+#include <iostream>
+#include <cstdlib>
+#include <Eigen/Core>
+#include <bench/BenchTimer.h>
+
+using namespace Eigen;
+
+#ifndef REPEAT
+#define REPEAT 10
+#endif
+
+#ifndef TRIES
+#define TRIES 4
+#endif
+
+template<typename Scalar>
+Matrix<Scalar,Dynamic,Dynamic> random_quantized(Index rows, Index cols, int minValue, int maxValue)
+{
+  Matrix<Scalar,Dynamic,Dynamic> m(rows,cols);
+  for(Index j=0; j<cols; ++j)
+    for(Index i=0; i<rows; ++i)
+      m(i,j) = Scalar(internal::random<int>(minValue,maxValue));
+  return m;
+}
+
+template<typename LhsScalar, typename RhsScalar>
+void bench(const char* name, Index rows, Index depth, Index cols, int maxValue)
+{
+  typedef Matrix<LhsScalar,Dynamic,Dynamic> LhsType;
+  typedef Matrix<RhsScalar,Dynamic,Dynamic> RhsType;
+  int lhsMin = NumTraits<LhsScalar>::IsSigned ? -maxValue : 0;
+  int rhsMin = NumTraits<RhsScalar>::IsSigned ? -maxValue : 0;
+  LhsType a = random_quantized<LhsScalar>(rows, depth, lhsMin, maxValue);
+  RhsType b = random_quantized<RhsScalar>(depth, cols, rhsMin, maxValue);
+  MatrixXf af = a.template cast<float>();
+  MatrixXf bf = b.template cast<float>();
+  MatrixXi c(rows,cols);
+  MatrixXf cf(rows,cols), df(rows,cols);
+
+  VectorXi za = VectorXi::Constant(rows, 3);
+  VectorXf sa = VectorXf::Constant(rows, 0.01f);
+  RowVectorXi zb = RowVectorXi::Zero(cols);
+  RowVectorXf sb = RowVectorXf::Constant(cols, 0.02f);
+
+  BenchTimer tfloat, tint, tdeq;
+  BENCH(tfloat, TRIES, REPEAT, cf.noalias() = af * bf);
+  BENCH(tint, TRIES, REPEAT, quantized_product(a, b, c));
+  BENCH(tdeq, TRIES, REPEAT, quantized_product(a, b, df, za, sa, zb, sb));
+
+  double flops = 2. * double(rows) * double(depth) * double(cols) * REPEAT * 1e-9;
+  std::cout << name << " " << rows << "x" << depth << " * " << depth << "x" << cols << ":"
+            << "  float " << tfloat.best() << "s (" << flops/tfloat.best() << " GFlops)"
+            << "  int32 " << tint.best() << "s (" << flops/tint.best() << " GOps)"
+            << "  dequantized " << tdeq.best() << "s (" << flops/tdeq.best() << " GOps)"
+            << "  speedup " << tfloat.best()/tint.best()
+            << "  max error " << (c.cast<float>()-cf).cwiseAbs().maxCoeff() << "\n";
+}
+
+int main(int argc, char** argv)
+{
+  Index size = argc>1 ? std::atoi(argv[1]) : 1024;
+  std::cout << SimdInstructionSetsInUse() << ", threads: " << nbThreads() << "\n";
+  // small enough values for the float products to be exact
+  bench<unsigned char,signed char>("u8*s8 ", size, size, size, 15);
+  bench<signed char,signed char>("s8*s8 ", size, size, size, 15);
+  bench<short,short>("s16*s16", size, size, size, 15);
+  bench<unsigned char,signed char>("u8*s8 ", 64, size, size, 15);
+  bench<unsigned char,signed char>("u8*s8 ", size, size, 64, 15);
+  return 0;
+}
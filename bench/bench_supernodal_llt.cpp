@@ -0,0 +1,82 @@
+// Benchmarks the supernodal sparse Cholesky factorization SupernodalLLT against SimplicialLLT
+// on the 7-point Laplacian of a 3D grid.
+//
+// g++ -O3 -DNDEBUG -I.. -march=native bench_supernodal_llt.cpp -o bench_supernodal_llt
+// g++ -O3 -DNDEBUG -I.. -march=native -fopenmp bench_supernodal_llt.cpp -o bench_supernodal_llt
+//
+// Usage: ./bench_supernodal_llt [grid size]
+
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+#include <Eigen/SparseCholesky>
+#include <bench/BenchTimer.h>
+
+using namespace Eigen;
+
+#ifndef REPEAT
+#define REPEAT 1
+#endif
+
+#ifndef TRIES
+#define TRIES 3
+#endif
+
+typedef SparseMatrix<double> SpMat;
+
+SpMat laplacian_3d(int n)
+{
+  std::vector<Triplet<double> > triplets;
+  for(int i = 0; i < n; ++i)
+    for(int j = 0; j < n; ++j)
+      for(int k = 0; k < n; ++k)
+      {
+        const int id = (i*n+j)*n+k;
+        triplets.push_back(Triplet<double>(id, id, 6.));
+        if(i>0) triplets.push_back(Triplet<double>(id, id-n*n, -1.));
+        if(j>0) triplets.push_back(Triplet<double>(id, id-n, -1.));
+        if(k>0) triplets.push_back(Triplet<double>(id, id-1, -1.));
+      }
+  SpMat A(n*n*n, n*n*n);
+  A.setFromTriplets(triplets.begin(), triplets.end());
+  return A;
+}
+
+void bench(int n)
+{
+  SpMat A = laplacian_3d(n);
+  VectorXd b = VectorXd::Random(A.rows()), x;
+
+  SimplicialLLT<SpMat> simplicial;
+  SupernodalLLT<SpMat> supernodal;
+  simplicial.analyzePattern(A);
+  supernodal.analyzePattern(A);
+
+  BenchTimer tsimp, tsup, tsimpSolve, tsupSolve;
+  BENCH(tsimp, TRIES, REPEAT, simplicial.factorize(A));
+  BENCH(tsup, TRIES, REPEAT, supernodal.factorize(A));
+  BENCH(tsimpSolve, TRIES, REPEAT, x = simplicial.solve(b));
+  BENCH(tsupSolve, TRIES, REPEAT, x = supernodal.solve(b));
+
+  std::cout << n << "^3 grid, " << A.rows() << " unknowns, " << supernodal.supernodes() << " supernodes:"
+            << "  simplicial " << tsimp.best() << "s"
+            << "  supernodal " << tsup.best() << "s"
+            << "  speedup " << tsimp.best()/tsup.best()
+            << "  solve " << tsimpSolve.best() << "s / " << tsupSolve.best() << "s"
+            << "  residual " << (A.selfadjointView<Lower>()*x-b).norm()/b.norm() << "\n";
+}
+
+int main(int argc, char** argv)
+{
+  std::cout << "threads: " << nbThreads() << "\n";
+  if(argc>1)
+  {
+    bench(std::atoi(argv[1]));
+    return 0;
+  }
+  bench(10);
+  bench(20);
+  bench(30);
+  bench(40);
+  return 0;
+}
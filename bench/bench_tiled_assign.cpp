@@ -0,0 +1,51 @@
+// Benchmarks the assignment of expressions mixing storage orders, which are traversed by tiles of
+// EIGEN_ASSIGN_TILE_SIZE^2 coefficients, against an assignment with matching storage orders.
+//
+// g++ -O3 -DNDEBUG -I.. -march=native bench_tiled_assign.cpp -o bench_tiled_assign
+// g++ -O3 -DNDEBUG -I.. -march=native -DEIGEN_ASSIGN_TILE_SIZE=16 bench_tiled_assign.cpp -o bench_tiled_assign
+//
+// Usage: ./bench_tiled_assign [size]
+
+#include <iostream>
+#include <cstdlib>
+#include <Eigen/Core>
+#include <bench/BenchTimer.h>
+
+using namespace Eigen;
+
+#ifndef REPEAT
+#define REPEAT 4
+#endif
+
+#ifndef TRIES
+#define TRIES 4
+#endif
+
+void bench(Index size)
+{
+  MatrixXf b = MatrixXf::Random(size, size), c = MatrixXf::Random(size, size), a(size, size);
+  Matrix<float,Dynamic,Dynamic,RowMajor> r = b;
+
+  BenchTimer tsame, ttrans, tcopy;
+  BENCH(tsame, TRIES, REPEAT, a = b + c);
+  BENCH(ttrans, TRIES, REPEAT, a = b.transpose() + c);
+  BENCH(tcopy, TRIES, REPEAT, a = r);
+
+  std::cout << size << "x" << size << ":"
+            << "  A=B+C " << tsame.best() << "s"
+            << "  A=B^T+C " << ttrans.best() << "s"
+            << "  A=RowMajor " << tcopy.best() << "s\n";
+}
+
+int main(int argc, char** argv)
+{
+  if(argc>1)
+  {
+    bench(std::atoi(argv[1]));
+    return 0;
+  }
+  bench(256);
+  bench(1024);
+  bench(4096);
+  return 0;
+}
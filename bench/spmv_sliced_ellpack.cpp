@@ -0,0 +1,100 @@
+// Benchmarks the sparse matrix - vector products of the sliced ELLPACK format (SlicedEllpackMatrix)
+// against the compressed row and column storages of SparseMatrix, on matrices with short rows.
+//
+// g++ -O3 -DNDEBUG -I.. -march=native spmv_sliced_ellpack.cpp -o spmv_sliced_ellpack
+//
+// Usage: ./spmv_sliced_ellpack [size]
+
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+#include <cmath>
+#include <Eigen/SparseCore>
+#include <bench/BenchTimer.h>
+
+using namespace Eigen;
+
+#ifndef SCALAR
+#define SCALAR double
+#endif
+
+#ifndef REPEAT
+#define REPEAT 20
+#endif
+
+#ifndef TRIES
+#define TRIES 4
+#endif
+
+typedef SCALAR Scalar;
+typedef SparseMatrix<Scalar,ColMajor> ColSpMat;
+typedef SparseMatrix<Scalar,RowMajor> RowSpMat;
+typedef Matrix<Scalar,Dynamic,1> DenseVector;
+
+void bench(const char* name, const RowSpMat& A)
+{
+  ColSpMat Ac(A);
+  DenseVector x = DenseVector::Random(A.cols()), y(A.rows()), ref(A.rows());
+  SlicedEllpackMatrix<Scalar> S1(A, 1), S(A, 256);
+
+  BenchTimer tcsr, tcsc, tsell1, tsell;
+  BENCH(tcsr, TRIES, REPEAT, ref.noalias() = A * x);
+  BENCH(tcsc, TRIES, REPEAT, y.noalias() = Ac * x);
+  BENCH(tsell1, TRIES, REPEAT, y.noalias() = S1 * x);
+  BENCH(tsell, TRIES, REPEAT, y.noalias() = S * x);
+
+  double flops = 2. * double(A.nonZeros()) * REPEAT * 1e-9;
+  std::cout << name << " " << A.rows() << "x" << A.cols() << ", " << double(A.nonZeros())/double(A.rows()) << " nnz/row:"
+            << "  CSR " << flops/tcsr.best() << " GFlops"
+            << "  CSC " << flops/tcsc.best() << " GFlops"
+            << "  SELL-C-1 " << flops/tsell1.best() << " GFlops (padding " << double(S1.storedSize())/double(S1.nonZeros()) << ")"
+            << "  SELL-C-256 " << flops/tsell.best() << " GFlops (padding " << double(S.storedSize())/double(S.nonZeros()) << ")"
+            << "  error " << (y-ref).cwiseAbs().maxCoeff() << "\n";
+}
+
+// 5-point stencil on a n x n grid
+RowSpMat laplacian2d(int n)
+{
+  std::vector<Triplet<Scalar> > triplets;
+  for(int j=0; j<n; ++j)
+    for(int i=0; i<n; ++i)
+    {
+      int k = i+j*n;
+      triplets.push_back(Triplet<Scalar>(k, k, 4));
+      if(i>0)   triplets.push_back(Triplet<Scalar>(k, k-1, -1));
+      if(i<n-1) triplets.push_back(Triplet<Scalar>(k, k+1, -1));
+      if(j>0)   triplets.push_back(Triplet<Scalar>(k, k-n, -1));
+      if(j<n-1) triplets.push_back(Triplet<Scalar>(k, k+n, -1));
+    }
+  RowSpMat A(n*n, n*n);
+  A.setFromTriplets(triplets.begin(), triplets.end());
+  return A;
+}
+
+// random matrix whose rows have between minNnz and maxNnz nonzeros, with a few long rows if skewed
+RowSpMat randomRows(int n, int minNnz, int maxNnz, bool skewed)
+{
+  std::vector<Triplet<Scalar> > triplets;
+  for(int i=0; i<n; ++i)
+  {
+    int nnz = minNnz + std::rand()%(maxNnz-minNnz+1);
+    if(skewed && std::rand()%100==0)
+      nnz *= 20;
+    for(int k=0; k<nnz; ++k)
+      triplets.push_back(Triplet<Scalar>(i, std::rand()%n, Scalar(std::rand())/Scalar(RAND_MAX)));
+  }
+  RowSpMat A(n, n);
+  A.setFromTriplets(triplets.begin(), triplets.end());
+  return A;
+}
+
+int main(int argc, char** argv)
+{
+  int size = argc>1 ? std::atoi(argv[1]) : 1000000;
+  int n = int(std::sqrt(double(size)));
+  bench("laplacian 2D    ", laplacian2d(n));
+  bench("random 2-8      ", randomRows(size, 2, 8, false));
+  bench("random 1-16     ", randomRows(size, 1, 16, false));
+  bench("random 2-8 skew ", randomRows(size, 2, 8, true));
+  return 0;
+}
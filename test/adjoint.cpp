@@ -191,6 +191,49 @@ void adjoint_extra()
   a = a.transpose();
 }
 
+// Assignments mixing storage orders are traversed by tiles, check sizes which are not multiples of the tile size
+template<typename Scalar>
+void adjoint_tiled(Index rows, Index cols)
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic,ColMajor> ColMatrix;
+  typedef Matrix<Scalar,Dynamic,Dynamic,RowMajor> RowMatrix;
+
+  ColMatrix a = ColMatrix::Random(rows,cols), b = ColMatrix::Random(cols,rows);
+  RowMatrix r = a;
+  ColMatrix c(rows,cols);
+  for(Index j=0; j<cols; ++j)
+    for(Index i=0; i<rows; ++i)
+    {
+      VERIFY_IS_EQUAL(r(i,j), a(i,j));
+      c(i,j) = b(j,i) + a(i,j);
+    }
+
+  ColMatrix d = b.transpose() + a;
+  VERIFY_IS_EQUAL(d, c);
+  d = a + r;
+  VERIFY_IS_EQUAL(d, (a + a).eval());
+  d = b.adjoint().conjugate() + a;
+  VERIFY_IS_EQUAL(d, c);
+  RowMatrix e = b.transpose() + a;
+  VERIFY_IS_EQUAL(ColMatrix(e), c);
+  e.transpose() = b;
+  VERIFY_IS_EQUAL(ColMatrix(e), b.transpose().eval());
+  d -= r;
+  VERIFY_IS_EQUAL(d, (c - a).eval());
+
+  // blocks and compound assignments
+  if(rows>2 && cols>2)
+  {
+    d = c;
+    d.block(1,2,rows-2,cols-2) += b.transpose().block(1,2,rows-2,cols-2);
+    ColMatrix f = c;
+    for(Index j=2; j<cols; ++j)
+      for(Index i=1; i<rows-1; ++i)
+        f(i,j) += b(j,i);
+    VERIFY_IS_EQUAL(d, f);
+  }
+}
+
 EIGEN_DECLARE_TEST(adjoint)
 {
   for(int i = 0; i < g_repeat; i++) {
@@ -215,5 +258,9 @@ EIGEN_DECLARE_TEST(adjoint)
   CALL_SUBTEST_7( adjoint(Matrix<float, 100, 100>()) );
 
   CALL_SUBTEST_13( adjoint_extra<0>() );
+  CALL_SUBTEST_14( adjoint_tiled<float>(internal::random<int>(1,3*EIGEN_TEST_MAX_SIZE), internal::random<int>(1,3*EIGEN_TEST_MAX_SIZE)) );
+  CALL_SUBTEST_14( adjoint_tiled<std::complex<double> >(internal::random<int>(1,200), internal::random<int>(1,200)) );
+  CALL_SUBTEST_14( adjoint_tiled<int>(1, internal::random<int>(1,500)) );
+  CALL_SUBTEST_14( adjoint_tiled<int>(internal::random<int>(1,500), 1) );
 }
 
@@ -0,0 +1,62 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "main.h"
+
+template<typename Lhs, typename Rhs, typename Dst>
+void batched_product_check(Index count, Index rows, Index depth, Index cols)
+{
+  std::vector<Lhs,aligned_allocator<Lhs> > a(count);
+  std::vector<Rhs,aligned_allocator<Rhs> > b(count);
+  std::vector<Dst,aligned_allocator<Dst> > c(count);
+  for(Index i=0; i<count; ++i)
+  {
+    a[i] = Lhs::Random(rows,depth);
+    b[i] = Rhs::Random(depth,cols);
+  }
+
+  batched_product(a.data(), b.data(), c.data(), count);
+
+  for(Index i=0; i<count; ++i)
+  {
+    Dst ref = a[i] * b[i];
+    VERIFY_IS_APPROX(c[i], ref);
+  }
+}
+
+template<typename Scalar, int Rows, int Depth, int Cols>
+void batched_product_fixed()
+{
+  // counts that are not multiples of the packet size exercise the scalar remainder
+  Index count = internal::random<Index>(0,300);
+  CALL_SUBTEST(( batched_product_check<Matrix<Scalar,Rows,Depth>, Matrix<Scalar,Depth,Cols>, Matrix<Scalar,Rows,Cols> >(count, Rows, Depth, Cols) ));
+  enum {
+    LhsOrder = Depth==1 ? ColMajor : RowMajor,
+    DstOrder = Cols==1 ? ColMajor : RowMajor
+  };
+  CALL_SUBTEST(( batched_product_check<Matrix<Scalar,Rows,Depth,LhsOrder>, Matrix<Scalar,Depth,Cols>,
+                                       Matrix<Scalar,Rows,Cols,DstOrder> >(count, Rows, Depth, Cols) ));
+}
+
+EIGEN_DECLARE_TEST(batched_product)
+{
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1(( batched_product_fixed<float,3,3,3>() ));
+    CALL_SUBTEST_1(( batched_product_fixed<float,4,4,4>() ));
+    CALL_SUBTEST_1(( batched_product_fixed<float,2,5,3>() ));
+    CALL_SUBTEST_1(( batched_product_fixed<float,7,5,3>() ));
+    CALL_SUBTEST_2(( batched_product_fixed<double,6,6,6>() ));
+    CALL_SUBTEST_2(( batched_product_fixed<double,3,1,4>() ));
+    CALL_SUBTEST_3(( batched_product_fixed<float,8,8,8>() ));
+    CALL_SUBTEST_3(( batched_product_fixed<float,16,16,16>() ));
+    CALL_SUBTEST_3(( batched_product_fixed<float,32,32,32>() ));
+    CALL_SUBTEST_4(( batched_product_fixed<std::complex<float>,3,3,3>() ));
+    CALL_SUBTEST_5(( batched_product_fixed<int,4,3,2>() ));
+    CALL_SUBTEST_6(( batched_product_check<MatrixXd,MatrixXd,MatrixXd>(internal::random<Index>(0,20), internal::random<Index>(1,40), internal::random<Index>(1,40), internal::random<Index>(1,40)) ));
+    CALL_SUBTEST_6(( batched_product_check<Matrix<double,40,40>,Matrix<double,40,40>,Matrix<double,40,40> >(internal::random<Index>(0,20), 40, 40, 40) ));
+  }
+}
@@ -0,0 +1,226 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <sstream>
+
+#include "main.h"
+
+#include <Eigen/src/Core/arch/Default/BFloat16.h>
+
+// Make sure it's possible to forward declare Eigen::bfloat16
+namespace Eigen {
+struct bfloat16;
+}
+
+using Eigen::bfloat16;
+
+typedef Matrix<bfloat16,Dynamic,Dynamic> MatrixXbf;
+
+void test_conversion()
+{
+  using Eigen::bfloat16_impl::__bfloat16_raw;
+
+  // Conversion from float.
+  VERIFY_IS_EQUAL(bfloat16(1.0f).x, 0x3f80);
+  VERIFY_IS_EQUAL(bfloat16(0.5f).x, 0x3f00);
+  VERIFY_IS_EQUAL(bfloat16(0.33333f).x, 0x3eab);
+  VERIFY_IS_EQUAL(bfloat16(0.0f).x, 0x0000);
+  VERIFY_IS_EQUAL(bfloat16(-0.0f).x, 0x8000);
+  VERIFY_IS_EQUAL(bfloat16(3.38953139e38f).x, 0x7f7f);
+  VERIFY_IS_EQUAL(bfloat16(3.40e38f).x, 0x7f80);  // Becomes infinity.
+
+  // Denormals.
+  VERIFY_IS_EQUAL(bfloat16(-9.18355e-41f).x, 0x8001);
+  VERIFY_IS_EQUAL(bfloat16(9.18355e-41f).x, 0x0001);
+
+  // Verify round-to-nearest-even behavior.
+  float val1 = float(bfloat16(__bfloat16_raw(0x3f80)));
+  float val2 = float(bfloat16(__bfloat16_raw(0x3f81)));
+  float val3 = float(bfloat16(__bfloat16_raw(0x3f82)));
+  VERIFY_IS_EQUAL(bfloat16(0.5f * (val1 + val2)).x, 0x3f80);
+  VERIFY_IS_EQUAL(bfloat16(0.5f * (val2 + val3)).x, 0x3f82);
+
+  // Conversion from int.
+  VERIFY_IS_EQUAL(bfloat16(-1).x, 0xbf80);
+  VERIFY_IS_EQUAL(bfloat16(0).x, 0x0000);
+  VERIFY_IS_EQUAL(bfloat16(1).x, 0x3f80);
+  VERIFY_IS_EQUAL(bfloat16(2).x, 0x4000);
+  VERIFY_IS_EQUAL(bfloat16(3).x, 0x4040);
+
+  // Conversion from bool.
+  VERIFY_IS_EQUAL(bfloat16(false).x, 0x0000);
+  VERIFY_IS_EQUAL(bfloat16(true).x, 0x3f80);
+
+  // Conversion to float.
+  VERIFY_IS_EQUAL(float(bfloat16(__bfloat16_raw(0x0000))), 0.0f);
+  VERIFY_IS_EQUAL(float(bfloat16(__bfloat16_raw(0x3f80))), 1.0f);
+
+  // NaNs and infinities.
+  VERIFY(!(numext::isinf)(float(bfloat16(3.38953139e38f))));  // Largest finite number.
+  VERIFY(!(numext::isnan)(float(bfloat16(0.0f))));
+  VERIFY((numext::isinf)(float(bfloat16(__bfloat16_raw(0xff80)))));
+  VERIFY((numext::isnan)(float(bfloat16(__bfloat16_raw(0xff81)))));
+  VERIFY((numext::isinf)(float(bfloat16(__bfloat16_raw(0x7f80)))));
+  VERIFY((numext::isnan)(float(bfloat16(__bfloat16_raw(0x7f81)))));
+
+  // Rounding must not turn a NaN into an infinity.
+  float nan_with_low_payload;
+  const uint32_t nan_bits = 0x7f800001u;
+  std::memcpy(&nan_with_low_payload, &nan_bits, sizeof(float));
+  VERIFY((numext::isnan)(bfloat16(nan_with_low_payload)));
+
+  // Exactly same checks as above, just directly on the bfloat16 representation.
+  VERIFY(!(numext::isinf)(bfloat16(__bfloat16_raw(0x7f7f))));
+  VERIFY(!(numext::isnan)(bfloat16(__bfloat16_raw(0x0000))));
+  VERIFY((numext::isinf)(bfloat16(__bfloat16_raw(0xff80))));
+  VERIFY((numext::isnan)(bfloat16(__bfloat16_raw(0xff81))));
+  VERIFY((numext::isinf)(bfloat16(__bfloat16_raw(0x7f80))));
+  VERIFY((numext::isnan)(bfloat16(__bfloat16_raw(0x7f81))));
+}
+
+void test_numtraits()
+{
+  std::cout << "epsilon       = " << NumTraits<bfloat16>::epsilon() << "  (0x" << std::hex << NumTraits<bfloat16>::epsilon().x << ")" << std::endl;
+  std::cout << "highest       = " << NumTraits<bfloat16>::highest() << "  (0x" << std::hex << NumTraits<bfloat16>::highest().x << ")" << std::endl;
+  std::cout << "lowest        = " << NumTraits<bfloat16>::lowest() << "  (0x" << std::hex << NumTraits<bfloat16>::lowest().x << ")" << std::endl;
+  std::cout << "min           = " << (std::numeric_limits<bfloat16>::min)() << "  (0x" << std::hex << bfloat16((std::numeric_limits<bfloat16>::min)()).x << ")" << std::endl;
+  std::cout << "denorm min    = " << (std::numeric_limits<bfloat16>::denorm_min)() << "  (0x" << std::hex << bfloat16((std::numeric_limits<bfloat16>::denorm_min)()).x << ")" << std::endl;
+  std::cout << "infinity      = " << NumTraits<bfloat16>::infinity() << "  (0x" << std::hex << NumTraits<bfloat16>::infinity().x << ")" << std::endl;
+  std::cout << "quiet nan     = " << NumTraits<bfloat16>::quiet_NaN() << "  (0x" << std::hex << NumTraits<bfloat16>::quiet_NaN().x << ")" << std::endl;
+  std::cout << "signaling nan = " << std::numeric_limits<bfloat16>::signaling_NaN() << "  (0x" << std::hex << std::numeric_limits<bfloat16>::signaling_NaN().x << ")" << std::endl << std::dec;
+
+  VERIFY(NumTraits<bfloat16>::IsSigned);
+
+  VERIFY_IS_EQUAL( std::numeric_limits<bfloat16>::infinity().x, bfloat16(std::numeric_limits<float>::infinity()).x );
+  VERIFY_IS_EQUAL( std::numeric_limits<bfloat16>::quiet_NaN().x, bfloat16(std::numeric_limits<float>::quiet_NaN()).x );
+  VERIFY( (std::numeric_limits<bfloat16>::min)() > bfloat16(0.f) );
+  VERIFY( (std::numeric_limits<bfloat16>::denorm_min)() > bfloat16(0.f) );
+  VERIFY( (std::numeric_limits<bfloat16>::min)()/bfloat16(2) > bfloat16(0.f) );
+  VERIFY_IS_EQUAL( (std::numeric_limits<bfloat16>::denorm_min)()/bfloat16(2), bfloat16(0.f) );
+  VERIFY_IS_EQUAL( float(bfloat16(1) + NumTraits<bfloat16>::epsilon()), 1.0078125f );
+}
+
+void test_arithmetic()
+{
+  VERIFY_IS_EQUAL(float(bfloat16(2) + bfloat16(2)), 4);
+  VERIFY_IS_EQUAL(float(bfloat16(2) + bfloat16(-2)), 0);
+  VERIFY_IS_APPROX(bfloat16(0.33333f) + bfloat16(0.66667f), bfloat16(1.0f));
+  VERIFY_IS_EQUAL(float(bfloat16(2.0f) * bfloat16(-5.5f)), -11.0f);
+  VERIFY_IS_APPROX(bfloat16(1.0f) / bfloat16(3.0f), bfloat16(0.33333f));
+  VERIFY_IS_EQUAL(float(-bfloat16(4096.0f)), -4096.0f);
+  VERIFY_IS_EQUAL(float(-bfloat16(-4096.0f)), 4096.0f);
+}
+
+void test_comparison()
+{
+  VERIFY(bfloat16(1.0f) > bfloat16(0.5f));
+  VERIFY(bfloat16(0.5f) < bfloat16(1.0f));
+  VERIFY(!(bfloat16(1.0f) < bfloat16(0.5f)));
+  VERIFY(!(bfloat16(0.5f) > bfloat16(1.0f)));
+
+  VERIFY(!(bfloat16(4.0f) > bfloat16(4.0f)));
+  VERIFY(!(bfloat16(4.0f) < bfloat16(4.0f)));
+
+  VERIFY(!(bfloat16(0.0f) < bfloat16(-0.0f)));
+  VERIFY(!(bfloat16(-0.0f) < bfloat16(0.0f)));
+
+  VERIFY(bfloat16(0.2f) > bfloat16(-1.0f));
+  VERIFY(bfloat16(-16.0f) < bfloat16(-15.0f));
+
+  VERIFY(bfloat16(1.0f) == bfloat16(1.0f));
+  VERIFY(bfloat16(1.0f) != bfloat16(2.0f));
+
+  VERIFY(!(NumTraits<bfloat16>::quiet_NaN() == NumTraits<bfloat16>::quiet_NaN()));
+  VERIFY(NumTraits<bfloat16>::quiet_NaN() != NumTraits<bfloat16>::quiet_NaN());
+  VERIFY(bfloat16(1.0f) < NumTraits<bfloat16>::infinity());
+}
+
+void test_basic_functions()
+{
+  VERIFY_IS_EQUAL(float(numext::abs(bfloat16(-3.5f))), 3.5f);
+  VERIFY_IS_EQUAL(float(abs(bfloat16(-3.5f))), 3.5f);
+  VERIFY_IS_EQUAL(float(numext::floor(bfloat16(-3.5f))), -4.0f);
+  VERIFY_IS_EQUAL(float(numext::ceil(bfloat16(-3.5f))), -3.0f);
+  VERIFY_IS_APPROX(numext::sqrt(bfloat16(4.0f)), bfloat16(2.0f));
+  VERIFY_IS_APPROX(numext::pow(bfloat16(2.0f), bfloat16(2.0f)), bfloat16(4.0f));
+  VERIFY_IS_EQUAL(float(numext::exp(bfloat16(0.0f))), 1.0f);
+  VERIFY_IS_APPROX(numext::exp(bfloat16(EIGEN_PI)), bfloat16(20.f + float(EIGEN_PI)));
+  VERIFY_IS_EQUAL(float(numext::log(bfloat16(1.0f))), 0.0f);
+  VERIFY_IS_APPROX(numext::log(bfloat16(10.0f)), bfloat16(2.30273f));
+  VERIFY_IS_APPROX(numext::cos(bfloat16(3.5f)), bfloat16(cosf(3.5f)));
+  VERIFY_IS_APPROX(numext::sin(bfloat16(3.5f)), bfloat16(sinf(3.5f)));
+}
+
+void test_array()
+{
+  typedef Array<bfloat16,1,Dynamic> ArrayXbf;
+  Index size = internal::random<Index>(1,40);
+  Index i = internal::random<Index>(0,size-1);
+  ArrayXbf a1 = ArrayXbf::Random(size), a2 = ArrayXbf::Random(size);
+  VERIFY_IS_APPROX( a1+a1, bfloat16(2)*a1 );
+  VERIFY( (a1.abs() >= bfloat16(0)).all() );
+  VERIFY_IS_APPROX( (a1*a1).sqrt(), a1.abs() );
+
+  VERIFY( ((a1.min)(a2) <= (a1.max)(a2)).all() );
+  a1(i) = bfloat16(-10.);
+  VERIFY_IS_EQUAL( a1.minCoeff(), bfloat16(-10.) );
+  a1(i) = bfloat16(10.);
+  VERIFY_IS_EQUAL( a1.maxCoeff(), bfloat16(10.) );
+
+  // vectorized conversions must round exactly like the scalar ones
+  Array<float,1,Dynamic> f = Array<float,1,Dynamic>::Random(size) * 100.f;
+  ArrayXbf b = f.cast<bfloat16>();
+  for(Index k=0; k<size; ++k)
+    VERIFY_IS_EQUAL(b(k).x, bfloat16(f(k)).x);
+  VERIFY_IS_EQUAL((b.cast<float>() - f).abs().maxCoeff() <= f.abs().maxCoeff() / 128.f, true);
+
+  std::stringstream ss;
+  ss << a1;
+}
+
+template<typename LhsType, typename RhsType>
+void test_product(Index rows, Index cols, Index depth)
+{
+  LhsType Ab = LhsType::Random(rows,depth);
+  RhsType Bb = RhsType::Random(depth,cols);
+  MatrixXbf Cb = MatrixXbf::Random(rows,cols);
+  MatrixXf Af = Ab.template cast<float>();
+  MatrixXf Bf = Bb.template cast<float>();
+  MatrixXf Cf = Cb.cast<float>();
+
+  // the products are accumulated in float and rounded once: the error does not grow with the depth
+  Cf.noalias() += Af*Bf;
+  Cb.noalias() += Ab*Bb;
+  VERIFY_IS_APPROX(Cb, Cf.cast<bfloat16>());
+  VERIFY((Cb.cast<float>()-Cf).cwiseAbs().maxCoeff() <= Cf.cwiseAbs().maxCoeff() / 64.f);
+
+  Cf.noalias() = 2.f * Af*Bf;
+  Cb.noalias() = bfloat16(2) * Ab*Bb;
+  VERIFY_IS_APPROX(Cb, Cf.cast<bfloat16>());
+
+  Matrix<bfloat16,Dynamic,Dynamic,RowMajor> Rb(rows,cols);
+  Rb.noalias() = Ab*Bb;
+  VERIFY_IS_APPROX(Rb, (Af*Bf).cast<bfloat16>());
+}
+
+EIGEN_DECLARE_TEST(bfloat16_float)
+{
+  typedef Matrix<bfloat16,Dynamic,Dynamic,RowMajor> RowMatrixXbf;
+  CALL_SUBTEST(test_numtraits());
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST(test_conversion());
+    CALL_SUBTEST(test_arithmetic());
+    CALL_SUBTEST(test_comparison());
+    CALL_SUBTEST(test_basic_functions());
+    CALL_SUBTEST(test_array());
+    CALL_SUBTEST(( test_product<MatrixXbf,MatrixXbf>(internal::random<Index>(1,EIGEN_TEST_MAX_SIZE), internal::random<Index>(1,EIGEN_TEST_MAX_SIZE), internal::random<Index>(1,EIGEN_TEST_MAX_SIZE)) ));
+    CALL_SUBTEST(( test_product<RowMatrixXbf,MatrixXbf>(internal::random<Index>(1,EIGEN_TEST_MAX_SIZE), internal::random<Index>(1,EIGEN_TEST_MAX_SIZE), internal::random<Index>(1,EIGEN_TEST_MAX_SIZE)) ));
+    CALL_SUBTEST(( test_product<MatrixXbf,RowMatrixXbf>(internal::random<Index>(1,EIGEN_TEST_MAX_SIZE), internal::random<Index>(1,EIGEN_TEST_MAX_SIZE), internal::random<Index>(1,EIGEN_TEST_MAX_SIZE)) ));
+  }
+  // deep products span several blocks along the depth
+  CALL_SUBTEST(( test_product<MatrixXbf,MatrixXbf>(internal::random<Index>(100,300), internal::random<Index>(100,300), internal::random<Index>(1000,2000)) ));
+}
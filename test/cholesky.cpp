@@ -468,6 +468,50 @@ void cholesky_faillure_cases()
   }
 }
 
+// Large LDLT factorizations are computed by panels, with the pivots of the unblocked algorithm
+template<typename MatrixType, int UpLo> void cholesky_ldlt_blocked(Index size)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename MatrixType::RealScalar RealScalar;
+  typedef Matrix<Scalar,MatrixType::RowsAtCompileTime,1> VectorType;
+  MatrixType a = MatrixType::Random(size,size);
+  MatrixType symm = (a + a.adjoint()).eval();
+  symm.diagonal().array() += RealScalar(2*size);
+  symm.topLeftCorner(size/3,size/3).diagonal().array() -= RealScalar(4*size);
+
+  LDLT<MatrixType,UpLo> ldlt(symm);
+  VERIFY_IS_EQUAL(ldlt.info(), Success);
+  VERIFY(!ldlt.isPositive() && !ldlt.isNegative());
+  VERIFY_IS_APPROX(symm, ldlt.reconstructedMatrix());
+  MatrixType b = MatrixType::Random(size, 3);
+  VERIFY_IS_APPROX(symm * ldlt.solve(b), b);
+
+  MatrixType m = symm;
+  Transpositions<MatrixType::RowsAtCompileTime> transpositions(size);
+  VectorType temp(size);
+  internal::SignMatrix sign = internal::ZeroSign;
+  VERIFY(internal::ldlt_inplace<UpLo>::unblocked(m, transpositions, temp, sign));
+  VERIFY_IS_EQUAL(sign, internal::Indefinite);
+  VERIFY(transpositions.indices() == ldlt.transpositionsP().indices());
+  VERIFY_IS_APPROX(m.diagonal(), ldlt.matrixLDLT().diagonal());
+
+  // definite matrices
+  symm = a * a.adjoint() + MatrixType::Identity(size, size);
+  ldlt.compute(symm);
+  VERIFY(ldlt.isPositive());
+  VERIFY_IS_APPROX(symm, ldlt.reconstructedMatrix());
+  ldlt.compute(-symm);
+  VERIFY(ldlt.isNegative());
+  VERIFY_IS_APPROX(MatrixType(-symm), ldlt.reconstructedMatrix());
+
+  // a zero pivot followed by nonzero ones
+  symm.bottomRows(2).setZero();
+  symm.rightCols(2).setZero();
+  symm(size-1,size-2) = symm(size-2,size-1) = Scalar(1);
+  ldlt.compute(symm);
+  VERIFY_IS_EQUAL(ldlt.info(), NumericalIssue);
+}
+
 template<typename MatrixType> void cholesky_verify_assert()
 {
   MatrixType tmp;
@@ -528,5 +572,12 @@ EIGEN_DECLARE_TEST(cholesky)
 
   CALL_SUBTEST_2( cholesky_faillure_cases<void>() );
 
+  s = internal::random<int>(32,(std::max)(EIGEN_TEST_MAX_SIZE,33));
+  CALL_SUBTEST_2(( cholesky_ldlt_blocked<MatrixXd,Lower>(s) ));
+  CALL_SUBTEST_2(( cholesky_ldlt_blocked<MatrixXd,Upper>(s) ));
+  CALL_SUBTEST_6(( cholesky_ldlt_blocked<MatrixXcd,Lower>(s/2+16) ));
+  CALL_SUBTEST_8(( cholesky_ldlt_blocked<Matrix<float,Dynamic,Dynamic,RowMajor>,Upper>(s) ));
+  TEST_SET_BUT_UNUSED_VARIABLE(s)
+
   TEST_SET_BUT_UNUSED_VARIABLE(nb_temporaries)
 }
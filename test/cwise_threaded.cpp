@@ -0,0 +1,88 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#define EIGEN_GEMM_THREADPOOL
+#define EIGEN_PARALLELIZE_CWISE
+#define EIGEN_PARALLEL_CWISE_THREAD_COST 1000
+#define EIGEN_PARALLEL_REDUX_BLOCK_SIZE 1000
+#include "main.h"
+
+// Large coefficient-wise assignments are split among the threads of the pool,
+// check them against the sequential evaluation.
+template<typename MatrixType>
+void cwise_threaded(Index rows, Index cols)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Array<Scalar,Dynamic,Dynamic> ColArray;
+  typedef Matrix<Scalar,Dynamic,1> VectorType;
+  ThreadPoolInterface* pool = getGemmThreadPool();
+
+  MatrixType a = MatrixType::Random(rows,cols);
+  MatrixType b = MatrixType::Random(rows,cols);
+  ColArray c = ColArray::Random(rows,cols);
+  VectorType v = VectorType::Random(rows*cols);
+
+  MatrixType ref1, ref2, ref3;
+  VectorType vref;
+  ColArray aref;
+  Scalar sum, prod, squaredNorm;
+  typename NumTraits<Scalar>::Real maxAbs;
+  {
+    setGemmThreadPool(0);
+    ref1 = a + b;
+    ref2 = (a.array().abs2() * c + c).matrix();
+    ref3 = a.transpose().transpose() - b;
+    vref = v * Scalar(2);
+    aref = c;
+    aref.block(1,1,rows-2,cols-2) += a.array().block(1,1,rows-2,cols-2);
+    sum = a.sum();
+    prod = (a.array()*Scalar(0.01)+Scalar(1)).prod();
+    squaredNorm = v.squaredNorm();
+    maxAbs = a.cwiseAbs().maxCoeff();
+    setGemmThreadPool(pool);
+  }
+
+  MatrixType d;
+  d = a + b;
+  VERIFY_IS_EQUAL(d, ref1);
+  d = (a.array().abs2() * c + c).matrix();
+  VERIFY_IS_EQUAL(d, ref2);
+  d = a.transpose().transpose() - b;
+  VERIFY_IS_EQUAL(d, ref3);
+  VectorType w = v * Scalar(2);
+  VERIFY_IS_EQUAL(w, vref);
+  ColArray e = c;
+  e.block(1,1,rows-2,cols-2) += a.array().block(1,1,rows-2,cols-2);
+  VERIFY_IS_EQUAL(e.matrix(), aref.matrix());
+
+  // reductions are split into blocks which do not depend on the number of threads
+  VERIFY_IS_EQUAL(a.sum(), sum);
+  VERIFY_IS_EQUAL((a.array()*Scalar(0.01)+Scalar(1)).prod(), prod);
+  VERIFY_IS_EQUAL(v.squaredNorm(), squaredNorm);
+  VERIFY_IS_EQUAL(a.cwiseAbs().maxCoeff(), maxAbs);
+  VERIFY_IS_APPROX(a.sum(), a.colwise().sum().sum());
+  VERIFY_IS_APPROX(v.squaredNorm(), v.cwiseAbs2().eval().colwise().sum()(0));
+  VERIFY_IS_APPROX(a.block(1,1,rows-2,cols-2).sum(), a.block(1,1,rows-2,cols-2).eval().sum());
+  VERIFY_IS_EQUAL(a.cwiseAbs().maxCoeff(), a.cwiseAbs().colwise().maxCoeff().maxCoeff());
+}
+
+EIGEN_DECLARE_TEST(cwise_threaded)
+{
+  ThreadPool pool(4);
+  setGemmThreadPool(&pool);
+
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1(( cwise_threaded<MatrixXf>(internal::random<int>(3,500), internal::random<int>(3,500)) ));
+    CALL_SUBTEST_2(( cwise_threaded<Matrix<double,Dynamic,Dynamic,RowMajor> >(internal::random<int>(3,500), internal::random<int>(3,500)) ));
+    CALL_SUBTEST_3(( cwise_threaded<MatrixXcd>(internal::random<int>(3,200), internal::random<int>(3,200)) ));
+    CALL_SUBTEST_4(( cwise_threaded<MatrixXi>(internal::random<int>(3,500), internal::random<int>(3,500)) ));
+  }
+
+  setNbThreads(2);
+  CALL_SUBTEST_1(( cwise_threaded<MatrixXf>(300, 300) ));
+  setGemmThreadPool(0);
+}
@@ -190,6 +190,129 @@ template<typename MatrixType> void selfadjointeigensolver(const MatrixType& m)
   }
 }
 
+// large dynamic-size matrices are reduced to tridiagonal form by panels
+template<typename MatrixType> void tridiagonalization_blocked(Index size)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,1> CoeffVectorType;
+
+  MatrixType a = MatrixType::Random(size,size);
+  MatrixType symmA = a.adjoint() * a;
+
+  Tridiagonalization<MatrixType> tridiag(symmA);
+  MatrixType Q = tridiag.matrixQ();
+  VERIFY_IS_UNITARY(Q);
+  VERIFY_IS_APPROX(symmA, Q * tridiag.matrixT() * Q.adjoint());
+
+  // the blocked reduction must match the unblocked one
+  MatrixType packed = symmA;
+  CoeffVectorType hCoeffs(size-1);
+  internal::tridiagonalization_inplace_unblocked(packed, hCoeffs);
+  VERIFY_IS_APPROX(tridiag.householderCoefficients(), hCoeffs);
+  VERIFY_IS_APPROX(MatrixType(tridiag.packedMatrix().template triangularView<Lower>()),
+                   MatrixType(packed.template triangularView<Lower>()));
+  VERIFY_IS_EQUAL(MatrixType(tridiag.packedMatrix().template triangularView<StrictlyUpper>()),
+                  MatrixType(symmA.template triangularView<StrictlyUpper>()));
+
+  SelfAdjointEigenSolver<MatrixType> eiSymm(symmA);
+  VERIFY_IS_EQUAL(eiSymm.info(), Success);
+  VERIFY_IS_APPROX(symmA * eiSymm.eigenvectors(), eiSymm.eigenvectors() * eiSymm.eigenvalues().asDiagonal());
+}
+
+// large matrices are solved by divide-and-conquer, check it on matrices with many deflated eigenvalues as well
+template<typename MatrixType> void selfadjointeigensolver_divide_and_conquer(Index size)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef Matrix<RealScalar,Dynamic,1> RealVectorType;
+
+  MatrixType a = MatrixType::Random(size,size);
+  MatrixType symmA = a.adjoint() * a;
+  selfadjointeigensolver_essential_check(symmA);
+  selfadjointeigensolver_essential_check(MatrixType(MatrixType::Identity(size,size)));
+
+  // a few distinct eigenvalues of high multiplicity
+  MatrixType q = HouseholderQR<MatrixType>(a).householderQ();
+  RealVectorType d(size);
+  for(Index i=0; i<size; ++i)
+    d(i) = RealScalar(i%3);
+  MatrixType b = q * d.template cast<Scalar>().asDiagonal() * q.adjoint();
+  selfadjointeigensolver_essential_check(b);
+
+  // tridiagonal matrices
+  RealVectorType diag = RealVectorType::Random(size), subdiag = RealVectorType::Random(size-1);
+  subdiag.segment(size/3, size/4).setZero();
+  MatrixType t = MatrixType::Zero(size,size);
+  t.diagonal() = diag.template cast<Scalar>();
+  t.template diagonal<-1>() = subdiag.template cast<Scalar>();
+  t.template diagonal<1>() = subdiag.template cast<Scalar>();
+  SelfAdjointEigenSolver<MatrixType> eig, eigValues;
+  eig.computeFromTridiagonal(diag, subdiag);
+  eigValues.computeFromTridiagonal(diag, subdiag, EigenvaluesOnly);
+  VERIFY_IS_EQUAL(eig.info(), Success);
+  VERIFY_IS_APPROX(eig.eigenvalues(), eigValues.eigenvalues());
+  VERIFY_IS_APPROX(t * eig.eigenvectors(), eig.eigenvectors() * eig.eigenvalues().asDiagonal());
+  VERIFY_IS_UNITARY(eig.eigenvectors());
+}
+
+// selected eigenpairs, by indices and by values
+template<typename MatrixType> void selfadjointeigensolver_range_check(const MatrixType& m)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef Matrix<RealScalar,Dynamic,1> RealVectorType;
+  Index n = m.rows();
+  RealScalar tol = test_precision<RealScalar>() * m.norm();
+
+  SelfAdjointEigenSolver<MatrixType> ref(m);
+  Index count = internal::random<Index>(0,n);
+  Index first = internal::random<Index>(0,n-count);
+  RealVectorType refValues = ref.eigenvalues().segment(first,count);
+
+  SelfAdjointEigenSolver<MatrixType> eig;
+  eig.computeIndexRange(m, first, count);
+  VERIFY_IS_EQUAL(eig.info(), Success);
+  VERIFY_IS_EQUAL(eig.eigenvalues().size(), count);
+  VERIFY_IS_EQUAL(eig.eigenvectors().cols(), count);
+  VERIFY((eig.eigenvalues() - refValues).norm() <= tol);
+  VERIFY((m * eig.eigenvectors() - eig.eigenvectors() * eig.eigenvalues().asDiagonal()).norm() <= tol);
+  VERIFY_IS_APPROX(eig.eigenvectors().adjoint() * eig.eigenvectors(), MatrixType::Identity(count,count));
+
+  // the k largest eigenvalues
+  Index k = (std::min)(n, Index(5));
+  eig.computeIndexRange(m, n-k, k, EigenvaluesOnly);
+  VERIFY_IS_EQUAL(eig.info(), Success);
+  VERIFY((eig.eigenvalues() - ref.eigenvalues().tail(k)).norm() <= tol);
+
+  // the eigenvalues in an interval whose bounds lie between eigenvalues
+  const RealVectorType& values = ref.eigenvalues();
+  RealScalar lower = first==0 ? values(0) - RealScalar(1) : (values(first-1) + values(first)) / RealScalar(2);
+  RealScalar upper = lower;
+  if(count>0)
+    upper = first+count==n ? values(n-1) + RealScalar(1) : (values(first+count-1) + values(first+count)) / RealScalar(2);
+  if(count>0 && ((first>0 && values(first)-values(first-1)<=tol) || (first+count<n && values(first+count)-values(first+count-1)<=tol)))
+    return;
+  eig.computeValueRange(m, lower, upper);
+  VERIFY_IS_EQUAL(eig.info(), Success);
+  VERIFY_IS_EQUAL(eig.eigenvalues().size(), count);
+  VERIFY((eig.eigenvalues() - refValues).norm() <= tol);
+  VERIFY((m * eig.eigenvectors() - eig.eigenvectors() * eig.eigenvalues().asDiagonal()).norm() <= tol);
+}
+
+template<typename MatrixType> void selfadjointeigensolver_range(Index size)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  MatrixType a = MatrixType::Random(size,size);
+  selfadjointeigensolver_range_check(MatrixType(a + a.adjoint()));
+
+  // clusters of eigenvectors
+  MatrixType q = HouseholderQR<MatrixType>(a).householderQ();
+  Matrix<Scalar,Dynamic,1> d(size);
+  for(Index i=0; i<size; ++i)
+    d(i) = Scalar(i%4);
+  selfadjointeigensolver_range_check(MatrixType(q * d.asDiagonal() * q.adjoint()));
+}
+
 template<int>
 void bug_854()
 {
@@ -249,6 +372,8 @@ EIGEN_DECLARE_TEST(eigensolver_selfadjoint)
     CALL_SUBTEST_4( selfadjointeigensolver(MatrixXd(s,s)) );
     CALL_SUBTEST_5( selfadjointeigensolver(MatrixXcd(s,s)) );
     CALL_SUBTEST_9( selfadjointeigensolver(Matrix<std::complex<double>,Dynamic,Dynamic,RowMajor>(s,s)) );
+    CALL_SUBTEST_16( selfadjointeigensolver_range<MatrixXd>(s) );
+    CALL_SUBTEST_16( selfadjointeigensolver_range<MatrixXcf>(s) );
     TEST_SET_BUT_UNUSED_VARIABLE(s)
 
     // some trivial but implementation-wise tricky cases
@@ -258,6 +383,15 @@ EIGEN_DECLARE_TEST(eigensolver_selfadjoint)
     CALL_SUBTEST_7( selfadjointeigensolver(Matrix<double,2,2>()) );
   }
   
+  s = internal::random<int>(256,320);
+  CALL_SUBTEST_10(( tridiagonalization_blocked<MatrixXd>(s) ));
+  CALL_SUBTEST_11(( tridiagonalization_blocked<Matrix<std::complex<float>,Dynamic,Dynamic,RowMajor> >(s) ));
+
+  s = internal::random<int>(128,320);
+  CALL_SUBTEST_14(( selfadjointeigensolver_divide_and_conquer<MatrixXd>(s) ));
+  CALL_SUBTEST_15(( selfadjointeigensolver_divide_and_conquer<Matrix<std::complex<float>,Dynamic,Dynamic,RowMajor> >(s) ));
+  CALL_SUBTEST_16(( selfadjointeigensolver_range<MatrixXd>(s) ));
+
   CALL_SUBTEST_13( bug_854<0>() );
   CALL_SUBTEST_13( bug_1014<0>() );
   CALL_SUBTEST_13( bug_1204<0>() );
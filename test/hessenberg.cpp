@@ -49,6 +49,26 @@ template<typename Scalar,int Size> void hessenberg(int size = Size)
   // TODO: Add tests for packedMatrix() and householderCoefficients()
 }
 
+// large dynamic-size matrices are reduced to Hessenberg form by panels
+template<typename MatrixType> void hessenberg_blocked(Index size)
+{
+  MatrixType m = MatrixType::Random(size,size);
+  HessenbergDecomposition<MatrixType> hess(m);
+  MatrixType Q = hess.matrixQ();
+  MatrixType H = hess.matrixH();
+  VERIFY_IS_UNITARY(Q);
+  VERIFY_IS_APPROX(m, Q * H * Q.adjoint());
+  VERIFY_IS_APPROX(H.template diagonal<-1>(), hess.packedMatrix().template diagonal<-1>());
+  VERIFY_IS_EQUAL(MatrixType(H.template triangularView<Upper>()), MatrixType(hess.packedMatrix().template triangularView<Upper>()));
+
+  // the Schur decomposition starts from the blocked Hessenberg reduction
+  typedef typename ComplexSchur<MatrixType>::ComplexMatrixType ComplexMatrixType;
+  ComplexSchur<MatrixType> schur(m);
+  VERIFY_IS_EQUAL(schur.info(), Success);
+  ComplexMatrixType mc = m.template cast<typename ComplexMatrixType::Scalar>();
+  VERIFY_IS_APPROX(mc, schur.matrixU() * schur.matrixT() * schur.matrixU().adjoint());
+}
+
 EIGEN_DECLARE_TEST(hessenberg)
 {
   CALL_SUBTEST_1(( hessenberg<std::complex<double>,1>() ));
@@ -57,6 +77,9 @@ EIGEN_DECLARE_TEST(hessenberg)
   CALL_SUBTEST_4(( hessenberg<float,Dynamic>(internal::random<int>(1,EIGEN_TEST_MAX_SIZE)) ));
   CALL_SUBTEST_5(( hessenberg<std::complex<double>,Dynamic>(internal::random<int>(1,EIGEN_TEST_MAX_SIZE)) ));
 
+  CALL_SUBTEST_7(( hessenberg_blocked<MatrixXd>(internal::random<int>(128,320)) ));
+  CALL_SUBTEST_8(( hessenberg_blocked<Matrix<std::complex<float>,Dynamic,Dynamic,RowMajor> >(internal::random<int>(128,320)) ));
+
   // Test problem size constructors
   CALL_SUBTEST_6(HessenbergDecomposition<MatrixXf>(10));
 }
@@ -46,7 +46,7 @@
 #include <list>
 #if __cplusplus >= 201103L
 #include <random>
-#ifdef EIGEN_USE_THREADS
+#if defined(EIGEN_USE_THREADS) || defined(EIGEN_GEMM_THREADPOOL)
 #include <future>
 #endif
 #endif
@@ -435,6 +435,7 @@ EIGEN_TEST_SCALAR_TEST_OVERLOAD(unsigned long long)
 EIGEN_TEST_SCALAR_TEST_OVERLOAD(float)
 EIGEN_TEST_SCALAR_TEST_OVERLOAD(double)
 EIGEN_TEST_SCALAR_TEST_OVERLOAD(half)
+EIGEN_TEST_SCALAR_TEST_OVERLOAD(bfloat16)
 
 #undef EIGEN_TEST_SCALAR_TEST_OVERLOAD
 
@@ -0,0 +1,91 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "main.h"
+
+template<typename MatrixType>
+void packed_matrix(Index rows, Index depth, Index cols)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> ColMatrix;
+  typedef Matrix<Scalar,Dynamic,Dynamic,RowMajor> RowMatrix;
+
+  MatrixType a = MatrixType::Random(rows,depth);
+  ColMatrix b = ColMatrix::Random(depth,cols);
+  RowMatrix bt = b.transpose();
+  ColMatrix ref = a * b;
+
+  // packed left-hand side
+  PackedMatrix<Scalar,OnTheLeft> pa(a);
+  VERIFY_IS_EQUAL(pa.rows(), rows);
+  VERIFY_IS_EQUAL(pa.cols(), depth);
+
+  ColMatrix c(rows,cols);
+  c.noalias() = pa * b;
+  VERIFY_IS_APPROX(c, ref);
+  c = pa * b;
+  VERIFY_IS_APPROX(c, ref);
+  c.noalias() += pa * b;
+  VERIFY_IS_APPROX(c, Scalar(2)*ref);
+  c.noalias() -= pa * bt.transpose();
+  VERIFY_IS_APPROX(c, ref);
+
+  RowMatrix r(rows,cols);
+  r.noalias() = pa * b;
+  VERIFY_IS_APPROX(r, ref);
+
+  // sub-matrix destination and right-hand side
+  ColMatrix big = ColMatrix::Zero(rows+3,cols+2);
+  big.block(1,2,rows,cols).noalias() = pa * b;
+  VERIFY_IS_APPROX(big.block(1,2,rows,cols), ref);
+  VERIFY_IS_EQUAL(big.leftCols(2).norm() + big.topRows(1).norm(), 0);
+
+  Matrix<Scalar,Dynamic,1> v = Matrix<Scalar,Dynamic,1>::Random(depth);
+  VERIFY_IS_APPROX((pa * v).eval(), (a * v).eval());
+  VERIFY_IS_APPROX((pa * b).sum(), ref.sum());
+
+  // packed right-hand side
+  PackedMatrix<Scalar,OnTheRight> pbt(a.transpose());
+  ColMatrix ct(cols,rows);
+  ct.noalias() = bt * pbt;
+  VERIFY_IS_APPROX(ct, ref.transpose());
+  ct.noalias() -= b.transpose() * pbt;
+  VERIFY_IS_MUCH_SMALLER_THAN(ct.norm(), ref.norm());
+  RowMatrix rt(cols,rows);
+  rt = bt * pbt;
+  VERIFY_IS_APPROX(rt, ref.transpose());
+
+  // repacking with another matrix
+  MatrixType a2 = MatrixType::Random(cols,depth);
+  pa.compute(a2, rows);
+  c.resize(cols,cols);
+  c.noalias() = pa * b;
+  VERIFY_IS_APPROX(c, (a2*b).eval());
+}
+
+template<int>
+void packed_matrix_small_blocks()
+{
+  // make sure the packed matrices are split into several blocks along all dimensions
+  std::ptrdiff_t l1 = l1CacheSize(), l2 = l2CacheSize(), l3 = l3CacheSize();
+  setCpuCacheSizes(2048, 8192, 16384);
+  CALL_SUBTEST(( packed_matrix<MatrixXf>(internal::random<int>(100,300), internal::random<int>(100,300), internal::random<int>(100,300)) ));
+  CALL_SUBTEST(( packed_matrix<MatrixXd>(internal::random<int>(100,300), internal::random<int>(100,300), internal::random<int>(100,300)) ));
+  setCpuCacheSizes(l1, l2, l3);
+}
+
+EIGEN_DECLARE_TEST(packed_matrix)
+{
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1(( packed_matrix<MatrixXf>(internal::random<int>(1,300), internal::random<int>(1,300), internal::random<int>(1,300)) ));
+    CALL_SUBTEST_2(( packed_matrix<MatrixXd>(internal::random<int>(1,300), internal::random<int>(1,300), internal::random<int>(1,300)) ));
+    CALL_SUBTEST_3(( packed_matrix<Matrix<float,Dynamic,Dynamic,RowMajor> >(internal::random<int>(1,300), internal::random<int>(1,300), internal::random<int>(1,300)) ));
+    CALL_SUBTEST_4(( packed_matrix<MatrixXcf>(internal::random<int>(1,150), internal::random<int>(1,150), internal::random<int>(1,150)) ));
+    CALL_SUBTEST_5(( packed_matrix_small_blocks<0>() ));
+  }
+  CALL_SUBTEST_1(( packed_matrix<MatrixXf>(1000, 600, 500) ));
+}
@@ -56,6 +56,7 @@ T apply_bit_op(Bits a, Bits b, Func f) {
   EIGEN_TEST_MAKE_BITWISE2(OP,FUNC,float)                 \
   EIGEN_TEST_MAKE_BITWISE2(OP,FUNC,double)                \
   EIGEN_TEST_MAKE_BITWISE2(OP,FUNC,half)                  \
+  EIGEN_TEST_MAKE_BITWISE2(OP,FUNC,bfloat16)              \
   EIGEN_TEST_MAKE_BITWISE2(OP,FUNC,std::complex<float>)   \
   EIGEN_TEST_MAKE_BITWISE2(OP,FUNC,std::complex<double>)
 
@@ -95,6 +96,11 @@ template<typename Scalar> bool areApproxAbs(const Scalar* a, const Scalar* b, in
   return true;
 }
 
+// The reference reductions of bfloat16 values are accumulated in float, otherwise the rounding errors of
+// the sequential bfloat16 sums exceed the tolerance of areApproxAbs.
+template<typename Scalar> struct reference_accumulator { typedef Scalar type; };
+template<> struct reference_accumulator<bfloat16> { typedef float type; };
+
 template<typename Scalar> bool areApprox(const Scalar* a, const Scalar* b, int size)
 {
   for (int i=0; i<size; ++i)
@@ -367,9 +373,11 @@ template<typename Scalar,typename Packet> void packetmath()
     }
   }
 
-  ref[0] = Scalar(0);
+  typedef typename reference_accumulator<Scalar>::type Accumulator;
+  Accumulator acc = Accumulator(0);
   for (int i=0; i<PacketSize; ++i)
-    ref[0] += data1[i];
+    acc += Accumulator(data1[i]);
+  ref[0] = Scalar(acc);
   VERIFY(isApproxAbs(ref[0], internal::predux(internal::pload<Packet>(data1)), refvalue) && "internal::predux");
 
   if(PacketSize==8 && internal::unpacket_traits<typename internal::unpacket_traits<Packet>::half>::size ==4) // so far, predux_half_downto4 is only required in such a case
@@ -392,9 +400,10 @@ template<typename Scalar,typename Packet> void packetmath()
   {
     for (int j=0; j<PacketSize; ++j)
     {
-      ref[j] = Scalar(0);
+      acc = Accumulator(0);
       for (int i=0; i<PacketSize; ++i)
-        ref[j] += data1[i+j*PacketSize];
+        acc += Accumulator(data1[i+j*PacketSize]);
+      ref[j] = Scalar(acc);
       packets[j] = internal::pload<Packet>(data1+j*PacketSize);
     }
     internal::pstore(data2, internal::preduxp(packets));
@@ -966,8 +975,26 @@ struct runner<Scalar,PacketType,false,false>
   }
 };
 
+void simd_instruction_sets()
+{
+  // the instruction sets this test has been compiled for are necessarily supported by the CPU running it
+  VERIFY(SimdInstructionSetsInUseAreSupported());
+  int supported = internal::querySimdInstructionSets();
+  int used = internal::compiledSimdInstructionSets();
+  if(supported!=-1)
+  {
+    VERIFY_IS_EQUAL(used & ~supported, 0);
+    VERIFY(SimdInstructionSetsSupported().find(internal::simdInstructionSetsToString((used & internal::SimdAVX2) ? int(internal::SimdAVX2) : int(internal::SimdSSE2))) != std::string::npos
+        || used==0);
+  }
+  VERIFY(!SimdInstructionSetsSupported().empty());
+  VERIFY_IS_EQUAL(internal::simdInstructionSetsToString(0), std::string("None"));
+  VERIFY_IS_EQUAL(internal::simdInstructionSetsToString(internal::SimdSSE|internal::SimdAVX2), std::string("SSE, AVX2"));
+}
+
 EIGEN_DECLARE_TEST(packetmath)
 {
+  CALL_SUBTEST_1( simd_instruction_sets() );
   g_first_pass = true;
   for(int i = 0; i < g_repeat; i++) {
 
@@ -977,6 +1004,7 @@ EIGEN_DECLARE_TEST(packetmath)
     CALL_SUBTEST_4( runner<std::complex<float> >::run() );
     CALL_SUBTEST_5( runner<std::complex<double> >::run() );
     CALL_SUBTEST_6(( packetmath<half,internal::packet_traits<half>::type>() ));
+    CALL_SUBTEST_7(( packetmath<bfloat16,internal::packet_traits<bfloat16>::type>() ));
     g_first_pass = false;
   }
 }
@@ -0,0 +1,111 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "main.h"
+
+template<typename Scalar>
+struct relu_op {
+  Scalar operator()(const Scalar& x) const { return numext::maxi(x, Scalar(0)); }
+};
+
+// Coefficient-wise operations applied to a matrix-matrix product are fused into the product,
+// check them against the evaluation of the product into a temporary.
+template<typename Scalar, int DstOptions, int LhsOptions>
+void product_epilogue(Index rows, Index depth, Index cols)
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic,LhsOptions> LhsType;
+  typedef Matrix<Scalar,Dynamic,Dynamic> RhsType;
+  typedef Matrix<Scalar,Dynamic,Dynamic,DstOptions> DstType;
+  typedef Matrix<Scalar,Dynamic,1> ColVectorType;
+  typedef Matrix<Scalar,1,Dynamic> RowVectorType;
+  typedef Array<Scalar,Dynamic,Dynamic,DstOptions> DstArrayType;
+
+  LhsType a = LhsType::Random(rows, depth);
+  RhsType b = RhsType::Random(depth, cols);
+  RowVectorType bias = RowVectorType::Random(cols);
+  ColVectorType colBias = ColVectorType::Random(rows);
+  DstType other = DstType::Random(rows, cols);
+  Scalar s = internal::random<Scalar>();
+
+  DstType prod = a * b;
+  DstType ref = prod;
+  ref.rowwise() += bias;
+  DstType relu = ref.unaryExpr(relu_op<Scalar>());
+
+  DstType c;
+  c.noalias() = (a * b).rowwise() + bias;
+  VERIFY_IS_APPROX(c, ref);
+  c.noalias() = ((a * b).rowwise() + bias).unaryExpr(relu_op<Scalar>());
+  VERIFY_IS_APPROX(c, relu);
+  c.noalias() = ((a * b).rowwise() + bias).cwiseMax(Scalar(0));
+  VERIFY_IS_APPROX(c, relu);
+  c = ((a * b).rowwise() + bias).cwiseMax(Scalar(0));
+  VERIFY_IS_APPROX(c, relu);
+  c.noalias() = (((a * b).array().rowwise() + bias.array()).max)(Scalar(0)).matrix();
+  VERIFY_IS_APPROX(c, relu);
+
+  c.noalias() = (a * b).colwise() - colBias;
+  VERIFY_IS_APPROX(c, (prod.colwise() - colBias).eval());
+  c.noalias() = s * ((a * b) + other);
+  VERIFY_IS_APPROX(c, (s * (prod + other)).eval());
+  c.noalias() = other.cwiseProduct(a * b + other) - other;
+  VERIFY_IS_APPROX(c, (other.cwiseProduct(prod + other) - other).eval());
+  c.noalias() = (a * b) * s;
+  VERIFY_IS_APPROX(c, (prod * s).eval());
+
+  DstArrayType d;
+  d = (((a * b).array().colwise() + colBias.array()).min)(Scalar(1));
+  VERIFY_IS_APPROX(d.matrix(), (prod.colwise() + colBias).cwiseMin(Scalar(1)).eval());
+
+  // sub-blocks of the destination
+  DstType e = DstType::Random(rows+3, cols+2), e0 = e;
+  e.block(1, 2, rows, cols).noalias() = ((a * b).rowwise() + bias).unaryExpr(relu_op<Scalar>());
+  e0.block(1, 2, rows, cols) = relu;
+  VERIFY_IS_APPROX(e, e0);
+
+  // the destination is read by the epilogue
+  c = other;
+  c.noalias() = (a * b) + c;
+  VERIFY_IS_APPROX(c, (prod + other).eval());
+  c = other;
+  c.noalias() = ((a * b).array() * c.array()).matrix().cwiseMax(Scalar(0));
+  VERIFY_IS_APPROX(c, prod.cwiseProduct(other).cwiseMax(Scalar(0)).eval());
+  c = other;
+  c = (c * c.transpose()).cwiseMax(Scalar(0));
+  VERIFY_IS_APPROX(c, (other * other.transpose()).cwiseMax(Scalar(0)).eval());
+}
+
+template<int>
+void product_epilogue_blocking()
+{
+  // several blocks along all dimensions
+  std::ptrdiff_t l1 = l1CacheSize(), l2 = l2CacheSize(), l3 = l3CacheSize();
+  setCpuCacheSizes(2048, 8192, 16384);
+  CALL_SUBTEST(( product_epilogue<float,ColMajor,ColMajor>(internal::random<int>(100,300), internal::random<int>(100,300), internal::random<int>(100,300)) ));
+  CALL_SUBTEST(( product_epilogue<double,RowMajor,ColMajor>(internal::random<int>(100,300), internal::random<int>(100,300), internal::random<int>(100,300)) ));
+  setCpuCacheSizes(l1, l2, l3);
+
+  // empty products
+  Matrix<float,Dynamic,Dynamic> c;
+  c.noalias() = (MatrixXf(3,0) * MatrixXf(0,4)).rowwise() + RowVectorXf::Ones(4);
+  VERIFY_IS_APPROX(c, MatrixXf::Ones(3,4));
+  c.noalias() = (MatrixXf(0,3) * MatrixXf(3,4)).rowwise() + RowVectorXf::Ones(4);
+  VERIFY_IS_EQUAL(c.rows(), 0);
+}
+
+EIGEN_DECLARE_TEST(product_epilogue)
+{
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1(( product_epilogue<float,ColMajor,ColMajor>(internal::random<int>(1,EIGEN_TEST_MAX_SIZE), internal::random<int>(1,EIGEN_TEST_MAX_SIZE), internal::random<int>(1,EIGEN_TEST_MAX_SIZE)) ));
+    CALL_SUBTEST_2(( product_epilogue<double,RowMajor,ColMajor>(internal::random<int>(1,EIGEN_TEST_MAX_SIZE), internal::random<int>(1,EIGEN_TEST_MAX_SIZE), internal::random<int>(1,EIGEN_TEST_MAX_SIZE)) ));
+    CALL_SUBTEST_3(( product_epilogue<double,ColMajor,RowMajor>(internal::random<int>(1,EIGEN_TEST_MAX_SIZE), internal::random<int>(1,EIGEN_TEST_MAX_SIZE), internal::random<int>(1,EIGEN_TEST_MAX_SIZE)) ));
+    CALL_SUBTEST_4(( product_epilogue<float,RowMajor,RowMajor>(internal::random<int>(1,10), internal::random<int>(1,10), internal::random<int>(1,10)) ));
+    CALL_SUBTEST_4(( product_epilogue<float,ColMajor,ColMajor>(1, internal::random<int>(1,100), internal::random<int>(1,100)) ));
+    CALL_SUBTEST_4(( product_epilogue<float,ColMajor,ColMajor>(internal::random<int>(1,100), internal::random<int>(1,100), 1) ));
+  }
+  CALL_SUBTEST_5( product_epilogue_blocking<0>() );
+}
@@ -91,6 +91,16 @@ template<typename MatrixType> void product_notemporary(const MatrixType& m)
   VERIFY_EVALUATION_COUNT( m3.noalias() += m3 - m1 * m2.transpose(), 0);
   VERIFY_EVALUATION_COUNT( m3.noalias() -= m3 - m1 * m2.transpose(), 0);
 
+  // Coefficient-wise operations on the result of a product are fused into the product
+  VERIFY_EVALUATION_COUNT( m3.noalias() = (m1 * m2.adjoint()).rowwise() + rv1, 0);
+  VERIFY_EVALUATION_COUNT( m3.noalias() = s1 * ((m1 * m2.adjoint()).colwise() - cv1), 0);
+  VERIFY_EVALUATION_COUNT( m3.noalias() = ((m1 * m2.adjoint()) + m2).cwiseProduct(m1), 0);
+  VERIFY_EVALUATION_COUNT( m3.noalias() = ((m1 * m2.adjoint()).array() * m1.array()).matrix(), 0);
+  VERIFY_EVALUATION_COUNT( rm3.noalias() = -((m1 * m2.adjoint()).rowwise() + rv1), 0);
+  VERIFY_EVALUATION_COUNT( m3 = (m1 * m2.adjoint()).rowwise() + rv1, 1);
+  // ... unless the destination is one of the other operands
+  VERIFY_EVALUATION_COUNT( m3.noalias() = (m1 * m2.adjoint()) + m3, 1);
+
   VERIFY_EVALUATION_COUNT( m3.noalias() = s1 * m1 * s2 * m2.adjoint(), 0);
   VERIFY_EVALUATION_COUNT( m3.noalias() = s1 * m1 * s2 * (m1*s3+m2*s2).adjoint(), 1);
   VERIFY_EVALUATION_COUNT( m3.noalias() = (s1 * m1).adjoint() * s2 * m2, 0);
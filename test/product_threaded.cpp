@@ -0,0 +1,190 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#define EIGEN_GEMM_THREADPOOL
+#include "main.h"
+#include <Eigen/Eigenvalues>
+#include <Eigen/SVD>
+
+template<typename MatrixType>
+void product_threaded(Index rows, Index cols, Index depth)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> ColMatrix;
+  MatrixType a = MatrixType::Random(rows,depth);
+  MatrixType b = MatrixType::Random(depth,cols);
+  MatrixType c(rows,cols);
+
+  // reference computed sequentially
+  ColMatrix ref;
+  {
+    ThreadPoolInterface* previous = setGemmThreadPool(0);
+    ref.noalias() = a * b;
+    setGemmThreadPool(previous);
+  }
+
+  c.noalias() = a * b;
+  VERIFY_IS_APPROX(c, ref);
+
+  c.setOnes();
+  c.noalias() += a * b;
+  VERIFY_IS_APPROX(c, (ref.array()+Scalar(1)).matrix());
+
+  // transposed products exercise the row-major path of parallelize_gemm
+  ColMatrix ct(cols,rows);
+  ct.noalias() = b.transpose() * a.transpose();
+  VERIFY_IS_APPROX(ct, ref.transpose());
+
+  // fused epilogues are applied by each thread to its own blocks
+  Matrix<Scalar,1,Dynamic> bias = Matrix<Scalar,1,Dynamic>::Random(cols);
+  c.noalias() = -((a * b).rowwise() + bias);
+  VERIFY_IS_APPROX(c, (-(ref.rowwise() + bias)).eval());
+}
+
+// Products issued from within the pool's own threads must neither deadlock nor run serially.
+void product_threaded_nested(ThreadPool& pool)
+{
+  const int n = 4;
+  std::vector<MatrixXf> a(n), b(n), c(n);
+  for(int i=0; i<n; ++i)
+  {
+    a[i] = MatrixXf::Random(300,200);
+    b[i] = MatrixXf::Random(200,250);
+  }
+  Barrier barrier(n);
+  for(int i=0; i<n; ++i)
+    pool.Schedule([&,i]() { c[i].noalias() = a[i] * b[i]; barrier.Notify(); });
+  barrier.Wait();
+
+  setGemmThreadPool(0);
+  for(int i=0; i<n; ++i)
+    VERIFY_IS_APPROX(c[i], (a[i]*b[i]).eval());
+  setGemmThreadPool(&pool);
+}
+
+// Large batches of small products are split among the threads of the pool.
+void product_threaded_batched()
+{
+  typedef std::vector<Matrix3f,aligned_allocator<Matrix3f> > Batch;
+  const Index n = 100003;
+  Batch a(n), b(n), c(n);
+  for(Index i=0; i<n; ++i)
+  {
+    a[i].setRandom();
+    b[i].setRandom();
+  }
+  batched_product(a.data(), b.data(), c.data(), n);
+  for(Index i=0; i<n; ++i)
+    VERIFY_IS_APPROX(c[i], (a[i]*b[i]).eval());
+}
+
+// Products with a pre-packed operand are split among the threads of the pool.
+void product_threaded_packed(Index rows, Index depth, Index cols)
+{
+  MatrixXf a = MatrixXf::Random(rows,depth);
+  MatrixXf b = MatrixXf::Random(depth,cols);
+  PackedMatrix<float,OnTheLeft> pa(a);
+  PackedMatrix<float,OnTheRight> pb(b);
+  MatrixXf c(rows,cols);
+  c.noalias() = pa * b;
+  VERIFY_IS_APPROX(c, (a*b).eval());
+  c.noalias() = a * pb;
+  VERIFY_IS_APPROX(c, (a*b).eval());
+}
+
+// Quantized products are split into tiles among the threads of the pool.
+void product_threaded_quantized(Index rows, Index depth, Index cols)
+{
+  Matrix<unsigned char,Dynamic,Dynamic> a = Matrix<unsigned char,Dynamic,Dynamic>::Random(rows,depth);
+  Matrix<signed char,Dynamic,Dynamic> b = Matrix<signed char,Dynamic,Dynamic>::Random(depth,cols);
+  MatrixXi c;
+  quantized_product(a, b, c);
+  VERIFY_IS_EQUAL(c, (a.cast<int>() * b.cast<int>()).eval());
+}
+
+// The subproblems and secular equations of the divide-and-conquer eigensolver, and the eigenpairs selected by
+// bisection, are computed by the threads of the pool.
+template<typename MatrixType>
+void product_threaded_eigensolver(Index size)
+{
+  MatrixType a = MatrixType::Random(size,size);
+  MatrixType m = a + a.adjoint();
+  SelfAdjointEigenSolver<MatrixType> eig(m);
+  VERIFY_IS_EQUAL(eig.info(), Success);
+  VERIFY_IS_APPROX(m * eig.eigenvectors(), eig.eigenvectors() * eig.eigenvalues().asDiagonal());
+  VERIFY_IS_UNITARY(eig.eigenvectors());
+  SelfAdjointEigenSolver<MatrixType> eigValues(m, EigenvaluesOnly);
+  VERIFY_IS_APPROX(eig.eigenvalues(), eigValues.eigenvalues());
+
+  Index k = size/4;
+  SelfAdjointEigenSolver<MatrixType> eigRange;
+  eigRange.computeIndexRange(m, size-k, k);
+  VERIFY_IS_EQUAL(eigRange.info(), Success);
+  VERIFY_IS_APPROX(eigRange.eigenvalues(), eig.eigenvalues().tail(k));
+  VERIFY_IS_APPROX(m * eigRange.eigenvectors(), eigRange.eigenvectors() * eigRange.eigenvalues().asDiagonal());
+}
+
+// The two halves of the divide steps of BDCSVD, and the roots of the secular equations of their merges, are
+// computed by the threads of the pool.
+template<typename MatrixType>
+void product_threaded_bdcsvd(Index rows, Index cols)
+{
+  MatrixType m = MatrixType::Random(rows,cols);
+  Index diagSize = (std::min)(rows,cols);
+  BDCSVD<MatrixType> svd(m, ComputeThinU|ComputeThinV);
+  VERIFY_IS_APPROX(svd.matrixU() * svd.singularValues().asDiagonal() * svd.matrixV().adjoint(), m);
+  VERIFY_IS_UNITARY(svd.matrixU());
+  VERIFY_IS_UNITARY(svd.matrixV());
+  BDCSVD<MatrixType> svdValues(m);
+  VERIFY_IS_APPROX(svd.singularValues(), svdValues.singularValues());
+
+  // rank deficient matrices go through the deflation of the merges
+  m.rightCols(diagSize/2) = m.leftCols(diagSize/2);
+  BDCSVD<MatrixType> svdDeficient(m, ComputeFullU|ComputeFullV);
+  VERIFY_IS_APPROX(svdDeficient.matrixU().leftCols(diagSize) * svdDeficient.singularValues().asDiagonal()
+                   * svdDeficient.matrixV().leftCols(diagSize).adjoint(), m);
+  VERIFY_IS_UNITARY(svdDeficient.matrixU());
+  VERIFY_IS_UNITARY(svdDeficient.matrixV());
+}
+
+EIGEN_DECLARE_TEST(product_threaded)
+{
+  ThreadPool pool(4);
+  VERIFY(setGemmThreadPool(&pool) == 0);
+  VERIFY(getGemmThreadPool() == &pool);
+  VERIFY_IS_EQUAL(nbThreads(), 4);
+
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1(( product_threaded<MatrixXf>(internal::random<int>(1,500), internal::random<int>(1,500), internal::random<int>(1,300)) ));
+    CALL_SUBTEST_2(( product_threaded<MatrixXd>(internal::random<int>(200,400), internal::random<int>(200,400), internal::random<int>(50,200)) ));
+    CALL_SUBTEST_3(( product_threaded<Matrix<float,Dynamic,Dynamic,RowMajor> >(internal::random<int>(200,400), internal::random<int>(200,400), internal::random<int>(50,200)) ));
+    CALL_SUBTEST_4(( product_threaded<MatrixXcf>(internal::random<int>(100,200), internal::random<int>(100,200), internal::random<int>(50,100)) ));
+  }
+  CALL_SUBTEST_5( product_threaded_nested(pool) );
+  CALL_SUBTEST_5( product_threaded_batched() );
+  CALL_SUBTEST_5( product_threaded_packed(internal::random<int>(200,600), internal::random<int>(100,300), internal::random<int>(1,600)) );
+  CALL_SUBTEST_5( product_threaded_packed(5000, 64, 16) );
+  CALL_SUBTEST_5( product_threaded_quantized(internal::random<int>(200,600), internal::random<int>(100,300), internal::random<int>(1,600)) );
+  CALL_SUBTEST_5( product_threaded_quantized(5000, 64, 16) );
+  CALL_SUBTEST_6(( product_threaded_eigensolver<MatrixXd>(internal::random<int>(300,500)) ));
+  CALL_SUBTEST_6(( product_threaded_eigensolver<MatrixXcf>(internal::random<int>(200,300)) ));
+  CALL_SUBTEST_7(( product_threaded_bdcsvd<MatrixXd>(internal::random<int>(300,500), internal::random<int>(300,500)) ));
+  CALL_SUBTEST_7(( product_threaded_bdcsvd<MatrixXcf>(internal::random<int>(200,300), internal::random<int>(100,200)) ));
+
+  // tall-skinny and short-wide products are split into 2D tiles
+  CALL_SUBTEST_1(( product_threaded<MatrixXf>(20000, 64, 64) ));
+  CALL_SUBTEST_1(( product_threaded<MatrixXf>(64, 20000, 64) ));
+  CALL_SUBTEST_3(( product_threaded<Matrix<float,Dynamic,Dynamic,RowMajor> >(internal::random<int>(5000,10000), internal::random<int>(1,30), 32) ));
+  CALL_SUBTEST_2(( product_threaded<MatrixXd>(internal::random<int>(1,30), internal::random<int>(5000,10000), 32) ));
+
+  setNbThreads(2);
+  VERIFY_IS_EQUAL(nbThreads(), 2);
+  CALL_SUBTEST_1(( product_threaded<MatrixXf>(300, 300, 300) ));
+
+  setGemmThreadPool(0);
+  VERIFY(getGemmThreadPool() == 0);
+}
@@ -247,6 +247,34 @@ template<typename MatrixType> void qr_kahan_matrix()
   }
 }
 
+// Large matrices are factorized by panels of columns, whose norms are recomputed when they lose accuracy,
+// as happens once the rank is reached.
+template<typename MatrixType> void qr_blocked()
+{
+  typedef typename MatrixType::RealScalar RealScalar;
+  Index rows = internal::random<Index>(100,(std::max)(EIGEN_TEST_MAX_SIZE,101)), cols = internal::random<Index>(100,rows);
+  Index rank = internal::random<Index>(cols/2, cols-1);
+  MatrixType m1;
+  createRandomPIMatrixOfRank(rank,rows,cols,m1);
+  m1.col(internal::random<Index>(0,cols-1)) *= RealScalar(1e3);
+  ColPivHouseholderQR<MatrixType> qr(m1);
+  VERIFY_IS_EQUAL(qr.rank(), rank);
+  MatrixType r = qr.matrixQR().template triangularView<Upper>();
+  MatrixType c = MatrixType(qr.householderQ()) * r * qr.colsPermutation().inverse();
+  VERIFY_IS_APPROX(m1, c);
+  for (Index i = 0; i < rank-1; ++i)
+    VERIFY_IS_APPROX_OR_LESS_THAN(numext::abs(r(i+1,i+1)), numext::abs(r(i,i)));
+  VERIFY_IS_APPROX(qr.maxPivot(), r.diagonal().cwiseAbs().maxCoeff());
+
+  m1 = MatrixType::Random(rows, cols);
+  qr.compute(m1);
+  VERIFY_IS_EQUAL(qr.rank(), cols);
+  MatrixType b = MatrixType::Random(rows, 2);
+  MatrixType x = qr.solve(b);
+  // least squares solution
+  VERIFY_IS_APPROX(MatrixType(m1.adjoint() * (m1 * x)), MatrixType(m1.adjoint() * b));
+}
+
 template<typename MatrixType> void qr_invertible()
 {
   using std::log;
@@ -363,6 +391,10 @@ EIGEN_DECLARE_TEST(qr_colpivoting)
   // Test problem size constructors
   CALL_SUBTEST_9(ColPivHouseholderQR<MatrixXf>(10, 20));
 
+  CALL_SUBTEST_2( qr_blocked<MatrixXd>() );
+  CALL_SUBTEST_2(( qr_blocked<Matrix<double,Dynamic,Dynamic,RowMajor> >() ));
+  CALL_SUBTEST_6( qr_blocked<MatrixXcf>() );
+
   CALL_SUBTEST_1( qr_kahan_matrix<MatrixXf>() );
   CALL_SUBTEST_2( qr_kahan_matrix<MatrixXd>() );
 }
@@ -0,0 +1,113 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "main.h"
+
+template<typename Scalar, int Options>
+Matrix<Scalar,Dynamic,Dynamic,Options> random_quantized(Index rows, Index cols)
+{
+  // keep the 16-bit products small enough for the sums not to overflow
+  const int maxValue = (std::min)(int((std::numeric_limits<Scalar>::max)()), 2047);
+  const int minValue = (std::max)(int((std::numeric_limits<Scalar>::min)()), -2048);
+  Matrix<Scalar,Dynamic,Dynamic,Options> m(rows,cols);
+  for(Index j=0; j<cols; ++j)
+    for(Index i=0; i<rows; ++i)
+      m(i,j) = Scalar(internal::random<int>(minValue, maxValue));
+  return m;
+}
+
+template<typename LhsScalar, int LhsOptions, typename RhsScalar, int RhsOptions>
+void quantized_product_mixed(Index rows, Index depth, Index cols)
+{
+  typedef Matrix<LhsScalar,Dynamic,Dynamic,LhsOptions> LhsType;
+  typedef Matrix<RhsScalar,Dynamic,Dynamic,RhsOptions> RhsType;
+  LhsType a = random_quantized<LhsScalar,LhsOptions>(rows,depth);
+  RhsType b = random_quantized<RhsScalar,RhsOptions>(depth,cols);
+  MatrixXi ref = a.template cast<int>() * b.template cast<int>();
+
+  // exact 32-bit integer accumulation
+  MatrixXi c;
+  quantized_product(a, b, c);
+  VERIFY_IS_EQUAL(c.rows(), rows);
+  VERIFY_IS_EQUAL(c.cols(), cols);
+  VERIFY_IS_EQUAL(c, ref);
+
+  Matrix<int,Dynamic,Dynamic,RowMajor> r;
+  quantized_product(a, b, r);
+  VERIFY_IS_EQUAL(r, ref);
+
+  // sub-matrices and transposed operands
+  if(rows>1 && depth>1 && cols>1)
+  {
+    quantized_product(a.bottomRightCorner(rows-1,depth-1), b.bottomRows(depth-1), c);
+    VERIFY_IS_EQUAL(c, (a.bottomRightCorner(rows-1,depth-1).template cast<int>() * b.bottomRows(depth-1).template cast<int>()).eval());
+  }
+  quantized_product(b.transpose(), a.transpose(), c);
+  VERIFY_IS_EQUAL(c, ref.transpose());
+
+  // dequantization with per-row and per-column zero points and scales
+  VectorXi za(rows);
+  RowVectorXi zb(cols);
+  for(Index i=0; i<rows; ++i) za(i) = internal::random<int>(-15,15);
+  for(Index j=0; j<cols; ++j) zb(j) = internal::random<int>(-15,15);
+  VectorXf sa = VectorXf::Random(rows).cwiseAbs();
+  RowVectorXf sb = RowVectorXf::Random(cols).cwiseAbs();
+  MatrixXf f;
+  quantized_product(a, b, f, za, sa, zb, sb);
+  MatrixXd fa = (a.template cast<int>().colwise() - za).template cast<double>();
+  MatrixXd fb = (b.template cast<int>().rowwise() - zb).template cast<double>();
+  MatrixXd fref = sa.cast<double>().asDiagonal() * (fa * fb) * sb.cast<double>().asDiagonal();
+  VERIFY_IS_APPROX(f, fref.template cast<float>());
+
+  // per-tensor quantization
+  MatrixXd d;
+  quantized_product(a, b, d, VectorXi::Constant(rows,3), VectorXd::Constant(rows,0.5), RowVectorXi::Zero(cols), RowVectorXd::Constant(cols,0.25));
+  VERIFY_IS_APPROX(d, (0.125 * (a.template cast<int>().array()-3).matrix().template cast<double>() * b.template cast<double>()).eval());
+}
+
+template<int>
+void quantized_product_corner_cases()
+{
+  // extreme values must not saturate
+  typedef Matrix<signed char,Dynamic,Dynamic> MatrixXs8;
+  typedef Matrix<unsigned char,Dynamic,Dynamic> MatrixXu8;
+  typedef Matrix<short,Dynamic,Dynamic> MatrixXs16;
+  const Index depth = 1001;
+  MatrixXu8 a = MatrixXu8::Constant(17, depth, 255);
+  MatrixXs8 b = MatrixXs8::Constant(depth, 9, -128);
+  MatrixXi c;
+  quantized_product(a, b, c);
+  VERIFY_IS_EQUAL(c, MatrixXi::Constant(17, 9, 255*(-128)*int(depth)));
+
+  MatrixXs16 s = MatrixXs16::Constant(5, 41, -32768);
+  MatrixXs16 t = MatrixXs16::Constant(41, 3, 1000);
+  quantized_product(s, t, c);
+  VERIFY_IS_EQUAL(c, MatrixXi::Constant(5, 3, -32768*1000*41));
+
+  // empty products
+  quantized_product(MatrixXs8(3,0), MatrixXs8(0,4), c);
+  VERIFY_IS_EQUAL(c, MatrixXi::Zero(3,4));
+  quantized_product(MatrixXs8(0,3), MatrixXs8(3,4), c);
+  VERIFY_IS_EQUAL(c.rows(), 0);
+
+  // several blocks along all dimensions
+  std::ptrdiff_t l1 = l1CacheSize(), l2 = l2CacheSize(), l3 = l3CacheSize();
+  setCpuCacheSizes(2048, 8192, 16384);
+  CALL_SUBTEST(( quantized_product_mixed<unsigned char,ColMajor,signed char,ColMajor>(internal::random<int>(100,300), internal::random<int>(100,300), internal::random<int>(100,300)) ));
+  setCpuCacheSizes(l1, l2, l3);
+}
+
+EIGEN_DECLARE_TEST(quantized_product)
+{
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1(( quantized_product_mixed<signed char,ColMajor,signed char,ColMajor>(internal::random<int>(1,EIGEN_TEST_MAX_SIZE), internal::random<int>(1,EIGEN_TEST_MAX_SIZE), internal::random<int>(1,EIGEN_TEST_MAX_SIZE)) ));
+    CALL_SUBTEST_2(( quantized_product_mixed<unsigned char,RowMajor,signed char,ColMajor>(internal::random<int>(1,EIGEN_TEST_MAX_SIZE), internal::random<int>(1,EIGEN_TEST_MAX_SIZE), internal::random<int>(1,EIGEN_TEST_MAX_SIZE)) ));
+    CALL_SUBTEST_3(( quantized_product_mixed<short,ColMajor,short,RowMajor>(internal::random<int>(1,EIGEN_TEST_MAX_SIZE), internal::random<int>(1,200), internal::random<int>(1,EIGEN_TEST_MAX_SIZE)) ));
+    CALL_SUBTEST_4(( quantized_product_mixed<unsigned char,ColMajor,short,ColMajor>(internal::random<int>(1,20), internal::random<int>(1,20), internal::random<int>(1,20)) ));
+  }
+  CALL_SUBTEST_5( quantized_product_corner_cases<0>() );
+}
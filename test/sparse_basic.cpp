@@ -417,6 +417,53 @@ template<typename SparseMatrixType> void sparse_basic(const SparseMatrixType& re
     m.setFromTriplets(triplets.begin(), triplets.end(), [] (Scalar,Scalar b) { return b; });
     VERIFY_IS_APPROX(m, refMat_last);
 #endif
+
+    // reuse the pattern of m for the first half of the triplets with new values
+    m.setFromTriplets(triplets.begin(), triplets.end());
+    const Index nnz = m.nonZeros();
+    DenseMatrix refMat_update = DenseMatrix::Zero(rows,cols);
+    std::vector<TripletType> updates(triplets.begin(), triplets.begin()+ntriplets/2);
+    for(std::size_t i=0;i<updates.size();++i)
+    {
+      Scalar v = internal::random<Scalar>();
+      updates[i] = TripletType(updates[i].row(), updates[i].col(), v);
+      refMat_update(updates[i].row(), updates[i].col()) += v;
+    }
+    m.updateFromTriplets(updates.begin(), updates.end());
+    VERIFY_IS_APPROX(m, refMat_update);
+    VERIFY_IS_EQUAL(m.nonZeros(), nnz);
+    if(!updates.empty())
+    {
+      SparseMatrixType m2(rows,cols);
+      m2.setFromTriplets(&updates[0], &updates[0]+updates.size(), std::multiplies<Scalar>());
+      m.updateFromTriplets(&updates[0], &updates[0]+updates.size(), std::multiplies<Scalar>());
+      VERIFY_IS_APPROX(m, m2);
+    }
+
+    // assembly plans
+    SparseMatrixType m3(rows,cols);
+    SparseAssemblyPlan<SparseMatrixType> plan(m3, triplets.begin(), triplets.end());
+    m.setFromTriplets(triplets.begin(), triplets.end());
+    VERIFY_IS_EQUAL(plan.size(), ntriplets);
+    VERIFY_IS_EQUAL(plan.nonZeros(), m.nonZeros());
+    VERIFY(m3.isCompressed());
+    VERIFY_IS_APPROX(m3, refMat_sum);
+    for(Index i=0;i<ntriplets;++i)
+      VERIFY_IS_EQUAL(m3.innerIndexPtr()[plan.offset(i)], SparseMatrixType::IsRowMajor ? triplets[i].col() : triplets[i].row());
+    std::vector<Scalar> values(ntriplets);
+    DenseMatrix refMat_plan = DenseMatrix::Zero(rows,cols);
+    for(Index i=0;i<ntriplets;++i)
+    {
+      values[i] = internal::random<Scalar>();
+      refMat_plan(triplets[i].row(), triplets[i].col()) += values[i];
+      triplets[i] = TripletType(triplets[i].row(), triplets[i].col(), values[i]);
+    }
+    plan.assemble(m3, values.begin());
+    VERIFY_IS_APPROX(m3, refMat_plan);
+    VERIFY_IS_EQUAL(m3.nonZeros(), plan.nonZeros());
+    m3.coeffs().setZero();
+    plan.assembleFromTriplets(m3, triplets.begin(), triplets.end());
+    VERIFY_IS_APPROX(m3, refMat_plan);
   }
   
   // test Map
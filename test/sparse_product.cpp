@@ -459,6 +459,52 @@ void test_mixing_types()
   VERIFY_IS_APPROX( dC2 = sC1 * dR1.col(0), dC3 = sC1 * dR1.template cast<Cplx>().col(0) );
 }
 
+// R^T * A * P with an aggregation-like prolongation P, and a restriction R which is P plus a few random nonzeros
+template<typename SparseMatrixType, typename OtherSparseMatrixType>
+void sparse_galerkin_product(Index n, Index nc)
+{
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+
+  DenseMatrix refA = DenseMatrix::Zero(n, n), refP = DenseMatrix::Zero(n, nc), refR = DenseMatrix::Zero(n, nc);
+  SparseMatrixType A(n, n), R(n, nc);
+  OtherSparseMatrixType P(n, nc);
+  initSparse<Scalar>(0.1, refA, A);
+  initSparse<Scalar>(0.02, refR, R);
+  std::vector<Triplet<Scalar> > triplets;
+  for(Index i=0; i<n; ++i)
+    triplets.push_back(Triplet<Scalar>(int(i), internal::random<int>(0,int(nc)-1), internal::random<Scalar>()));
+  P.setFromTriplets(triplets.begin(), triplets.end());
+  refP = P.toDense();
+  R += SparseMatrixType(P);
+  refR += refP;
+
+  SparseMatrixType Ac;
+  SparseGalerkinProduct<SparseMatrixType> galerkin(R, A, P, Ac);
+  VERIFY_IS_EQUAL(Ac.rows(), nc);
+  VERIFY_IS_EQUAL(Ac.cols(), nc);
+  VERIFY(Ac.isCompressed());
+  DenseMatrix refAc = refR.transpose() * refA * refP;
+  VERIFY_IS_APPROX(Ac.toDense(), refAc);
+  // the sparse sum requires the inner indices to be sorted
+  VERIFY_IS_APPROX(SparseMatrixType(Ac + SparseMatrixType(R.transpose() * A * P)).toDense(), (2*refAc).eval());
+
+  // new values with the same patterns
+  A.makeCompressed();
+  R.makeCompressed();
+  A.coeffs().setRandom();
+  P.coeffs() *= Scalar(2);
+  R.coeffs().setRandom();
+  galerkin.update(R, A, P, Ac);
+  VERIFY_IS_APPROX(Ac.toDense(), (R.toDense().transpose() * A.toDense() * P.toDense()).eval());
+
+  // expressions of the operands
+  SparseGalerkinProduct<SparseMatrixType> galerkin2;
+  galerkin2.compute(R, A.transpose(), P, Ac);
+  VERIFY_IS_APPROX(Ac.toDense(), (R.toDense().transpose() * A.toDense().transpose() * P.toDense()).eval());
+  VERIFY(galerkin2.flops() >= Ac.nonZeros());
+}
+
 EIGEN_DECLARE_TEST(sparse_product)
 {
   for(int i = 0; i < g_repeat; i++) {
@@ -471,5 +517,13 @@ EIGEN_DECLARE_TEST(sparse_product)
     CALL_SUBTEST_4( (sparse_product_regression_test<SparseMatrix<double,RowMajor>, Matrix<double, Dynamic, Dynamic, RowMajor> >()) );
 
     CALL_SUBTEST_5( (test_mixing_types<float>()) );
+
+    Index n = internal::random<Index>(10,300), nc = internal::random<Index>(1,n/3+1);
+    CALL_SUBTEST_6( (sparse_galerkin_product<SparseMatrix<double,ColMajor>, SparseMatrix<double,ColMajor> >(n, nc)) );
+    CALL_SUBTEST_6( (sparse_galerkin_product<SparseMatrix<double,RowMajor>, SparseMatrix<double,RowMajor> >(n, nc)) );
+    CALL_SUBTEST_7( (sparse_galerkin_product<SparseMatrix<std::complex<double>,RowMajor,long>, SparseMatrix<std::complex<double>,ColMajor,long> >(n, nc)) );
+    CALL_SUBTEST_7( (sparse_galerkin_product<SparseMatrix<float,ColMajor>, SparseMatrix<float,RowMajor> >(n, nc)) );
+    EIGEN_UNUSED_VARIABLE(n);
+    EIGEN_UNUSED_VARIABLE(nc);
   }
 }
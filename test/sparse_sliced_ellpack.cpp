@@ -0,0 +1,136 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "sparse.h"
+#include <Eigen/IterativeLinearSolvers>
+
+template<typename Scalar, typename StorageIndex>
+void sparse_sliced_ellpack(Index rows, Index cols, double density, Index sortingScope)
+{
+  typedef SlicedEllpackMatrix<Scalar,StorageIndex> SellMatrix;
+  typedef SparseMatrix<Scalar,ColMajor,StorageIndex> SpMat;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef Matrix<Scalar,Dynamic,Dynamic,RowMajor> RowDenseMatrix;
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+
+  DenseMatrix refMat = DenseMatrix::Zero(rows, cols);
+  SpMat m(rows, cols);
+  initSparse<Scalar>(density, refMat, m);
+  SellMatrix s(m, sortingScope);
+
+  VERIFY_IS_EQUAL(s.rows(), rows);
+  VERIFY_IS_EQUAL(s.cols(), cols);
+  VERIFY_IS_EQUAL(s.nonZeros(), m.nonZeros());
+  VERIFY(s.storedSize() >= s.nonZeros());
+  VERIFY_IS_EQUAL(s.storedSize() % SellMatrix::sliceHeight(), 0);
+  VERIFY_IS_EQUAL(s.slices(), (rows+SellMatrix::sliceHeight()-1)/SellMatrix::sliceHeight());
+  VERIFY_IS_EQUAL(s.sortingScope() % SellMatrix::sliceHeight(), 0);
+
+  // the rows are sorted within each window
+  SparseMatrix<Scalar,RowMajor,StorageIndex> mr(m);
+  for(Index i=0; i+1<rows; ++i)
+    if((i+1)%s.sortingScope()!=0 && s.sortingScope()>SellMatrix::sliceHeight())
+      VERIFY(mr.row(s.permutation(i)).nonZeros() >= mr.row(s.permutation(i+1)).nonZeros());
+
+  // iterators
+  SparseMatrix<Scalar,RowMajor,StorageIndex> m2(rows, cols);
+  for(Index i=0; i<rows; ++i)
+  {
+    m2.startVec(i);
+    for(typename SellMatrix::InnerIterator it(s,i); it; ++it)
+    {
+      VERIFY_IS_EQUAL(it.row(), i);
+      m2.insertBackByOuterInner(i, it.index()) = it.value();
+    }
+  }
+  m2.finalize();
+  VERIFY_IS_APPROX(m2.toDense(), refMat);
+
+  // products
+  DenseVector x = DenseVector::Random(cols);
+  DenseMatrix X = DenseMatrix::Random(cols, internal::random<Index>(1,5));
+  RowDenseMatrix Xr = X;
+  Scalar alpha = internal::random<Scalar>();
+
+  DenseVector y = s * x;
+  VERIFY_IS_APPROX(y, (refMat * x).eval());
+  DenseVector y0 = DenseVector::Random(rows);
+  y = y0;
+  y.noalias() += alpha * (s * x);
+  VERIFY_IS_APPROX(y, (y0 + alpha * refMat * x).eval());
+  y = y0;
+  y.noalias() -= s * x;
+  VERIFY_IS_APPROX(y, (y0 - refMat * x).eval());
+  VERIFY_IS_APPROX(DenseMatrix(s * X), DenseMatrix(refMat * X));
+  VERIFY_IS_APPROX(DenseMatrix(s * Xr), DenseMatrix(refMat * X));
+  VERIFY_IS_APPROX(DenseVector(s * X.col(0)), DenseVector(refMat * X.col(0)));
+  VERIFY_IS_APPROX(DenseVector(s * Xr.col(0)), DenseVector(refMat * X.col(0)));
+  DenseMatrix Y = DenseMatrix::Random(rows+2, X.cols()+1), Y0 = Y;
+  Y.block(1, 1, rows, X.cols()).noalias() = s * X;
+  Y0.block(1, 1, rows, X.cols()) = refMat * X;
+  VERIFY_IS_APPROX(Y, Y0);
+
+  // copy and default construction
+  SellMatrix s2;
+  VERIFY_IS_EQUAL(s2.rows(), 0);
+  s2 = s;
+  VERIFY_IS_APPROX(DenseVector(s2 * x), DenseVector(refMat * x));
+  s2.compute(m.transpose(), 1);
+  VERIFY_IS_EQUAL(s2.rows(), cols);
+  VERIFY_IS_APPROX(DenseVector(s2 * y0), DenseVector(refMat.transpose() * y0));
+}
+
+// a SlicedEllpackMatrix can be used by the iterative solvers
+template<typename Scalar>
+void sparse_sliced_ellpack_solvers(int n)
+{
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef SparseMatrix<Scalar> SpMat;
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+  SpMat A(n*n, n*n);
+  std::vector<Triplet<Scalar> > triplets;
+  for(int j=0; j<n; ++j)
+    for(int i=0; i<n; ++i)
+    {
+      int k = i+j*n;
+      triplets.push_back(Triplet<Scalar>(k, k, Scalar(4) + internal::random<RealScalar>(0,1)));
+      if(i>0)   triplets.push_back(Triplet<Scalar>(k, k-1, Scalar(-1)));
+      if(i<n-1) triplets.push_back(Triplet<Scalar>(k, k+1, Scalar(-1)));
+      if(j>0)   triplets.push_back(Triplet<Scalar>(k, k-n, Scalar(-1)));
+      if(j<n-1) triplets.push_back(Triplet<Scalar>(k, k+n, Scalar(-1)));
+    }
+  A.setFromTriplets(triplets.begin(), triplets.end());
+  SlicedEllpackMatrix<Scalar> S(A);
+  DenseVector b = DenseVector::Random(n*n);
+
+  ConjugateGradient<SlicedEllpackMatrix<Scalar>, Lower|Upper, DiagonalPreconditioner<Scalar> > cg(S);
+  DenseVector x = cg.solve(b);
+  VERIFY_IS_EQUAL(cg.info(), Success);
+  VERIFY((A*x-b).norm() <= Scalar(10)*cg.tolerance()*b.norm());
+
+  BiCGSTAB<SlicedEllpackMatrix<Scalar>, IdentityPreconditioner> bicg(S);
+  x = bicg.solve(b);
+  VERIFY_IS_EQUAL(bicg.info(), Success);
+  VERIFY((A*x-b).norm() <= Scalar(10)*bicg.tolerance()*b.norm());
+}
+
+EIGEN_DECLARE_TEST(sparse_sliced_ellpack)
+{
+  for(int i = 0; i < g_repeat; i++) {
+    Index rows = internal::random<Index>(1,EIGEN_TEST_MAX_SIZE), cols = internal::random<Index>(1,EIGEN_TEST_MAX_SIZE);
+    CALL_SUBTEST_1(( sparse_sliced_ellpack<double,int>(rows, cols, internal::random<double>(0.01,0.2), internal::random<int>(1,100)) ));
+    CALL_SUBTEST_1(( sparse_sliced_ellpack<double,int>(rows, cols, 0.02, 1) ));
+    CALL_SUBTEST_2(( sparse_sliced_ellpack<float,long>(rows, cols, internal::random<double>(0.01,0.2), rows) ));
+    CALL_SUBTEST_3(( sparse_sliced_ellpack<std::complex<double>,int>(rows, cols, internal::random<double>(0.01,0.2), 256) ));
+    EIGEN_UNUSED_VARIABLE(rows);
+    EIGEN_UNUSED_VARIABLE(cols);
+    CALL_SUBTEST_4(( sparse_sliced_ellpack<double,short>(internal::random<int>(1,100), internal::random<int>(1,100), 0.1, 16) ));
+  }
+  CALL_SUBTEST_1(( sparse_sliced_ellpack<double,int>(1, 1, 1., 1) ));
+  CALL_SUBTEST_5(( sparse_sliced_ellpack_solvers<double>(internal::random<int>(5,30)) ));
+  CALL_SUBTEST_5(( sparse_sliced_ellpack_solvers<float>(internal::random<int>(5,30)) ));
+}
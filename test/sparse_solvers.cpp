@@ -114,6 +114,61 @@ template<typename Scalar> void sparse_solvers(int rows, int cols)
   }
 }
 
+// SparseTriangularSolvePlan solves the same systems as triangularView()
+template<typename SparseMatrixType, int Mode> void sparse_triangular_solve_plan(int n)
+{
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef SparseTriangularSolvePlan<SparseMatrixType,Mode> Plan;
+  DenseMatrix refMat = DenseMatrix::Zero(n, n);
+  SparseMatrixType m(n, n);
+  initSparse<Scalar>((std::max)(8./(n*n), 0.05), refMat, m, ForceNonZeroDiag);
+  m.makeCompressed();
+  DenseMatrix B = DenseMatrix::Random(n, internal::random<int>(1,4)), X = B;
+
+  // the levels are a partition of the unknowns, each of which only depends on the ones of the previous levels
+  Plan plan(m);
+  VERIFY_IS_EQUAL(plan.size(), Index(n));
+  VectorXi level = VectorXi::Constant(n, -1);
+  for(Index l=0; l<plan.levels(); ++l)
+    for(Index k=0; k<plan.level(l).size(); ++k)
+    {
+      VERIFY_IS_EQUAL(level(plan.level(l)(k)), -1);
+      level(plan.level(l)(k)) = int(l);
+    }
+  VERIFY((level.array()>=0).all());
+  for(Index j=0; j<m.outerSize(); ++j)
+    for(typename SparseMatrixType::InnerIterator it(m,j); it; ++it)
+      if(it.row()!=it.col() && (it.row()>it.col()) == bool(Mode&Lower))
+        VERIFY(level(it.row()) > level(it.col()));
+
+  plan.solveInPlace(m, X);
+  VERIFY_IS_APPROX(X, refMat.template triangularView<Mode>().solve(B));
+  typename DenseMatrix::ColXpr x0 = X.col(0);
+  x0 = B.col(0);
+  plan.solveInPlace(m, x0);
+  VERIFY_IS_APPROX(x0, refMat.template triangularView<Mode>().solve(B.col(0)));
+
+  // adjoint of the factor
+  Plan adjointPlan(m, true);
+  X = B;
+  adjointPlan.solveInPlace(m, X);
+  VERIFY_IS_APPROX(X, refMat.adjoint().template triangularView<Mode>().solve(B));
+
+  // the values of the factor can change
+  m.coeffs() *= Scalar(2);
+  refMat *= Scalar(2);
+  X = B;
+  plan.solveInPlace(m, X);
+  VERIFY_IS_APPROX(X, refMat.template triangularView<Mode>().solve(B));
+  Plan plan2;
+  VERIFY_IS_EQUAL(plan2.size(), 0);
+  plan2 = plan;
+  X = B;
+  plan2.solveInPlace(m, X);
+  VERIFY_IS_APPROX(X, refMat.template triangularView<Mode>().solve(B));
+}
+
 EIGEN_DECLARE_TEST(sparse_solvers)
 {
   for(int i = 0; i < g_repeat; i++) {
@@ -121,5 +176,10 @@ EIGEN_DECLARE_TEST(sparse_solvers)
     int s = internal::random<int>(1,300);
     CALL_SUBTEST_2(sparse_solvers<std::complex<double> >(s,s) );
     CALL_SUBTEST_1(sparse_solvers<double>(s,s) );
+    CALL_SUBTEST_3(( sparse_triangular_solve_plan<SparseMatrix<double>,Lower>(s) ));
+    CALL_SUBTEST_3(( sparse_triangular_solve_plan<SparseMatrix<double,RowMajor>,Upper>(s) ));
+    CALL_SUBTEST_3(( sparse_triangular_solve_plan<SparseMatrix<double,RowMajor>,UnitLower>(s) ));
+    CALL_SUBTEST_4(( sparse_triangular_solve_plan<SparseMatrix<std::complex<double>,ColMajor,long>,UnitUpper>(s) ));
+    CALL_SUBTEST_4(( sparse_triangular_solve_plan<SparseMatrix<std::complex<double>,RowMajor>,Lower>(s) ));
   }
 }
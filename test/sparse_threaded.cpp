@@ -0,0 +1,367 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#define EIGEN_GEMM_THREADPOOL
+#define EIGEN_PARALLEL_CWISE_THREAD_COST 1000
+#include "sparse.h"
+#include <Eigen/SparseCholesky>
+#include <Eigen/SparseLU>
+#include <Eigen/IterativeLinearSolvers>
+#include <list>
+
+// Large lists of triplets are assembled by the threads of the pool,
+// check them against the sequential assembly.
+template<typename SparseMatrixType>
+void sparse_threaded_assembly(Index rows, Index cols, Index ntriplets)
+{
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef typename SparseMatrixType::StorageIndex StorageIndex;
+  typedef Triplet<Scalar,StorageIndex> TripletType;
+  ThreadPoolInterface* pool = getGemmThreadPool();
+
+  std::vector<TripletType> triplets;
+  triplets.reserve(ntriplets);
+  for(Index k=0; k<ntriplets; ++k)
+    triplets.push_back(TripletType(internal::random<StorageIndex>(0,StorageIndex(rows-1)),
+                                   internal::random<StorageIndex>(0,StorageIndex(cols-1)),
+                                   internal::random<Scalar>()));
+  // a list is not random access and is always assembled sequentially
+  std::list<TripletType> tripletList(triplets.begin(), triplets.end());
+
+  SparseMatrixType ref_sum(rows,cols), ref_last(rows,cols), ref_update(rows,cols);
+  {
+    setGemmThreadPool(0);
+    ref_sum.setFromTriplets(triplets.begin(), triplets.end());
+    ref_last.setFromTriplets(triplets.begin(), triplets.end(), [] (const Scalar&, const Scalar& b) { return b; });
+    ref_update = ref_sum;
+    ref_update.updateFromTriplets(triplets.begin()+ntriplets/3, triplets.end());
+    setGemmThreadPool(pool);
+  }
+
+  // the duplicates are summed in the same order, the results are identical
+  SparseMatrixType m(rows,cols);
+  m.setFromTriplets(triplets.begin(), triplets.end());
+  VERIFY(m.isCompressed());
+  VERIFY_IS_EQUAL(m.nonZeros(), ref_sum.nonZeros());
+  VERIFY_IS_EQUAL(m.toDense(), ref_sum.toDense());
+  VERIFY(std::equal(m.innerIndexPtr(), m.innerIndexPtr()+m.nonZeros(), ref_sum.innerIndexPtr()));
+  VERIFY(std::equal(m.outerIndexPtr(), m.outerIndexPtr()+m.outerSize()+1, ref_sum.outerIndexPtr()));
+
+  m.setFromTriplets(tripletList.begin(), tripletList.end());
+  VERIFY_IS_EQUAL(m.toDense(), ref_sum.toDense());
+
+  m.setFromTriplets(&triplets[0], &triplets[0]+ntriplets, [] (const Scalar&, const Scalar& b) { return b; });
+  VERIFY_IS_EQUAL(m.nonZeros(), ref_last.nonZeros());
+  VERIFY_IS_EQUAL(m.toDense(), ref_last.toDense());
+
+  // reuse of the pattern
+  m.setFromTriplets(triplets.begin(), triplets.end());
+  m.updateFromTriplets(triplets.begin()+ntriplets/3, triplets.end());
+  VERIFY_IS_EQUAL(m.nonZeros(), ref_sum.nonZeros());
+  VERIFY_IS_EQUAL(m.toDense(), ref_update.toDense());
+
+  // assembly plans
+  SparseMatrixType m2(rows,cols);
+  SparseAssemblyPlan<SparseMatrixType> plan(m2, triplets.begin(), triplets.end());
+  VERIFY_IS_EQUAL(m2.toDense(), ref_sum.toDense());
+  m2.coeffs().setZero();
+  plan.assembleFromTriplets(m2, triplets.begin(), triplets.end());
+  VERIFY_IS_EQUAL(m2.nonZeros(), ref_sum.nonZeros());
+  VERIFY_IS_EQUAL(m2.toDense(), ref_sum.toDense());
+}
+
+// The independent supernodes of SupernodalLLT are factorized concurrently
+template<typename Scalar>
+void sparse_threaded_supernodal_llt(int n)
+{
+  typedef SparseMatrix<Scalar> SparseMatrixType;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  ThreadPoolInterface* pool = getGemmThreadPool();
+
+  // 2D Laplacian
+  std::vector<Triplet<Scalar> > triplets;
+  for(int i = 0; i < n; ++i)
+    for(int j = 0; j < n; ++j)
+    {
+      triplets.push_back(Triplet<Scalar>(i*n+j, i*n+j, Scalar(4.5)));
+      if(i>0) triplets.push_back(Triplet<Scalar>(i*n+j, (i-1)*n+j, Scalar(-1)));
+      if(j>0) triplets.push_back(Triplet<Scalar>(i*n+j, i*n+j-1, Scalar(-1)));
+    }
+  SparseMatrixType A(n*n, n*n);
+  A.setFromTriplets(triplets.begin(), triplets.end());
+  DenseMatrix B = DenseMatrix::Random(n*n, 2);
+
+  SupernodalLLT<SparseMatrixType> llt;
+  llt.setRelaxation(4);
+  DenseMatrix ref;
+  {
+    setGemmThreadPool(0);
+    llt.compute(A);
+    ref = llt.solve(B);
+    setGemmThreadPool(pool);
+  }
+  llt.compute(A);
+  VERIFY_IS_EQUAL(llt.info(), Success);
+  DenseMatrix X = llt.solve(B);
+  VERIFY_IS_APPROX(X, ref);
+  VERIFY_IS_APPROX(DenseMatrix(A.template selfadjointView<Lower>() * X), B);
+}
+
+// Large sparse * dense products are split over the threads of the pool, whatever the storage order,
+// check them against the dense products.
+template<typename SparseMatrixType>
+void sparse_threaded_dense_product(Index rows, Index cols, Index nrhs)
+{
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef Matrix<Scalar,Dynamic,Dynamic,RowMajor> RowDenseMatrix;
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+
+  DenseMatrix refMat = DenseMatrix::Zero(rows, cols);
+  SparseMatrixType m(rows, cols);
+  initSparse<Scalar>(0.3, refMat, m);
+  DenseVector x = DenseVector::Random(cols), xt = DenseVector::Random(rows);
+  DenseMatrix X = DenseMatrix::Random(cols, nrhs);
+  RowDenseMatrix Xr = X;
+  Scalar s = internal::random<Scalar>();
+
+  DenseVector y = DenseVector::Random(rows), y0 = y;
+  y.noalias() += s * m * x;
+  VERIFY_IS_APPROX(y, (y0 + s * refMat * x).eval());
+  VERIFY_IS_APPROX(DenseVector(m.transpose() * xt), DenseVector(refMat.transpose() * xt));
+  VERIFY_IS_APPROX(DenseVector(m.adjoint() * xt), DenseVector(refMat.adjoint() * xt));
+  VERIFY_IS_APPROX(DenseMatrix(m * X), DenseMatrix(refMat * X));
+  VERIFY_IS_APPROX(DenseMatrix(m * Xr), DenseMatrix(refMat * X));
+  VERIFY_IS_APPROX(RowDenseMatrix(xt.transpose() * m), RowDenseMatrix(xt.transpose() * refMat));
+  SlicedEllpackMatrix<Scalar,typename SparseMatrixType::StorageIndex> sell(m);
+  VERIFY_IS_APPROX(DenseVector(sell * x), DenseVector(refMat * x));
+  VERIFY_IS_APPROX(DenseMatrix(sell * X), DenseMatrix(refMat * X));
+
+  // selfadjoint views
+  SparseMatrixType sq = m.topLeftCorner((std::min)(rows,cols), (std::min)(rows,cols));
+  DenseMatrix refSq = sq.toDense();
+  DenseMatrix refLower = refSq.template selfadjointView<Lower>();
+  DenseMatrix refUpper = refSq.template selfadjointView<Upper>();
+  DenseMatrix Y = X.topRows(sq.cols());
+  VERIFY_IS_APPROX(DenseMatrix(sq.template selfadjointView<Lower>() * Y), DenseMatrix(refLower * Y));
+  VERIFY_IS_APPROX(DenseMatrix(sq.template selfadjointView<Upper>() * Y), DenseMatrix(refUpper * Y));
+  VERIFY_IS_APPROX(DenseVector(sq.template selfadjointView<Lower>() * Y.col(0)), DenseVector(refLower * Y.col(0)));
+  VERIFY_IS_APPROX(DenseMatrix(Y.transpose() * sq.template selfadjointView<Upper>()), DenseMatrix(Y.transpose() * refUpper));
+}
+
+// Large sparse * sparse products compute the columns of the result concurrently, in a symbolic and a numeric pass,
+// check them against the dense products for all storage orders.
+template<typename LhsType, typename RhsType>
+void sparse_threaded_sparse_product(Index rows, Index depth, Index cols, double density)
+{
+  typedef typename LhsType::Scalar Scalar;
+  typedef typename LhsType::StorageIndex StorageIndex;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef SparseMatrix<Scalar,ColMajor,StorageIndex> ColSpMat;
+  typedef SparseMatrix<Scalar,RowMajor,StorageIndex> RowSpMat;
+
+  DenseMatrix refLhs = DenseMatrix::Zero(rows, depth), refRhs = DenseMatrix::Zero(depth, cols);
+  LhsType lhs(rows, depth);
+  RhsType rhs(depth, cols);
+  initSparse<Scalar>(density, refLhs, lhs);
+  initSparse<Scalar>(density, refRhs, rhs);
+  DenseMatrix refProd = refLhs * refRhs;
+
+  ColSpMat resCol = lhs * rhs;
+  RowSpMat resRow = lhs * rhs;
+  VERIFY_IS_APPROX(resCol.toDense(), refProd);
+  VERIFY_IS_APPROX(resRow.toDense(), refProd);
+  // the sparse sums require the inner indices of the results to be sorted
+  VERIFY_IS_APPROX(ColSpMat(resCol + ColSpMat(resRow)).toDense(), (2*refProd).eval());
+  VERIFY_IS_APPROX(RowSpMat(resRow + RowSpMat(resCol)).toDense(), (2*refProd).eval());
+  VERIFY_IS_APPROX(ColSpMat(lhs * rhs.col(0)).toDense(), refProd.col(0));
+}
+
+// The rows of large Galerkin products are computed concurrently
+template<typename SparseMatrixType>
+void sparse_threaded_galerkin_product(Index n, Index nc)
+{
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  DenseMatrix refA = DenseMatrix::Zero(n, n), refP = DenseMatrix::Zero(n, nc);
+  SparseMatrixType A(n, n), P(n, nc), Ac;
+  initSparse<Scalar>(0.05, refA, A, ForceNonZeroDiag);
+  initSparse<Scalar>(0.05, refP, P);
+  SparseGalerkinProduct<SparseMatrixType> galerkin(P, A, P, Ac);
+  VERIFY_IS_APPROX(Ac.toDense(), (refP.transpose() * refA * refP).eval());
+  A.makeCompressed();
+  A.coeffs() *= Scalar(3);
+  galerkin.update(P, A, P, Ac);
+  VERIFY_IS_APPROX(Ac.toDense(), (Scalar(3) * refP.transpose() * refA * refP).eval());
+}
+
+// The independent subtrees of the column elimination tree of SparseLU are factorized concurrently
+template<typename Scalar>
+void sparse_threaded_sparselu(int n)
+{
+  typedef SparseMatrix<Scalar> SparseMatrixType;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  ThreadPoolInterface* pool = getGemmThreadPool();
+
+  // unsymmetric 2D stencil, whose rows are shuffled to require pivoting
+  std::vector<Triplet<Scalar> > triplets;
+  for(int i = 0; i < n; ++i)
+    for(int j = 0; j < n; ++j)
+    {
+      triplets.push_back(Triplet<Scalar>(i*n+j, i*n+j, Scalar(5) + internal::random<Scalar>()));
+      if(i>0) triplets.push_back(Triplet<Scalar>(i*n+j, (i-1)*n+j, internal::random<Scalar>()));
+      if(j>0) triplets.push_back(Triplet<Scalar>(i*n+j, i*n+j-1, internal::random<Scalar>()));
+      if(i+1<n) triplets.push_back(Triplet<Scalar>(i*n+j, (i+1)*n+j, internal::random<Scalar>()));
+    }
+  SparseMatrixType A0(n*n, n*n);
+  A0.setFromTriplets(triplets.begin(), triplets.end());
+  PermutationMatrix<Dynamic,Dynamic,int> P(n*n);
+  P.setIdentity();
+  for(int k = n*n-1; k > 0; --k)
+    P.applyTranspositionOnTheRight(k, internal::random<int>(0,k));
+  SparseMatrixType A = P * A0;
+  DenseMatrix B = DenseMatrix::Random(n*n, 2);
+
+  SparseLU<SparseMatrixType> lu;
+  DenseMatrix ref;
+  {
+    setGemmThreadPool(0);
+    lu.compute(A);
+    VERIFY_IS_EQUAL(lu.info(), Success);
+    ref = lu.solve(B);
+    setGemmThreadPool(pool);
+  }
+  lu.compute(A);
+  VERIFY_IS_EQUAL(lu.info(), Success);
+  DenseMatrix X = lu.solve(B);
+  VERIFY_IS_APPROX(X, ref);
+  VERIFY_IS_APPROX(DenseMatrix(A * X), B);
+
+  // a structurally singular matrix
+  SparseMatrixType S = A;
+  S.col(internal::random<int>(0, n*n-1)) *= Scalar(0);
+  S.prune(Scalar(1));
+  lu.compute(S);
+  VERIFY(lu.info() != Success);
+}
+
+// Compares the solutions of a solver computed with and without the thread pool
+template<typename Solver, typename SparseMatrixType, typename DenseMatrix>
+void sparse_threaded_check_solver(Solver& solver, const SparseMatrixType& A, const DenseMatrix& B)
+{
+  ThreadPoolInterface* pool = getGemmThreadPool();
+  DenseMatrix ref;
+  {
+    setGemmThreadPool(0);
+    solver.compute(A);
+    ref = solver.solve(B);
+    setGemmThreadPool(pool);
+  }
+  solver.compute(A);
+  VERIFY_IS_EQUAL(solver.info(), Success);
+  DenseMatrix X = solver.solve(B);
+  VERIFY_IS_APPROX(X, ref);
+}
+
+// Large triangular factors are solved by levels, the rows of each level being split over the threads
+template<typename Scalar>
+void sparse_threaded_triangular_solve(int n)
+{
+  typedef SparseMatrix<Scalar> SparseMatrixType;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+
+  // 2D Laplacian, with a random unsymmetric perturbation
+  std::vector<Triplet<Scalar> > triplets, unsymTriplets;
+  for(int i = 0; i < n; ++i)
+    for(int j = 0; j < n; ++j)
+    {
+      triplets.push_back(Triplet<Scalar>(i*n+j, i*n+j, Scalar(4.5)));
+      if(i>0) triplets.push_back(Triplet<Scalar>(i*n+j, (i-1)*n+j, Scalar(-1)));
+      if(j>0) triplets.push_back(Triplet<Scalar>(i*n+j, i*n+j-1, Scalar(-1)));
+      if(i+1<n) unsymTriplets.push_back(Triplet<Scalar>(i*n+j, (i+1)*n+j, internal::random<Scalar>()));
+    }
+  SparseMatrixType L(n*n, n*n), A(n*n, n*n), U(n*n, n*n);
+  L.setFromTriplets(triplets.begin(), triplets.end());
+  A = L.template selfadjointView<Lower>();
+  unsymTriplets.insert(unsymTriplets.end(), triplets.begin(), triplets.end());
+  U.setFromTriplets(unsymTriplets.begin(), unsymTriplets.end());
+  DenseMatrix B = DenseMatrix::Random(n*n, 3);
+
+  SparseTriangularSolvePlan<SparseMatrixType,Lower> lower(L);
+  SparseTriangularSolvePlan<SparseMatrixType,Upper> upper(L, true);
+  VERIFY(lower.levels() < n*n);
+  DenseMatrix X = B;
+  lower.solveInPlace(L, X);
+  VERIFY_IS_APPROX(X, DenseMatrix(L.template triangularView<Lower>().solve(B)));
+  DenseMatrix Y = X;
+  upper.solveInPlace(L, Y);
+  VERIFY_IS_APPROX(Y, DenseMatrix(L.adjoint().template triangularView<Upper>().solve(X)));
+
+  IncompleteCholesky<Scalar> ic;
+  sparse_threaded_check_solver(ic, A, B);
+  IncompleteLUT<Scalar> ilut;
+  sparse_threaded_check_solver(ilut, U, B);
+  SimplicialLLT<SparseMatrixType> llt;
+  sparse_threaded_check_solver(llt, A, B);
+  SimplicialLDLT<SparseMatrixType> ldlt;
+  sparse_threaded_check_solver(ldlt, A, B);
+  VERIFY_IS_APPROX(DenseMatrix(A * ldlt.solve(B)), B);
+  SimplicialCholesky<SparseMatrixType> chol;
+  chol.setMode(SimplicialCholeskyLLT);
+  sparse_threaded_check_solver(chol, A, B);
+  VERIFY_IS_APPROX(DenseMatrix(A * chol.solve(B)), B);
+}
+
+EIGEN_DECLARE_TEST(sparse_threaded)
+{
+  ThreadPool pool(4);
+  setGemmThreadPool(&pool);
+
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1(( sparse_threaded_assembly<SparseMatrix<double> >(internal::random<int>(1,500), internal::random<int>(1,500), internal::random<int>(100,20000)) ));
+    CALL_SUBTEST_2(( sparse_threaded_assembly<SparseMatrix<float,RowMajor> >(internal::random<int>(1,500), internal::random<int>(1,500), internal::random<int>(100,20000)) ));
+    CALL_SUBTEST_3(( sparse_threaded_assembly<SparseMatrix<std::complex<double>,ColMajor,long> >(internal::random<int>(1,100), internal::random<int>(1,100), internal::random<int>(100,20000)) ));
+  }
+
+  CALL_SUBTEST_4(( sparse_threaded_supernodal_llt<double>(internal::random<int>(10,60)) ));
+  CALL_SUBTEST_4(( sparse_threaded_supernodal_llt<std::complex<float> >(internal::random<int>(10,30)) ));
+  CALL_SUBTEST_5(( sparse_threaded_sparselu<double>(internal::random<int>(10,60)) ));
+  CALL_SUBTEST_5(( sparse_threaded_sparselu<std::complex<double> >(internal::random<int>(10,30)) ));
+
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_6(( sparse_threaded_dense_product<SparseMatrix<double> >(internal::random<int>(400,700), internal::random<int>(400,700), internal::random<int>(1,4)) ));
+    CALL_SUBTEST_6(( sparse_threaded_dense_product<SparseMatrix<double,RowMajor> >(internal::random<int>(400,700), internal::random<int>(400,700), internal::random<int>(1,4)) ));
+    CALL_SUBTEST_7(( sparse_threaded_dense_product<SparseMatrix<std::complex<float>,ColMajor,long> >(internal::random<int>(200,400), internal::random<int>(200,400), internal::random<int>(1,4)) ));
+    CALL_SUBTEST_7(( sparse_threaded_dense_product<SparseMatrix<std::complex<float>,RowMajor> >(internal::random<int>(200,400), internal::random<int>(200,400), internal::random<int>(1,4)) ));
+  }
+  CALL_SUBTEST_6(( sparse_threaded_dense_product<SparseMatrix<double> >(10, 10, 2) ));
+
+  for(int i = 0; i < g_repeat; i++) {
+    Index rows = internal::random<int>(200,500), depth = internal::random<int>(200,500), cols = internal::random<int>(200,500);
+    CALL_SUBTEST_8(( sparse_threaded_sparse_product<SparseMatrix<double>, SparseMatrix<double> >(rows, depth, cols, 0.05) ));
+    CALL_SUBTEST_8(( sparse_threaded_sparse_product<SparseMatrix<double,RowMajor>, SparseMatrix<double> >(rows, depth, cols, 0.05) ));
+    CALL_SUBTEST_8(( sparse_threaded_sparse_product<SparseMatrix<double>, SparseMatrix<double,RowMajor> >(rows, depth, cols, 0.05) ));
+    CALL_SUBTEST_8(( sparse_threaded_sparse_product<SparseMatrix<double,RowMajor>, SparseMatrix<double,RowMajor> >(rows, depth, cols, 0.05) ));
+    // very sparse columns go to the hash accumulators
+    CALL_SUBTEST_9(( sparse_threaded_sparse_product<SparseMatrix<std::complex<double>,ColMajor,long>, SparseMatrix<std::complex<double>,ColMajor,long> >(10*rows, 10*depth, cols, 0.002) ));
+    CALL_SUBTEST_9(( sparse_threaded_sparse_product<SparseMatrix<float,RowMajor>, SparseMatrix<float,RowMajor> >(rows, 10*depth, 10*cols, 0.002) ));
+    CALL_SUBTEST_10(( sparse_threaded_galerkin_product<SparseMatrix<double> >(rows, depth) ));
+    CALL_SUBTEST_10(( sparse_threaded_galerkin_product<SparseMatrix<std::complex<float>,RowMajor> >(rows, depth) ));
+    EIGEN_UNUSED_VARIABLE(rows);
+    EIGEN_UNUSED_VARIABLE(depth);
+    EIGEN_UNUSED_VARIABLE(cols);
+  }
+
+  CALL_SUBTEST_11(( sparse_threaded_triangular_solve<double>(internal::random<int>(20,50)) ));
+  CALL_SUBTEST_11(( sparse_threaded_triangular_solve<std::complex<float> >(internal::random<int>(10,30)) ));
+
+  // a few triplets are assembled sequentially
+  CALL_SUBTEST_1(( sparse_threaded_assembly<SparseMatrix<double> >(50, 50, 10) ));
+  setNbThreads(2);
+  CALL_SUBTEST_1(( sparse_threaded_assembly<SparseMatrix<double> >(300, 200, 50000) ));
+  setGemmThreadPool(0);
+}
@@ -0,0 +1,97 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "sparse_solver.h"
+
+// 3D Laplacian on a n x n x n grid, whose factor has a large fill-in and large supernodes
+template<typename SparseMatrixType>
+void laplacian_3d(int n, SparseMatrixType& A)
+{
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef typename SparseMatrixType::StorageIndex StorageIndex;
+  std::vector<Triplet<Scalar,StorageIndex> > triplets;
+  const int size = n*n*n;
+  for(int i = 0; i < n; ++i)
+    for(int j = 0; j < n; ++j)
+      for(int k = 0; k < n; ++k)
+      {
+        const int id = (i*n+j)*n+k;
+        triplets.push_back(Triplet<Scalar,StorageIndex>(id, id, Scalar(6.5)));
+        if(i>0) triplets.push_back(Triplet<Scalar,StorageIndex>(id, id-n*n, Scalar(-1)));
+        if(j>0) triplets.push_back(Triplet<Scalar,StorageIndex>(id, id-n, Scalar(-1)));
+        if(k>0) triplets.push_back(Triplet<Scalar,StorageIndex>(id, id-1, Scalar(-1)));
+        if(i<n-1) triplets.push_back(Triplet<Scalar,StorageIndex>(id, id+n*n, Scalar(-1)));
+        if(j<n-1) triplets.push_back(Triplet<Scalar,StorageIndex>(id, id+n, Scalar(-1)));
+        if(k<n-1) triplets.push_back(Triplet<Scalar,StorageIndex>(id, id+1, Scalar(-1)));
+      }
+  A.resize(size, size);
+  A.setFromTriplets(triplets.begin(), triplets.end());
+}
+
+template<typename Solver> void check_supernodal_factor(Solver& solver, int n)
+{
+  typedef typename Solver::MatrixType SparseMatrixType;
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+
+  SparseMatrixType A;
+  laplacian_3d(n, A);
+  solver.compute(A);
+  VERIFY_IS_EQUAL(solver.info(), Success);
+  VERIFY(solver.supernodes() < A.rows());
+
+  // P A P^-1 = L L^*
+  SparseMatrixType PAP;
+  PAP = A.template selfadjointView<Lower>().twistedBy(solver.permutationP());
+  typename Solver::CholMatrixType L = solver.matrixL();
+  DenseMatrix dL = L.toDense();
+  VERIFY_IS_APPROX(DenseMatrix(dL * dL.adjoint()), PAP.toDense());
+
+  // same solution as SimplicialLLT
+  SimplicialLLT<SparseMatrixType> llt(A);
+  DenseMatrix B = DenseMatrix::Random(A.rows(), 3);
+  DenseMatrix X = solver.solve(B);
+  VERIFY_IS_APPROX(X, llt.solve(B));
+  VERIFY_IS_APPROX(A * X, B);
+
+  // without relaxed supernodes
+  solver.setRelaxation(0);
+  solver.compute(A);
+  VERIFY_IS_EQUAL(solver.info(), Success);
+  VERIFY_IS_APPROX(solver.solve(B), X);
+  solver.setRelaxation(16);
+
+  // not positive definite
+  SparseMatrixType mA = -A;
+  solver.compute(mA);
+  VERIFY_IS_EQUAL(solver.info(), NumericalIssue);
+}
+
+template<typename T, typename I_> void test_supernodal_cholesky_T()
+{
+  typedef SparseMatrix<T,0,I_> SparseMatrixType;
+  SupernodalLLT<SparseMatrixType, Lower> llt_colmajor_lower_amd;
+  SupernodalLLT<SparseMatrixType, Upper> llt_colmajor_upper_amd;
+  SupernodalLLT<SparseMatrixType, Lower, NaturalOrdering<I_> > llt_colmajor_lower_nat;
+
+  check_sparse_spd_solving(llt_colmajor_lower_amd);
+  check_sparse_spd_solving(llt_colmajor_upper_amd);
+  check_sparse_spd_solving(llt_colmajor_lower_nat, (std::min)(300,EIGEN_TEST_MAX_SIZE), 1000);
+
+  check_sparse_spd_determinant(llt_colmajor_lower_amd);
+  check_sparse_spd_determinant(llt_colmajor_upper_amd);
+
+  check_supernodal_factor(llt_colmajor_lower_amd, 8);
+  check_supernodal_factor(llt_colmajor_lower_nat, 5);
+}
+
+EIGEN_DECLARE_TEST(supernodal_cholesky)
+{
+  CALL_SUBTEST_1(( test_supernodal_cholesky_T<double,int>() ));
+  CALL_SUBTEST_2(( test_supernodal_cholesky_T<std::complex<double>, int>() ));
+  CALL_SUBTEST_3(( test_supernodal_cholesky_T<double,long int>() ));
+}
@@ -264,6 +264,15 @@ struct vectorization_logic
     VERIFY(test_assign(MatrixXX(10,10),MatrixXX(20,20).block(10,10,2,3),
       SliceVectorizedTraversal,NoUnrolling));
 
+    VERIFY(test_assign(MatrixXX(10,10),MatrixXX(10,10).transpose(),
+      TiledTraversal,NoUnrolling));
+
+    VERIFY(test_assign(MatrixXX(10,10),MatrixXX(10,10).transpose()+MatrixXX(10,10),
+      TiledTraversal,NoUnrolling));
+
+    VERIFY(test_assign(MatrixXX(10,10),Matrix<Scalar,Dynamic,Dynamic,RowMajor>(10,10),
+      TiledTraversal,NoUnrolling));
+
     VERIFY(test_redux(VectorX(10),
       LinearVectorizedTraversal,NoUnrolling));
   }
@@ -25,8 +25,8 @@ template<typename Dimensions, typename LhsXprType, typename RhsXprType, typename
 struct traits<TensorContractionOp<Dimensions, LhsXprType, RhsXprType, OutputKernelType> >
 {
   // Type promotion to handle the case where the types of the lhs and the rhs are different.
-  typedef typename gebp_traits<typename remove_const<typename LhsXprType::Scalar>::type,
-                               typename remove_const<typename RhsXprType::Scalar>::type>::ResScalar Scalar;
+  typedef typename tensor_contraction_scalars<typename LhsXprType::Scalar,
+                                              typename RhsXprType::Scalar>::ResScalar Scalar;
 
   typedef typename promote_storage_type<typename traits<LhsXprType>::StorageKind,
                                         typename traits<RhsXprType>::StorageKind>::ret StorageKind;
@@ -274,6 +274,127 @@ struct TensorContractionKernel {
   const StorageIndex bn;
 };
 
+// Contraction kernel of 8-bit and 16-bit integer tensors (see QuantizedProduct.h): the
+// packed blocks hold pairs of coefficients along the contraction dimension,
+// and the products are accumulated into 32-bit integers.
+template <typename LhsScalar, typename RhsScalar, typename StorageIndex,
+          typename OutputMapper, typename LhsMapper, typename RhsMapper>
+struct TensorContractionQuantizedKernel {
+  enum { HasBeta = false };
+
+  EIGEN_DEVICE_FUNC
+  TensorContractionQuantizedKernel(StorageIndex m_, StorageIndex k_, StorageIndex n_,
+                                   StorageIndex bm_, StorageIndex bk_, StorageIndex bn_)
+      : m(m_), k(k_), n(n_), bm(bm_), bk(bk_), bn(bn_) {}
+
+  typedef int* LhsBlock;
+  typedef int* RhsBlock;
+
+  typedef TensorContractionBlockMemAllocator<int, int> BlockMemAllocator;
+  typedef typename BlockMemAllocator::BlockMemHandle BlockMemHandle;
+
+  typedef internal::quantized_gemm_traits Traits;
+
+  typedef internal::quantized_gemm_pack_lhs<
+      LhsScalar, StorageIndex, typename LhsMapper::SubMapper>
+      LhsPacker;
+
+  typedef internal::quantized_gemm_pack_rhs<
+      RhsScalar, StorageIndex, typename RhsMapper::SubMapper>
+      RhsPacker;
+
+  typedef internal::quantized_gebp_kernel<StorageIndex, OutputMapper>
+      GebpKernel;
+
+  template <typename Device>
+  EIGEN_DEVICE_FUNC BlockMemHandle allocate(Device& d, LhsBlock* lhs_block,
+                                            RhsBlock* rhs_block) {
+    return BlockMemAllocator::allocate(d, packedRows(), packedDepth(), bn,
+                                       lhs_block, rhs_block);
+  }
+
+  template <typename Device>
+  EIGEN_DEVICE_FUNC BlockMemHandle allocateSlices(
+      Device& d, const StorageIndex num_lhs, const StorageIndex num_rhs,
+      const StorageIndex num_slices, std::vector<LhsBlock>* lhs_blocks,
+      std::vector<RhsBlock>* rhs_blocks) {
+    return BlockMemAllocator::allocateSlices(
+        d, packedRows(), packedDepth(), bn, num_lhs, num_rhs, num_slices,
+        lhs_blocks, rhs_blocks);
+  }
+
+  template <typename Device>
+  EIGEN_DEVICE_FUNC static void deallocate(Device& d, BlockMemHandle handle) {
+    BlockMemAllocator::deallocate(d, handle);
+  }
+
+  EIGEN_DEVICE_FUNC EIGEN_DONT_INLINE void packLhs(
+      LhsBlock* lhsBlock, const typename LhsMapper::SubMapper& data_mapper,
+      const StorageIndex depth, const StorageIndex rows) {
+    LhsPacker()(*lhsBlock, data_mapper, depth, rows);
+  }
+
+  EIGEN_DEVICE_FUNC EIGEN_DONT_INLINE void packRhs(
+      RhsBlock* rhsBlock, const typename RhsMapper::SubMapper& data_mapper,
+      const StorageIndex depth, const StorageIndex cols) {
+    RhsPacker()(*rhsBlock, data_mapper, depth, cols);
+  }
+
+  EIGEN_DEVICE_FUNC EIGEN_DONT_INLINE void invoke(
+      const OutputMapper& output_mapper, const LhsBlock& lhsBlock,
+      const RhsBlock& rhsBlock, const StorageIndex rows,
+      const StorageIndex depth, const StorageIndex cols,
+      const int alpha, const int beta) {
+    // The integer kernel accumulates into the output without any scaling.
+    eigen_assert(alpha == 1 && beta == 1);
+    EIGEN_UNUSED_VARIABLE(alpha);
+    EIGEN_UNUSED_VARIABLE(beta);
+    GebpKernel()(output_mapper, lhsBlock, rhsBlock, rows, depth, cols);
+  }
+
+ private:
+  // The packed lhs panels are padded to a multiple of mr rows, and both
+  // operands are packed as pairs of coefficients along the depth.
+  StorageIndex packedRows() const { return divup<StorageIndex>(bm, Traits::mr) * Traits::mr; }
+  StorageIndex packedDepth() const { return divup<StorageIndex>(bk, 2); }
+
+  const StorageIndex m;
+  const StorageIndex k;
+  const StorageIndex n;
+  const StorageIndex bm;
+  const StorageIndex bk;
+  const StorageIndex bn;
+};
+
+#define EIGEN_TENSOR_CONTRACTION_QUANTIZED_KERNEL(LHS, RHS)                   \
+  template <typename StorageIndex, typename OutputMapper, typename LhsMapper, \
+            typename RhsMapper>                                               \
+  struct TensorContractionKernel<int, LHS, RHS, StorageIndex, OutputMapper,   \
+                                 LhsMapper, RhsMapper>                        \
+      : TensorContractionQuantizedKernel<LHS, RHS, StorageIndex,              \
+                                         OutputMapper, LhsMapper, RhsMapper> { \
+    typedef TensorContractionQuantizedKernel<LHS, RHS, StorageIndex,          \
+                                             OutputMapper, LhsMapper,         \
+                                             RhsMapper> Base;                 \
+    EIGEN_DEVICE_FUNC                                                         \
+    TensorContractionKernel(StorageIndex m_, StorageIndex k_, StorageIndex n_, \
+                            StorageIndex bm_, StorageIndex bk_,               \
+                            StorageIndex bn_)                                 \
+        : Base(m_, k_, n_, bm_, bk_, bn_) {}                                  \
+  };
+
+EIGEN_TENSOR_CONTRACTION_QUANTIZED_KERNEL(signed char, signed char)
+EIGEN_TENSOR_CONTRACTION_QUANTIZED_KERNEL(signed char, unsigned char)
+EIGEN_TENSOR_CONTRACTION_QUANTIZED_KERNEL(signed char, short)
+EIGEN_TENSOR_CONTRACTION_QUANTIZED_KERNEL(unsigned char, signed char)
+EIGEN_TENSOR_CONTRACTION_QUANTIZED_KERNEL(unsigned char, unsigned char)
+EIGEN_TENSOR_CONTRACTION_QUANTIZED_KERNEL(unsigned char, short)
+EIGEN_TENSOR_CONTRACTION_QUANTIZED_KERNEL(short, signed char)
+EIGEN_TENSOR_CONTRACTION_QUANTIZED_KERNEL(short, unsigned char)
+EIGEN_TENSOR_CONTRACTION_QUANTIZED_KERNEL(short, short)
+
+#undef EIGEN_TENSOR_CONTRACTION_QUANTIZED_KERNEL
+
 }  // end namespace internal
 
 // Tensor contraction params that should enable to get from output matrix
@@ -326,8 +447,8 @@ class TensorContractionOp : public TensorBase<TensorContractionOp<Indices, LhsXp
 {
   public:
   typedef typename Eigen::internal::traits<TensorContractionOp>::Scalar Scalar;
-  typedef typename internal::gebp_traits<typename LhsXprType::CoeffReturnType,
-                                         typename RhsXprType::CoeffReturnType>::ResScalar CoeffReturnType;
+  typedef typename internal::tensor_contraction_scalars<typename LhsXprType::CoeffReturnType,
+                                                        typename RhsXprType::CoeffReturnType>::ResScalar CoeffReturnType;
   typedef typename Eigen::internal::nested<TensorContractionOp>::type Nested;
   typedef typename Eigen::internal::traits<TensorContractionOp>::StorageKind StorageKind;
   typedef typename Eigen::internal::traits<TensorContractionOp>::Index Index;
@@ -712,15 +833,34 @@ struct TensorContractionEvaluatorBase
             bool rhs_inner_dim_reordered, int Alignment>
   void evalProductSequential(Scalar* buffer) const {
     if (this->m_j_size == 1) {
-      this->template evalGemv<lhs_inner_dim_contiguous,
-                              rhs_inner_dim_contiguous, rhs_inner_dim_reordered,
-                              Alignment>(buffer);
+      this->template evalGemvIfSupported<lhs_inner_dim_contiguous,
+                                         rhs_inner_dim_contiguous, rhs_inner_dim_reordered,
+                                         Alignment>(buffer, HasGemv());
     } else {
       this->template evalGemm<lhs_inner_dim_contiguous, rhs_inner_dim_contiguous,
                               rhs_inner_dim_reordered, Alignment>(buffer);
     }
   }
 
+  // There is no matrix-vector product for the quantized scalar types, their
+  // contractions always go through the matrix kernels.
+  typedef typename internal::conditional<
+      internal::tensor_contraction_scalars<typename EvalLeftArgType::Scalar,
+                                           typename EvalRightArgType::Scalar>::IsQuantized,
+      internal::false_type, internal::true_type>::type HasGemv;
+
+  template <bool lhs_inner_dim_contiguous, bool rhs_inner_dim_contiguous, bool rhs_inner_dim_reordered, int Alignment>
+  void evalGemvIfSupported(Scalar* buffer, internal::true_type) const {
+    this->template evalGemv<lhs_inner_dim_contiguous, rhs_inner_dim_contiguous,
+                            rhs_inner_dim_reordered, Alignment>(buffer);
+  }
+
+  template <bool lhs_inner_dim_contiguous, bool rhs_inner_dim_contiguous, bool rhs_inner_dim_reordered, int Alignment>
+  void evalGemvIfSupported(Scalar* buffer, internal::false_type) const {
+    this->template evalGemm<lhs_inner_dim_contiguous, rhs_inner_dim_contiguous,
+                            rhs_inner_dim_reordered, Alignment>(buffer);
+  }
+
   template <bool lhs_inner_dim_contiguous, bool rhs_inner_dim_contiguous, bool rhs_inner_dim_reordered, int Alignment>
   #if !defined(EIGEN_HIPCC)
   EIGEN_DEVICE_FUNC
@@ -20,6 +20,22 @@ enum {
 };
 
 
+// Scalar types of the contraction of tensors of LhsScalar and RhsScalar. The
+// contractions of 8-bit and 16-bit integers are computed by the quantized
+// kernels of QuantizedProduct.h: they are accumulated into 32-bit integers, and
+// their packed operands hold 16-bit integers, for which the blocking sizes must
+// be computed.
+template<typename LhsScalar, typename RhsScalar>
+struct tensor_contraction_scalars {
+  typedef typename remove_const<LhsScalar>::type Lhs;
+  typedef typename remove_const<RhsScalar>::type Rhs;
+  enum { IsQuantized = is_quantized_scalar<Lhs>::value && is_quantized_scalar<Rhs>::value };
+  typedef typename conditional<IsQuantized, short, Lhs>::type PackedLhsScalar;
+  typedef typename conditional<IsQuantized, short, Rhs>::type PackedRhsScalar;
+  typedef typename conditional<IsQuantized, int,
+      typename gebp_traits<PackedLhsScalar, PackedRhsScalar>::ResScalar>::type ResScalar;
+};
+
 // Default Blocking Strategy
 template<typename ResScalar, typename LhsScalar, typename RhsScalar, typename StorageIndex, int ShardingType = ShardByCol>
 class TensorContractionBlocking {
@@ -45,14 +61,16 @@ class TensorContractionBlocking {
  TensorContractionBlocking(StorageIndex k, StorageIndex m, StorageIndex n, StorageIndex num_threads = 1) :
       kc_(k), mc_(m), nc_(n)
   {
+    typedef typename tensor_contraction_scalars<LhsScalar, RhsScalar>::PackedLhsScalar PackedLhsScalar;
+    typedef typename tensor_contraction_scalars<LhsScalar, RhsScalar>::PackedRhsScalar PackedRhsScalar;
     if (ShardingType == ShardByCol) {
-      computeProductBlockingSizes<LhsScalar, RhsScalar, 1>(kc_, mc_, nc_, num_threads);
+      computeProductBlockingSizes<PackedLhsScalar, PackedRhsScalar, 1>(kc_, mc_, nc_, num_threads);
     }
     else {
-      computeProductBlockingSizes<LhsScalar, RhsScalar, 1>(kc_, nc_, mc_, num_threads);
+      computeProductBlockingSizes<PackedLhsScalar, PackedRhsScalar, 1>(kc_, nc_, mc_, num_threads);
     }
 
-    const int rhs_packet_size = internal::packet_traits<RhsScalar>::size;
+    const int rhs_packet_size = internal::packet_traits<PackedRhsScalar>::size;
     kc_ = (rhs_packet_size <= 8 || kc_ <= rhs_packet_size) ?
       kc_ : (kc_ / rhs_packet_size) * rhs_packet_size;
   }
@@ -63,7 +63,9 @@ struct TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgT
   // typedefs needed in evalTo
   typedef typename internal::remove_const<typename EvalLeftArgType::Scalar>::type LhsScalar;
   typedef typename internal::remove_const<typename EvalRightArgType::Scalar>::type RhsScalar;
-  typedef typename internal::gebp_traits<LhsScalar, RhsScalar> Traits;
+  typedef typename internal::tensor_contraction_scalars<LhsScalar, RhsScalar> ContractionScalars;
+  typedef typename internal::gebp_traits<typename ContractionScalars::PackedLhsScalar,
+                                         typename ContractionScalars::PackedRhsScalar> Traits;
 
   typedef TensorEvaluator<EvalLeftArgType, Device> LeftEvaluator;
   typedef TensorEvaluator<EvalRightArgType, Device> RightEvaluator;
@@ -56,11 +56,11 @@ template<typename _Scalar, int _BlockAtCompileTime=Dynamic, int _Options=ColMajo
 template<typename BlockSparseMatrixT> class BlockSparseMatrixView;
 
 namespace internal {
-template<typename _Scalar, int _BlockAtCompileTime, int _Options, typename _Index>
-struct traits<BlockSparseMatrix<_Scalar,_BlockAtCompileTime,_Options, _Index> >
+template<typename _Scalar, int _BlockAtCompileTime, int _Options, typename _StorageIndex>
+struct traits<BlockSparseMatrix<_Scalar,_BlockAtCompileTime,_Options, _StorageIndex> >
 {
   typedef _Scalar Scalar;
-  typedef _Index Index;
+  typedef _StorageIndex StorageIndex;
   typedef Sparse StorageKind; // FIXME Where is it used ??
   typedef MatrixXpr XprKind;
   enum {
@@ -236,50 +236,66 @@ class BlockVectorReturn
     VectorType& m_vec;
 };
 
-// Block version of the sparse dense product
-template<typename Lhs, typename Rhs>
-class BlockSparseTimeDenseProduct;
-
 namespace internal {
 
-template<typename BlockSparseMatrixT, typename VecType>
-struct traits<BlockSparseTimeDenseProduct<BlockSparseMatrixT, VecType> >
+/** \internal
+  * Block version of the sparse dense product: computes the products of the blocks of a range of outer blocks of a
+  * BlockSparseMatrix by \a rhs. The blocks are mapped as \a B x \a B matrices, so that the products of fixed-size blocks
+  * are fully unrolled, and \a B is Dynamic for blocks whose size is only known at runtime.
+  */
+template<typename BlockSparseMatrixT, int B, typename Rhs, typename Res>
+struct block_sparse_time_dense_kernel
 {
-  typedef Dense StorageKind;
-  typedef MatrixXpr XprKind;
   typedef typename BlockSparseMatrixT::Scalar Scalar;
-  typedef typename BlockSparseMatrixT::Index Index;
-  enum {
-    RowsAtCompileTime = Dynamic,
-    ColsAtCompileTime = Dynamic,
-    MaxRowsAtCompileTime = Dynamic,
-    MaxColsAtCompileTime = Dynamic,
-    Flags = 0,
-    CoeffReadCost = internal::traits<BlockSparseMatrixT>::CoeffReadCost
-  };
-};
-} // end namespace internal
-
-template<typename Lhs, typename Rhs>
-class BlockSparseTimeDenseProduct
-  : public ProductBase<BlockSparseTimeDenseProduct<Lhs,Rhs>, Lhs, Rhs>
-{
-  public:
-    EIGEN_PRODUCT_PUBLIC_INTERFACE(BlockSparseTimeDenseProduct)
+  typedef typename BlockSparseMatrixT::StorageIndex StorageIndex;
+  typedef Map<const Matrix<Scalar,B,B,BlockSparseMatrixT::IsColMajor ? ColMajor : RowMajor> > BlockMap;
+
+  block_sparse_time_dense_kernel(const BlockSparseMatrixT& lhs, const Rhs& rhs, Res& res, const Scalar& alpha)
+    : m_lhs(lhs), m_rhs(rhs), m_res(res), m_alpha(alpha) {}
+
+  // dst(rows of the block bi) += alpha * block * rhs(columns of the block bj)
+  template<typename Dest>
+  void addBlock(Dest& dst, Index bi, Index bj, Index id) const
+  {
+    const Index rowStart = m_lhs.blockRowsIndex(bi), rowSize = m_lhs.blockRowsIndex(bi+1) - rowStart;
+    const Index colStart = m_lhs.blockColsIndex(bj), colSize = m_lhs.blockColsIndex(bj+1) - colStart;
+    BlockMap block(m_lhs.valuePtr() + m_lhs.blockPtr(id), rowSize, colSize);
+    if(B==Dynamic)
+      dst.middleRows(rowStart, rowSize).noalias() += m_alpha * block * m_rhs.middleRows(colStart, colSize);
+    else
+      dst.template middleRows<B>(rowStart, rowSize).noalias()
+        += m_alpha * block.lazyProduct(m_rhs.template middleRows<B>(colStart, colSize));
+  }
 
-    BlockSparseTimeDenseProduct(const Lhs& lhs, const Rhs& rhs) : Base(lhs,rhs)
-    {}
+  // block rows begin to end-1 of a row-major lhs
+  void run(Index begin, Index end) const
+  {
+    const StorageIndex* outerIndex = m_lhs.outerIndexPtr();
+    const StorageIndex* innerIndex = m_lhs.innerIndexPtr();
+    for(Index bi=begin; bi<end; ++bi)
+      for(Index id=outerIndex[bi]; id<outerIndex[bi+1]; ++id)
+        addBlock(m_res, bi, innerIndex[id], id);
+  }
 
-    template<typename Dest> void scaleAndAddTo(Dest& dest, const typename Rhs::Scalar& alpha) const
-    {
-      BlockVectorReturn<Lhs,Dest> tmpDest(m_lhs, dest);
-      internal::sparse_time_dense_product( BlockSparseMatrixView<Lhs>(m_lhs),  BlockVectorView<Lhs, Rhs>(m_lhs, m_rhs), tmpDest, alpha);
-    }
+  // scatter of the block columns begin to end-1 of a column-major lhs into dst
+  template<typename Dest>
+  void run(Index begin, Index end, Dest& dst) const
+  {
+    const StorageIndex* outerIndex = m_lhs.outerIndexPtr();
+    const StorageIndex* innerIndex = m_lhs.innerIndexPtr();
+    for(Index bj=begin; bj<end; ++bj)
+      for(Index id=outerIndex[bj]; id<outerIndex[bj+1]; ++id)
+        addBlock(dst, innerIndex[id], bj, id);
+  }
 
-  private:
-    BlockSparseTimeDenseProduct& operator=(const BlockSparseTimeDenseProduct&);
+  const BlockSparseMatrixT& m_lhs;
+  const Rhs& m_rhs;
+  Res& m_res;
+  const Scalar& m_alpha;
 };
 
+} // end namespace internal
+
 template<typename _Scalar, int _BlockAtCompileTime, int _Options, typename _StorageIndex>
 class BlockSparseMatrix : public SparseMatrixBase<BlockSparseMatrix<_Scalar,_BlockAtCompileTime, _Options,_StorageIndex> >
 {
@@ -308,7 +324,7 @@ class BlockSparseMatrix : public SparseMatrixBase<BlockSparseMatrix<_Scalar,_Blo
     // Default constructor
     BlockSparseMatrix()
     : m_innerBSize(0),m_outerBSize(0),m_innerOffset(0),m_outerOffset(0),
-      m_nonzerosblocks(0),m_values(0),m_blockPtr(0),m_indices(0),
+      m_nonzerosblocks(0),m_nonzeros(0),m_values(0),m_blockPtr(0),m_indices(0),
       m_outerIndex(0),m_blockSize(BlockSize)
     { }
 
@@ -320,7 +336,7 @@ class BlockSparseMatrix : public SparseMatrixBase<BlockSparseMatrix<_Scalar,_Blo
     BlockSparseMatrix(Index brow, Index bcol)
       : m_innerBSize(IsColMajor ? brow : bcol),
         m_outerBSize(IsColMajor ? bcol : brow),
-        m_innerOffset(0),m_outerOffset(0),m_nonzerosblocks(0),
+        m_innerOffset(0),m_outerOffset(0),m_nonzerosblocks(0),m_nonzeros(0),
         m_values(0),m_blockPtr(0),m_indices(0),
         m_outerIndex(0),m_blockSize(BlockSize)
     { }
@@ -330,22 +346,15 @@ class BlockSparseMatrix : public SparseMatrixBase<BlockSparseMatrix<_Scalar,_Blo
      */
     BlockSparseMatrix(const BlockSparseMatrix& other)
       : m_innerBSize(other.m_innerBSize),m_outerBSize(other.m_outerBSize),
+        m_innerOffset(copyArray(other.m_innerOffset, m_innerBSize+1)),
+        m_outerOffset(copyArray(other.m_outerOffset, m_outerBSize+1)),
         m_nonzerosblocks(other.m_nonzerosblocks),m_nonzeros(other.m_nonzeros),
-        m_blockPtr(0),m_blockSize(other.m_blockSize)
-    {
-      // should we allow copying between variable-size blocks and fixed-size blocks ??
-      eigen_assert(m_blockSize == BlockSize && " CAN NOT COPY BETWEEN FIXED-SIZE AND VARIABLE-SIZE BLOCKS");
-
-      std::copy(other.m_innerOffset, other.m_innerOffset+m_innerBSize+1, m_innerOffset);
-      std::copy(other.m_outerOffset, other.m_outerOffset+m_outerBSize+1, m_outerOffset);
-      std::copy(other.m_values, other.m_values+m_nonzeros, m_values);
-
-      if(m_blockSize != Dynamic)
-        std::copy(other.m_blockPtr, other.m_blockPtr+m_nonzerosblocks, m_blockPtr);
-
-      std::copy(other.m_indices, other.m_indices+m_nonzerosblocks, m_indices);
-      std::copy(other.m_outerIndex, other.m_outerIndex+m_outerBSize, m_outerIndex);
-    }
+        m_values(copyArray(other.m_values, m_nonzeros)),
+        m_blockPtr(copyArray(other.m_blockPtr, m_nonzerosblocks+1)),
+        m_indices(copyArray(other.m_indices, m_nonzerosblocks+1)),
+        m_outerIndex(copyArray(other.m_outerIndex, m_outerBSize+1)),
+        m_blockSize(other.m_blockSize)
+    { }
 
     friend void swap(BlockSparseMatrix& first, BlockSparseMatrix& second)
     {
@@ -359,7 +368,7 @@ class BlockSparseMatrix : public SparseMatrixBase<BlockSparseMatrix<_Scalar,_Blo
       std::swap(first.m_blockPtr, second.m_blockPtr);
       std::swap(first.m_indices, second.m_indices);
       std::swap(first.m_outerIndex, second.m_outerIndex);
-      std::swap(first.m_BlockSize, second.m_blockSize);
+      std::swap(first.m_blockSize, second.m_blockSize);
     }
 
     BlockSparseMatrix& operator=(BlockSparseMatrix other)
@@ -382,33 +391,43 @@ class BlockSparseMatrix : public SparseMatrixBase<BlockSparseMatrix<_Scalar,_Blo
 
 
     /**
-      * \brief Constructor from a sparse matrix
+      * \brief Constructor from a sparse matrix, for fixed-size blocks
       *
+      * The numbers of rows and columns of \a other must be multiples of the block size.
       */
-    template<typename MatrixType>
-    inline BlockSparseMatrix(const MatrixType& spmat) : m_blockSize(BlockSize)
+    template<typename OtherDerived>
+    inline BlockSparseMatrix(const SparseMatrixBase<OtherDerived>& other)
+      : m_innerBSize(0),m_outerBSize(0),m_innerOffset(0),m_outerOffset(0),
+        m_nonzerosblocks(0),m_nonzeros(0),m_values(0),m_blockPtr(0),m_indices(0),
+        m_outerIndex(0),m_blockSize(BlockSize)
     {
-      EIGEN_STATIC_ASSERT((m_blockSize != Dynamic), THIS_METHOD_IS_ONLY_FOR_FIXED_SIZE);
-
-      *this = spmat;
+      EIGEN_STATIC_ASSERT((BlockSize != Dynamic), THIS_METHOD_IS_ONLY_FOR_FIXED_SIZE);
+      eigen_assert(other.rows()%BlockSize==0 && other.cols()%BlockSize==0 && "the sizes must be multiples of the block size");
+      resize(other.rows()/BlockSize, other.cols()/BlockSize);
+      *this = other;
     }
 
     /**
-      * \brief Assignment from a sparse matrix with the same storage order
+      * \brief Assignment from a sparse matrix
       *
-      * Convert from a sparse matrix to block sparse matrix.
+      * Convert from a sparse matrix to block sparse matrix. Each block containing at least one
+      * nonzero of \a other is stored as a dense block.
       * \warning Before calling this function, tt is necessary to call
       * either setBlockLayout() (matrices with variable-size blocks)
       * or setBlockSize() (for fixed-size blocks).
+      *
+      * A BlockSparseMatrix is converted back to a SparseMatrix by the constructors and assignment operators of SparseMatrix.
       */
-    template<typename MatrixType>
-    inline BlockSparseMatrix& operator=(const MatrixType& spmat)
+    template<typename OtherDerived>
+    inline BlockSparseMatrix& operator=(const SparseMatrixBase<OtherDerived>& other)
     {
       eigen_assert((m_innerBSize != 0 && m_outerBSize != 0)
                    && "Trying to assign to a zero-size matrix, call resize() first");
-      eigen_assert(((MatrixType::Options&RowMajorBit) != IsColMajor) && "Wrong storage order");
-      typedef SparseMatrix<bool,MatrixType::Options,typename MatrixType::Index> MatrixPatternType;
-      MatrixPatternType  blockPattern(blockRows(), blockCols());
+      eigen_assert(other.rows()==rows() && other.cols()==cols());
+      typedef SparseMatrix<Scalar,IsColMajor ? ColMajor : RowMajor,StorageIndex> MatrixType;
+      const MatrixType spmat(other.derived());
+      typedef SparseMatrix<bool,IsColMajor ? ColMajor : RowMajor,StorageIndex> MatrixPatternType;
+      MatrixPatternType  blockPattern(IsColMajor ? m_innerBSize : m_outerBSize, IsColMajor ? m_outerBSize : m_innerBSize);
       m_nonzeros = 0;
 
       // First, compute the number of nonzero blocks and their locations
@@ -459,7 +478,7 @@ class BlockSparseMatrix : public SparseMatrixBase<BlockSparseMatrix<_Scalar,_Blo
               // Offset from all blocks before ...
               idxVal =  m_blockPtr[m_outerIndex[bj]+idx];
               // ... and offset inside the block
-              idxVal += (j - blockOuterIndex(bj)) * blockOuterSize(bj) + it_spmat.index() - m_innerOffset[bi];
+              idxVal += (j - blockOuterIndex(bj)) * blockInnerSize(bi) + it_spmat.index() - m_innerOffset[bi];
             }
             else
             {
@@ -498,6 +517,14 @@ class BlockSparseMatrix : public SparseMatrixBase<BlockSparseMatrix<_Scalar,_Blo
     void setBlockStructure(const MatrixType& blockPattern)
     {
       resize(blockPattern.rows(), blockPattern.cols());
+      if(m_blockSize == Dynamic)
+      {
+        // the number of nonzeros of the blocks of the pattern
+        m_nonzeros = 0;
+        for(StorageIndex bj = 0; bj < m_outerBSize; ++bj)
+          for(typename MatrixType::InnerIterator it(blockPattern, bj); it; ++it)
+            m_nonzeros += blockOuterSize(bj) * blockInnerSize(IsColMajor ? it.row() : it.col());
+      }
       reserve(blockPattern.nonZeros());
 
       // Browse the block pattern and set up the various pointers
@@ -519,16 +546,16 @@ class BlockSparseMatrix : public SparseMatrixBase<BlockSparseMatrix<_Scalar,_Blo
         std::sort(nzBlockIdx.begin(), nzBlockIdx.end());
 
         // Now, fill block indices and (eventually) pointers to blocks
-        for(StorageIndex idx = 0; idx < nzBlockIdx.size(); ++idx)
+        for(StorageIndex idx = 0; idx < StorageIndex(nzBlockIdx.size()); ++idx)
         {
           StorageIndex offset = m_outerIndex[bj]+idx; // offset in m_indices
           m_indices[offset] = nzBlockIdx[idx];
           if(m_blockSize == Dynamic)
-            m_blockPtr[offset] = m_blockPtr[offset-1] + blockInnerSize(nzBlockIdx[idx]) * blockOuterSize(bj);
+            m_blockPtr[offset+1] = StorageIndex(m_blockPtr[offset] + blockInnerSize(nzBlockIdx[idx]) * blockOuterSize(bj));
           // There is no blockPtr for fixed-size blocks... not needed !???
         }
         // Save the pointer to the next outer block
-        m_outerIndex[bj+1] = m_outerIndex[bj] + nzBlockIdx.size();
+        m_outerIndex[bj+1] = StorageIndex(m_outerIndex[bj] + nzBlockIdx.size());
       }
     }
 
@@ -568,6 +595,8 @@ class BlockSparseMatrix : public SparseMatrixBase<BlockSparseMatrix<_Scalar,_Blo
       eigen_assert(m_outerBSize == outerBlocks.size() && "CHECK THE NUMBER OF ROW OR COLUMN BLOCKS");
       m_outerBSize = outerBlocks.size();
       //  starting index of blocks... cumulative sums
+      delete[] m_innerOffset;
+      delete[] m_outerOffset;
       m_innerOffset = new StorageIndex[m_innerBSize+1];
       m_outerOffset = new StorageIndex[m_outerBSize+1];
       m_innerOffset[0] = 0;
@@ -598,7 +627,10 @@ class BlockSparseMatrix : public SparseMatrixBase<BlockSparseMatrix<_Scalar,_Blo
       eigen_assert((m_innerBSize != 0 && m_outerBSize != 0) &&
           "TRYING TO RESERVE ZERO-SIZE MATRICES, CALL resize() first");
 
-      //FIXME Should free if already allocated
+      delete[] m_outerIndex;
+      delete[] m_blockPtr;
+      delete[] m_indices;
+      delete[] m_values;
       m_outerIndex = new StorageIndex[m_outerBSize+1];
 
       m_nonzerosblocks = nonzerosblocks;
@@ -668,7 +700,11 @@ class BlockSparseMatrix : public SparseMatrixBase<BlockSparseMatrix<_Scalar,_Blo
         nzblock_outer(IsColMajor ? it->col() : it->row())++;
       }
       // Allocate member arrays
-      if(m_blockSize == Dynamic) setBlockLayout(rowBlocks, colBlocks);
+      if(m_blockSize == Dynamic)
+      {
+        setBlockLayout(rowBlocks, colBlocks);
+        m_nonzeros = nz_outer.sum();
+      }
       StorageIndex nzblocks = nzblock_outer.sum();
       reserve(nzblocks);
 
@@ -703,6 +739,8 @@ class BlockSparseMatrix : public SparseMatrixBase<BlockSparseMatrix<_Scalar,_Blo
         }
         block_id(outer)++;
       }
+      if(m_blockSize == Dynamic)
+        m_nonzeros = m_blockPtr[nzblocks];
 
       // An alternative when the outer indices are sorted...no need to use an array of markers
 //      for(Index bcol = 0; bcol < m_outerBSize; ++bcol)
@@ -815,15 +853,9 @@ class BlockSparseMatrix : public SparseMatrixBase<BlockSparseMatrix<_Scalar,_Blo
       StorageIndex offset = m_outerIndex[outer];
       while(offset < m_outerIndex[outer+1] && m_indices[offset] != inner)
         offset++;
-      if(m_indices[offset] == inner)
-      {
-        return Map<BlockScalar>(&(m_values[blockPtr(offset)]), rsize, csize);
-      }
-      else
-      {
-        //FIXME the block does not exist, Insert it !!!!!!!!!
-        eigen_assert("DYNAMIC INSERTION IS NOT YET SUPPORTED");
-      }
+      //FIXME the block does not exist, Insert it !!!!!!!!!
+      eigen_assert(offset < m_outerIndex[outer+1] && "DYNAMIC INSERTION IS NOT YET SUPPORTED");
+      return Map<BlockScalar>(&(m_values[blockPtr(offset)]), rsize, csize);
     }
 
     /**
@@ -840,20 +872,40 @@ class BlockSparseMatrix : public SparseMatrixBase<BlockSparseMatrix<_Scalar,_Blo
       StorageIndex outer = IsColMajor ? bcol : brow;
       StorageIndex offset = m_outerIndex[outer];
       while(offset < m_outerIndex[outer+1] && m_indices[offset] != inner) offset++;
-      if(m_indices[offset] == inner)
-      {
-        return Map<const BlockScalar> (&(m_values[blockPtr(offset)]), rsize, csize);
-      }
-      else
 //        return BlockScalar::Zero(rsize, csize);
-        eigen_assert("NOT YET SUPPORTED");
+      eigen_assert(offset < m_outerIndex[outer+1] && "NOT YET SUPPORTED");
+      return Map<const BlockScalar> (&(m_values[blockPtr(offset)]), rsize, csize);
     }
 
-    // Block Matrix times vector product
-    template<typename VecType>
-    BlockSparseTimeDenseProduct<BlockSparseMatrix, VecType> operator*(const VecType& lhs) const
+    /**
+      * \returns the product of \c *this by the dense vector or matrix \a rhs
+      *
+      * The blocks are multiplied by fixed-size kernels when their size is known at compile time, or when it is given at
+      * runtime by setBlockSize() and is 2, 3, 4 or 6. The large products run on several threads (see \ref TopicMultiThreading).
+      */
+    template<typename Rhs>
+    Product<BlockSparseMatrix,Rhs,AliasFreeProduct> operator*(const MatrixBase<Rhs>& rhs) const
     {
-      return BlockSparseTimeDenseProduct<BlockSparseMatrix, VecType>(*this, lhs);
+      eigen_assert(cols()==rhs.rows() && "invalid matrix product");
+      return Product<BlockSparseMatrix,Rhs,AliasFreeProduct>(*this, rhs.derived());
+    }
+
+    /** \internal Adds \a alpha times \c *this times \a rhs to \a dst, see operator*() */
+    template<typename Rhs, typename Dest>
+    void scaleAndAddTo(Dest& dst, const Rhs& rhs, const Scalar& alpha) const
+    {
+      // the blocks of uniform size are mapped as fixed-size matrices
+      enum { B = BlockSize==Dynamic ? 2 : BlockSize };
+      if(BlockSize!=Dynamic || m_blockSize==2)
+        blockProduct<B>(dst, rhs, alpha);
+      else if(m_blockSize==3)
+        blockProduct<BlockSize==Dynamic ? 3 : BlockSize>(dst, rhs, alpha);
+      else if(m_blockSize==4)
+        blockProduct<BlockSize==Dynamic ? 4 : BlockSize>(dst, rhs, alpha);
+      else if(m_blockSize==6)
+        blockProduct<BlockSize==Dynamic ? 6 : BlockSize>(dst, rhs, alpha);
+      else
+        blockProduct<BlockSize>(dst, rhs, alpha);
     }
 
     /** \returns the number of nonzero blocks */
@@ -861,8 +913,8 @@ class BlockSparseMatrix : public SparseMatrixBase<BlockSparseMatrix<_Scalar,_Blo
     /** \returns the total number of nonzero elements, including eventual explicit zeros in blocks */
     inline Index nonZeros() const { return m_nonzeros; }
 
-    inline BlockScalarReturnType *valuePtr() {return static_cast<BlockScalarReturnType *>(m_values);}
-//    inline Scalar *valuePtr(){ return m_values; }
+    inline Scalar *valuePtr(){ return m_values; }
+    inline const Scalar *valuePtr() const { return m_values; }
     inline StorageIndex *innerIndexPtr() {return m_indices; }
     inline const StorageIndex *innerIndexPtr() const {return m_indices; }
     inline StorageIndex *outerIndexPtr() {return m_outerIndex; }
@@ -942,6 +994,45 @@ class BlockSparseMatrix : public SparseMatrixBase<BlockSparseMatrix<_Scalar,_Blo
 
 
   protected:
+    template<int B, typename Rhs, typename Dest>
+    void blockProduct(Dest& dst, const Rhs& rhs, const Scalar& alpha) const
+    {
+      typedef typename internal::nested_eval<Rhs,Dynamic>::type RhsNested;
+      typedef typename internal::remove_all<RhsNested>::type ActualRhs;
+      typedef internal::block_sparse_time_dense_kernel<BlockSparseMatrix,B,ActualRhs,Dest> Kernel;
+      RhsNested actualRhs(rhs);
+      Kernel kernel(*this, actualRhs, dst, alpha);
+      const double work = double(nonZeros()) * double(rhs.cols());
+      if(IsColMajor)
+      {
+        // the block columns are scattered into a buffer per thread
+        Index threads = internal::sparse_scatter_threads(double(nonZeros()), dst);
+        if(threads>1)
+          internal::parallel_sparse_scatter(kernel, m_outerBSize, dst, threads);
+        else
+          kernel.run(0, m_outerBSize, dst);
+      }
+      else
+      {
+        // the block rows are independent
+        Index threads = internal::sparse_dense_product_threads(work);
+        if(threads>1)
+          internal::parallel_run_tasks(4*threads, threads, internal::sparse_dense_product_task<Kernel>(kernel, m_outerBSize, 4*threads));
+        else
+          kernel.run(0, m_outerBSize);
+      }
+    }
+
+    template<typename T>
+    static T* copyArray(const T* src, Index size)
+    {
+      if(src==0)
+        return 0;
+      T* dst = new T[size];
+      std::copy(src, src+size, dst);
+      return dst;
+    }
+
 //    inline Index blockDynIdx(Index id, internal::true_type) const
 //    {
 //      return m_blockPtr[id];
@@ -1000,13 +1091,13 @@ class BlockSparseMatrix<_Scalar, _BlockAtCompileTime, _Options, _StorageIndex>::
     inline Index index() const {return m_mat.m_indices[m_id]; }
     inline Index outer() const { return m_outer; }
     // block row index
-    inline Index row() const  {return index(); }
+    inline Index row() const  {return IsColMajor ? index() : outer(); }
     // block column index
-    inline Index col() const {return outer(); }
-    // FIXME Number of rows in the current block
-    inline Index rows() const { return (m_mat.m_blockSize==Dynamic) ? (m_mat.m_innerOffset[index()+1] - m_mat.m_innerOffset[index()]) : m_mat.m_blockSize; }
+    inline Index col() const {return IsColMajor ? outer() : index(); }
+    // Number of rows in the current block
+    inline Index rows() const { return IsColMajor ? m_mat.blockInnerSize(index()) : m_mat.blockOuterSize(m_outer); }
     // Number of columns in the current block ...
-    inline Index cols() const { return (m_mat.m_blockSize==Dynamic) ? (m_mat.m_outerOffset[m_outer+1]-m_mat.m_outerOffset[m_outer]) : m_mat.m_blockSize;}
+    inline Index cols() const { return IsColMajor ? m_mat.blockOuterSize(m_outer) : m_mat.blockInnerSize(index()); }
     inline operator bool() const { return (m_id < m_end); }
 
   protected:
@@ -1021,9 +1112,10 @@ class BlockSparseMatrix<_Scalar, _BlockAtCompileTime, _Options, _StorageIndex>::
 {
   public:
     InnerIterator(const BlockSparseMatrix& mat, Index outer)
-    : m_mat(mat),m_outerB(mat.outerToBlock(outer)),m_outer(outer),
+    : m_mat(mat),m_outer(outer),m_outerB(mat.outerToBlock(outer)),
       itb(mat, mat.outerToBlock(outer)),
-      m_offset(outer - mat.blockOuterIndex(m_outerB))
+      m_offset(outer - mat.blockOuterIndex(m_outerB)),
+      m_start(0), m_id(0), m_end(0)
      {
         if (itb)
         {
@@ -1049,16 +1141,16 @@ class BlockSparseMatrix<_Scalar, _BlockAtCompileTime, _Options, _StorageIndex>::
     }
     inline const Scalar& value() const
     {
-      return itb.value().coeff(m_id - m_start, m_offset);
+      return IsColMajor ? itb.value().coeffRef(m_id - m_start, m_offset) : itb.value().coeffRef(m_offset, m_id - m_start);
     }
     inline Scalar& valueRef()
     {
-      return itb.valueRef().coeff(m_id - m_start, m_offset);
+      return IsColMajor ? itb.valueRef().coeffRef(m_id - m_start, m_offset) : itb.valueRef().coeffRef(m_offset, m_id - m_start);
     }
     inline Index index() const { return m_id; }
     inline Index outer() const {return m_outer; }
-    inline Index col() const {return outer(); }
-    inline Index row() const { return index();}
+    inline Index col() const {return IsColMajor ? outer() : index(); }
+    inline Index row() const { return IsColMajor ? index() : outer(); }
     inline operator bool() const
     {
       return itb;
@@ -1074,6 +1166,50 @@ class BlockSparseMatrix<_Scalar, _BlockAtCompileTime, _Options, _StorageIndex>::
     Index m_end; // starting inner index of the next block
 
 };
+
+namespace internal {
+
+// the coefficients of a BlockSparseMatrix are read by the assignments to a SparseMatrix
+template<typename _Scalar, int _BlockAtCompileTime, int _Options, typename _StorageIndex>
+struct evaluator<BlockSparseMatrix<_Scalar,_BlockAtCompileTime,_Options,_StorageIndex> >
+  : evaluator_base<BlockSparseMatrix<_Scalar,_BlockAtCompileTime,_Options,_StorageIndex> >
+{
+  typedef BlockSparseMatrix<_Scalar,_BlockAtCompileTime,_Options,_StorageIndex> XprType;
+  enum {
+    CoeffReadCost = NumTraits<_Scalar>::ReadCost,
+    Flags = traits<XprType>::Flags
+  };
+
+  class InnerIterator : public XprType::InnerIterator
+  {
+    public:
+      InnerIterator(const evaluator& eval, Index outer) : XprType::InnerIterator(eval.m_matrix, outer) {}
+  };
+
+  explicit evaluator(const XprType& mat) : m_matrix(mat) {}
+
+  inline Index nonZerosEstimate() const { return m_matrix.nonZeros(); }
+
+  const XprType& m_matrix;
+};
+
+template<typename _Scalar, int _BlockAtCompileTime, int _Options, typename _StorageIndex, typename Rhs, int ProductType>
+struct generic_product_impl<BlockSparseMatrix<_Scalar,_BlockAtCompileTime,_Options,_StorageIndex>, Rhs, SparseShape, DenseShape, ProductType>
+ : generic_product_impl_base<BlockSparseMatrix<_Scalar,_BlockAtCompileTime,_Options,_StorageIndex>,Rhs,
+                             generic_product_impl<BlockSparseMatrix<_Scalar,_BlockAtCompileTime,_Options,_StorageIndex>,Rhs,SparseShape,DenseShape,ProductType> >
+{
+  typedef BlockSparseMatrix<_Scalar,_BlockAtCompileTime,_Options,_StorageIndex> Lhs;
+  typedef typename Product<Lhs,Rhs>::Scalar Scalar;
+
+  template<typename Dest>
+  static void scaleAndAddTo(Dest& dst, const Lhs& lhs, const Rhs& rhs, const Scalar& alpha)
+  {
+    lhs.scaleAndAddTo(dst, rhs, alpha);
+  }
+};
+
+} // end namespace internal
+
 } // end namespace Eigen
 
 #endif // EIGEN_SPARSEBLOCKMATRIX_H
@@ -0,0 +1,138 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "sparse.h"
+#include <Eigen/SparseExtra>
+
+// Checks the conversions of a BlockSparseMatrix from and to a SparseMatrix, and its products
+template<typename BlockMatrixType, typename SparseMatrixType>
+void check_block_sparse_matrix(BlockMatrixType& b, const SparseMatrixType& m)
+{
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef Matrix<Scalar,Dynamic,Dynamic,RowMajor> RowDenseMatrix;
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+  const DenseMatrix refMat = m.toDense();
+
+  b = m;
+  VERIFY_IS_EQUAL(b.rows(), m.rows());
+  VERIFY_IS_EQUAL(b.cols(), m.cols());
+  VERIFY(b.nonZeros() >= m.nonZeros());
+  SparseMatrix<Scalar> m1(b);
+  VERIFY_IS_APPROX(m1.toDense(), refMat);
+  SparseMatrix<Scalar,RowMajor> m2 = b;
+  VERIFY_IS_APPROX(m2.toDense(), refMat);
+  BlockMatrixType b2(b);
+  VERIFY_IS_APPROX(SparseMatrix<Scalar>(b2).toDense(), refMat);
+
+  DenseVector x = DenseVector::Random(m.cols());
+  DenseMatrix X = DenseMatrix::Random(m.cols(), internal::random<Index>(1,4));
+  RowDenseMatrix Xr = X;
+  Scalar alpha = internal::random<Scalar>();
+  VERIFY_IS_APPROX(DenseVector(b * x), DenseVector(refMat * x));
+  VERIFY_IS_APPROX(DenseMatrix(b * X), DenseMatrix(refMat * X));
+  VERIFY_IS_APPROX(DenseMatrix(b * Xr), DenseMatrix(refMat * X));
+  VERIFY_IS_APPROX(DenseVector(b * X.col(0)), DenseVector(refMat * X.col(0)));
+  DenseVector y = DenseVector::Random(m.rows()), y0 = y;
+  y.noalias() += alpha * (b * x);
+  VERIFY_IS_APPROX(y, (y0 + alpha * refMat * x).eval());
+  y = y0;
+  y.noalias() -= b2 * x;
+  VERIFY_IS_APPROX(y, (y0 - refMat * x).eval());
+}
+
+// fixed-size blocks can be constructed from a sparse matrix
+template<typename BlockMatrixType, int BlockSize = BlockMatrixType::BlockSize>
+struct block_sparse_matrix_constructor
+{
+  template<typename SparseMatrixType>
+  static void run(const SparseMatrixType& m, Index blockRows)
+  {
+    BlockMatrixType b(m);
+    VERIFY_IS_EQUAL(b.blockRows(), blockRows);
+    VERIFY_IS_APPROX(SparseMatrixType(b).toDense(), m.toDense());
+  }
+};
+
+template<typename BlockMatrixType>
+struct block_sparse_matrix_constructor<BlockMatrixType,Dynamic>
+{
+  template<typename SparseMatrixType>
+  static void run(const SparseMatrixType&, Index) {}
+};
+
+template<typename Scalar, int BlockSize, int Options>
+void block_sparse_matrix(Index blockRows, Index blockCols, Index blockSize)
+{
+  typedef SparseMatrix<Scalar> SpMat;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  Index rows = blockRows*blockSize, cols = blockCols*blockSize;
+  DenseMatrix refMat = DenseMatrix::Zero(rows, cols);
+  SpMat m(rows, cols);
+  initSparse<Scalar>(internal::random<double>(0.01,0.1), refMat, m);
+
+  // blocks of fixed or uniform size
+  BlockSparseMatrix<Scalar,BlockSize,Options> b(blockRows, blockCols);
+  b.setBlockSize(blockSize);
+  check_block_sparse_matrix(b, m);
+  block_sparse_matrix_constructor<BlockSparseMatrix<Scalar,BlockSize,Options> >::run(m, blockRows);
+
+  // blocks of variable sizes, with the same total sizes
+  if(BlockSize==Dynamic)
+  {
+    VectorXi rowBlocks = VectorXi::Constant(blockRows, int(blockSize)), colBlocks = VectorXi::Constant(blockCols, int(blockSize));
+    if(blockRows>1 && blockSize>1) { rowBlocks(0) -= 1; rowBlocks(1) += 1; }
+    if(blockCols>2 && blockSize>1) { colBlocks(2) -= 1; colBlocks(0) += 1; }
+    BlockSparseMatrix<Scalar,Dynamic,Options> v(blockRows, blockCols);
+    v.setBlockLayout(rowBlocks, colBlocks);
+    check_block_sparse_matrix(v, m);
+  }
+}
+
+// setFromTriplets() with dense blocks
+template<typename Scalar, int BlockSize>
+void block_sparse_matrix_triplets(Index blockRows, Index blockCols)
+{
+  typedef Matrix<Scalar,BlockSize,BlockSize> BlockScalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  DenseMatrix refMat = DenseMatrix::Zero(blockRows*BlockSize, blockCols*BlockSize);
+  std::vector<Triplet<BlockScalar> > triplets;
+  for(Index bj=0; bj<blockCols; ++bj)
+    for(Index bi=0; bi<blockRows; ++bi)
+      if(internal::random<int>(0,3)==0)
+      {
+        BlockScalar block = BlockScalar::Random();
+        triplets.push_back(Triplet<BlockScalar>(int(bi), int(bj), block));
+        refMat.block(bi*BlockSize, bj*BlockSize, BlockSize, BlockSize) = block;
+      }
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+  BlockSparseMatrix<Scalar,BlockSize> b(blockRows, blockCols);
+  b.setFromTriplets(triplets.begin(), triplets.end());
+  VERIFY_IS_EQUAL(b.nonZerosBlocks(), Index(triplets.size()));
+  VERIFY_IS_APPROX(SparseMatrix<Scalar>(b).toDense(), refMat);
+  DenseVector x = DenseVector::Random(refMat.cols());
+  VERIFY_IS_APPROX(DenseVector(b * x), DenseVector(refMat * x));
+}
+
+EIGEN_DECLARE_TEST(block_sparse_matrix)
+{
+  for(int i = 0; i < g_repeat; i++) {
+    Index br = internal::random<Index>(1,60), bc = internal::random<Index>(1,60);
+    CALL_SUBTEST_1(( block_sparse_matrix<double,3,ColMajor>(br, bc, 3) ));
+    CALL_SUBTEST_1(( block_sparse_matrix<double,3,RowMajor>(br, bc, 3) ));
+    CALL_SUBTEST_2(( block_sparse_matrix<float,2,RowMajor>(br, bc, 2) ));
+    CALL_SUBTEST_2(( block_sparse_matrix<float,4,ColMajor>(br, bc, 4) ));
+    CALL_SUBTEST_3(( block_sparse_matrix<double,Dynamic,ColMajor>(br, bc, internal::random<Index>(1,7)) ));
+    CALL_SUBTEST_3(( block_sparse_matrix<double,Dynamic,RowMajor>(br, bc, internal::random<Index>(1,7)) ));
+    CALL_SUBTEST_4(( block_sparse_matrix<std::complex<double>,6,RowMajor>(br, bc, 6) ));
+    CALL_SUBTEST_4(( block_sparse_matrix<std::complex<double>,Dynamic,ColMajor>(br, bc, 6) ));
+    CALL_SUBTEST_5(( block_sparse_matrix_triplets<double,3>(br, bc) ));
+    CALL_SUBTEST_5(( block_sparse_matrix_triplets<float,2>(br, bc) ));
+    EIGEN_UNUSED_VARIABLE(br);
+    EIGEN_UNUSED_VARIABLE(bc);
+  }
+}
@@ -560,6 +560,53 @@ static void test_large_contraction_with_output_kernel() {
   }
 }
 
+template<int DataLayout>
+static void test_bfloat16_contraction()
+{
+  Tensor<bfloat16, 3, DataLayout> t_left(20, 15, 31);
+  Tensor<bfloat16, 2, DataLayout> t_right(31, 40);
+  t_left.setRandom();
+  t_right.setRandom();
+
+  // Add a little offset so that the results won't be close to zero.
+  t_left += t_left.constant(bfloat16(1.0f));
+  t_right += t_right.constant(bfloat16(1.0f));
+
+  Eigen::array<DimPair, 1> dims = {{DimPair(2, 0)}};
+  Tensor<bfloat16, 3, DataLayout> t_result = t_left.contract(t_right, dims);
+  Tensor<float, 3, DataLayout> f_result = t_left.template cast<float>().contract(t_right.template cast<float>(), dims);
+
+  for (int i = 0; i < t_result.dimensions().TotalSize(); i++) {
+    VERIFY(t_result.data()[i] >= bfloat16(31.0f));
+    VERIFY_IS_APPROX(t_result.data()[i], bfloat16(f_result.data()[i]));
+  }
+}
+
+template<int DataLayout>
+static void test_quantized_contraction()
+{
+  Tensor<signed char, 3, DataLayout> t_left(20, 15, 131);
+  Tensor<unsigned char, 2, DataLayout> t_right(131, 40);
+  Tensor<unsigned char, 1, DataLayout> t_vector(131);
+  for (int i = 0; i < t_left.size(); i++) t_left.data()[i] = static_cast<signed char>(internal::random<int>(-128, 127));
+  for (int i = 0; i < t_right.size(); i++) t_right.data()[i] = static_cast<unsigned char>(internal::random<int>(0, 255));
+  for (int i = 0; i < t_vector.size(); i++) t_vector.data()[i] = static_cast<unsigned char>(internal::random<int>(0, 255));
+
+  // 8-bit contractions are accumulated into 32-bit integers
+  Eigen::array<DimPair, 1> dims = {{DimPair(2, 0)}};
+  Tensor<int, 3, DataLayout> t_result = t_left.contract(t_right, dims);
+  Tensor<int, 3, DataLayout> i_result = t_left.template cast<int>().contract(t_right.template cast<int>(), dims);
+  for (int i = 0; i < t_result.size(); i++) {
+    VERIFY_IS_EQUAL(t_result.data()[i], i_result.data()[i]);
+  }
+
+  Tensor<int, 2, DataLayout> v_result = t_left.contract(t_vector, dims);
+  Tensor<int, 2, DataLayout> iv_result = t_left.template cast<int>().contract(t_vector.template cast<int>(), dims);
+  for (int i = 0; i < v_result.size(); i++) {
+    VERIFY_IS_EQUAL(v_result.data()[i], iv_result.data()[i]);
+  }
+}
+
 EIGEN_DECLARE_TEST(cxx11_tensor_contraction)
 {
   CALL_SUBTEST(test_evals<ColMajor>());
@@ -594,4 +641,8 @@ EIGEN_DECLARE_TEST(cxx11_tensor_contraction)
   CALL_SUBTEST(test_const_inputs<RowMajor>());
   CALL_SUBTEST(test_large_contraction_with_output_kernel<ColMajor>());
   CALL_SUBTEST(test_large_contraction_with_output_kernel<RowMajor>());
+  CALL_SUBTEST(test_bfloat16_contraction<ColMajor>());
+  CALL_SUBTEST(test_bfloat16_contraction<RowMajor>());
+  CALL_SUBTEST(test_quantized_contraction<ColMajor>());
+  CALL_SUBTEST(test_quantized_contraction<RowMajor>());
 }
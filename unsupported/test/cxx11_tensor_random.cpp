@@ -36,6 +36,19 @@ static void test_normal()
 }
 
 
+static void test_bfloat16()
+{
+  Tensor<bfloat16, 1> vec(64);
+  vec.setRandom();
+
+  // uniform values in [0,1)
+  for (int i = 0; i < 64; ++i) {
+    VERIFY(vec(i) >= bfloat16(0.0f));
+    VERIFY(vec(i) < bfloat16(1.0f));
+  }
+}
+
+
 struct MyGenerator {
   MyGenerator() { }
   MyGenerator(const MyGenerator&) { }
@@ -75,4 +88,5 @@ EIGEN_DECLARE_TEST(cxx11_tensor_random)
   CALL_SUBTEST(test_default());
   CALL_SUBTEST(test_normal());
   CALL_SUBTEST(test_custom());
+  CALL_SUBTEST(test_bfloat16());
 }
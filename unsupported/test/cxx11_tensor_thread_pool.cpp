@@ -290,6 +290,34 @@ struct SqrtOutputKernel {
   }
 };
 
+// 8-bit contractions accumulated into 32-bit integers must be exact, whatever
+// the sharding of the blocks among the threads.
+template<int DataLayout>
+void test_multithread_quantized_contraction() {
+  int contract_size = internal::random<int>(1, 5000);
+  Tensor<unsigned char, 2, DataLayout> left(internal::random<int>(1, 80), contract_size);
+  Tensor<signed char, 3, DataLayout> right(contract_size, internal::random<int>(1, 37), internal::random<int>(1, 51));
+  for (ptrdiff_t i = 0; i < left.size(); i++) left.data()[i] = static_cast<unsigned char>(internal::random<int>(0, 255));
+  for (ptrdiff_t i = 0; i < right.size(); i++) right.data()[i] = static_cast<signed char>(internal::random<int>(-128, 127));
+
+  typedef Tensor<float, 1>::DimensionPair DimPair;
+  Eigen::array<DimPair, 1> dims({{DimPair(1, 0)}});
+
+  Eigen::ThreadPool tp(internal::random<int>(2, 11));
+  Eigen::ThreadPoolDevice thread_pool_device(&tp, internal::random<int>(2, 11));
+
+  Tensor<int, 3, DataLayout> st_result;
+  st_result = left.template cast<int>().contract(right.template cast<int>(), dims);
+
+  Tensor<int, 3, DataLayout> tp_result(st_result.dimensions());
+  tp_result.device(thread_pool_device) = left.contract(right, dims);
+
+  VERIFY(dimensions_match(st_result.dimensions(), tp_result.dimensions()));
+  for (ptrdiff_t i = 0; i < st_result.size(); i++) {
+    VERIFY_IS_EQUAL(st_result.data()[i], tp_result.data()[i]);
+  }
+}
+
 template <int DataLayout>
 static void test_multithread_contraction_with_output_kernel() {
   typedef Tensor<float, 1>::DimensionPair DimPair;
@@ -683,6 +711,8 @@ EIGEN_DECLARE_TEST(cxx11_tensor_thread_pool)
   CALL_SUBTEST_3(test_multithread_contraction_agrees_with_singlethread<RowMajor>());
   CALL_SUBTEST_3(test_multithread_contraction_with_output_kernel<ColMajor>());
   CALL_SUBTEST_3(test_multithread_contraction_with_output_kernel<RowMajor>());
+  CALL_SUBTEST_3(test_multithread_quantized_contraction<ColMajor>());
+  CALL_SUBTEST_3(test_multithread_quantized_contraction<RowMajor>());
 
   CALL_SUBTEST_4(test_async_multithread_contraction_agrees_with_singlethread<ColMajor>());
   CALL_SUBTEST_4(test_async_multithread_contraction_agrees_with_singlethread<RowMajor>());